@@ -0,0 +1,842 @@
+/* Copyright 2020-2021, Robotec.ai sp. z o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <ApiCommon.h>
+#include <Nodes.h>
+#include <Scene.h>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <rgl/api/core.h>
+#include <rgl/api/extensions/pcl.h>
+#include <rgl/api/extensions/ros2.h>
+#include <unordered_map>
+#include <unordered_set>
+
+using namespace RGL::Cpu;
+
+namespace
+{
+    // Version of the RGL API implemented by this backend.
+    constexpr int32_t ApiVersionMajor = 0;
+    constexpr int32_t ApiVersionMinor = 15;
+    constexpr int32_t ApiVersionPatch = 0;
+
+    struct ApiState
+    {
+        ApiState()
+        {
+            // Entities remove themselves from the default scene when destroyed, so the scene has to outlive the state.
+            Scene::GetDefault();
+        }
+
+        std::recursive_mutex m_mutex;
+        std::string m_lastError;
+
+        std::unordered_map<Mesh*, std::shared_ptr<Mesh>> m_meshes;
+        std::unordered_map<Entity*, std::unique_ptr<Entity>> m_entities;
+        std::unordered_map<Texture*, std::shared_ptr<Texture>> m_textures;
+        std::unordered_map<Node*, std::unique_ptr<Node>> m_nodes;
+
+        rgl_log_level_t m_logLevel{ RGL_LOG_LEVEL_WARN };
+        bool m_logToStdout{ true };
+        std::FILE* m_logFile{ nullptr };
+    };
+
+    ApiState& GetState()
+    {
+        static ApiState State;
+        return State;
+    }
+
+    //! Runs the API call body, translating the thrown errors into the returned status and the last error string.
+    template<typename Function>
+    rgl_status_t ApiCall(const char* functionName, Function&& function)
+    {
+        ApiState& state = GetState();
+        std::lock_guard lock(state.m_mutex);
+        try
+        {
+            function();
+            return RGL_SUCCESS;
+        }
+        catch (const ApiError& error)
+        {
+            state.m_lastError = std::string(functionName) + ": " + error.what();
+            Log(RGL_LOG_LEVEL_ERROR, state.m_lastError);
+            return error.GetStatus();
+        }
+        catch (const std::exception& exception)
+        {
+            state.m_lastError = std::string(functionName) + ": " + exception.what();
+            Log(RGL_LOG_LEVEL_CRITICAL, state.m_lastError);
+            return RGL_INTERNAL_EXCEPTION;
+        }
+    }
+
+    template<typename T>
+    void CheckNotNull(const T* pointer, const char* name)
+    {
+        if (pointer == nullptr)
+        {
+            ThrowInvalidArgument(std::string(name) + " must not be null.");
+        }
+    }
+
+    Scene& GetScene(rgl_scene_t scene)
+    {
+        if (scene != nullptr)
+        {
+            ThrowNotImplemented("Only the default scene (null handle) is supported.");
+        }
+        return Scene::GetDefault();
+    }
+
+    std::shared_ptr<Mesh> GetMesh(rgl_mesh_t mesh)
+    {
+        auto& meshes = GetState().m_meshes;
+        auto meshIt = meshes.find(mesh);
+        if (meshIt == meshes.end())
+        {
+            throw ApiError(RGL_INVALID_API_OBJECT, "Invalid mesh handle.");
+        }
+        return meshIt->second;
+    }
+
+    std::shared_ptr<Texture> GetTexture(rgl_texture_t texture)
+    {
+        auto& textures = GetState().m_textures;
+        auto textureIt = textures.find(texture);
+        if (textureIt == textures.end())
+        {
+            throw ApiError(RGL_INVALID_API_OBJECT, "Invalid texture handle.");
+        }
+        return textureIt->second;
+    }
+
+    Entity& GetEntity(rgl_entity_t entity)
+    {
+        auto& entities = GetState().m_entities;
+        auto entityIt = entities.find(entity);
+        if (entityIt == entities.end())
+        {
+            throw ApiError(RGL_INVALID_API_OBJECT, "Invalid entity handle.");
+        }
+        return *entityIt->second;
+    }
+
+    Node& GetNode(rgl_node_t node)
+    {
+        auto& nodes = GetState().m_nodes;
+        auto nodeIt = nodes.find(node);
+        if (nodeIt == nodes.end())
+        {
+            throw ApiError(RGL_INVALID_API_OBJECT, "Invalid node handle.");
+        }
+        return *nodeIt->second;
+    }
+
+    //! Implements the RGL convention: a null handle creates a new node, a non-null one reconfigures an existing node of the same type.
+    template<typename NodeType, typename... Args>
+    void CreateOrUpdateNode(rgl_node_t* node, Args&&... args)
+    {
+        CheckNotNull(node, "node");
+        if (*node == nullptr)
+        {
+            auto newNode = std::make_unique<NodeType>();
+            newNode->SetParameters(std::forward<Args>(args)...);
+            *node = newNode.get();
+            GetState().m_nodes.emplace(newNode.get(), std::move(newNode));
+            return;
+        }
+
+        auto* existingNode = dynamic_cast<NodeType*>(&GetNode(*node));
+        if (existingNode == nullptr)
+        {
+            ThrowInvalidArgument("Node type does not match the called function.");
+        }
+        existingNode->SetParameters(std::forward<Args>(args)...);
+    }
+
+    //! Returns all the nodes connected (in either direction) to the given one.
+    std::vector<Node*> GetConnectedNodes(Node& node)
+    {
+        std::vector<Node*> connectedNodes;
+        std::unordered_set<Node*> visited{ &node };
+        std::queue<Node*> toVisit;
+        toVisit.push(&node);
+        while (!toVisit.empty())
+        {
+            Node* current = toVisit.front();
+            toVisit.pop();
+            connectedNodes.push_back(current);
+            for (const auto* neighbours : { &current->m_inputs, &current->m_outputs })
+            {
+                for (Node* neighbour : *neighbours)
+                {
+                    if (visited.insert(neighbour).second)
+                    {
+                        toVisit.push(neighbour);
+                    }
+                }
+            }
+        }
+        return connectedNodes;
+    }
+
+    std::vector<Node*> SortTopologically(const std::vector<Node*>& nodes)
+    {
+        std::unordered_map<Node*, size_t> remainingInputs;
+        std::queue<Node*> ready;
+        for (Node* node : nodes)
+        {
+            remainingInputs[node] = node->m_inputs.size();
+            if (node->m_inputs.empty())
+            {
+                ready.push(node);
+            }
+        }
+
+        std::vector<Node*> sortedNodes;
+        while (!ready.empty())
+        {
+            Node* node = ready.front();
+            ready.pop();
+            sortedNodes.push_back(node);
+            for (Node* output : node->m_outputs)
+            {
+                if (--remainingInputs[output] == 0LU)
+                {
+                    ready.push(output);
+                }
+            }
+        }
+
+        if (sortedNodes.size() != nodes.size())
+        {
+            ThrowInvalidPipeline("Graph contains a cycle.");
+        }
+        return sortedNodes;
+    }
+
+    const PointsNode& GetResultNode(rgl_node_t node)
+    {
+        const auto* pointsNode = dynamic_cast<const PointsNode*>(&GetNode(node));
+        if (pointsNode == nullptr)
+        {
+            ThrowInvalidArgument("Results are only available for nodes producing points.");
+        }
+        if (!pointsNode->HasResults())
+        {
+            throw ApiError(RGL_INVALID_STATE, "The graph has not been run yet.");
+        }
+        return *pointsNode;
+    }
+} // namespace
+
+namespace RGL::Cpu
+{
+    void ConfigureLogging(rgl_log_level_t level, const char* filePath, bool useStdout)
+    {
+        ApiState& state = GetState();
+        if (state.m_logFile != nullptr)
+        {
+            std::fclose(state.m_logFile);
+            state.m_logFile = nullptr;
+        }
+
+        state.m_logLevel = level;
+        state.m_logToStdout = useStdout;
+        if (filePath != nullptr && std::strlen(filePath) > 0LU)
+        {
+            state.m_logFile = std::fopen(filePath, "w");
+            if (state.m_logFile == nullptr)
+            {
+                throw ApiError(RGL_INVALID_FILE_PATH, std::string("Unable to open the log file ") + filePath + ".");
+            }
+        }
+    }
+
+    void Log(rgl_log_level_t level, const std::string& message)
+    {
+        const ApiState& state = GetState();
+        if (level < state.m_logLevel || state.m_logLevel == RGL_LOG_LEVEL_OFF)
+        {
+            return;
+        }
+
+        if (state.m_logToStdout)
+        {
+            std::printf("[RGL CPU] %s\n", message.c_str());
+        }
+        if (state.m_logFile != nullptr)
+        {
+            std::fprintf(state.m_logFile, "%s\n", message.c_str());
+            std::fflush(state.m_logFile);
+        }
+    }
+} // namespace RGL::Cpu
+
+// Common
+
+RGL_API rgl_status_t rgl_get_version_info(int32_t* out_major, int32_t* out_minor, int32_t* out_patch)
+{
+    return ApiCall(
+        __func__,
+        [&]
+        {
+            CheckNotNull(out_major, "out_major");
+            CheckNotNull(out_minor, "out_minor");
+            CheckNotNull(out_patch, "out_patch");
+            *out_major = ApiVersionMajor;
+            *out_minor = ApiVersionMinor;
+            *out_patch = ApiVersionPatch;
+        });
+}
+
+RGL_API rgl_status_t rgl_configure_logging(rgl_log_level_t log_level, const char* log_file_path, bool use_stdout)
+{
+    return ApiCall(
+        __func__,
+        [&]
+        {
+            ConfigureLogging(log_level, log_file_path, use_stdout);
+        });
+}
+
+RGL_API void rgl_get_last_error_string(const char** out_error_string)
+{
+    if (out_error_string != nullptr)
+    {
+        ApiState& state = GetState();
+        std::lock_guard lock(state.m_mutex);
+        *out_error_string = state.m_lastError.c_str();
+    }
+}
+
+RGL_API rgl_status_t rgl_cleanup(void)
+{
+    return ApiCall(
+        __func__,
+        []
+        {
+            ApiState& state = GetState();
+            state.m_nodes.clear();
+            state.m_entities.clear();
+            state.m_meshes.clear();
+            state.m_textures.clear();
+            Scene::GetDefault().Clear();
+        });
+}
+
+// Meshes
+
+RGL_API rgl_status_t rgl_mesh_create(
+    rgl_mesh_t* out_mesh, const rgl_vec3f* vertices, int32_t vertex_count, const rgl_vec3i* indices, int32_t index_count)
+{
+    return ApiCall(
+        __func__,
+        [&]
+        {
+            CheckNotNull(out_mesh, "out_mesh");
+            auto mesh = std::make_shared<Mesh>(vertices, vertex_count, indices, index_count);
+            *out_mesh = mesh.get();
+            GetState().m_meshes.emplace(mesh.get(), std::move(mesh));
+        });
+}
+
+RGL_API rgl_status_t rgl_mesh_set_texture_coords(rgl_mesh_t mesh, const rgl_vec2f* uvs, int32_t uv_count)
+{
+    return ApiCall(
+        __func__,
+        [&]
+        {
+            GetMesh(mesh)->SetTextureCoords(uvs, uv_count);
+        });
+}
+
+RGL_API rgl_status_t rgl_mesh_destroy(rgl_mesh_t mesh)
+{
+    return ApiCall(
+        __func__,
+        [&]
+        {
+            GetMesh(mesh);
+            // Entities using the mesh keep it alive until they are destroyed.
+            GetState().m_meshes.erase(mesh);
+        });
+}
+
+RGL_API rgl_status_t rgl_mesh_update_vertices(rgl_mesh_t mesh, const rgl_vec3f* vertices, int32_t vertex_count)
+{
+    return ApiCall(
+        __func__,
+        [&]
+        {
+            GetMesh(mesh)->UpdateVertices(vertices, vertex_count);
+        });
+}
+
+// Entities
+
+RGL_API rgl_status_t rgl_entity_create(rgl_entity_t* out_entity, rgl_scene_t scene, rgl_mesh_t mesh)
+{
+    return ApiCall(
+        __func__,
+        [&]
+        {
+            CheckNotNull(out_entity, "out_entity");
+            auto entity = std::make_unique<Entity>(GetScene(scene), GetMesh(mesh));
+            *out_entity = entity.get();
+            GetState().m_entities.emplace(entity.get(), std::move(entity));
+        });
+}
+
+RGL_API rgl_status_t rgl_entity_destroy(rgl_entity_t entity)
+{
+    return ApiCall(
+        __func__,
+        [&]
+        {
+            GetEntity(entity);
+            GetState().m_entities.erase(entity);
+        });
+}
+
+RGL_API rgl_status_t rgl_entity_set_pose(rgl_entity_t entity, const rgl_mat3x4f* transform)
+{
+    return ApiCall(
+        __func__,
+        [&]
+        {
+            CheckNotNull(transform, "transform");
+            GetEntity(entity).SetPose(*transform);
+        });
+}
+
+RGL_API rgl_status_t rgl_entity_set_id(rgl_entity_t entity, int32_t id)
+{
+    return ApiCall(
+        __func__,
+        [&]
+        {
+            GetEntity(entity).SetId(id);
+        });
+}
+
+RGL_API rgl_status_t rgl_entity_set_intensity_texture(rgl_entity_t entity, rgl_texture_t texture)
+{
+    return ApiCall(
+        __func__,
+        [&]
+        {
+            GetEntity(entity).SetIntensityTexture(GetTexture(texture));
+        });
+}
+
+// Textures
+
+RGL_API rgl_status_t rgl_texture_create(rgl_texture_t* out_texture, const void* texels, int32_t width, int32_t height)
+{
+    return ApiCall(
+        __func__,
+        [&]
+        {
+            CheckNotNull(out_texture, "out_texture");
+            auto texture = std::make_shared<Texture>(texels, width, height);
+            *out_texture = texture.get();
+            GetState().m_textures.emplace(texture.get(), std::move(texture));
+        });
+}
+
+RGL_API rgl_status_t rgl_texture_destroy(rgl_texture_t texture)
+{
+    return ApiCall(
+        __func__,
+        [&]
+        {
+            GetTexture(texture);
+            // Entities using the texture keep it alive until they are destroyed.
+            GetState().m_textures.erase(texture);
+        });
+}
+
+// Scene
+
+RGL_API rgl_status_t rgl_scene_set_time(rgl_scene_t scene, uint64_t nanoseconds)
+{
+    return ApiCall(
+        __func__,
+        [&]
+        {
+            GetScene(scene).SetTime(nanoseconds);
+        });
+}
+
+// Nodes
+
+RGL_API rgl_status_t rgl_node_rays_from_mat3x4f(rgl_node_t* node, const rgl_mat3x4f* rays, int32_t ray_count)
+{
+    return ApiCall(
+        __func__,
+        [&]
+        {
+            CreateOrUpdateNode<RaysFromMat3x4fNode>(node, rays, ray_count);
+        });
+}
+
+RGL_API rgl_status_t rgl_node_rays_set_range(rgl_node_t* node, const rgl_vec2f* ranges, int32_t ranges_count)
+{
+    return ApiCall(
+        __func__,
+        [&]
+        {
+            CreateOrUpdateNode<RaysSetRangeNode>(node, ranges, ranges_count);
+        });
+}
+
+RGL_API rgl_status_t rgl_node_rays_set_ring_ids(rgl_node_t* node, const int32_t* ring_ids, int32_t ring_ids_count)
+{
+    return ApiCall(
+        __func__,
+        [&]
+        {
+            CreateOrUpdateNode<RaysSetRingIdsNode>(node, ring_ids, ring_ids_count);
+        });
+}
+
+RGL_API rgl_status_t rgl_node_rays_set_time_offsets(rgl_node_t* node, const float* offsets, int32_t offsets_count)
+{
+    return ApiCall(
+        __func__,
+        [&]
+        {
+            CreateOrUpdateNode<RaysSetTimeOffsetsNode>(node, offsets, offsets_count);
+        });
+}
+
+RGL_API rgl_status_t rgl_node_rays_transform(rgl_node_t* node, const rgl_mat3x4f* transform)
+{
+    return ApiCall(
+        __func__,
+        [&]
+        {
+            CheckNotNull(transform, "transform");
+            CreateOrUpdateNode<RaysTransformNode>(node, *transform);
+        });
+}
+
+RGL_API rgl_status_t rgl_node_points_transform(rgl_node_t* node, const rgl_mat3x4f* transform)
+{
+    return ApiCall(
+        __func__,
+        [&]
+        {
+            CheckNotNull(transform, "transform");
+            CreateOrUpdateNode<PointsTransformNode>(node, *transform);
+        });
+}
+
+RGL_API rgl_status_t rgl_node_raytrace(rgl_node_t* node, rgl_scene_t scene)
+{
+    return ApiCall(
+        __func__,
+        [&]
+        {
+            CreateOrUpdateNode<RaytraceNode>(node, GetScene(scene));
+        });
+}
+
+RGL_API rgl_status_t rgl_node_raytrace_with_distortion(
+    rgl_node_t* node, rgl_scene_t scene, const rgl_vec3f* linear_velocity, const rgl_vec3f* angular_velocity)
+{
+    return ApiCall(
+        __func__,
+        [&]
+        {
+            CheckNotNull(linear_velocity, "linear_velocity");
+            CheckNotNull(angular_velocity, "angular_velocity");
+            CreateOrUpdateNode<RaytraceNode>(node, GetScene(scene), *linear_velocity, *angular_velocity);
+        });
+}
+
+RGL_API rgl_status_t rgl_node_points_format(rgl_node_t* node, const rgl_field_t* fields, int32_t field_count)
+{
+    return ApiCall(
+        __func__,
+        [&]
+        {
+            CreateOrUpdateNode<PointsFormatNode>(node, fields, field_count);
+        });
+}
+
+RGL_API rgl_status_t rgl_node_points_yield(rgl_node_t* node, const rgl_field_t* fields, int32_t field_count)
+{
+    return ApiCall(
+        __func__,
+        [&]
+        {
+            CreateOrUpdateNode<PointsYieldNode>(node, fields, field_count);
+        });
+}
+
+RGL_API rgl_status_t rgl_node_points_compact(rgl_node_t* node)
+{
+    return ApiCall(
+        __func__,
+        [&]
+        {
+            CheckNotNull(node, "node");
+            if (*node == nullptr)
+            {
+                auto newNode = std::make_unique<PointsCompactNode>();
+                *node = newNode.get();
+                GetState().m_nodes.emplace(newNode.get(), std::move(newNode));
+            }
+            else if (dynamic_cast<PointsCompactNode*>(&GetNode(*node)) == nullptr)
+            {
+                ThrowInvalidArgument("Node type does not match the called function.");
+            }
+        });
+}
+
+RGL_API rgl_status_t rgl_node_points_downsample(rgl_node_t* node, float leaf_size_x, float leaf_size_y, float leaf_size_z)
+{
+    return ApiCall(
+        __func__,
+        [&]
+        {
+            CreateOrUpdateNode<PointsDownsampleNode>(node, leaf_size_x, leaf_size_y, leaf_size_z);
+        });
+}
+
+RGL_API rgl_status_t rgl_node_points_spatial_merge(rgl_node_t*, const rgl_field_t*, int32_t)
+{
+    return ApiCall(
+        __func__,
+        []
+        {
+            ThrowNotImplemented("Spatial merge is not supported by the CPU backend.");
+        });
+}
+
+RGL_API rgl_status_t rgl_node_points_temporal_merge(rgl_node_t*, const rgl_field_t*, int32_t)
+{
+    return ApiCall(
+        __func__,
+        []
+        {
+            ThrowNotImplemented("Temporal merge is not supported by the CPU backend.");
+        });
+}
+
+RGL_API rgl_status_t rgl_node_points_from_array(rgl_node_t*, const void*, int32_t, const rgl_field_t*, int32_t)
+{
+    return ApiCall(
+        __func__,
+        []
+        {
+            ThrowNotImplemented("Points from array are not supported by the CPU backend.");
+        });
+}
+
+RGL_API rgl_status_t rgl_node_gaussian_noise_angular_ray(rgl_node_t* node, float mean, float st_dev, rgl_axis_t rotation_axis)
+{
+    return ApiCall(
+        __func__,
+        [&]
+        {
+            CreateOrUpdateNode<GaussianNoiseAngularRayNode>(node, mean, st_dev, rotation_axis);
+        });
+}
+
+RGL_API rgl_status_t rgl_node_gaussian_noise_angular_hitpoint(rgl_node_t*, float, float, rgl_axis_t)
+{
+    return ApiCall(
+        __func__,
+        []
+        {
+            ThrowNotImplemented("Angular hitpoint noise is not supported by the CPU backend.");
+        });
+}
+
+RGL_API rgl_status_t rgl_node_gaussian_noise_distance(rgl_node_t* node, float mean, float st_dev_base, float st_dev_rise_per_meter)
+{
+    return ApiCall(
+        __func__,
+        [&]
+        {
+            CreateOrUpdateNode<GaussianNoiseDistanceNode>(node, mean, st_dev_base, st_dev_rise_per_meter);
+        });
+}
+
+RGL_API rgl_status_t rgl_node_points_ros2_publish(rgl_node_t* node, const char* topic_name, const char* frame_id)
+{
+    return ApiCall(
+        __func__,
+        [&]
+        {
+            CreateOrUpdateNode<PointsRos2PublishNode>(node, topic_name, frame_id);
+        });
+}
+
+RGL_API rgl_status_t rgl_node_points_ros2_publish_with_qos(
+    rgl_node_t* node,
+    const char* topic_name,
+    const char* frame_id,
+    rgl_qos_policy_reliability_t,
+    rgl_qos_policy_durability_t,
+    rgl_qos_policy_history_t,
+    int32_t)
+{
+    return ApiCall(
+        __func__,
+        [&]
+        {
+            CreateOrUpdateNode<PointsRos2PublishNode>(node, topic_name, frame_id);
+        });
+}
+
+// Graph
+
+RGL_API rgl_status_t rgl_graph_run(rgl_node_t node)
+{
+    return ApiCall(
+        __func__,
+        [&]
+        {
+            // Execution is synchronous, so the results are ready as soon as the call returns.
+            for (Node* graphNode : SortTopologically(GetConnectedNodes(GetNode(node))))
+            {
+                graphNode->Execute();
+            }
+        });
+}
+
+RGL_API rgl_status_t rgl_graph_destroy(rgl_node_t node)
+{
+    return ApiCall(
+        __func__,
+        [&]
+        {
+            for (Node* graphNode : GetConnectedNodes(GetNode(node)))
+            {
+                GetState().m_nodes.erase(graphNode);
+            }
+        });
+}
+
+RGL_API rgl_status_t rgl_graph_get_result_size(rgl_node_t node, rgl_field_t field, int32_t* out_count, int32_t* out_size_of)
+{
+    return ApiCall(
+        __func__,
+        [&]
+        {
+            const PointsNode& resultNode = GetResultNode(node);
+            size_t fieldSize = 0LU;
+            if (field == RGL_FIELD_DYNAMIC_FORMAT)
+            {
+                const auto* formatNode = dynamic_cast<const PointsFormatNode*>(&resultNode);
+                if (formatNode == nullptr)
+                {
+                    ThrowInvalidArgument("The formatted result is only available for the format node.");
+                }
+                fieldSize = formatNode->GetPointSize();
+            }
+            else
+            {
+                if (!resultNode.GetPoints().HasField(field))
+                {
+                    ThrowInvalidPipeline("Requested field is not present in the node results.");
+                }
+                fieldSize = GetFieldSize(field);
+            }
+
+            if (out_count != nullptr)
+            {
+                *out_count = static_cast<int32_t>(resultNode.GetPoints().GetPointCount());
+            }
+            if (out_size_of != nullptr)
+            {
+                *out_size_of = static_cast<int32_t>(fieldSize);
+            }
+        });
+}
+
+RGL_API rgl_status_t rgl_graph_get_result_data(rgl_node_t node, rgl_field_t field, void* data)
+{
+    return ApiCall(
+        __func__,
+        [&]
+        {
+            CheckNotNull(data, "data");
+            const PointsNode& resultNode = GetResultNode(node);
+            if (field == RGL_FIELD_DYNAMIC_FORMAT)
+            {
+                const auto* formatNode = dynamic_cast<const PointsFormatNode*>(&resultNode);
+                if (formatNode == nullptr)
+                {
+                    ThrowInvalidArgument("The formatted result is only available for the format node.");
+                }
+                const std::vector<uint8_t>& formattedData = formatNode->GetFormattedData();
+                std::memcpy(data, formattedData.data(), formattedData.size());
+                return;
+            }
+
+            const PointCloud& points = resultNode.GetPoints();
+            const uint8_t* fieldData = points.GetFieldData(field);
+            if (fieldData == nullptr)
+            {
+                ThrowInvalidPipeline("Requested field is not present in the node results.");
+            }
+            std::memcpy(data, fieldData, points.GetPointCount() * GetFieldSize(field));
+        });
+}
+
+RGL_API rgl_status_t rgl_graph_node_add_child(rgl_node_t parent, rgl_node_t child)
+{
+    return ApiCall(
+        __func__,
+        [&]
+        {
+            Node& parentNode = GetNode(parent);
+            Node& childNode = GetNode(child);
+            if (std::find(parentNode.m_outputs.begin(), parentNode.m_outputs.end(), &childNode) != parentNode.m_outputs.end())
+            {
+                return;
+            }
+            parentNode.m_outputs.push_back(&childNode);
+            childNode.m_inputs.push_back(&parentNode);
+        });
+}
+
+RGL_API rgl_status_t rgl_graph_node_remove_child(rgl_node_t parent, rgl_node_t child)
+{
+    return ApiCall(
+        __func__,
+        [&]
+        {
+            Node& parentNode = GetNode(parent);
+            Node& childNode = GetNode(child);
+            auto childIt = std::find(parentNode.m_outputs.begin(), parentNode.m_outputs.end(), &childNode);
+            if (childIt == parentNode.m_outputs.end())
+            {
+                ThrowInvalidArgument("Given node is not a child of the parent node.");
+            }
+            parentNode.m_outputs.erase(childIt);
+            childNode.m_inputs.erase(std::find(childNode.m_inputs.begin(), childNode.m_inputs.end(), &parentNode));
+        });
+}
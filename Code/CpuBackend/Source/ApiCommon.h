@@ -0,0 +1,59 @@
+/* Copyright 2020-2021, Robotec.ai sp. z o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <rgl/api/core.h>
+#include <stdexcept>
+#include <string>
+
+namespace RGL::Cpu
+{
+    //! Thrown inside the backend and translated into the returned status at the API boundary.
+    class ApiError : public std::runtime_error
+    {
+    public:
+        ApiError(rgl_status_t status, const std::string& message)
+            : std::runtime_error(message)
+            , m_status{ status }
+        {
+        }
+
+        [[nodiscard]] rgl_status_t GetStatus() const
+        {
+            return m_status;
+        }
+
+    private:
+        rgl_status_t m_status;
+    };
+
+    [[noreturn]] inline void ThrowInvalidArgument(const std::string& message)
+    {
+        throw ApiError(RGL_INVALID_ARGUMENT, message);
+    }
+
+    [[noreturn]] inline void ThrowInvalidPipeline(const std::string& message)
+    {
+        throw ApiError(RGL_INVALID_PIPELINE, message);
+    }
+
+    [[noreturn]] inline void ThrowNotImplemented(const std::string& message)
+    {
+        throw ApiError(RGL_NOT_IMPLEMENTED, message);
+    }
+
+    void ConfigureLogging(rgl_log_level_t level, const char* filePath, bool useStdout);
+    void Log(rgl_log_level_t level, const std::string& message);
+} // namespace RGL::Cpu
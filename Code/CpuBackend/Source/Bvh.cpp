@@ -0,0 +1,301 @@
+/* Copyright 2020-2021, Robotec.ai sp. z o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <Bvh.h>
+#include <ThreadPool.h>
+#include <algorithm>
+#include <numeric>
+
+namespace RGL::Cpu
+{
+    namespace
+    {
+        constexpr int BinCount = 12;
+        // Relative cost of visiting an inner node compared to intersecting a single primitive.
+        constexpr float TraversalCost = 1.0f;
+
+        int GetWidestAxis(const Aabb& bounds)
+        {
+            const Vec3 extent = bounds.m_max - bounds.m_min;
+            if (extent.x >= extent.y && extent.x >= extent.z)
+            {
+                return 0;
+            }
+            return extent.y >= extent.z ? 1 : 2;
+        }
+    } // namespace
+
+    void Bvh::Build(const std::vector<Aabb>& primitiveBounds)
+    {
+        m_nodes.clear();
+        m_primitiveIndices.resize(primitiveBounds.size());
+        std::iota(m_primitiveIndices.begin(), m_primitiveIndices.end(), 0U);
+        if (primitiveBounds.empty())
+        {
+            return;
+        }
+
+        std::vector<Vec3> centroids(primitiveBounds.size());
+        for (size_t primitive = 0LU; primitive < primitiveBounds.size(); ++primitive)
+        {
+            centroids[primitive] = primitiveBounds[primitive].GetCenter();
+        }
+
+        m_nodes.reserve(2LU * primitiveBounds.size());
+        BvhNode& root = m_nodes.emplace_back();
+        root.m_firstIndex = 0U;
+        root.m_primitiveCount = static_cast<uint32_t>(primitiveBounds.size());
+
+        // The top of the tree is split on the calling thread until the nodes are small enough to be built as separate subtrees.
+        std::vector<BuildTask> subtrees;
+        std::vector<BuildTask> tasks{ BuildTask{ 0U, 0U } };
+        while (!tasks.empty())
+        {
+            const BuildTask task = tasks.back();
+            tasks.pop_back();
+            if (m_nodes[task.m_nodeIndex].m_primitiveCount < ParallelSubtreeSize)
+            {
+                subtrees.push_back(task);
+                continue;
+            }
+
+            if (SplitNode(m_nodes, task, m_primitiveIndices, primitiveBounds, centroids))
+            {
+                const uint32_t left = m_nodes[task.m_nodeIndex].m_firstIndex;
+                tasks.push_back(BuildTask{ left + 1U, task.m_depth + 1U });
+                tasks.push_back(BuildTask{ left, task.m_depth + 1U });
+            }
+        }
+
+        std::vector<std::vector<BvhNode>> subtreeNodes(subtrees.size());
+        const ThreadPool::RangeFunction buildSubtrees = [&](size_t begin, size_t end)
+        {
+            for (size_t subtree = begin; subtree < end; ++subtree)
+            {
+                std::vector<BvhNode>& nodes = subtreeNodes[subtree];
+                nodes.reserve(2LU * m_nodes[subtrees[subtree].m_nodeIndex].m_primitiveCount);
+                nodes.push_back(m_nodes[subtrees[subtree].m_nodeIndex]);
+                BuildSubtree(nodes, subtrees[subtree].m_depth, m_primitiveIndices, primitiveBounds, centroids);
+            }
+        };
+        ThreadPool::Get().ParallelFor(subtrees.size(), 1LU, buildSubtrees);
+
+        // The subtree nodes are appended after the top of the tree, so the children still follow their parents.
+        for (size_t subtree = 0LU; subtree < subtrees.size(); ++subtree)
+        {
+            const std::vector<BvhNode>& nodes = subtreeNodes[subtree];
+            const auto offset = static_cast<uint32_t>(m_nodes.size() - 1LU);
+            const auto relocate = [offset](BvhNode node)
+            {
+                if (!node.IsLeaf())
+                {
+                    node.m_firstIndex += offset;
+                }
+                return node;
+            };
+
+            m_nodes[subtrees[subtree].m_nodeIndex] = relocate(nodes.front());
+            for (size_t nodeIndex = 1LU; nodeIndex < nodes.size(); ++nodeIndex)
+            {
+                m_nodes.push_back(relocate(nodes[nodeIndex]));
+            }
+        }
+    }
+
+    void Bvh::Refit(const std::vector<Aabb>& primitiveBounds)
+    {
+        for (size_t nodeIndex = m_nodes.size(); nodeIndex-- > 0LU;)
+        {
+            BvhNode& node = m_nodes[nodeIndex];
+            node.m_bounds = Aabb{};
+            if (node.IsLeaf())
+            {
+                for (uint32_t i = 0U; i < node.m_primitiveCount; ++i)
+                {
+                    node.m_bounds.Grow(primitiveBounds[m_primitiveIndices[node.m_firstIndex + i]]);
+                }
+                continue;
+            }
+
+            node.m_bounds.Grow(m_nodes[node.m_firstIndex].m_bounds);
+            node.m_bounds.Grow(m_nodes[node.m_firstIndex + 1U].m_bounds);
+        }
+    }
+
+    void Bvh::BuildSubtree(
+        std::vector<BvhNode>& nodes,
+        uint32_t depth,
+        std::vector<uint32_t>& primitiveIndices,
+        const std::vector<Aabb>& primitiveBounds,
+        const std::vector<Vec3>& centroids)
+    {
+        std::vector<BuildTask> tasks{ BuildTask{ 0U, depth } };
+        while (!tasks.empty())
+        {
+            const BuildTask task = tasks.back();
+            tasks.pop_back();
+            if (SplitNode(nodes, task, primitiveIndices, primitiveBounds, centroids))
+            {
+                const uint32_t left = nodes[task.m_nodeIndex].m_firstIndex;
+                tasks.push_back(BuildTask{ left + 1U, task.m_depth + 1U });
+                tasks.push_back(BuildTask{ left, task.m_depth + 1U });
+            }
+        }
+    }
+
+    bool Bvh::SplitNode(
+        std::vector<BvhNode>& nodes,
+        const BuildTask& task,
+        std::vector<uint32_t>& primitiveIndices,
+        const std::vector<Aabb>& primitiveBounds,
+        const std::vector<Vec3>& centroids)
+    {
+        const uint32_t first = nodes[task.m_nodeIndex].m_firstIndex;
+        const uint32_t count = nodes[task.m_nodeIndex].m_primitiveCount;
+
+        Aabb bounds, centroidBounds;
+        for (uint32_t i = first; i < first + count; ++i)
+        {
+            bounds.Grow(primitiveBounds[primitiveIndices[i]]);
+            centroidBounds.Grow(centroids[primitiveIndices[i]]);
+        }
+        nodes[task.m_nodeIndex].m_bounds = bounds;
+
+        if (count <= 1U)
+        {
+            return false;
+        }
+
+        uint32_t middle = first;
+        if (task.m_depth >= MaxSahDepth)
+        {
+            if (count <= MaxLeafSize)
+            {
+                return false;
+            }
+
+            // Deep nodes are split at the median, which bounds the depth of the rest of the subtree by the logarithm of its size.
+            const int axis = GetWidestAxis(centroidBounds);
+            middle = first + count / 2U;
+            std::nth_element(
+                primitiveIndices.data() + first,
+                primitiveIndices.data() + middle,
+                primitiveIndices.data() + first + count,
+                [&](uint32_t lhs, uint32_t rhs)
+                {
+                    return centroids[lhs][axis] < centroids[rhs][axis];
+                });
+        }
+        else
+        {
+            // Find the cheapest binned split over all axes.
+            int bestAxis = -1;
+            int bestSplit = 0;
+            float bestCost = std::numeric_limits<float>::max();
+            for (int axis = 0; axis < 3; ++axis)
+            {
+                const float extentMin = centroidBounds.m_min[axis];
+                const float extent = centroidBounds.m_max[axis] - extentMin;
+                if (extent <= 0.0f)
+                {
+                    continue;
+                }
+
+                Aabb binBounds[BinCount];
+                uint32_t binCounts[BinCount] = {};
+                const float scale = BinCount / extent;
+                for (uint32_t i = first; i < first + count; ++i)
+                {
+                    const uint32_t primitive = primitiveIndices[i];
+                    const int bin = std::min(BinCount - 1, static_cast<int>((centroids[primitive][axis] - extentMin) * scale));
+                    ++binCounts[bin];
+                    binBounds[bin].Grow(primitiveBounds[primitive]);
+                }
+
+                // Sweep from the right to accumulate the right-hand side areas, then from the left to evaluate the splits.
+                float rightAreas[BinCount - 1];
+                uint32_t rightCounts[BinCount - 1];
+                Aabb rightBounds;
+                uint32_t rightCount = 0U;
+                for (int split = BinCount - 1; split > 0; --split)
+                {
+                    rightBounds.Grow(binBounds[split]);
+                    rightCount += binCounts[split];
+                    rightAreas[split - 1] = rightBounds.GetSurfaceArea();
+                    rightCounts[split - 1] = rightCount;
+                }
+
+                Aabb leftBounds;
+                uint32_t leftCount = 0U;
+                for (int split = 0; split < BinCount - 1; ++split)
+                {
+                    leftBounds.Grow(binBounds[split]);
+                    leftCount += binCounts[split];
+                    if (leftCount == 0U || rightCounts[split] == 0U)
+                    {
+                        continue;
+                    }
+
+                    const float cost = leftBounds.GetSurfaceArea() * static_cast<float>(leftCount) +
+                        rightAreas[split] * static_cast<float>(rightCounts[split]);
+                    if (cost < bestCost)
+                    {
+                        bestCost = cost;
+                        bestAxis = axis;
+                        bestSplit = split;
+                    }
+                }
+            }
+
+            const float leafCost = bounds.GetSurfaceArea() * static_cast<float>(count);
+            const float splitCost = TraversalCost * bounds.GetSurfaceArea() + bestCost;
+            if (count <= MaxLeafSize && (bestAxis < 0 || splitCost >= leafCost))
+            {
+                return false;
+            }
+
+            if (bestAxis >= 0)
+            {
+                const float extentMin = centroidBounds.m_min[bestAxis];
+                const float scale = BinCount / (centroidBounds.m_max[bestAxis] - extentMin);
+                const auto* partitionEnd = std::partition(
+                    primitiveIndices.data() + first,
+                    primitiveIndices.data() + first + count,
+                    [&](uint32_t primitive)
+                    {
+                        const int bin = std::min(BinCount - 1, static_cast<int>((centroids[primitive][bestAxis] - extentMin) * scale));
+                        return bin <= bestSplit;
+                    });
+                middle = static_cast<uint32_t>(partitionEnd - primitiveIndices.data());
+            }
+
+            // All centroids coincide (or the partition degenerated), split the range in half to bound the leaf size.
+            if (middle == first || middle == first + count)
+            {
+                middle = first + count / 2U;
+            }
+        }
+
+        const auto leftIndex = static_cast<uint32_t>(nodes.size());
+        nodes.resize(nodes.size() + 2LU);
+        nodes[leftIndex].m_firstIndex = first;
+        nodes[leftIndex].m_primitiveCount = middle - first;
+        nodes[leftIndex + 1U].m_firstIndex = middle;
+        nodes[leftIndex + 1U].m_primitiveCount = first + count - middle;
+
+        nodes[task.m_nodeIndex].m_firstIndex = leftIndex;
+        nodes[task.m_nodeIndex].m_primitiveCount = 0U;
+        return true;
+    }
+} // namespace RGL::Cpu
@@ -0,0 +1,195 @@
+/* Copyright 2020-2021, Robotec.ai sp. z o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <Math.h>
+#include <cstdint>
+#include <vector>
+
+namespace RGL::Cpu
+{
+    struct BvhNode
+    {
+        Aabb m_bounds;
+        //! Index of the left child (the right one directly follows it) or of the first primitive for leaves.
+        uint32_t m_firstIndex{ 0U };
+        //! Number of primitives for leaves, zero for inner nodes.
+        uint32_t m_primitiveCount{ 0U };
+
+        [[nodiscard]] bool IsLeaf() const
+        {
+            return m_primitiveCount > 0U;
+        }
+    };
+
+    //! Bounding volume hierarchy built with the binned surface area heuristic.
+    //! Children are always stored after their parent, which allows refitting the tree in a single reverse pass.
+    class Bvh
+    {
+    public:
+        static constexpr uint32_t MaxLeafSize = 4U;
+        //! Depth below which the nodes are split at the median of their widest axis instead of the surface area heuristic.
+        static constexpr uint32_t MaxSahDepth = 64U;
+        //! The median splits halve the primitive count, so they add at most 32 levels below MaxSahDepth.
+        static constexpr uint32_t MaxDepth = MaxSahDepth + 32U;
+        //! Nodes with fewer primitives are built as separate subtrees, in parallel.
+        static constexpr uint32_t ParallelSubtreeSize = 4096U;
+
+        //! Builds the hierarchy over primitives with the provided bounds.
+        void Build(const std::vector<Aabb>& primitiveBounds);
+
+        //! Updates the node bounds after the primitives moved, keeping the tree topology.
+        void Refit(const std::vector<Aabb>& primitiveBounds);
+
+        [[nodiscard]] bool IsEmpty() const
+        {
+            return m_nodes.empty();
+        }
+
+        [[nodiscard]] const Aabb& GetBounds() const
+        {
+            return m_nodes.front().m_bounds;
+        }
+
+        [[nodiscard]] const std::vector<BvhNode>& GetNodes() const
+        {
+            return m_nodes;
+        }
+
+        //! Primitive indices ordered so that every leaf references a contiguous range.
+        [[nodiscard]] const std::vector<uint32_t>& GetPrimitiveIndices() const
+        {
+            return m_primitiveIndices;
+        }
+
+        //! Visits the leaves intersected by the ray, nearest first.
+        //! @param visitLeaf Called as visitLeaf(nodeIndex, node, tMax) and may shorten tMax once a hit is found.
+        template<typename LeafVisitor>
+        void Traverse(const Vec3& origin, const Vec3& direction, float tMin, float& tMax, LeafVisitor&& visitLeaf) const;
+
+    private:
+        struct BuildTask
+        {
+            uint32_t m_nodeIndex;
+            uint32_t m_depth;
+        };
+
+        //! Sets the bounds of the node and splits it into two children appended to the nodes, unless it should stay a leaf.
+        //! @return True if the node was split.
+        static bool SplitNode(
+            std::vector<BvhNode>& nodes,
+            const BuildTask& task,
+            std::vector<uint32_t>& primitiveIndices,
+            const std::vector<Aabb>& primitiveBounds,
+            const std::vector<Vec3>& centroids);
+
+        //! Builds the subtree of the first node without recursion. Only the primitive indices of that node are reordered,
+        //! so the subtrees of disjoint nodes may be built concurrently.
+        static void BuildSubtree(
+            std::vector<BvhNode>& nodes,
+            uint32_t depth,
+            std::vector<uint32_t>& primitiveIndices,
+            const std::vector<Aabb>& primitiveBounds,
+            const std::vector<Vec3>& centroids);
+
+        std::vector<BvhNode> m_nodes;
+        std::vector<uint32_t> m_primitiveIndices;
+    };
+
+    namespace Internal
+    {
+        //! Returns the distance at which the ray enters the box or infinity if it misses it.
+        inline float IntersectAabb(const Aabb& box, const Vec3& origin, const Vec3& invDirection, float tMin, float tMax)
+        {
+            float entry = tMin, exit = tMax;
+            for (int axis = 0; axis < 3; ++axis)
+            {
+                float t0 = (box.m_min[axis] - origin[axis]) * invDirection[axis];
+                float t1 = (box.m_max[axis] - origin[axis]) * invDirection[axis];
+                if (t0 > t1)
+                {
+                    std::swap(t0, t1);
+                }
+                // NaN (0 * inf) comparisons are false, so such axes do not restrict the interval.
+                entry = t0 > entry ? t0 : entry;
+                exit = t1 < exit ? t1 : exit;
+            }
+            return entry <= exit ? entry : std::numeric_limits<float>::infinity();
+        }
+    } // namespace Internal
+
+    template<typename LeafVisitor>
+    void Bvh::Traverse(const Vec3& origin, const Vec3& direction, float tMin, float& tMax, LeafVisitor&& visitLeaf) const
+    {
+        if (m_nodes.empty())
+        {
+            return;
+        }
+
+        const Vec3 invDirection{ 1.0f / direction.x, 1.0f / direction.y, 1.0f / direction.z };
+        if (Internal::IntersectAabb(m_nodes.front().m_bounds, origin, invDirection, tMin, tMax) == std::numeric_limits<float>::infinity())
+        {
+            return;
+        }
+
+        // The stack holds at most one sibling of each node on the current path, and the build bounds the depth of the tree.
+        constexpr int StackSize = static_cast<int>(MaxDepth);
+        uint32_t stack[StackSize];
+        float stackEntries[StackSize];
+        int stackSize = 0;
+        uint32_t nodeIndex = 0U;
+        while (true)
+        {
+            const BvhNode& node = m_nodes[nodeIndex];
+            if (node.IsLeaf())
+            {
+                visitLeaf(nodeIndex, node, tMax);
+            }
+            else
+            {
+                const uint32_t left = node.m_firstIndex, right = node.m_firstIndex + 1U;
+                const float leftEntry = Internal::IntersectAabb(m_nodes[left].m_bounds, origin, invDirection, tMin, tMax);
+                const float rightEntry = Internal::IntersectAabb(m_nodes[right].m_bounds, origin, invDirection, tMin, tMax);
+                const bool leftHit = leftEntry != std::numeric_limits<float>::infinity();
+                const bool rightHit = rightEntry != std::numeric_limits<float>::infinity();
+                if (leftHit && rightHit)
+                {
+                    const bool leftFirst = leftEntry <= rightEntry;
+                    stack[stackSize] = leftFirst ? right : left;
+                    stackEntries[stackSize] = leftFirst ? rightEntry : leftEntry;
+                    ++stackSize;
+                    nodeIndex = leftFirst ? left : right;
+                    continue;
+                }
+                if (leftHit || rightHit)
+                {
+                    nodeIndex = leftHit ? left : right;
+                    continue;
+                }
+            }
+
+            // Skip the postponed nodes which lie behind the closest hit found so far.
+            do
+            {
+                if (stackSize == 0)
+                {
+                    return;
+                }
+                --stackSize;
+            } while (stackEntries[stackSize] > tMax);
+            nodeIndex = stack[stackSize];
+        }
+    }
+} // namespace RGL::Cpu
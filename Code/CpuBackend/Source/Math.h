@@ -0,0 +1,239 @@
+/* Copyright 2020-2021, Robotec.ai sp. z o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <rgl/api/core.h>
+
+namespace RGL::Cpu
+{
+    struct Vec3
+    {
+        float x{ 0.0f }, y{ 0.0f }, z{ 0.0f };
+
+        Vec3() = default;
+        constexpr Vec3(float x, float y, float z)
+            : x{ x }
+            , y{ y }
+            , z{ z }
+        {
+        }
+
+        explicit Vec3(const rgl_vec3f& vector)
+            : x{ vector.value[0] }
+            , y{ vector.value[1] }
+            , z{ vector.value[2] }
+        {
+        }
+
+        [[nodiscard]] rgl_vec3f ToRgl() const
+        {
+            return { { x, y, z } };
+        }
+
+        float operator[](int axis) const
+        {
+            return axis == 0 ? x : (axis == 1 ? y : z);
+        }
+
+        Vec3 operator+(const Vec3& other) const
+        {
+            return { x + other.x, y + other.y, z + other.z };
+        }
+
+        Vec3 operator-(const Vec3& other) const
+        {
+            return { x - other.x, y - other.y, z - other.z };
+        }
+
+        Vec3 operator*(float scalar) const
+        {
+            return { x * scalar, y * scalar, z * scalar };
+        }
+
+        [[nodiscard]] float Dot(const Vec3& other) const
+        {
+            return x * other.x + y * other.y + z * other.z;
+        }
+
+        [[nodiscard]] Vec3 Cross(const Vec3& other) const
+        {
+            return { y * other.z - z * other.y, z * other.x - x * other.z, x * other.y - y * other.x };
+        }
+
+        [[nodiscard]] float Length() const
+        {
+            return std::sqrt(Dot(*this));
+        }
+
+        [[nodiscard]] Vec3 Normalized() const
+        {
+            const float length = Length();
+            return length > 0.0f ? *this * (1.0f / length) : *this;
+        }
+
+        static Vec3 Min(const Vec3& a, const Vec3& b)
+        {
+            return { std::min(a.x, b.x), std::min(a.y, b.y), std::min(a.z, b.z) };
+        }
+
+        static Vec3 Max(const Vec3& a, const Vec3& b)
+        {
+            return { std::max(a.x, b.x), std::max(a.y, b.y), std::max(a.z, b.z) };
+        }
+    };
+
+    //! Returns the product of two affine 3x4 transforms (lhs * rhs).
+    inline rgl_mat3x4f Multiply(const rgl_mat3x4f& lhs, const rgl_mat3x4f& rhs)
+    {
+        rgl_mat3x4f result{};
+        for (int row = 0; row < 3; ++row)
+        {
+            for (int column = 0; column < 4; ++column)
+            {
+                float value = column == 3 ? lhs.value[row][3] : 0.0f;
+                for (int k = 0; k < 3; ++k)
+                {
+                    value += lhs.value[row][k] * rhs.value[k][column];
+                }
+                result.value[row][column] = value;
+            }
+        }
+        return result;
+    }
+
+    inline float Determinant(const rgl_mat3x4f& matrix)
+    {
+        const auto& m = matrix.value;
+        return m[0][0] * (m[1][1] * m[2][2] - m[1][2] * m[2][1]) + m[0][1] * (m[1][2] * m[2][0] - m[1][0] * m[2][2]) +
+            m[0][2] * (m[1][0] * m[2][1] - m[1][1] * m[2][0]);
+    }
+
+    //! Returns the inverse of an affine 3x4 transform. Singular transforms (e.g. zero scale) produce an all-zero matrix.
+    inline rgl_mat3x4f Inverse(const rgl_mat3x4f& matrix)
+    {
+        const auto& m = matrix.value;
+        const float c00 = m[1][1] * m[2][2] - m[1][2] * m[2][1];
+        const float c01 = m[1][2] * m[2][0] - m[1][0] * m[2][2];
+        const float c02 = m[1][0] * m[2][1] - m[1][1] * m[2][0];
+        const float determinant = m[0][0] * c00 + m[0][1] * c01 + m[0][2] * c02;
+
+        rgl_mat3x4f result{};
+        if (std::abs(determinant) <= std::numeric_limits<float>::min())
+        {
+            return result;
+        }
+
+        const float invDet = 1.0f / determinant;
+        auto& r = result.value;
+        r[0][0] = c00 * invDet;
+        r[0][1] = (m[0][2] * m[2][1] - m[0][1] * m[2][2]) * invDet;
+        r[0][2] = (m[0][1] * m[1][2] - m[0][2] * m[1][1]) * invDet;
+        r[1][0] = c01 * invDet;
+        r[1][1] = (m[0][0] * m[2][2] - m[0][2] * m[2][0]) * invDet;
+        r[1][2] = (m[0][2] * m[1][0] - m[0][0] * m[1][2]) * invDet;
+        r[2][0] = c02 * invDet;
+        r[2][1] = (m[0][1] * m[2][0] - m[0][0] * m[2][1]) * invDet;
+        r[2][2] = (m[0][0] * m[1][1] - m[0][1] * m[1][0]) * invDet;
+        for (int row = 0; row < 3; ++row)
+        {
+            r[row][3] = -(r[row][0] * m[0][3] + r[row][1] * m[1][3] + r[row][2] * m[2][3]);
+        }
+        return result;
+    }
+
+    inline Vec3 TransformPoint(const rgl_mat3x4f& matrix, const Vec3& point)
+    {
+        const auto& m = matrix.value;
+        return { m[0][0] * point.x + m[0][1] * point.y + m[0][2] * point.z + m[0][3],
+                 m[1][0] * point.x + m[1][1] * point.y + m[1][2] * point.z + m[1][3],
+                 m[2][0] * point.x + m[2][1] * point.y + m[2][2] * point.z + m[2][3] };
+    }
+
+    inline Vec3 TransformVector(const rgl_mat3x4f& matrix, const Vec3& vector)
+    {
+        const auto& m = matrix.value;
+        return { m[0][0] * vector.x + m[0][1] * vector.y + m[0][2] * vector.z,
+                 m[1][0] * vector.x + m[1][1] * vector.y + m[1][2] * vector.z,
+                 m[2][0] * vector.x + m[2][1] * vector.y + m[2][2] * vector.z };
+    }
+
+    //! RGL rays are transforms applied to a ray cast from the origin along the Z axis.
+    inline Vec3 GetRayOrigin(const rgl_mat3x4f& ray)
+    {
+        return { ray.value[0][3], ray.value[1][3], ray.value[2][3] };
+    }
+
+    inline Vec3 GetRayDirection(const rgl_mat3x4f& ray)
+    {
+        return Vec3{ ray.value[0][2], ray.value[1][2], ray.value[2][2] }.Normalized();
+    }
+
+    struct Aabb
+    {
+        Vec3 m_min{ std::numeric_limits<float>::max(), std::numeric_limits<float>::max(), std::numeric_limits<float>::max() };
+        Vec3 m_max{ std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest() };
+
+        void Grow(const Vec3& point)
+        {
+            m_min = Vec3::Min(m_min, point);
+            m_max = Vec3::Max(m_max, point);
+        }
+
+        void Grow(const Aabb& other)
+        {
+            m_min = Vec3::Min(m_min, other.m_min);
+            m_max = Vec3::Max(m_max, other.m_max);
+        }
+
+        [[nodiscard]] bool IsValid() const
+        {
+            return m_min.x <= m_max.x && m_min.y <= m_max.y && m_min.z <= m_max.z;
+        }
+
+        [[nodiscard]] Vec3 GetCenter() const
+        {
+            return (m_min + m_max) * 0.5f;
+        }
+
+        [[nodiscard]] float GetSurfaceArea() const
+        {
+            if (!IsValid())
+            {
+                return 0.0f;
+            }
+            const Vec3 extent = m_max - m_min;
+            return 2.0f * (extent.x * extent.y + extent.y * extent.z + extent.z * extent.x);
+        }
+
+        //! Returns the bounds of this box after an affine transform.
+        [[nodiscard]] Aabb Transformed(const rgl_mat3x4f& matrix) const
+        {
+            Aabb result;
+            if (!IsValid())
+            {
+                return result;
+            }
+            for (int corner = 0; corner < 8; ++corner)
+            {
+                const Vec3 point{ (corner & 1) ? m_max.x : m_min.x, (corner & 2) ? m_max.y : m_min.y, (corner & 4) ? m_max.z : m_min.z };
+                result.Grow(TransformPoint(matrix, point));
+            }
+            return result;
+        }
+    };
+} // namespace RGL::Cpu
@@ -0,0 +1,499 @@
+/* Copyright 2020-2021, Robotec.ai sp. z o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <ApiCommon.h>
+#include <Nodes.h>
+#include <Scene.h>
+#include <ThreadPool.h>
+#include <cmath>
+#include <unordered_map>
+
+namespace RGL::Cpu
+{
+    namespace
+    {
+        // Rays are traced in chunks to amortize the scheduling cost.
+        constexpr size_t RaytraceChunkSize = 256LU;
+
+        const std::vector<rgl_vec2f> DefaultRanges = { { { 0.0f, std::numeric_limits<float>::max() } } };
+
+        std::vector<rgl_field_t> ValidateFields(const rgl_field_t* fields, int32_t fieldCount)
+        {
+            if (fields == nullptr || fieldCount <= 0)
+            {
+                ThrowInvalidArgument("At least one field is required.");
+            }
+
+            std::vector<rgl_field_t> result(fields, fields + fieldCount);
+            for (rgl_field_t field : result)
+            {
+                ValidateField(field);
+            }
+            return result;
+        }
+
+        rgl_mat3x4f CreateRotation(rgl_axis_t axis, float angle)
+        {
+            const float sin = std::sin(angle), cos = std::cos(angle);
+            switch (axis)
+            {
+            case RGL_AXIS_X:
+                return { { { 1.0f, 0.0f, 0.0f, 0.0f }, { 0.0f, cos, -sin, 0.0f }, { 0.0f, sin, cos, 0.0f } } };
+            case RGL_AXIS_Y:
+                return { { { cos, 0.0f, sin, 0.0f }, { 0.0f, 1.0f, 0.0f, 0.0f }, { -sin, 0.0f, cos, 0.0f } } };
+            default:
+                return { { { cos, -sin, 0.0f, 0.0f }, { sin, cos, 0.0f, 0.0f }, { 0.0f, 0.0f, 1.0f, 0.0f } } };
+            }
+        }
+    } // namespace
+
+    void RaysFromMat3x4fNode::SetParameters(const rgl_mat3x4f* rays, int32_t rayCount)
+    {
+        if (rays == nullptr || rayCount <= 0)
+        {
+            ThrowInvalidArgument("At least one ray is required.");
+        }
+        m_storedRays.assign(rays, rays + rayCount);
+    }
+
+    void RaysFromMat3x4fNode::Execute()
+    {
+        if (!m_inputs.empty())
+        {
+            ThrowInvalidPipeline("RaysFromMat3x4fNode does not accept inputs.");
+        }
+        m_rays = &m_storedRays;
+        m_ranges = &DefaultRanges;
+    }
+
+    void RaysSetRangeNode::SetParameters(const rgl_vec2f* ranges, int32_t rangeCount)
+    {
+        if (ranges == nullptr || rangeCount <= 0)
+        {
+            ThrowInvalidArgument("At least one range is required.");
+        }
+        m_storedRanges.assign(ranges, ranges + rangeCount);
+        for (const rgl_vec2f& range : m_storedRanges)
+        {
+            if (range.value[0] < 0.0f || range.value[0] > range.value[1])
+            {
+                ThrowInvalidArgument("Ray range has to be non-negative with the minimum not greater than the maximum.");
+            }
+        }
+    }
+
+    void RaysSetRangeNode::Execute()
+    {
+        const RaysNode& input = GetInput<RaysNode>();
+        if (m_storedRanges.size() != 1LU && m_storedRanges.size() != input.GetRays().size())
+        {
+            ThrowInvalidPipeline("The number of ranges has to be one or equal to the number of rays.");
+        }
+        m_rays = &input.GetRays();
+        ForwardAttributes(input);
+        m_ranges = &m_storedRanges;
+    }
+
+    void RaysSetRingIdsNode::SetParameters(const int32_t* ringIds, int32_t ringIdCount)
+    {
+        if (ringIds == nullptr || ringIdCount <= 0)
+        {
+            ThrowInvalidArgument("At least one ring id is required.");
+        }
+        m_storedRingIds.assign(ringIds, ringIds + ringIdCount);
+    }
+
+    void RaysSetRingIdsNode::Execute()
+    {
+        const RaysNode& input = GetInput<RaysNode>();
+        // RGL repeats the ring ids over the rays only as a whole.
+        if (input.GetRays().size() % m_storedRingIds.size() != 0LU)
+        {
+            ThrowInvalidPipeline("The number of rays has to be a multiple of the number of ring ids.");
+        }
+        m_rays = &input.GetRays();
+        ForwardAttributes(input);
+        m_ringIds = &m_storedRingIds;
+    }
+
+    void RaysSetTimeOffsetsNode::SetParameters(const float* offsets, int32_t offsetCount)
+    {
+        if (offsets == nullptr || offsetCount <= 0)
+        {
+            ThrowInvalidArgument("At least one time offset is required.");
+        }
+        m_storedOffsets.assign(offsets, offsets + offsetCount);
+    }
+
+    void RaysSetTimeOffsetsNode::Execute()
+    {
+        const RaysNode& input = GetInput<RaysNode>();
+        if (m_storedOffsets.size() != input.GetRays().size())
+        {
+            ThrowInvalidPipeline("The number of time offsets has to be equal to the number of rays.");
+        }
+        m_rays = &input.GetRays();
+        ForwardAttributes(input);
+        m_timeOffsets = &m_storedOffsets;
+    }
+
+    void RaysTransformNode::SetParameters(const rgl_mat3x4f& transform)
+    {
+        m_transform = transform;
+    }
+
+    void RaysTransformNode::Execute()
+    {
+        const RaysNode& input = GetInput<RaysNode>();
+        const std::vector<rgl_mat3x4f>& inputRays = input.GetRays();
+        m_transformedRays.resize(inputRays.size());
+        for (size_t rayIndex = 0LU; rayIndex < inputRays.size(); ++rayIndex)
+        {
+            m_transformedRays[rayIndex] = Multiply(m_transform, inputRays[rayIndex]);
+        }
+        m_rays = &m_transformedRays;
+        ForwardAttributes(input);
+        m_cumulativeTransform = Multiply(m_transform, input.GetCumulativeTransform());
+    }
+
+    void GaussianNoiseAngularRayNode::SetParameters(float mean, float stDev, rgl_axis_t rotationAxis)
+    {
+        if (stDev < 0.0f)
+        {
+            ThrowInvalidArgument("Standard deviation has to be non-negative.");
+        }
+        m_mean = mean;
+        m_stDev = stDev;
+        m_rotationAxis = rotationAxis;
+    }
+
+    void GaussianNoiseAngularRayNode::Execute()
+    {
+        const RaysNode& input = GetInput<RaysNode>();
+        const std::vector<rgl_mat3x4f>& inputRays = input.GetRays();
+        std::normal_distribution<float> distribution(m_mean, m_stDev);
+
+        m_noisyRays.resize(inputRays.size());
+        for (size_t rayIndex = 0LU; rayIndex < inputRays.size(); ++rayIndex)
+        {
+            rgl_mat3x4f noisyRay = Multiply(CreateRotation(m_rotationAxis, distribution(m_randomEngine)), inputRays[rayIndex]);
+            for (int row = 0; row < 3; ++row)
+            {
+                noisyRay.value[row][3] = inputRays[rayIndex].value[row][3];
+            }
+            m_noisyRays[rayIndex] = noisyRay;
+        }
+        m_rays = &m_noisyRays;
+        ForwardAttributes(input);
+    }
+
+    void RaytraceNode::SetParameters(Scene& scene)
+    {
+        m_scene = &scene;
+        m_isDistortionEnabled = false;
+    }
+
+    void RaytraceNode::SetParameters(Scene& scene, const rgl_vec3f& linearVelocity, const rgl_vec3f& angularVelocity)
+    {
+        m_scene = &scene;
+        m_isDistortionEnabled = true;
+        m_linearVelocity = Vec3{ linearVelocity };
+        m_angularVelocity = Vec3{ angularVelocity };
+    }
+
+    rgl_mat3x4f RaytraceNode::DistortRay(
+        const rgl_mat3x4f& ray, float timeOffset, const rgl_mat3x4f& sensorPose, const rgl_mat3x4f& inverseSensorPose) const
+    {
+        // The motion of the sensor during the time offset, expressed in the sensor frame.
+        const float time = timeOffset * 0.001f;
+        rgl_mat3x4f motion = Multiply(
+            CreateRotation(RGL_AXIS_Z, m_angularVelocity.z * time),
+            Multiply(CreateRotation(RGL_AXIS_Y, m_angularVelocity.y * time), CreateRotation(RGL_AXIS_X, m_angularVelocity.x * time)));
+        for (int row = 0; row < 3; ++row)
+        {
+            motion.value[row][3] = m_linearVelocity[row] * time;
+        }
+
+        return Multiply(sensorPose, Multiply(motion, Multiply(inverseSensorPose, ray)));
+    }
+
+    void RaytraceNode::Execute()
+    {
+        const RaysNode& input = GetInput<RaysNode>();
+        const std::vector<rgl_mat3x4f>& rays = input.GetRays();
+        const std::vector<rgl_vec2f>& ranges = input.GetRanges();
+
+        m_cloud.Clear();
+        for (rgl_field_t field : { RGL_FIELD_XYZ_F32,
+                                   RGL_FIELD_IS_HIT_I32,
+                                   RGL_FIELD_RAY_IDX_U32,
+                                   RGL_FIELD_ENTITY_ID_I32,
+                                   RGL_FIELD_DISTANCE_F32,
+                                   RGL_FIELD_INTENSITY_F32,
+                                   RGL_FIELD_RING_ID_U16,
+                                   RGL_FIELD_TIME_STAMP_F64 })
+        {
+            m_cloud.AddField(field);
+        }
+        m_cloud.Resize(rays.size());
+
+        auto* xyz = m_cloud.GetField<rgl_vec3f>(RGL_FIELD_XYZ_F32);
+        auto* isHit = m_cloud.GetField<int32_t>(RGL_FIELD_IS_HIT_I32);
+        auto* rayIdx = m_cloud.GetField<uint32_t>(RGL_FIELD_RAY_IDX_U32);
+        auto* entityId = m_cloud.GetField<int32_t>(RGL_FIELD_ENTITY_ID_I32);
+        auto* distance = m_cloud.GetField<float>(RGL_FIELD_DISTANCE_F32);
+        auto* intensity = m_cloud.GetField<float>(RGL_FIELD_INTENSITY_F32);
+        auto* ringId = m_cloud.GetField<uint16_t>(RGL_FIELD_RING_ID_U16);
+        auto* timeStamp = m_cloud.GetField<double>(RGL_FIELD_TIME_STAMP_F64);
+        const std::vector<int32_t>* ringIds = input.GetRingIds();
+        const std::vector<float>* timeOffsets = input.GetTimeOffsets();
+        std::vector<Vec3>& rayDirections = m_cloud.GetRayDirections();
+
+        if (m_isDistortionEnabled && timeOffsets == nullptr)
+        {
+            ThrowInvalidPipeline("RaytraceNode with the velocity distortion requires the ray time offsets.");
+        }
+        const rgl_mat3x4f& sensorPose = input.GetCumulativeTransform();
+        const rgl_mat3x4f inverseSensorPose = Inverse(sensorPose);
+
+        m_scene->Prepare();
+        const Scene& scene = *m_scene;
+        ThreadPool::Get().ParallelFor(
+            rays.size(),
+            RaytraceChunkSize,
+            [&](size_t begin, size_t end)
+            {
+                for (size_t rayIndex = begin; rayIndex < end; ++rayIndex)
+                {
+                    const rgl_vec2f& range = ranges.size() == 1LU ? ranges.front() : ranges[rayIndex];
+                    const float timeOffset = timeOffsets != nullptr ? (*timeOffsets)[rayIndex] : 0.0f;
+                    const rgl_mat3x4f ray =
+                        m_isDistortionEnabled ? DistortRay(rays[rayIndex], timeOffset, sensorPose, inverseSensorPose) : rays[rayIndex];
+                    const Vec3 origin = GetRayOrigin(ray);
+                    const Vec3 direction = GetRayDirection(ray);
+
+                    Scene::Hit hit;
+                    const bool rayHit = scene.Intersect(origin, direction, range.value[0], range.value[1], hit);
+                    const Vec3 point = origin + direction * (rayHit ? hit.m_distance : range.value[1]);
+                    xyz[rayIndex] = point.ToRgl();
+                    isHit[rayIndex] = rayHit ? 1 : 0;
+                    rayIdx[rayIndex] = static_cast<uint32_t>(rayIndex);
+                    entityId[rayIndex] = rayHit ? hit.m_entity->GetId() : Scene::DefaultEntityId;
+                    distance[rayIndex] = rayHit ? hit.m_distance : NonHitDistance;
+                    intensity[rayIndex] =
+                        rayHit ? hit.m_entity->GetIntensity(hit.m_triangle, TransformPoint(hit.m_entity->GetInversePose(), point)) : 0.0f;
+                    ringId[rayIndex] = ringIds != nullptr ? static_cast<uint16_t>((*ringIds)[rayIndex % ringIds->size()]) : 0U;
+                    // The time at which the ray was fired, in seconds.
+                    timeStamp[rayIndex] = static_cast<double>(m_scene->GetTime()) * 1e-9 + static_cast<double>(timeOffset) * 1e-3;
+                    rayDirections[rayIndex] = direction;
+                }
+            });
+
+        m_points = &m_cloud;
+    }
+
+    void PointsCompactNode::Execute()
+    {
+        const PointCloud& input = GetInput<PointsNode>().GetPoints();
+        const int32_t* isHit = input.GetField<int32_t>(RGL_FIELD_IS_HIT_I32);
+        if (isHit == nullptr)
+        {
+            ThrowInvalidPipeline("PointsCompactNode requires the IS_HIT field.");
+        }
+
+        m_cloud.AssignFiltered(
+            input,
+            [isHit](uint32_t pointIndex)
+            {
+                return isHit[pointIndex] != 0;
+            });
+        m_points = &m_cloud;
+    }
+
+    void PointsDownsampleNode::SetParameters(float leafSizeX, float leafSizeY, float leafSizeZ)
+    {
+        if (leafSizeX <= 0.0f || leafSizeY <= 0.0f || leafSizeZ <= 0.0f)
+        {
+            ThrowInvalidArgument("Leaf size has to be positive.");
+        }
+        m_leafSize = Vec3{ leafSizeX, leafSizeY, leafSizeZ };
+    }
+
+    void PointsDownsampleNode::Execute()
+    {
+        const PointCloud& input = GetInput<PointsNode>().GetPoints();
+        const auto* xyz = input.GetField<rgl_vec3f>(RGL_FIELD_XYZ_F32);
+        if (xyz == nullptr)
+        {
+            ThrowInvalidPipeline("PointsDownsampleNode requires the XYZ field.");
+        }
+
+        // Voxel coordinates packed into a single key. 21 bits per axis cover over a million voxels along each axis.
+        const auto GetVoxelKey = [this](const rgl_vec3f& point)
+        {
+            constexpr int64_t AxisMask = (int64_t{ 1 } << 21) - 1;
+            const auto x = static_cast<int64_t>(std::floor(point.value[0] / m_leafSize.x)) & AxisMask;
+            const auto y = static_cast<int64_t>(std::floor(point.value[1] / m_leafSize.y)) & AxisMask;
+            const auto z = static_cast<int64_t>(std::floor(point.value[2] / m_leafSize.z)) & AxisMask;
+            return (x << 42) | (y << 21) | z;
+        };
+
+        const size_t pointCount = input.GetPointCount();
+        std::unordered_map<int64_t, uint32_t> voxelIndices;
+        std::vector<Vec3> voxelSums;
+        std::vector<uint32_t> voxelPointCounts;
+        std::vector<bool> isVoxelRepresentative(pointCount, false);
+        for (uint32_t pointIndex = 0U; pointIndex < pointCount; ++pointIndex)
+        {
+            const auto [voxelIt, isNewVoxel] = voxelIndices.emplace(GetVoxelKey(xyz[pointIndex]), static_cast<uint32_t>(voxelSums.size()));
+            if (isNewVoxel)
+            {
+                voxelSums.emplace_back();
+                voxelPointCounts.push_back(0U);
+                isVoxelRepresentative[pointIndex] = true;
+            }
+
+            voxelSums[voxelIt->second] = voxelSums[voxelIt->second] + Vec3{ xyz[pointIndex] };
+            ++voxelPointCounts[voxelIt->second];
+        }
+
+        // The representatives are kept in order, so the output point index matches the voxel index.
+        m_cloud.AssignFiltered(
+            input,
+            [&isVoxelRepresentative](uint32_t pointIndex)
+            {
+                return isVoxelRepresentative[pointIndex];
+            });
+
+        auto* outputXyz = m_cloud.GetField<rgl_vec3f>(RGL_FIELD_XYZ_F32);
+        for (size_t voxelIndex = 0LU; voxelIndex < voxelSums.size(); ++voxelIndex)
+        {
+            outputXyz[voxelIndex] = (voxelSums[voxelIndex] * (1.0f / static_cast<float>(voxelPointCounts[voxelIndex]))).ToRgl();
+        }
+        m_points = &m_cloud;
+    }
+
+    void PointsTransformNode::SetParameters(const rgl_mat3x4f& transform)
+    {
+        m_transform = transform;
+    }
+
+    void PointsTransformNode::Execute()
+    {
+        m_cloud = GetInput<PointsNode>().GetPoints();
+        if (auto* xyz = m_cloud.GetField<rgl_vec3f>(RGL_FIELD_XYZ_F32); xyz != nullptr)
+        {
+            for (size_t pointIndex = 0LU; pointIndex < m_cloud.GetPointCount(); ++pointIndex)
+            {
+                xyz[pointIndex] = TransformPoint(m_transform, Vec3{ xyz[pointIndex] }).ToRgl();
+            }
+        }
+
+        for (Vec3& direction : m_cloud.GetRayDirections())
+        {
+            direction = TransformVector(m_transform, direction).Normalized();
+        }
+        m_points = &m_cloud;
+    }
+
+    void GaussianNoiseDistanceNode::SetParameters(float mean, float stDevBase, float stDevRisePerMeter)
+    {
+        if (stDevBase < 0.0f || stDevRisePerMeter < 0.0f)
+        {
+            ThrowInvalidArgument("Standard deviation has to be non-negative.");
+        }
+        m_mean = mean;
+        m_stDevBase = stDevBase;
+        m_stDevRisePerMeter = stDevRisePerMeter;
+    }
+
+    void GaussianNoiseDistanceNode::Execute()
+    {
+        m_cloud = GetInput<PointsNode>().GetPoints();
+        auto* xyz = m_cloud.GetField<rgl_vec3f>(RGL_FIELD_XYZ_F32);
+        auto* distance = m_cloud.GetField<float>(RGL_FIELD_DISTANCE_F32);
+        const int32_t* isHit = m_cloud.GetField<int32_t>(RGL_FIELD_IS_HIT_I32);
+        if (xyz == nullptr || distance == nullptr || isHit == nullptr)
+        {
+            ThrowInvalidPipeline("GaussianNoiseDistanceNode requires the XYZ, DISTANCE and IS_HIT fields.");
+        }
+
+        const std::vector<Vec3>& rayDirections = m_cloud.GetRayDirections();
+        for (size_t pointIndex = 0LU; pointIndex < m_cloud.GetPointCount(); ++pointIndex)
+        {
+            if (isHit[pointIndex] == 0)
+            {
+                continue;
+            }
+
+            const float stDev = m_stDevBase + m_stDevRisePerMeter * distance[pointIndex];
+            std::normal_distribution<float> distribution(m_mean, stDev);
+            const float distanceError = distribution(m_randomEngine);
+            distance[pointIndex] += distanceError;
+            xyz[pointIndex] = (Vec3{ xyz[pointIndex] } + rayDirections[pointIndex] * distanceError).ToRgl();
+        }
+        m_points = &m_cloud;
+    }
+
+    void PointsYieldNode::SetParameters(const rgl_field_t* fields, int32_t fieldCount)
+    {
+        m_fields = ValidateFields(fields, fieldCount);
+    }
+
+    void PointsYieldNode::Execute()
+    {
+        m_cloud.AssignFields(GetInput<PointsNode>().GetPoints(), m_fields);
+        m_points = &m_cloud;
+    }
+
+    void PointsFormatNode::SetParameters(const rgl_field_t* fields, int32_t fieldCount)
+    {
+        m_fields = ValidateFields(fields, fieldCount);
+    }
+
+    void PointsFormatNode::Execute()
+    {
+        m_points = &GetInput<PointsNode>().GetPoints();
+        m_points->Format(m_fields, m_formattedData);
+    }
+
+    size_t PointsFormatNode::GetPointSize() const
+    {
+        size_t pointSize = 0LU;
+        for (rgl_field_t field : m_fields)
+        {
+            pointSize += GetFieldSize(field);
+        }
+        return pointSize;
+    }
+
+    void PointsRos2PublishNode::SetParameters(const char* topicName, [[maybe_unused]] const char* frameId)
+    {
+        if (topicName == nullptr || frameId == nullptr)
+        {
+            ThrowInvalidArgument("Topic name and frame id are required.");
+        }
+        m_topicName = topicName;
+    }
+
+    void PointsRos2PublishNode::Execute()
+    {
+        m_points = &GetInput<PointsNode>().GetPoints();
+        if (!m_isWarningReported)
+        {
+            Log(RGL_LOG_LEVEL_WARN, "ROS 2 publishing is not available in the CPU backend, nothing is published on " + m_topicName + ".");
+            m_isWarningReported = true;
+        }
+    }
+} // namespace RGL::Cpu
@@ -0,0 +1,366 @@
+/* Copyright 2020-2021, Robotec.ai sp. z o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <ApiCommon.h>
+#include <PointCloud.h>
+#include <random>
+#include <rgl/api/core.h>
+#include <string>
+#include <vector>
+
+struct Scene;
+
+//! Base of all the graph nodes. The RGL API declares node handles as pointers to this global type.
+struct Node
+{
+public:
+    virtual ~Node() = default;
+
+    //! Computes the node output. Called in the topological order, so all the inputs are already executed.
+    virtual void Execute() = 0;
+
+    [[nodiscard]] virtual const char* GetName() const = 0;
+
+    std::vector<Node*> m_inputs;
+    std::vector<Node*> m_outputs;
+
+protected:
+    //! Returns the only input of the node cast to the expected node kind or throws an invalid pipeline error.
+    template<typename InputType>
+    InputType& GetInput() const
+    {
+        auto* input = m_inputs.size() == 1LU ? dynamic_cast<InputType*>(m_inputs.front()) : nullptr;
+        if (input == nullptr)
+        {
+            RGL::Cpu::ThrowInvalidPipeline(std::string(GetName()) + " requires exactly one input of a matching kind.");
+        }
+        return *input;
+    }
+};
+
+namespace RGL::Cpu
+{
+    //! Node producing rays (transforms of the ray cast along the Z axis) with their ranges.
+    class RaysNode : public Node
+    {
+    public:
+        [[nodiscard]] const std::vector<rgl_mat3x4f>& GetRays() const
+        {
+            return *m_rays;
+        }
+
+        //! Either a single range for all the rays or one range per ray.
+        [[nodiscard]] const std::vector<rgl_vec2f>& GetRanges() const
+        {
+            return *m_ranges;
+        }
+
+        //! Ring id of each ray, repeated when there are fewer ring ids than rays (the ray count is their multiple).
+        //! Null when the ring ids are not set.
+        [[nodiscard]] const std::vector<int32_t>* GetRingIds() const
+        {
+            return m_ringIds;
+        }
+
+        //! Time offset of each ray in milliseconds. Null when the time offsets are not set.
+        [[nodiscard]] const std::vector<float>* GetTimeOffsets() const
+        {
+            return m_timeOffsets;
+        }
+
+        //! Product of the transforms applied to the rays, i.e. the pose of the sensor.
+        [[nodiscard]] const rgl_mat3x4f& GetCumulativeTransform() const
+        {
+            return m_cumulativeTransform;
+        }
+
+    protected:
+        //! Passes the ray attributes other than the rays themselves from the input.
+        void ForwardAttributes(const RaysNode& input)
+        {
+            m_ranges = &input.GetRanges();
+            m_ringIds = input.GetRingIds();
+            m_timeOffsets = input.GetTimeOffsets();
+            m_cumulativeTransform = input.GetCumulativeTransform();
+        }
+
+        const std::vector<rgl_mat3x4f>* m_rays{ nullptr };
+        const std::vector<rgl_vec2f>* m_ranges{ nullptr };
+        const std::vector<int32_t>* m_ringIds{ nullptr };
+        const std::vector<float>* m_timeOffsets{ nullptr };
+        rgl_mat3x4f m_cumulativeTransform{ { { 1.0f, 0.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 1.0f, 0.0f } } };
+    };
+
+    //! Node producing a point cloud.
+    class PointsNode : public Node
+    {
+    public:
+        [[nodiscard]] bool HasResults() const
+        {
+            return m_points != nullptr;
+        }
+
+        [[nodiscard]] const PointCloud& GetPoints() const
+        {
+            return *m_points;
+        }
+
+    protected:
+        const PointCloud* m_points{ nullptr };
+    };
+
+    class RaysFromMat3x4fNode : public RaysNode
+    {
+    public:
+        void SetParameters(const rgl_mat3x4f* rays, int32_t rayCount);
+        void Execute() override;
+        const char* GetName() const override
+        {
+            return "RaysFromMat3x4fNode";
+        }
+
+    private:
+        std::vector<rgl_mat3x4f> m_storedRays;
+    };
+
+    class RaysSetRangeNode : public RaysNode
+    {
+    public:
+        void SetParameters(const rgl_vec2f* ranges, int32_t rangeCount);
+        void Execute() override;
+        const char* GetName() const override
+        {
+            return "RaysSetRangeNode";
+        }
+
+    private:
+        std::vector<rgl_vec2f> m_storedRanges;
+    };
+
+    class RaysSetRingIdsNode : public RaysNode
+    {
+    public:
+        void SetParameters(const int32_t* ringIds, int32_t ringIdCount);
+        void Execute() override;
+        const char* GetName() const override
+        {
+            return "RaysSetRingIdsNode";
+        }
+
+    private:
+        std::vector<int32_t> m_storedRingIds;
+    };
+
+    class RaysSetTimeOffsetsNode : public RaysNode
+    {
+    public:
+        void SetParameters(const float* offsets, int32_t offsetCount);
+        void Execute() override;
+        const char* GetName() const override
+        {
+            return "RaysSetTimeOffsetsNode";
+        }
+
+    private:
+        std::vector<float> m_storedOffsets;
+    };
+
+    class RaysTransformNode : public RaysNode
+    {
+    public:
+        void SetParameters(const rgl_mat3x4f& transform);
+        void Execute() override;
+        const char* GetName() const override
+        {
+            return "RaysTransformNode";
+        }
+
+    private:
+        rgl_mat3x4f m_transform{};
+        std::vector<rgl_mat3x4f> m_transformedRays;
+    };
+
+    //! Rotates each ray direction by a normally distributed angle around the given axis, keeping the ray origins.
+    class GaussianNoiseAngularRayNode : public RaysNode
+    {
+    public:
+        void SetParameters(float mean, float stDev, rgl_axis_t rotationAxis);
+        void Execute() override;
+        const char* GetName() const override
+        {
+            return "GaussianNoiseAngularRayNode";
+        }
+
+    private:
+        float m_mean{ 0.0f };
+        float m_stDev{ 0.0f };
+        rgl_axis_t m_rotationAxis{ RGL_AXIS_Z };
+        std::mt19937 m_randomEngine{ std::random_device{}() };
+        std::vector<rgl_mat3x4f> m_noisyRays;
+    };
+
+    class RaytraceNode : public PointsNode
+    {
+    public:
+        //! Distance reported for the rays which did not hit anything. The point is placed at the end of the ray.
+        static constexpr float NonHitDistance = std::numeric_limits<float>::max();
+
+        void SetParameters(Scene& scene);
+        //! Enables the velocity distortion: each ray is fired from the sensor pose reached after its time offset.
+        //! The velocities are given in the sensor frame, with the angular velocity as the roll, pitch and yaw rates.
+        void SetParameters(Scene& scene, const rgl_vec3f& linearVelocity, const rgl_vec3f& angularVelocity);
+        void Execute() override;
+        const char* GetName() const override
+        {
+            return "RaytraceNode";
+        }
+
+    private:
+        //! Returns the ray moved by the sensor motion during the time offset.
+        [[nodiscard]] rgl_mat3x4f DistortRay(
+            const rgl_mat3x4f& ray, float timeOffset, const rgl_mat3x4f& sensorPose, const rgl_mat3x4f& inverseSensorPose) const;
+
+        Scene* m_scene{ nullptr };
+        bool m_isDistortionEnabled{ false };
+        Vec3 m_linearVelocity;
+        Vec3 m_angularVelocity;
+        PointCloud m_cloud;
+    };
+
+    class PointsCompactNode : public PointsNode
+    {
+    public:
+        void Execute() override;
+        const char* GetName() const override
+        {
+            return "PointsCompactNode";
+        }
+
+    private:
+        PointCloud m_cloud;
+    };
+
+    //! Replaces the points within each voxel of the grid by a single point. The first point of the voxel is kept
+    //! with all its fields, moved to the centroid of the voxel points.
+    class PointsDownsampleNode : public PointsNode
+    {
+    public:
+        void SetParameters(float leafSizeX, float leafSizeY, float leafSizeZ);
+        void Execute() override;
+        const char* GetName() const override
+        {
+            return "PointsDownsampleNode";
+        }
+
+    private:
+        Vec3 m_leafSize{ 1.0f, 1.0f, 1.0f };
+        PointCloud m_cloud;
+    };
+
+    class PointsTransformNode : public PointsNode
+    {
+    public:
+        void SetParameters(const rgl_mat3x4f& transform);
+        void Execute() override;
+        const char* GetName() const override
+        {
+            return "PointsTransformNode";
+        }
+
+    private:
+        rgl_mat3x4f m_transform{};
+        PointCloud m_cloud;
+    };
+
+    //! Moves each hit point along its ray by a normally distributed distance.
+    class GaussianNoiseDistanceNode : public PointsNode
+    {
+    public:
+        void SetParameters(float mean, float stDevBase, float stDevRisePerMeter);
+        void Execute() override;
+        const char* GetName() const override
+        {
+            return "GaussianNoiseDistanceNode";
+        }
+
+    private:
+        float m_mean{ 0.0f };
+        float m_stDevBase{ 0.0f };
+        float m_stDevRisePerMeter{ 0.0f };
+        std::mt19937 m_randomEngine{ std::random_device{}() };
+        PointCloud m_cloud;
+    };
+
+    //! Makes the listed fields available as the graph results. As in RGL, only the listed fields are available
+    //! to the results and to the child nodes.
+    class PointsYieldNode : public PointsNode
+    {
+    public:
+        void SetParameters(const rgl_field_t* fields, int32_t fieldCount);
+        void Execute() override;
+        const char* GetName() const override
+        {
+            return "PointsYieldNode";
+        }
+
+        [[nodiscard]] const std::vector<rgl_field_t>& GetFields() const
+        {
+            return m_fields;
+        }
+
+    private:
+        std::vector<rgl_field_t> m_fields;
+        PointCloud m_cloud;
+    };
+
+    //! Packs the listed fields of each point into a single buffer, available as the RGL_FIELD_DYNAMIC_FORMAT result.
+    class PointsFormatNode : public PointsNode
+    {
+    public:
+        void SetParameters(const rgl_field_t* fields, int32_t fieldCount);
+        void Execute() override;
+        const char* GetName() const override
+        {
+            return "PointsFormatNode";
+        }
+
+        [[nodiscard]] size_t GetPointSize() const;
+        [[nodiscard]] const std::vector<uint8_t>& GetFormattedData() const
+        {
+            return m_formattedData;
+        }
+
+    private:
+        std::vector<rgl_field_t> m_fields;
+        std::vector<uint8_t> m_formattedData;
+    };
+
+    //! ROS 2 is not available to the CPU backend. The node accepts the configuration and passes the points through.
+    class PointsRos2PublishNode : public PointsNode
+    {
+    public:
+        void SetParameters(const char* topicName, const char* frameId);
+        void Execute() override;
+        const char* GetName() const override
+        {
+            return "PointsRos2PublishNode";
+        }
+
+    private:
+        std::string m_topicName;
+        bool m_isWarningReported{ false };
+    };
+} // namespace RGL::Cpu
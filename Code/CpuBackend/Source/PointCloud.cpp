@@ -0,0 +1,147 @@
+/* Copyright 2020-2021, Robotec.ai sp. z o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <ApiCommon.h>
+#include <PointCloud.h>
+#include <cstring>
+
+namespace RGL::Cpu
+{
+    size_t GetFieldSize(rgl_field_t field)
+    {
+        switch (field)
+        {
+        case RGL_FIELD_XYZ_F32:
+            return sizeof(rgl_vec3f);
+        case RGL_FIELD_INTENSITY_F32:
+        case RGL_FIELD_IS_HIT_I32:
+        case RGL_FIELD_RAY_IDX_U32:
+        case RGL_FIELD_ENTITY_ID_I32:
+        case RGL_FIELD_DISTANCE_F32:
+        case RGL_FIELD_AZIMUTH_F32:
+        case RGL_FIELD_PADDING_32:
+            return 4LU;
+        case RGL_FIELD_RING_ID_U16:
+        case RGL_FIELD_PADDING_16:
+            return 2LU;
+        case RGL_FIELD_RETURN_TYPE_U8:
+        case RGL_FIELD_PADDING_8:
+            return 1LU;
+        case RGL_FIELD_TIME_STAMP_F64:
+            return 8LU;
+        default:
+            return 0LU;
+        }
+    }
+
+    void ValidateField(rgl_field_t field)
+    {
+        switch (field)
+        {
+        case RGL_FIELD_XYZ_F32:
+        case RGL_FIELD_INTENSITY_F32:
+        case RGL_FIELD_IS_HIT_I32:
+        case RGL_FIELD_RAY_IDX_U32:
+        case RGL_FIELD_ENTITY_ID_I32:
+        case RGL_FIELD_DISTANCE_F32:
+        case RGL_FIELD_RING_ID_U16:
+        case RGL_FIELD_TIME_STAMP_F64:
+        case RGL_FIELD_PADDING_8:
+        case RGL_FIELD_PADDING_16:
+        case RGL_FIELD_PADDING_32:
+            return;
+        default:
+            ThrowNotImplemented("Field " + std::to_string(static_cast<int>(field)) + " is not supported by the CPU backend.");
+        }
+    }
+
+    void PointCloud::Resize(size_t pointCount)
+    {
+        m_pointCount = pointCount;
+        for (auto& [field, data] : m_fields)
+        {
+            data.resize(pointCount * GetFieldSize(field));
+        }
+        m_rayDirections.resize(pointCount);
+    }
+
+    void PointCloud::Clear()
+    {
+        m_pointCount = 0LU;
+        m_fields.clear();
+        m_rayDirections.clear();
+    }
+
+    void PointCloud::AddField(rgl_field_t field)
+    {
+        m_fields[field].resize(m_pointCount * GetFieldSize(field));
+    }
+
+    const uint8_t* PointCloud::GetFieldData(rgl_field_t field) const
+    {
+        auto fieldIt = m_fields.find(field);
+        return fieldIt != m_fields.end() ? fieldIt->second.data() : nullptr;
+    }
+
+    uint8_t* PointCloud::GetFieldData(rgl_field_t field)
+    {
+        auto fieldIt = m_fields.find(field);
+        return fieldIt != m_fields.end() ? fieldIt->second.data() : nullptr;
+    }
+
+    void PointCloud::AssignFields(const PointCloud& source, const std::vector<rgl_field_t>& fields)
+    {
+        m_fields.clear();
+        m_pointCount = source.m_pointCount;
+        for (rgl_field_t field : fields)
+        {
+            if (IsPaddingField(field))
+            {
+                continue;
+            }
+
+            auto sourceIt = source.m_fields.find(field);
+            if (sourceIt == source.m_fields.end())
+            {
+                ThrowInvalidPipeline("Field " + std::to_string(static_cast<int>(field)) + " is not present in the input points.");
+            }
+            m_fields[field] = sourceIt->second;
+        }
+        m_rayDirections = source.m_rayDirections;
+    }
+
+    void PointCloud::Format(const std::vector<rgl_field_t>& fields, std::vector<uint8_t>& output) const
+    {
+        size_t pointSize = 0LU;
+        for (rgl_field_t field : fields)
+        {
+            pointSize += GetFieldSize(field);
+        }
+
+        output.assign(m_pointCount * pointSize, 0U);
+        size_t fieldOffset = 0LU;
+        for (rgl_field_t field : fields)
+        {
+            const size_t fieldSize = GetFieldSize(field);
+            if (const uint8_t* data = GetFieldData(field); data != nullptr && !IsPaddingField(field))
+            {
+                for (size_t pointIndex = 0LU; pointIndex < m_pointCount; ++pointIndex)
+                {
+                    std::memcpy(output.data() + pointIndex * pointSize + fieldOffset, data + pointIndex * fieldSize, fieldSize);
+                }
+            }
+            fieldOffset += fieldSize;
+        }
+    }
+} // namespace RGL::Cpu
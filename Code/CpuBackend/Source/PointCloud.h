@@ -0,0 +1,131 @@
+/* Copyright 2020-2021, Robotec.ai sp. z o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <Math.h>
+#include <cstdint>
+#include <map>
+#include <rgl/api/core.h>
+#include <vector>
+
+namespace RGL::Cpu
+{
+    //! @return Size in bytes of a single value of the field or zero for fields unknown to the backend.
+    size_t GetFieldSize(rgl_field_t field);
+
+    [[nodiscard]] inline bool IsPaddingField(rgl_field_t field)
+    {
+        return field == RGL_FIELD_PADDING_8 || field == RGL_FIELD_PADDING_16 || field == RGL_FIELD_PADDING_32;
+    }
+
+    //! Throws if the field cannot be produced by the raytrace node of this backend.
+    void ValidateField(rgl_field_t field);
+
+    //! Points stored as one contiguous array per field.
+    class PointCloud
+    {
+    public:
+        void Resize(size_t pointCount);
+        void Clear();
+
+        [[nodiscard]] size_t GetPointCount() const
+        {
+            return m_pointCount;
+        }
+
+        [[nodiscard]] bool HasField(rgl_field_t field) const
+        {
+            return m_fields.find(field) != m_fields.end();
+        }
+
+        //! Adds the field (if missing) sized to the current point count.
+        void AddField(rgl_field_t field);
+
+        [[nodiscard]] const uint8_t* GetFieldData(rgl_field_t field) const;
+        uint8_t* GetFieldData(rgl_field_t field);
+
+        template<typename T>
+        T* GetField(rgl_field_t field)
+        {
+            return reinterpret_cast<T*>(GetFieldData(field));
+        }
+
+        template<typename T>
+        const T* GetField(rgl_field_t field) const
+        {
+            return reinterpret_cast<const T*>(GetFieldData(field));
+        }
+
+        //! Normalized world space ray directions, kept next to the fields so that the noise nodes can move points along their rays.
+        std::vector<Vec3>& GetRayDirections()
+        {
+            return m_rayDirections;
+        }
+
+        [[nodiscard]] const std::vector<Vec3>& GetRayDirections() const
+        {
+            return m_rayDirections;
+        }
+
+        //! Copies the points for which the predicate returns true (in order).
+        template<typename Predicate>
+        void AssignFiltered(const PointCloud& source, Predicate&& keepPoint);
+
+        //! Copies the listed fields of all the points, dropping the other fields. The padding fields are skipped.
+        //! Throws if the source lacks any of the listed fields.
+        void AssignFields(const PointCloud& source, const std::vector<rgl_field_t>& fields);
+
+        //! Writes the requested fields of each point one after another (zeroes for padding fields).
+        void Format(const std::vector<rgl_field_t>& fields, std::vector<uint8_t>& output) const;
+
+    private:
+        size_t m_pointCount{ 0LU };
+        std::map<rgl_field_t, std::vector<uint8_t>> m_fields;
+        std::vector<Vec3> m_rayDirections;
+    };
+
+    template<typename Predicate>
+    void PointCloud::AssignFiltered(const PointCloud& source, Predicate&& keepPoint)
+    {
+        std::vector<uint32_t> keptIndices;
+        keptIndices.reserve(source.GetPointCount());
+        for (uint32_t pointIndex = 0U; pointIndex < source.GetPointCount(); ++pointIndex)
+        {
+            if (keepPoint(pointIndex))
+            {
+                keptIndices.push_back(pointIndex);
+            }
+        }
+
+        m_fields.clear();
+        m_pointCount = keptIndices.size();
+        for (const auto& [field, sourceData] : source.m_fields)
+        {
+            const size_t fieldSize = GetFieldSize(field);
+            std::vector<uint8_t>& data = m_fields[field];
+            data.resize(m_pointCount * fieldSize);
+            for (size_t i = 0LU; i < keptIndices.size(); ++i)
+            {
+                std::copy_n(sourceData.data() + keptIndices[i] * fieldSize, fieldSize, data.data() + i * fieldSize);
+            }
+        }
+
+        m_rayDirections.resize(m_pointCount);
+        for (size_t i = 0LU; i < keptIndices.size(); ++i)
+        {
+            m_rayDirections[i] = source.m_rayDirections[keptIndices[i]];
+        }
+    }
+} // namespace RGL::Cpu
@@ -0,0 +1,353 @@
+/* Copyright 2020-2021, Robotec.ai sp. z o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <ApiCommon.h>
+#include <Scene.h>
+
+using namespace RGL::Cpu;
+
+namespace
+{
+    constexpr rgl_mat3x4f IdentityTransform = { { { 1.0f, 0.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 1.0f, 0.0f } } };
+} // namespace
+
+Texture::Texture(const void* texels, int32_t width, int32_t height)
+    : m_width{ width }
+    , m_height{ height }
+{
+    if (texels == nullptr || width <= 0 || height <= 0)
+    {
+        ThrowInvalidArgument("Texture requires at least one texel.");
+    }
+
+    const auto* texelBytes = static_cast<const uint8_t*>(texels);
+    m_texels.assign(texelBytes, texelBytes + static_cast<size_t>(width) * static_cast<size_t>(height));
+}
+
+float Texture::Sample(const rgl_vec2f& uv) const
+{
+    const auto wrap = [](float coordinate, int32_t size)
+    {
+        const float wrapped = coordinate - std::floor(coordinate);
+        return std::min(static_cast<int32_t>(wrapped * static_cast<float>(size)), size - 1);
+    };
+
+    const int32_t x = wrap(uv.value[0], m_width);
+    const int32_t y = wrap(uv.value[1], m_height);
+    return static_cast<float>(m_texels[static_cast<size_t>(y) * static_cast<size_t>(m_width) + static_cast<size_t>(x)]);
+}
+
+Mesh::Mesh(const rgl_vec3f* vertices, int32_t vertexCount, const rgl_vec3i* indices, int32_t indexCount)
+{
+    if (vertices == nullptr || vertexCount <= 0 || indices == nullptr || indexCount <= 0)
+    {
+        ThrowInvalidArgument("Mesh requires at least one vertex and one triangle.");
+    }
+
+    m_vertices.assign(vertices, vertices + vertexCount);
+    m_indices.assign(indices, indices + indexCount);
+    for (const rgl_vec3i& triangle : m_indices)
+    {
+        for (int32_t index : triangle.value)
+        {
+            if (index < 0 || index >= vertexCount)
+            {
+                ThrowInvalidArgument("Mesh triangle references a vertex out of range.");
+            }
+        }
+    }
+
+    UpdateTriangleBounds();
+    m_bvh.Build(m_triangleBounds);
+    UpdatePackets();
+}
+
+void Mesh::UpdateVertices(const rgl_vec3f* vertices, int32_t vertexCount)
+{
+    if (vertices == nullptr || vertexCount != static_cast<int32_t>(m_vertices.size()))
+    {
+        ThrowInvalidArgument("Vertex count does not match the mesh vertex count.");
+    }
+
+    m_vertices.assign(vertices, vertices + vertexCount);
+    UpdateTriangleBounds();
+    m_bvh.Refit(m_triangleBounds);
+    UpdatePackets();
+    ++m_version;
+}
+
+void Mesh::SetTextureCoords(const rgl_vec2f* uvs, int32_t uvCount)
+{
+    if (uvs == nullptr || uvCount != static_cast<int32_t>(m_vertices.size()))
+    {
+        ThrowInvalidArgument("Texture coordinate count does not match the mesh vertex count.");
+    }
+
+    m_textureCoords.assign(uvs, uvs + uvCount);
+}
+
+rgl_vec2f Mesh::GetTextureCoords(int64_t triangle, const Vec3& point) const
+{
+    const rgl_vec3i& indices = m_indices[triangle];
+    const Vec3 a{ m_vertices[indices.value[0]] };
+    const Vec3 edge1 = Vec3{ m_vertices[indices.value[1]] } - a;
+    const Vec3 edge2 = Vec3{ m_vertices[indices.value[2]] } - a;
+    const Vec3 offset = point - a;
+
+    // Barycentric coordinates of the point projected onto the triangle plane.
+    const float d11 = edge1.Dot(edge1);
+    const float d12 = edge1.Dot(edge2);
+    const float d22 = edge2.Dot(edge2);
+    const float denominator = d11 * d22 - d12 * d12;
+    if (std::abs(denominator) <= std::numeric_limits<float>::min())
+    {
+        return m_textureCoords[indices.value[0]];
+    }
+
+    const float d1 = offset.Dot(edge1);
+    const float d2 = offset.Dot(edge2);
+    const float v = (d22 * d1 - d12 * d2) / denominator;
+    const float w = (d11 * d2 - d12 * d1) / denominator;
+    const float u = 1.0f - v - w;
+
+    const rgl_vec2f& uv0 = m_textureCoords[indices.value[0]];
+    const rgl_vec2f& uv1 = m_textureCoords[indices.value[1]];
+    const rgl_vec2f& uv2 = m_textureCoords[indices.value[2]];
+    return { { u * uv0.value[0] + v * uv1.value[0] + w * uv2.value[0], u * uv0.value[1] + v * uv1.value[1] + w * uv2.value[1] } };
+}
+
+int64_t Mesh::Intersect(const Vec3& origin, const Vec3& direction, float tMin, float& tMax) const
+{
+    int64_t closestTriangle = -1;
+    m_bvh.Traverse(
+        origin,
+        direction,
+        tMin,
+        tMax,
+        [&](uint32_t nodeIndex, const BvhNode&, float& maxDistance)
+        {
+            const TrianglePacket& packet = m_packets[m_nodePackets[nodeIndex]];
+            if (const int lane = packet.Intersect(origin, direction, tMin, maxDistance); lane >= 0)
+            {
+                closestTriangle = packet.m_triangleIndices[lane];
+            }
+        });
+    return closestTriangle;
+}
+
+Aabb Mesh::GetBounds() const
+{
+    return m_bvh.GetBounds();
+}
+
+void Mesh::UpdateTriangleBounds()
+{
+    m_triangleBounds.resize(m_indices.size());
+    for (size_t triangle = 0LU; triangle < m_indices.size(); ++triangle)
+    {
+        Aabb& bounds = m_triangleBounds[triangle];
+        bounds = Aabb{};
+        for (int32_t index : m_indices[triangle].value)
+        {
+            bounds.Grow(Vec3{ m_vertices[index] });
+        }
+    }
+}
+
+void Mesh::UpdatePackets()
+{
+    static_assert(Bvh::MaxLeafSize <= TrianglePacket::PacketWidth, "Every leaf has to fit into a single packet.");
+
+    const std::vector<BvhNode>& nodes = m_bvh.GetNodes();
+    const std::vector<uint32_t>& primitiveIndices = m_bvh.GetPrimitiveIndices();
+    m_packets.clear();
+    m_nodePackets.assign(nodes.size(), 0U);
+    for (size_t nodeIndex = 0LU; nodeIndex < nodes.size(); ++nodeIndex)
+    {
+        const BvhNode& node = nodes[nodeIndex];
+        if (!node.IsLeaf())
+        {
+            continue;
+        }
+
+        m_nodePackets[nodeIndex] = static_cast<uint32_t>(m_packets.size());
+        TrianglePacket& packet = m_packets.emplace_back();
+        for (uint32_t lane = 0U; lane < TrianglePacket::PacketWidth; ++lane)
+        {
+            if (lane >= node.m_primitiveCount)
+            {
+                packet.Clear(lane);
+                continue;
+            }
+
+            const uint32_t triangle = primitiveIndices[node.m_firstIndex + lane];
+            const rgl_vec3i& indices = m_indices[triangle];
+            packet.Set(
+                lane,
+                Vec3{ m_vertices[indices.value[0]] },
+                Vec3{ m_vertices[indices.value[1]] },
+                Vec3{ m_vertices[indices.value[2]] },
+                triangle);
+        }
+    }
+}
+
+Entity::Entity(Scene& scene, std::shared_ptr<Mesh> mesh)
+    : m_scene{ scene }
+    , m_mesh{ std::move(mesh) }
+    , m_pose{ IdentityTransform }
+    , m_inversePose{ IdentityTransform }
+    , m_id{ Scene::DefaultEntityId }
+{
+    m_scene.AddEntity(this);
+}
+
+Entity::~Entity()
+{
+    m_scene.RemoveEntity(this);
+}
+
+void Entity::SetPose(const rgl_mat3x4f& pose)
+{
+    m_pose = pose;
+    m_inversePose = Inverse(pose);
+    m_isDegenerate = std::abs(Determinant(pose)) <= std::numeric_limits<float>::min();
+    m_scene.MarkDirty();
+}
+
+void Entity::SetId(int32_t id)
+{
+    m_id = id;
+}
+
+void Entity::SetIntensityTexture(std::shared_ptr<Texture> texture)
+{
+    m_intensityTexture = std::move(texture);
+}
+
+float Entity::GetIntensity(int64_t triangle, const Vec3& point) const
+{
+    if (!m_intensityTexture || !m_mesh->HasTextureCoords())
+    {
+        return 0.0f;
+    }
+
+    return m_intensityTexture->Sample(m_mesh->GetTextureCoords(triangle, point));
+}
+
+Scene& Scene::GetDefault()
+{
+    static Scene DefaultScene;
+    return DefaultScene;
+}
+
+void Scene::AddEntity(Entity* entity)
+{
+    m_entities.insert(entity);
+    m_isDirty = true;
+}
+
+void Scene::RemoveEntity(Entity* entity)
+{
+    m_entities.erase(entity);
+    m_isDirty = true;
+}
+
+void Scene::MarkDirty()
+{
+    m_isDirty = true;
+}
+
+void Scene::SetTime(uint64_t nanoseconds)
+{
+    m_time = nanoseconds;
+}
+
+uint64_t Scene::GetTime() const
+{
+    return m_time;
+}
+
+void Scene::Prepare()
+{
+    if (!m_isDirty)
+    {
+        // Deformed meshes change their bounds without touching the entities.
+        for (size_t entityIndex = 0LU; entityIndex < m_entityList.size() && !m_isDirty; ++entityIndex)
+        {
+            m_isDirty = m_entityList[entityIndex]->GetMesh().GetVersion() != m_meshVersions[entityIndex];
+        }
+
+        if (!m_isDirty)
+        {
+            return;
+        }
+    }
+
+    m_entityList.clear();
+    m_meshVersions.clear();
+    std::vector<Aabb> entityBounds;
+    for (const Entity* entity : m_entities)
+    {
+        if (entity->IsDegenerate())
+        {
+            continue;
+        }
+
+        m_entityList.push_back(entity);
+        m_meshVersions.push_back(entity->GetMesh().GetVersion());
+        entityBounds.push_back(entity->GetMesh().GetBounds().Transformed(entity->GetPose()));
+    }
+
+    m_tlas.Build(entityBounds);
+    m_isDirty = false;
+}
+
+bool Scene::Intersect(const Vec3& origin, const Vec3& direction, float tMin, float tMax, Hit& hit) const
+{
+    bool isHit = false;
+    const std::vector<uint32_t>& entityIndices = m_tlas.GetPrimitiveIndices();
+    m_tlas.Traverse(
+        origin,
+        direction,
+        tMin,
+        tMax,
+        [&](uint32_t, const BvhNode& node, float& maxDistance)
+        {
+            for (uint32_t i = 0U; i < node.m_primitiveCount; ++i)
+            {
+                const Entity* entity = m_entityList[entityIndices[node.m_firstIndex + i]];
+                // The direction is not normalized in the mesh space so that the distances stay in the world units.
+                const Vec3 localOrigin = TransformPoint(entity->GetInversePose(), origin);
+                const Vec3 localDirection = TransformVector(entity->GetInversePose(), direction);
+                if (const int64_t triangle = entity->GetMesh().Intersect(localOrigin, localDirection, tMin, maxDistance); triangle >= 0)
+                {
+                    hit.m_distance = maxDistance;
+                    hit.m_entity = entity;
+                    hit.m_triangle = triangle;
+                    isHit = true;
+                }
+            }
+        });
+    return isHit;
+}
+
+void Scene::Clear()
+{
+    m_entities.clear();
+    m_entityList.clear();
+    m_meshVersions.clear();
+    m_tlas = Bvh{};
+    m_isDirty = true;
+}
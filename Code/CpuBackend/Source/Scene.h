@@ -0,0 +1,177 @@
+/* Copyright 2020-2021, Robotec.ai sp. z o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <Bvh.h>
+#include <TrianglePacket.h>
+#include <memory>
+#include <rgl/api/core.h>
+#include <unordered_set>
+#include <vector>
+
+// The RGL API declares its object handles as pointers to these global types.
+
+//! Single-channel texture of 8-bit texels, sampled with the nearest texel and the repeated (wrapped) coordinates.
+struct Texture
+{
+public:
+    Texture(const void* texels, int32_t width, int32_t height);
+
+    [[nodiscard]] float Sample(const rgl_vec2f& uv) const;
+
+private:
+    std::vector<uint8_t> m_texels;
+    int32_t m_width;
+    int32_t m_height;
+};
+
+//! Triangle mesh with its own bottom level acceleration structure, built in the mesh space.
+struct Mesh
+{
+public:
+    Mesh(const rgl_vec3f* vertices, int32_t vertexCount, const rgl_vec3i* indices, int32_t indexCount);
+
+    //! Replaces the vertex positions. The acceleration structure is refitted, keeping its topology.
+    void UpdateVertices(const rgl_vec3f* vertices, int32_t vertexCount);
+
+    //! Sets one texture coordinate per vertex.
+    void SetTextureCoords(const rgl_vec2f* uvs, int32_t uvCount);
+
+    [[nodiscard]] bool HasTextureCoords() const
+    {
+        return !m_textureCoords.empty();
+    }
+
+    //! Interpolates the texture coordinates of the triangle at the point given in the mesh space.
+    [[nodiscard]] rgl_vec2f GetTextureCoords(int64_t triangle, const RGL::Cpu::Vec3& point) const;
+
+    //! @return Index of the closest triangle hit within (tMin, tMax) or -1, tMax is updated on hit.
+    int64_t Intersect(const RGL::Cpu::Vec3& origin, const RGL::Cpu::Vec3& direction, float tMin, float& tMax) const;
+
+    [[nodiscard]] RGL::Cpu::Aabb GetBounds() const;
+
+    //! Incremented every time the vertices change.
+    [[nodiscard]] uint64_t GetVersion() const
+    {
+        return m_version;
+    }
+
+private:
+    void UpdateTriangleBounds();
+    void UpdatePackets();
+
+    std::vector<rgl_vec3f> m_vertices;
+    std::vector<rgl_vec3i> m_indices;
+    std::vector<rgl_vec2f> m_textureCoords;
+    std::vector<RGL::Cpu::Aabb> m_triangleBounds;
+    RGL::Cpu::Bvh m_bvh;
+    std::vector<RGL::Cpu::TrianglePacket> m_packets;
+    std::vector<uint32_t> m_nodePackets; //!< Maps leaf node indices to their triangle packets.
+    uint64_t m_version{ 0LU };
+};
+
+struct Scene;
+
+struct Entity
+{
+public:
+    Entity(Scene& scene, std::shared_ptr<Mesh> mesh);
+    ~Entity();
+
+    void SetPose(const rgl_mat3x4f& pose);
+    void SetId(int32_t id);
+    void SetIntensityTexture(std::shared_ptr<Texture> texture);
+
+    //! Returns the intensity of the hit on the triangle at the point given in the mesh space.
+    //! Zero unless the entity has an intensity texture and its mesh has the texture coordinates.
+    [[nodiscard]] float GetIntensity(int64_t triangle, const RGL::Cpu::Vec3& point) const;
+
+    [[nodiscard]] const Mesh& GetMesh() const
+    {
+        return *m_mesh;
+    }
+
+    [[nodiscard]] const rgl_mat3x4f& GetPose() const
+    {
+        return m_pose;
+    }
+
+    [[nodiscard]] const rgl_mat3x4f& GetInversePose() const
+    {
+        return m_inversePose;
+    }
+
+    [[nodiscard]] int32_t GetId() const
+    {
+        return m_id;
+    }
+
+    //! Entities with singular poses (e.g. zero scale) cannot be hit.
+    [[nodiscard]] bool IsDegenerate() const
+    {
+        return m_isDegenerate;
+    }
+
+private:
+    Scene& m_scene;
+    std::shared_ptr<Mesh> m_mesh; //!< Meshes outlive their API handle while any entity uses them.
+    std::shared_ptr<Texture> m_intensityTexture; //!< Textures outlive their API handle while any entity uses them.
+    rgl_mat3x4f m_pose;
+    rgl_mat3x4f m_inversePose;
+    int32_t m_id;
+    bool m_isDegenerate{ false };
+};
+
+struct Scene
+{
+public:
+    //! Default entity id reported for hits on entities without an id assigned.
+    static constexpr int32_t DefaultEntityId = 0;
+
+    struct Hit
+    {
+        float m_distance{ 0.0f };
+        const Entity* m_entity{ nullptr };
+        int64_t m_triangle{ -1 };
+    };
+
+    //! The only scene supported by the RGL API, addressed with a null handle.
+    static Scene& GetDefault();
+
+    void AddEntity(Entity* entity);
+    void RemoveEntity(Entity* entity);
+    void MarkDirty();
+
+    void SetTime(uint64_t nanoseconds);
+    [[nodiscard]] uint64_t GetTime() const;
+
+    //! Rebuilds the top level acceleration structure if any entity or mesh changed. Must be called before raytracing.
+    void Prepare();
+
+    //! Finds the closest hit within (tMin, tMax). Safe to call concurrently after Prepare.
+    //! @return True if the ray hit any entity.
+    bool Intersect(const RGL::Cpu::Vec3& origin, const RGL::Cpu::Vec3& direction, float tMin, float tMax, Hit& hit) const;
+
+    //! Removes all the entities (used on the RGL cleanup).
+    void Clear();
+
+private:
+    std::unordered_set<Entity*> m_entities;
+    std::vector<const Entity*> m_entityList; //!< Entities in the order referenced by the top level structure.
+    std::vector<uint64_t> m_meshVersions; //!< Mesh versions seen during the last rebuild, parallel to m_entityList.
+    RGL::Cpu::Bvh m_tlas;
+    bool m_isDirty{ true };
+    uint64_t m_time{ 0LU };
+};
@@ -0,0 +1,147 @@
+/* Copyright 2020-2021, Robotec.ai sp. z o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <ThreadPool.h>
+#include <algorithm>
+#include <cstdlib>
+#include <string>
+
+namespace RGL::Cpu
+{
+    namespace
+    {
+        //! The worker count may be limited with the RGL_CPU_THREADS environment variable (e.g. on shared CI runners).
+        size_t GetWorkerCount()
+        {
+            size_t threadCount = std::max(1U, std::thread::hardware_concurrency());
+            if (const char* threadsVariable = std::getenv("RGL_CPU_THREADS"); threadsVariable != nullptr)
+            {
+                if (const long requestedThreads = std::strtol(threadsVariable, nullptr, 10); requestedThreads > 0L)
+                {
+                    threadCount = static_cast<size_t>(requestedThreads);
+                }
+            }
+            // The calling thread also processes chunks.
+            return threadCount - 1LU;
+        }
+    } // namespace
+
+    ThreadPool& ThreadPool::Get()
+    {
+        static ThreadPool Pool(GetWorkerCount());
+        return Pool;
+    }
+
+    ThreadPool::ThreadPool(size_t workerCount)
+    {
+        m_workers.reserve(workerCount);
+        for (size_t worker = 0LU; worker < workerCount; ++worker)
+        {
+            m_workers.emplace_back(&ThreadPool::WorkerLoop, this);
+        }
+    }
+
+    ThreadPool::~ThreadPool()
+    {
+        {
+            std::lock_guard lock(m_mutex);
+            m_isStopping = true;
+        }
+        m_workAvailable.notify_all();
+        for (std::thread& worker : m_workers)
+        {
+            worker.join();
+        }
+    }
+
+    void ThreadPool::ParallelFor(size_t count, size_t chunkSize, const RangeFunction& function)
+    {
+        if (count == 0LU)
+        {
+            return;
+        }
+
+        chunkSize = std::max(chunkSize, 1LU);
+        if (m_workers.empty() || count <= chunkSize)
+        {
+            function(0LU, count);
+            return;
+        }
+
+        {
+            std::lock_guard lock(m_mutex);
+            m_function = &function;
+            m_count = count;
+            m_chunkSize = chunkSize;
+            m_nextIndex = 0LU;
+            m_activeWorkers = m_workers.size();
+            ++m_generation;
+        }
+        m_workAvailable.notify_all();
+
+        ProcessChunks();
+
+        std::unique_lock lock(m_mutex);
+        m_workFinished.wait(
+            lock,
+            [this]
+            {
+                return m_activeWorkers == 0LU;
+            });
+        m_function = nullptr;
+    }
+
+    void ThreadPool::WorkerLoop()
+    {
+        uint64_t seenGeneration = 0LU;
+        while (true)
+        {
+            {
+                std::unique_lock lock(m_mutex);
+                m_workAvailable.wait(
+                    lock,
+                    [this, seenGeneration]
+                    {
+                        return m_isStopping || m_generation != seenGeneration;
+                    });
+                if (m_isStopping)
+                {
+                    return;
+                }
+                seenGeneration = m_generation;
+            }
+
+            ProcessChunks();
+
+            {
+                std::lock_guard lock(m_mutex);
+                --m_activeWorkers;
+            }
+            m_workFinished.notify_one();
+        }
+    }
+
+    void ThreadPool::ProcessChunks()
+    {
+        while (true)
+        {
+            const size_t begin = m_nextIndex.fetch_add(m_chunkSize);
+            if (begin >= m_count)
+            {
+                return;
+            }
+            (*m_function)(begin, std::min(begin + m_chunkSize, m_count));
+        }
+    }
+} // namespace RGL::Cpu
@@ -0,0 +1,59 @@
+/* Copyright 2020-2021, Robotec.ai sp. z o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace RGL::Cpu
+{
+    //! Persistent worker threads used to split the raytracing work into chunks.
+    class ThreadPool
+    {
+    public:
+        using RangeFunction = std::function<void(size_t begin, size_t end)>;
+
+        static ThreadPool& Get();
+
+        explicit ThreadPool(size_t workerCount);
+        ~ThreadPool();
+
+        //! Calls function on consecutive chunks of [0, count) from all the workers and the calling thread.
+        //! Returns once every chunk is processed.
+        void ParallelFor(size_t count, size_t chunkSize, const RangeFunction& function);
+
+    private:
+        void WorkerLoop();
+        void ProcessChunks();
+
+        std::vector<std::thread> m_workers;
+        std::mutex m_mutex;
+        std::condition_variable m_workAvailable;
+        std::condition_variable m_workFinished;
+        bool m_isStopping{ false };
+        uint64_t m_generation{ 0LU };
+        size_t m_activeWorkers{ 0LU };
+
+        // Current job
+        const RangeFunction* m_function{ nullptr };
+        size_t m_count{ 0LU };
+        size_t m_chunkSize{ 1LU };
+        std::atomic<size_t> m_nextIndex{ 0LU };
+    };
+} // namespace RGL::Cpu
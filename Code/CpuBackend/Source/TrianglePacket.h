@@ -0,0 +1,143 @@
+/* Copyright 2020-2021, Robotec.ai sp. z o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <Math.h>
+#include <cstdint>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define RGL_CPU_BACKEND_SSE
+#endif
+
+namespace RGL::Cpu
+{
+    //! Up to PacketWidth triangles stored in the structure of arrays layout, intersected with a single ray at once.
+    //! Unused lanes hold degenerate triangles which never report a hit.
+    struct alignas(16) TrianglePacket
+    {
+        static constexpr uint32_t PacketWidth = 4U;
+
+        float m_v0[3][PacketWidth];
+        float m_edge1[3][PacketWidth];
+        float m_edge2[3][PacketWidth];
+        uint32_t m_triangleIndices[PacketWidth];
+
+        void Set(uint32_t lane, const Vec3& v0, const Vec3& v1, const Vec3& v2, uint32_t triangleIndex)
+        {
+            const Vec3 edge1 = v1 - v0, edge2 = v2 - v0;
+            for (int axis = 0; axis < 3; ++axis)
+            {
+                m_v0[axis][lane] = v0[axis];
+                m_edge1[axis][lane] = edge1[axis];
+                m_edge2[axis][lane] = edge2[axis];
+            }
+            m_triangleIndices[lane] = triangleIndex;
+        }
+
+        void Clear(uint32_t lane)
+        {
+            Set(lane, {}, {}, {}, 0U);
+        }
+
+        //! Möller-Trumbore test of all lanes. Both triangle sides are hittable.
+        //! @return Lane of the closest hit within (tMin, tMax) or -1, tMax is updated on hit.
+        int Intersect(const Vec3& origin, const Vec3& direction, float tMin, float& tMax) const
+        {
+#ifdef RGL_CPU_BACKEND_SSE
+            const __m128 dirX = _mm_set1_ps(direction.x), dirY = _mm_set1_ps(direction.y), dirZ = _mm_set1_ps(direction.z);
+            const __m128 e1X = _mm_load_ps(m_edge1[0]), e1Y = _mm_load_ps(m_edge1[1]), e1Z = _mm_load_ps(m_edge1[2]);
+            const __m128 e2X = _mm_load_ps(m_edge2[0]), e2Y = _mm_load_ps(m_edge2[1]), e2Z = _mm_load_ps(m_edge2[2]);
+
+            // p = direction x edge2
+            const __m128 pX = _mm_sub_ps(_mm_mul_ps(dirY, e2Z), _mm_mul_ps(dirZ, e2Y));
+            const __m128 pY = _mm_sub_ps(_mm_mul_ps(dirZ, e2X), _mm_mul_ps(dirX, e2Z));
+            const __m128 pZ = _mm_sub_ps(_mm_mul_ps(dirX, e2Y), _mm_mul_ps(dirY, e2X));
+            const __m128 det = _mm_add_ps(_mm_add_ps(_mm_mul_ps(e1X, pX), _mm_mul_ps(e1Y, pY)), _mm_mul_ps(e1Z, pZ));
+            const __m128 invDet = _mm_div_ps(_mm_set1_ps(1.0f), det);
+
+            // s = origin - v0
+            const __m128 sX = _mm_sub_ps(_mm_set1_ps(origin.x), _mm_load_ps(m_v0[0]));
+            const __m128 sY = _mm_sub_ps(_mm_set1_ps(origin.y), _mm_load_ps(m_v0[1]));
+            const __m128 sZ = _mm_sub_ps(_mm_set1_ps(origin.z), _mm_load_ps(m_v0[2]));
+            const __m128 u = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(sX, pX), _mm_mul_ps(sY, pY)), _mm_mul_ps(sZ, pZ)), invDet);
+
+            // q = s x edge1
+            const __m128 qX = _mm_sub_ps(_mm_mul_ps(sY, e1Z), _mm_mul_ps(sZ, e1Y));
+            const __m128 qY = _mm_sub_ps(_mm_mul_ps(sZ, e1X), _mm_mul_ps(sX, e1Z));
+            const __m128 qZ = _mm_sub_ps(_mm_mul_ps(sX, e1Y), _mm_mul_ps(sY, e1X));
+            const __m128 v = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(dirX, qX), _mm_mul_ps(dirY, qY)), _mm_mul_ps(dirZ, qZ)), invDet);
+            const __m128 t = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(e2X, qX), _mm_mul_ps(e2Y, qY)), _mm_mul_ps(e2Z, qZ)), invDet);
+
+            const __m128 zero = _mm_setzero_ps();
+            const __m128 absDet = _mm_andnot_ps(_mm_set1_ps(-0.0f), det);
+            __m128 mask = _mm_cmpgt_ps(absDet, _mm_set1_ps(DeterminantEpsilon));
+            mask = _mm_and_ps(mask, _mm_cmpge_ps(u, zero));
+            mask = _mm_and_ps(mask, _mm_cmpge_ps(v, zero));
+            mask = _mm_and_ps(mask, _mm_cmple_ps(_mm_add_ps(u, v), _mm_set1_ps(1.0f)));
+            mask = _mm_and_ps(mask, _mm_cmpgt_ps(t, _mm_set1_ps(tMin)));
+            mask = _mm_and_ps(mask, _mm_cmplt_ps(t, _mm_set1_ps(tMax)));
+
+            int hitMask = _mm_movemask_ps(mask);
+            if (hitMask == 0)
+            {
+                return -1;
+            }
+
+            alignas(16) float distances[PacketWidth];
+            _mm_store_ps(distances, t);
+            int closestLane = -1;
+            for (int lane = 0; hitMask != 0; ++lane, hitMask >>= 1)
+            {
+                if ((hitMask & 1) != 0 && distances[lane] < tMax)
+                {
+                    tMax = distances[lane];
+                    closestLane = lane;
+                }
+            }
+            return closestLane;
+#else
+            int closestLane = -1;
+            for (uint32_t lane = 0U; lane < PacketWidth; ++lane)
+            {
+                const Vec3 edge1{ m_edge1[0][lane], m_edge1[1][lane], m_edge1[2][lane] };
+                const Vec3 edge2{ m_edge2[0][lane], m_edge2[1][lane], m_edge2[2][lane] };
+                const Vec3 p = direction.Cross(edge2);
+                const float det = edge1.Dot(p);
+                if (std::abs(det) <= DeterminantEpsilon)
+                {
+                    continue;
+                }
+
+                const float invDet = 1.0f / det;
+                const Vec3 s = origin - Vec3{ m_v0[0][lane], m_v0[1][lane], m_v0[2][lane] };
+                const float u = s.Dot(p) * invDet;
+                const Vec3 q = s.Cross(edge1);
+                const float v = direction.Dot(q) * invDet;
+                const float t = edge2.Dot(q) * invDet;
+                if (u >= 0.0f && v >= 0.0f && u + v <= 1.0f && t > tMin && t < tMax)
+                {
+                    tMax = t;
+                    closestLane = static_cast<int>(lane);
+                }
+            }
+            return closestLane;
+#endif
+        }
+
+    private:
+        static constexpr float DeterminantEpsilon = 1e-12f;
+    };
+} // namespace RGL::Cpu
@@ -0,0 +1,241 @@
+/* Copyright 2020-2021, Robotec.ai sp. z o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cmath>
+#include <cstdio>
+#include <functional>
+#include <rgl/api/core.h>
+#include <rgl/api/extensions/pcl.h>
+#include <vector>
+
+// The tests exercise the backend through the public RGL API only, so that they do not depend on its internals.
+namespace
+{
+    int FailureCount = 0;
+
+#define EXPECT(condition)                                                                                                                  \
+    if (!(condition))                                                                                                                      \
+    {                                                                                                                                      \
+        std::printf("%s:%d: expectation failed: %s\n", __FILE__, __LINE__, #condition);                                                  \
+        ++FailureCount;                                                                                                                    \
+    }
+
+    rgl_mat3x4f CreateRayPose(float x, float y, float z)
+    {
+        // The identity rotation casts the ray along the Z axis.
+        return { { { 1.0f, 0.0f, 0.0f, x }, { 0.0f, 1.0f, 0.0f, y }, { 0.0f, 0.0f, 1.0f, z } } };
+    }
+
+    //! Adds a small triangle lying in the Z = 0 plane around the given point.
+    void AddTriangle(std::vector<rgl_vec3f>& vertices, std::vector<rgl_vec3i>& indices, float x, float y, float halfSize)
+    {
+        const int32_t first = static_cast<int32_t>(vertices.size());
+        vertices.push_back({ { x - halfSize, y - halfSize, 0.0f } });
+        vertices.push_back({ { x + halfSize, y - halfSize, 0.0f } });
+        vertices.push_back({ { x, y + halfSize, 0.0f } });
+        indices.push_back({ { first, first + 1, first + 2 } });
+    }
+
+    //! Casts one ray from below each of the given points and checks that all of them hit the scene one meter away.
+    void ExpectAllHit(const std::vector<rgl_vec3f>& vertices, const std::vector<rgl_vec3i>& indices, const std::vector<rgl_mat3x4f>& rays)
+    {
+        rgl_mesh_t mesh = nullptr;
+        rgl_entity_t entity = nullptr;
+        EXPECT(
+            rgl_mesh_create(
+                &mesh, vertices.data(), static_cast<int32_t>(vertices.size()), indices.data(), static_cast<int32_t>(indices.size())) ==
+            RGL_SUCCESS);
+        EXPECT(rgl_entity_create(&entity, nullptr, mesh) == RGL_SUCCESS);
+
+        const rgl_field_t fields[] = { RGL_FIELD_IS_HIT_I32, RGL_FIELD_DISTANCE_F32 };
+        rgl_node_t rayPoses = nullptr, rayTrace = nullptr, yield = nullptr;
+        EXPECT(rgl_node_rays_from_mat3x4f(&rayPoses, rays.data(), static_cast<int32_t>(rays.size())) == RGL_SUCCESS);
+        EXPECT(rgl_node_raytrace(&rayTrace, nullptr) == RGL_SUCCESS);
+        EXPECT(rgl_node_points_yield(&yield, fields, 2) == RGL_SUCCESS);
+        EXPECT(rgl_graph_node_add_child(rayPoses, rayTrace) == RGL_SUCCESS);
+        EXPECT(rgl_graph_node_add_child(rayTrace, yield) == RGL_SUCCESS);
+        EXPECT(rgl_graph_run(rayPoses) == RGL_SUCCESS);
+
+        int32_t count = 0;
+        EXPECT(rgl_graph_get_result_size(yield, RGL_FIELD_IS_HIT_I32, &count, nullptr) == RGL_SUCCESS);
+        EXPECT(count == static_cast<int32_t>(rays.size()));
+        std::vector<int32_t> isHit(rays.size());
+        std::vector<float> distances(rays.size());
+        EXPECT(rgl_graph_get_result_data(yield, RGL_FIELD_IS_HIT_I32, isHit.data()) == RGL_SUCCESS);
+        EXPECT(rgl_graph_get_result_data(yield, RGL_FIELD_DISTANCE_F32, distances.data()) == RGL_SUCCESS);
+
+        size_t missCount = 0LU;
+        for (size_t rayIndex = 0LU; rayIndex < rays.size(); ++rayIndex)
+        {
+            if (isHit[rayIndex] == 0 || std::fabs(distances[rayIndex] - 1.0f) > 1e-3f)
+            {
+                ++missCount;
+            }
+        }
+        EXPECT(missCount == 0LU);
+        EXPECT(rgl_cleanup() == RGL_SUCCESS);
+    }
+
+    void TestDegenerateBvh()
+    {
+        // Geometrically spaced triangles make the SAH peel one triangle off at a time, which used to overflow the traversal stack.
+        std::vector<rgl_vec3f> vertices;
+        std::vector<rgl_vec3i> indices;
+        std::vector<rgl_mat3x4f> rays;
+        float x = 1.0f;
+        for (int i = 0; i < 256; ++i, x *= 1.15f)
+        {
+            AddTriangle(vertices, indices, x, 0.0f, 0.01f * x);
+            rays.push_back(CreateRayPose(x, 0.0f, -1.0f));
+        }
+        ExpectAllHit(vertices, indices, rays);
+    }
+
+    void TestParallelBvhBuild()
+    {
+        // A grid large enough to have its subtrees built by several threads.
+        constexpr int GridSize = 128;
+        std::vector<rgl_vec3f> vertices;
+        std::vector<rgl_vec3i> indices;
+        std::vector<rgl_mat3x4f> rays;
+        for (int row = 0; row < GridSize; ++row)
+        {
+            for (int column = 0; column < GridSize; ++column)
+            {
+                AddTriangle(vertices, indices, static_cast<float>(column), static_cast<float>(row), 0.25f);
+                rays.push_back(CreateRayPose(static_cast<float>(column), static_cast<float>(row), -1.0f));
+            }
+        }
+        ExpectAllHit(vertices, indices, rays);
+    }
+
+    //! Runs a graph of the given number of rays with the given number of ring ids and returns the status of the run.
+    rgl_status_t RunWithRingIds(int32_t rayCount, int32_t ringIdCount)
+    {
+        const std::vector<rgl_mat3x4f> rays(rayCount, CreateRayPose(0.0f, 0.0f, 0.0f));
+        std::vector<int32_t> ringIds(ringIdCount);
+        for (int32_t ringId = 0; ringId < ringIdCount; ++ringId)
+        {
+            ringIds[ringId] = ringId;
+        }
+
+        rgl_node_t rayPoses = nullptr, rayRingIds = nullptr, rayTrace = nullptr;
+        EXPECT(rgl_node_rays_from_mat3x4f(&rayPoses, rays.data(), rayCount) == RGL_SUCCESS);
+        EXPECT(rgl_node_rays_set_ring_ids(&rayRingIds, ringIds.data(), ringIdCount) == RGL_SUCCESS);
+        EXPECT(rgl_node_raytrace(&rayTrace, nullptr) == RGL_SUCCESS);
+        EXPECT(rgl_graph_node_add_child(rayPoses, rayRingIds) == RGL_SUCCESS);
+        EXPECT(rgl_graph_node_add_child(rayRingIds, rayTrace) == RGL_SUCCESS);
+        const rgl_status_t status = rgl_graph_run(rayPoses);
+        EXPECT(rgl_cleanup() == RGL_SUCCESS);
+        return status;
+    }
+
+    void TestRingIdValidation()
+    {
+        EXPECT(RunWithRingIds(4, 2) == RGL_SUCCESS);
+        EXPECT(RunWithRingIds(4, 4) == RGL_SUCCESS);
+        EXPECT(RunWithRingIds(3, 2) == RGL_INVALID_PIPELINE);
+        EXPECT(RunWithRingIds(2, 4) == RGL_INVALID_PIPELINE);
+    }
+
+    void TestYieldFieldRestriction()
+    {
+        const rgl_mat3x4f ray = CreateRayPose(0.0f, 0.0f, 0.0f);
+        const rgl_field_t yieldField = RGL_FIELD_IS_HIT_I32;
+        rgl_node_t rayPoses = nullptr, rayTrace = nullptr, yield = nullptr;
+        EXPECT(rgl_node_rays_from_mat3x4f(&rayPoses, &ray, 1) == RGL_SUCCESS);
+        EXPECT(rgl_node_raytrace(&rayTrace, nullptr) == RGL_SUCCESS);
+        EXPECT(rgl_node_points_yield(&yield, &yieldField, 1) == RGL_SUCCESS);
+        EXPECT(rgl_graph_node_add_child(rayPoses, rayTrace) == RGL_SUCCESS);
+        EXPECT(rgl_graph_node_add_child(rayTrace, yield) == RGL_SUCCESS);
+        EXPECT(rgl_graph_run(rayPoses) == RGL_SUCCESS);
+
+        int32_t count = 0;
+        EXPECT(rgl_graph_get_result_size(yield, RGL_FIELD_IS_HIT_I32, &count, nullptr) == RGL_SUCCESS);
+        EXPECT(count == 1);
+        // The raytrace node produces the distances as well, but the yield node passes only its own fields.
+        EXPECT(rgl_graph_get_result_size(yield, RGL_FIELD_DISTANCE_F32, &count, nullptr) == RGL_INVALID_PIPELINE);
+        EXPECT(rgl_graph_get_result_size(rayTrace, RGL_FIELD_DISTANCE_F32, &count, nullptr) == RGL_SUCCESS);
+        EXPECT(rgl_cleanup() == RGL_SUCCESS);
+    }
+
+    void TestDownsampleCentroids()
+    {
+        // Two hits share the first voxel, the third one lies in a voxel of its own.
+        const std::vector<std::pair<float, float>> hits{ { 0.25f, 0.25f }, { 0.75f, 0.75f }, { 2.5f, 0.5f } };
+        std::vector<rgl_vec3f> vertices;
+        std::vector<rgl_vec3i> indices;
+        std::vector<rgl_mat3x4f> rays;
+        for (const auto& [x, y] : hits)
+        {
+            AddTriangle(vertices, indices, x, y, 0.1f);
+            rays.push_back(CreateRayPose(x, y, -0.5f));
+        }
+        // A ray without any hit is removed by the compaction before the downsampling.
+        rays.push_back(CreateRayPose(5.0f, 5.0f, -0.5f));
+
+        rgl_mesh_t mesh = nullptr;
+        rgl_entity_t entity = nullptr;
+        EXPECT(
+            rgl_mesh_create(
+                &mesh, vertices.data(), static_cast<int32_t>(vertices.size()), indices.data(), static_cast<int32_t>(indices.size())) ==
+            RGL_SUCCESS);
+        EXPECT(rgl_entity_create(&entity, nullptr, mesh) == RGL_SUCCESS);
+
+        const rgl_field_t yieldField = RGL_FIELD_XYZ_F32;
+        rgl_node_t rayPoses = nullptr, rayTrace = nullptr, compact = nullptr, downsample = nullptr, yield = nullptr;
+        EXPECT(rgl_node_rays_from_mat3x4f(&rayPoses, rays.data(), static_cast<int32_t>(rays.size())) == RGL_SUCCESS);
+        EXPECT(rgl_node_raytrace(&rayTrace, nullptr) == RGL_SUCCESS);
+        EXPECT(rgl_node_points_compact(&compact) == RGL_SUCCESS);
+        EXPECT(rgl_node_points_downsample(&downsample, 1.0f, 1.0f, 1.0f) == RGL_SUCCESS);
+        EXPECT(rgl_node_points_yield(&yield, &yieldField, 1) == RGL_SUCCESS);
+        EXPECT(rgl_graph_node_add_child(rayPoses, rayTrace) == RGL_SUCCESS);
+        EXPECT(rgl_graph_node_add_child(rayTrace, compact) == RGL_SUCCESS);
+        EXPECT(rgl_graph_node_add_child(compact, downsample) == RGL_SUCCESS);
+        EXPECT(rgl_graph_node_add_child(downsample, yield) == RGL_SUCCESS);
+        EXPECT(rgl_graph_run(rayPoses) == RGL_SUCCESS);
+
+        int32_t count = 0;
+        EXPECT(rgl_graph_get_result_size(yield, RGL_FIELD_XYZ_F32, &count, nullptr) == RGL_SUCCESS);
+        EXPECT(count == 2);
+        if (count == 2)
+        {
+            // Each voxel keeps a single point at the centroid of its hits, in the order of the first hit in the voxel.
+            std::vector<rgl_vec3f> points(2U);
+            EXPECT(rgl_graph_get_result_data(yield, RGL_FIELD_XYZ_F32, points.data()) == RGL_SUCCESS);
+            EXPECT(std::fabs(points[0].value[0] - 0.5f) < 1e-5f && std::fabs(points[0].value[1] - 0.5f) < 1e-5f);
+            EXPECT(std::fabs(points[1].value[0] - 2.5f) < 1e-5f && std::fabs(points[1].value[1] - 0.5f) < 1e-5f);
+        }
+        EXPECT(rgl_cleanup() == RGL_SUCCESS);
+    }
+} // namespace
+
+int main()
+{
+    const std::vector<std::pair<const char*, std::function<void()>>> tests{
+        { "DegenerateBvh", TestDegenerateBvh },
+        { "DownsampleCentroids", TestDownsampleCentroids },
+        { "ParallelBvhBuild", TestParallelBvhBuild },
+        { "RingIdValidation", TestRingIdValidation },
+        { "YieldFieldRestriction", TestYieldFieldRestriction },
+    };
+
+    for (const auto& [name, test] : tests)
+    {
+        const int previousFailureCount = FailureCount;
+        test();
+        std::printf("%s: %s\n", name, FailureCount == previousFailureCount ? "passed" : "FAILED");
+    }
+    return FailureCount == 0 ? 0 : 1;
+}
@@ -0,0 +1,61 @@
+/* Copyright 2020-2021, Robotec.ai sp. z o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <AzCore/Component/EntityId.h>
+#include <AzCore/EBus/EBus.h>
+#include <AzCore/Math/Vector3.h>
+#include <AzCore/std/containers/vector.h>
+
+namespace RGL
+{
+    //! Lidar results organized as an image with one row per beam (ring) and one column per azimuth step.
+    //! The rows are ordered from the highest beam down, the columns by increasing azimuth, starting from -180 degrees.
+    struct LidarRangeImage
+    {
+        size_t m_rowCount{ 0LU };
+        size_t m_columnCount{ 0LU };
+        //! Row-major ranges. Cells without a hit hold infinity (negative infinity below the minimum range).
+        AZStd::vector<float> m_ranges;
+        //! Row-major hit points in the world frame. Empty unless requested in the lidar settings.
+        //! Cells without a hit hold the zero vector.
+        AZStd::vector<AZ::Vector3> m_points;
+        //! Row-major ids of the hit entities, mapped to the Entities with RGLRequests::GetEntityIdByRglId.
+        //! Empty unless requested in the lidar settings. Cells without a hit hold 0.
+        AZStd::vector<int32_t> m_entityIds;
+        //! Row-major intensities of the hits, given by the reflectivity of the hit entities (see ReflectivityRequestBus).
+        //! Empty unless requested in the lidar settings. Cells without a hit hold 0.
+        AZStd::vector<float> m_intensities;
+    };
+
+    class LidarRangeImageNotifications : public AZ::EBusTraits
+    {
+    public:
+        //////////////////////////////////////////////////////////////////////////
+        // EBusTraits overrides
+        static constexpr AZ::EBusHandlerPolicy HandlerPolicy = AZ::EBusHandlerPolicy::Multiple;
+        static constexpr AZ::EBusAddressPolicy AddressPolicy = AZ::EBusAddressPolicy::ById;
+        using BusIdType = AZ::EntityId;
+        //////////////////////////////////////////////////////////////////////////
+
+        //! Called after each raycast of a lidar with the range image enabled, addressed by the lidar entity.
+        virtual void OnRangeImageUpdated(const LidarRangeImage& rangeImage) = 0;
+
+    protected:
+        ~LidarRangeImageNotifications() = default;
+    };
+
+    using LidarRangeImageNotificationBus = AZ::EBus<LidarRangeImageNotifications>;
+} // namespace RGL
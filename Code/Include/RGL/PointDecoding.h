@@ -0,0 +1,74 @@
+/* Copyright 2020-2021, Robotec.ai sp. z o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+//! Header-only decoding of the encoded lidar points. Depends on the standard library only,
+//! so that it can be used by the consumers of the published point clouds outside of the engine.
+namespace RGL::PointDecoding
+{
+    //! Point encoded as the index of its ray and the distance along the ray (PointCloudFormat::RayIndexDistance).
+    //! The layout matches the point cloud fields: ray index (uint32) followed by distance (float32), without padding.
+    struct RayIndexDistancePoint
+    {
+        uint32_t m_rayIndex;
+        float m_distance;
+    };
+    static_assert(sizeof(RayIndexDistancePoint) == 8, "The encoded point has to match the published point step.");
+
+    //! Decodes the point hit by the ray at the given distance.
+    //! @param rayPose Row-major 3x4 pose of the ray in the lidar frame. The rays are cast along the Z axis of their poses.
+    //! @param distance Distance of the hit along the ray.
+    //! @param point Decoded point in the lidar frame.
+    inline void DecodePoint(const float (&rayPose)[3][4], float distance, float (&point)[3])
+    {
+        for (size_t row = 0; row < 3; ++row)
+        {
+            point[row] = rayPose[row][3] + rayPose[row][2] * distance;
+        }
+    }
+
+    //! Decodes the points of an encoded point cloud.
+    //! @param data Point cloud data, consisting of RayIndexDistancePoint values.
+    //! @param pointCount Number of the encoded points.
+    //! @param rayPoses Poses of the lidar rays in the lidar frame, in the order of the lidar ray pattern.
+    //! @param rayCount Number of the lidar rays.
+    //! @param points Destination of the decoded points, as three floats per point.
+    //! @return Number of the decoded points. Points with ray indices out of the ray pattern are skipped.
+    inline size_t DecodePoints(const void* data, size_t pointCount, const float (*rayPoses)[3][4], size_t rayCount, float* points)
+    {
+        size_t decodedCount = 0;
+        const auto* bytes = static_cast<const uint8_t*>(data);
+        for (size_t pointIndex = 0; pointIndex < pointCount; ++pointIndex)
+        {
+            // The point cloud buffer is not guaranteed to be aligned.
+            RayIndexDistancePoint encoded;
+            std::memcpy(&encoded, bytes + pointIndex * sizeof(RayIndexDistancePoint), sizeof(RayIndexDistancePoint));
+            if (encoded.m_rayIndex >= rayCount)
+            {
+                continue;
+            }
+
+            float point[3];
+            DecodePoint(rayPoses[encoded.m_rayIndex], encoded.m_distance, point);
+            std::memcpy(points + decodedCount * 3, point, sizeof(point));
+            ++decodedCount;
+        }
+        return decodedCount;
+    }
+} // namespace RGL::PointDecoding
@@ -17,10 +17,25 @@
 #include <AzCore/Component/EntityId.h>
 #include <AzCore/EBus/EBus.h>
 #include <AzCore/Interface/Interface.h>
+#include <AzCore/Math/Matrix3x4.h>
+#include <AzCore/Math/Vector3.h>
+#include <AzCore/std/containers/vector.h>
+#include <AzCore/std/string/string.h>
 #include <SceneConfigurationComponent.h>
 
 namespace RGL
 {
+    //! Results of a batched raycast (see RGLRequests::RaycastBatch), with one element per ray.
+    struct RaycastBatchResults
+    {
+        //! Distances of the hits along the rays. Rays without a hit hold infinity.
+        AZStd::vector<float> m_distances;
+        //! Hit points in the world frame. Rays without a hit hold the zero vector.
+        AZStd::vector<AZ::Vector3> m_points;
+        //! Hit Entities. Empty unless requested. Rays without a hit on an Entity (e.g. on the terrain) hold an invalid EntityId.
+        AZStd::vector<AZ::EntityId> m_entityIds;
+    };
+
     class RGLRequests
     {
     public:
@@ -33,6 +48,51 @@ namespace RGL
         virtual void SetSceneConfiguration(const SceneConfiguration& config) = 0;
         [[nodiscard]] virtual const SceneConfiguration& GetSceneConfiguration() const = 0;
 
+        //! Writes the current RGL scene (meshes, entity poses, terrain and lidars) to a binary snapshot file.
+        //! The snapshot can be replayed without the engine using the RGL.SnapshotBenchmark tool.
+        //! @param filePath Path of the snapshot file.
+        //! @return If successful returns true, otherwise returns false.
+        virtual bool ExportSceneSnapshot(const AZStd::string& filePath) = 0;
+
+        //! Maps an id of the ENTITY_ID point field back to the Entity hit by the point.
+        //! @param rglEntityId Id reported for the point.
+        //! @return The hit Entity or an invalid EntityId for the points not hitting an Entity (e.g. the terrain or the non-hits).
+        [[nodiscard]] virtual AZ::EntityId GetEntityIdByRglId(int32_t rglEntityId) const = 0;
+
+        //! Maps an id of the ENTITY_ID point field to the semantic class of the hit Entity (see SemanticClassRequestBus).
+        //! @param rglEntityId Id reported for the point.
+        //! @return The semantic class or SemanticClassRequests::UnlabeledClassId if the Entity has no semantic class.
+        [[nodiscard]] virtual int32_t GetSemanticClassId(int32_t rglEntityId) const = 0;
+
+        //! Traces a batch of rays against the RGL scene in a single run of a cached graph. Meant to replace large numbers of
+        //! single physics raycasts issued in one frame. The scene mirrors the render geometry, not the physics colliders.
+        //! Has to be called from the main thread.
+        //! @param origins Origins of the rays in the world frame.
+        //! @param directions Non-zero directions of the rays in the world frame, one per origin. A batch containing a zero
+        //! direction is rejected.
+        //! @param maxRange Maximum distance of the hits.
+        //! @param includeEntityIds If true, the results include the hit Entities.
+        //! @param includeExcludedEntities If true, the query sees the Entities excluded from the lidars. Showing them modifies
+        //! the scene, so the lidars near them cannot reuse their results in the next tick. Otherwise, the query keeps the
+        //! Entities hidden by the last lidar trace, so it may miss the Entities excluded from that lidar.
+        //! @param results Destination of the results, reusing its buffers.
+        //! @return If successful returns true, otherwise returns false.
+        virtual bool RaycastBatch(
+            const AZStd::vector<AZ::Vector3>& origins,
+            const AZStd::vector<AZ::Vector3>& directions,
+            float maxRange,
+            bool includeEntityIds,
+            bool includeExcludedEntities,
+            RaycastBatchResults& results) = 0;
+
+        //! Same as RaycastBatch, with the rays given as their poses in the world frame. The rays are cast along the Z axes.
+        virtual bool RaycastBatchPoses(
+            const AZStd::vector<AZ::Matrix3x4>& rayPoses,
+            float maxRange,
+            bool includeEntityIds,
+            bool includeExcludedEntities,
+            RaycastBatchResults& results) = 0;
+
     protected:
         ~RGLRequests() = default;
     };
@@ -0,0 +1,33 @@
+/* Copyright 2020-2021, Robotec.ai sp. z o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <AzCore/Component/ComponentBus.h>
+
+namespace RGL
+{
+    //! Lidar reflectivity of an Entity, reported as the intensity of the points hitting the Entity.
+    class ReflectivityRequests : public AZ::ComponentBus
+    {
+    public:
+        //! Reflectivity in the 0-255 range of the RGL intensity.
+        [[nodiscard]] virtual AZ::u8 GetReflectivity() const = 0;
+
+    protected:
+        ~ReflectivityRequests() = default;
+    };
+
+    using ReflectivityRequestBus = AZ::EBus<ReflectivityRequests>;
+} // namespace RGL
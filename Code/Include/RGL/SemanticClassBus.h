@@ -0,0 +1,35 @@
+/* Copyright 2020-2021, Robotec.ai sp. z o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <AzCore/Component/ComponentBus.h>
+
+namespace RGL
+{
+    //! Semantic class of an Entity, reported for the points hitting the Entity (see RGLRequests::GetSemanticClassId).
+    class SemanticClassRequests : public AZ::ComponentBus
+    {
+    public:
+        //! Class reported for the Entities without a semantic class.
+        static constexpr int32_t UnlabeledClassId = 0;
+
+        [[nodiscard]] virtual int32_t GetSemanticClassId() const = 0;
+
+    protected:
+        ~SemanticClassRequests() = default;
+    };
+
+    using SemanticClassRequestBus = AZ::EBus<SemanticClassRequests>;
+} // namespace RGL
@@ -16,18 +16,19 @@
 #include <AzCore/std/string/string.h>
 #include <EMotionFX/Source/ActorInstance.h>
 #include <EMotionFX/Source/Mesh.h>
+#include <EMotionFX/Source/MotionSystem.h>
 #include <EMotionFX/Source/Node.h>
 #include <EMotionFX/Source/SubMesh.h>
 #include <EMotionFX/Source/TransformData.h>
 #include <Entity/ActorEntityManager.h>
+#include <Scene/SceneCommandBufferBus.h>
 #include <Utilities/RGLUtils.h>
 #include <rgl/api/core.h>
-#include <RGL/RGLBus.h>
 
 namespace RGL
 {
-    ActorEntityManager::ActorEntityManager(AZ::EntityId entityId)
-        : EntityManager(entityId)
+    ActorEntityManager::ActorEntityManager(AZ::EntityId entityId, int32_t rglEntityId, DynamicEntityList& dynamicEntities)
+        : EntityManager(entityId, rglEntityId, dynamicEntities)
     {
         EMotionFX::Integration::ActorComponentNotificationBus::Handler::BusConnect(entityId);
     }
@@ -40,19 +41,24 @@ namespace RGL
 
     ActorEntityManager::~ActorEntityManager()
     {
+        auto* commandBuffer = SceneCommandBufferInterface::Get();
         for (MeshPair mesh : m_meshes)
         {
-            RGL_CHECK(rgl_mesh_destroy(mesh.m_rglMesh));
+            commandBuffer->DestroyMesh(mesh.m_rglMesh);
         }
     }
 
-    void ActorEntityManager::Update()
+    void ActorEntityManager::AppendToSnapshot(Snapshot::SceneSnapshot& snapshot)
     {
-        if (RGLInterface::Get()->GetSceneConfiguration().m_isSkinnedMeshUpdateEnabled)
+        // Actor meshes are not stored in the MeshLibrary, so they are appended with their current (deformed) vertex positions.
+        for (MeshPair& mesh : m_meshes)
         {
-            UpdateMeshVertices();
+            UpdateVertexPositions(*mesh.m_eMotionMesh);
+            const AZStd::vector<rgl_vec3i> rglIndices = CollectIndexData(*mesh.m_eMotionMesh);
+            snapshot.AddMesh(mesh.m_rglMesh, m_positions.data(), m_positions.size(), rglIndices.data(), rglIndices.size());
         }
-        EntityManager::Update();
+
+        AppendEntitiesToSnapshot(snapshot, Snapshot::EntityKind::Skinned);
     }
 
     void ActorEntityManager::OnActorInstanceCreated(EMotionFX::ActorInstance* actorInstance)
@@ -88,6 +94,7 @@ namespace RGL
         }
 
         m_entities.reserve(m_meshes.size());
+        m_entityMeshes.reserve(m_meshes.size());
         for (MeshPair& mesh : m_meshes)
         {
             rgl_entity_t entity = nullptr;
@@ -95,6 +102,7 @@ namespace RGL
             if (entity)
             {
                 m_entities.emplace_back(entity);
+                m_entityMeshes.emplace_back(mesh.m_rglMesh);
             }
             else
             {
@@ -109,21 +117,49 @@ namespace RGL
 
         if (!m_entities.empty())
         {
-            UpdatePose();
+            InitializeEntities();
+        }
+    }
+
+    void ActorEntityManager::EnableTextureCoords()
+    {
+        // The actor meshes are not shared, so the texture coordinates are set once, when the entities are initialized.
+        for (MeshPair& mesh : m_meshes)
+        {
+            Utils::SetUniformTextureCoords(mesh.m_rglMesh, mesh.m_eMotionMesh->GetNumVertices());
         }
     }
 
     void ActorEntityManager::UpdateMeshVertices()
     {
+        if (!m_actorInstance)
+        {
+            return;
+        }
+
+        const bool isAnimated = IsAnimated();
+        if (!isAnimated && !m_wasAnimated)
+        {
+            return;
+        }
+        m_wasAnimated = isAnimated;
+
         m_actorInstance->UpdateMeshDeformers(0.0f);
 
+        auto* commandBuffer = SceneCommandBufferInterface::Get();
         for (MeshPair& mesh : m_meshes)
         {
             UpdateVertexPositions(*mesh.m_eMotionMesh);
-            RGL_CHECK(rgl_mesh_update_vertices(mesh.m_rglMesh, m_positions.data(), m_positions.size()));
+            commandBuffer->UpdateMeshVertices(mesh.m_rglMesh, m_positions);
         }
     }
 
+    bool ActorEntityManager::IsAnimated() const
+    {
+        const EMotionFX::MotionSystem* motionSystem = m_actorInstance->GetMotionSystem();
+        return m_actorInstance->GetAnimGraphInstance() != nullptr || (motionSystem && motionSystem->GetIsPlaying());
+    }
+
     void ActorEntityManager::UpdateVertexPositions(const EMotionFX::Mesh& mesh)
     {
         const size_t VertexCount = mesh.GetNumVertices();
@@ -31,17 +31,24 @@ namespace RGL
         , public EMotionFX::Integration::ActorComponentNotificationBus::Handler
     {
     public:
-        explicit ActorEntityManager(AZ::EntityId entityId);
+        ActorEntityManager(AZ::EntityId entityId, int32_t rglEntityId, DynamicEntityList& dynamicEntities);
         ActorEntityManager(const ActorEntityManager& other) = default;
         ActorEntityManager(ActorEntityManager&& other);
         ~ActorEntityManager();
 
-        void Update() override;
+        void AppendToSnapshot(Snapshot::SceneSnapshot& snapshot) override;
+
+        //! Records the current (deformed) vertex positions of all the actor meshes.
+        //! Actors which are not animated are skipped, once their final deformed vertices are recorded.
+        void UpdateMeshVertices();
 
     protected:
         // ActorComponentNotificationBus overrides
         void OnActorInstanceCreated(EMotionFX::ActorInstance* actorInstance) override;
 
+        // EntityManager overrides
+        void EnableTextureCoords() override;
+
     private:
         struct MeshPair
         {
@@ -54,8 +61,9 @@ namespace RGL
         // skinned and the mesh sharing would not be useful.
         AZStd::vector<MeshPair> m_meshes;
         AZStd::vector<rgl_vec3f> m_positions;
+        bool m_wasAnimated{ true }; //!< Was the actor animated during the last vertex update?
 
-        void UpdateMeshVertices();
+        [[nodiscard]] bool IsAnimated() const;
         void UpdateVertexPositions(const EMotionFX::Mesh& mesh);
         AZStd::vector<rgl_vec3i> CollectIndexData(const EMotionFX::Mesh& mesh);
         Mesh* EMotionFXMeshToRglMesh(const EMotionFX::Mesh& mesh);
@@ -0,0 +1,87 @@
+/* Copyright 2020-2021, Robotec.ai sp. z o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <Entity/DynamicEntityList.h>
+#include <Utilities/RGLUtils.h>
+
+namespace RGL
+{
+    void DynamicEntityList::Add(AZ::TransformInterface* poseSource, rgl_entity_t entity)
+    {
+        if (auto [indexIt, inserted] = m_entityIndices.emplace(entity, m_entities.size()); !inserted)
+        {
+            m_entities[indexIt->second].m_idleTicks = 0U;
+            return;
+        }
+
+        m_entities.push_back({ poseSource, entity, 0U });
+    }
+
+    void DynamicEntityList::Remove(rgl_entity_t entity)
+    {
+        if (auto indexIt = m_entityIndices.find(entity); indexIt != m_entityIndices.end())
+        {
+            RemoveAt(indexIt->second);
+        }
+    }
+
+    void DynamicEntityList::UpdatePoses(SceneCommandBufferRequests& commandBuffer)
+    {
+        const AZ::TransformInterface* lastPoseSource = nullptr;
+        rgl_mat3x4f pose;
+        size_t index = 0LU;
+        while (index < m_entities.size())
+        {
+            DynamicEntity& dynamicEntity = m_entities[index];
+            if (dynamicEntity.m_idleTicks == 0U)
+            {
+                // RGL entities of a single Entity (one per mesh) are usually listed next to each other.
+                if (dynamicEntity.m_poseSource != lastPoseSource)
+                {
+                    pose = Utils::RglMat3x4FromAzMatrix3x4(AZ::Matrix3x4::CreateFromTransform(dynamicEntity.m_poseSource->GetWorldTM()));
+                    lastPoseSource = dynamicEntity.m_poseSource;
+                }
+
+                commandBuffer.SetEntityPose(dynamicEntity.m_entity, pose);
+            }
+
+            if (++dynamicEntity.m_idleTicks > IdleTickLimit)
+            {
+                // The last element is moved to this index, so the index is not advanced.
+                RemoveAt(index);
+                continue;
+            }
+
+            ++index;
+        }
+    }
+
+    void DynamicEntityList::RemoveAt(size_t index)
+    {
+        m_entityIndices.erase(m_entities[index].m_entity);
+
+        // Swap with the last element to keep the list dense.
+        if (index != m_entities.size() - 1LU)
+        {
+            m_entities[index] = m_entities.back();
+            m_entityIndices[m_entities[index].m_entity] = index;
+        }
+        m_entities.pop_back();
+    }
+
+    size_t DynamicEntityList::GetSize() const
+    {
+        return m_entities.size();
+    }
+} // namespace RGL
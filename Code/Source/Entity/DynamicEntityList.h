@@ -0,0 +1,58 @@
+/* Copyright 2020-2021, Robotec.ai sp. z o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <AzCore/Component/TransformBus.h>
+#include <AzCore/std/containers/unordered_map.h>
+#include <AzCore/std/containers/vector.h>
+#include <Scene/SceneCommandBufferBus.h>
+#include <rgl/api/core.h>
+
+namespace RGL
+{
+    //! Dense list of the RGL entities following a moving Entity.
+    //! Poses of the listed RGL entities are updated each tick in a single linear pass. Entities which did not move
+    //! for IdleTickLimit ticks are removed from the list, so the tick cost is proportional to the moving entities only.
+    class DynamicEntityList
+    {
+    public:
+        static constexpr uint32_t IdleTickLimit = 30U;
+
+        //! Marks the RGL entity following the transform of the pose source as moved in the current tick.
+        //! The entity is added to the list if it is not listed yet.
+        void Add(AZ::TransformInterface* poseSource, rgl_entity_t entity);
+
+        //! Removes the RGL entity from the list. Removing an entity which is not listed does nothing.
+        void Remove(rgl_entity_t entity);
+
+        //! Records the current poses of the RGL entities moved since the last update and removes the idle ones.
+        void UpdatePoses(SceneCommandBufferRequests& commandBuffer);
+
+        [[nodiscard]] size_t GetSize() const;
+
+    private:
+        struct DynamicEntity
+        {
+            AZ::TransformInterface* m_poseSource;
+            rgl_entity_t m_entity;
+            uint32_t m_idleTicks;
+        };
+
+        void RemoveAt(size_t index);
+
+        AZStd::vector<DynamicEntity> m_entities;
+        AZStd::unordered_map<rgl_entity_t, size_t> m_entityIndices; //!< Used only to remove entities.
+    };
+} // namespace RGL
@@ -0,0 +1,62 @@
+/* Copyright 2020-2021, Robotec.ai sp. z o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <AzCore/Casting/numeric_cast.h>
+#include <AzCore/Debug/Trace.h>
+#include <Entity/EntityIdRegistry.h>
+
+namespace RGL
+{
+    int32_t EntityIdRegistry::Acquire(AZ::EntityId entityId)
+    {
+        if (m_freeIds.size() > ReuseDelay)
+        {
+            const int32_t rglEntityId = m_freeIds.front();
+            m_freeIds.pop_front();
+            m_entityIds[rglEntityId - 1] = entityId;
+            return rglEntityId;
+        }
+
+        m_entityIds.push_back(entityId);
+        return aznumeric_cast<int32_t>(m_entityIds.size());
+    }
+
+    void EntityIdRegistry::Release(int32_t rglEntityId)
+    {
+        if (rglEntityId == InvalidId)
+        {
+            return;
+        }
+
+        AZ_Assert(GetEntityId(rglEntityId).IsValid(), "Attempted to release an RGL entity id which is not assigned.");
+        m_entityIds[rglEntityId - 1] = AZ::EntityId{};
+        m_freeIds.push_back(rglEntityId);
+    }
+
+    AZ::EntityId EntityIdRegistry::GetEntityId(int32_t rglEntityId) const
+    {
+        if (rglEntityId <= InvalidId || aznumeric_cast<size_t>(rglEntityId) > m_entityIds.size())
+        {
+            return AZ::EntityId{};
+        }
+
+        return m_entityIds[rglEntityId - 1];
+    }
+
+    void EntityIdRegistry::Clear()
+    {
+        m_entityIds.clear();
+        m_freeIds.clear();
+    }
+} // namespace RGL
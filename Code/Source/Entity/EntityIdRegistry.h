@@ -0,0 +1,51 @@
+/* Copyright 2020-2021, Robotec.ai sp. z o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <AzCore/Component/EntityId.h>
+#include <AzCore/std/containers/deque.h>
+#include <AzCore/std/containers/vector.h>
+
+namespace RGL
+{
+    //! Assigns the RGL entity ids reported in the ENTITY_ID field to the Entities represented in the RGL scene.
+    //! The ids are dense, so they are mapped back to the Entities with a single lookup. Ids of removed Entities are reused
+    //! in the order of their release, once more than ReuseDelay ids are free. Results traced before an Entity was removed
+    //! then report an unassigned id rather than the id of another Entity.
+    class EntityIdRegistry
+    {
+    public:
+        //! Id reported for the rays without a hit. It is never assigned. The RGL entities without an assigned id
+        //! (e.g. the terrain) report the RGL default id, which is not mapped to any Entity either.
+        static constexpr int32_t InvalidId = 0;
+        //! Number of released ids kept free before the oldest one is reused.
+        static constexpr size_t ReuseDelay = 1024LU;
+
+        //! Assigns a new RGL entity id to the Entity.
+        [[nodiscard]] int32_t Acquire(AZ::EntityId entityId);
+
+        //! Frees the RGL entity id, to be reused after ReuseDelay more releases. Releasing the InvalidId does nothing.
+        void Release(int32_t rglEntityId);
+
+        //! Returns the Entity of the RGL entity id or an invalid EntityId if the id is not assigned.
+        [[nodiscard]] AZ::EntityId GetEntityId(int32_t rglEntityId) const;
+
+        void Clear();
+
+    private:
+        AZStd::vector<AZ::EntityId> m_entityIds; //!< Entity of each id, offset by one since the InvalidId is not assigned.
+        AZStd::deque<int32_t> m_freeIds; //!< Released ids, from the oldest one.
+    };
+} // namespace RGL
@@ -13,46 +13,79 @@
  * limitations under the License.
  */
 
+#include <AzCore/Component/TransformBus.h>
 #include <Entity/EntityManager.h>
+#include <Mesh/MeshLibraryBus.h>
+#include <RGL/ReflectivityBus.h>
+#include <Scene/SceneCommandBufferBus.h>
 #include <Utilities/RGLUtils.h>
-#include <AzCore/Component/TransformBus.h>
 
 namespace RGL
 {
-    EntityManager::EntityManager(AZ::EntityId entityId)
+    EntityManager::EntityManager(AZ::EntityId entityId, int32_t rglEntityId, DynamicEntityList& dynamicEntities)
         : m_entityId{ entityId }
+        , m_rglEntityId{ rglEntityId }
+        , m_dynamicEntities{ dynamicEntities }
     {
         AZ::EntityBus::Handler::BusConnect(m_entityId);
     }
 
     EntityManager::EntityManager(EntityManager&& other)
         : m_entityId{ other.m_entityId }
+        , m_rglEntityId{ other.m_rglEntityId }
         , m_entities{ AZStd::move(other.m_entities) }
+        , m_entityMeshes{ AZStd::move(other.m_entityMeshes) }
+        , m_dynamicEntities{ other.m_dynamicEntities }
+        , m_poseSource{ other.m_poseSource }
         , m_isStatic{ other.m_isStatic }
+        , m_isVisible{ other.m_isVisible }
     {
         AZ::EntityBus::Handler::BusConnect(m_entityId);
+        if (m_poseSource && !IsStatic())
+        {
+            AZ::TransformNotificationBus::Handler::BusConnect(m_entityId);
+        }
     }
 
     EntityManager::~EntityManager()
     {
         AZ::EntityBus::Handler::BusDisconnect();
+        AZ::TransformNotificationBus::Handler::BusDisconnect();
 
+        RemoveDynamicEntities();
+        auto* commandBuffer = SceneCommandBufferInterface::Get();
         for (rgl_entity_t entity : m_entities)
         {
-            RGL_CHECK(rgl_entity_destroy(entity));
+            commandBuffer->DestroyEntity(entity);
         }
     }
 
-    void EntityManager::Update()
+    void EntityManager::AppendToSnapshot(Snapshot::SceneSnapshot& snapshot)
     {
-        if (IsStatic())
+        AppendEntitiesToSnapshot(snapshot, IsStatic() ? Snapshot::EntityKind::Static : Snapshot::EntityKind::Dynamic);
+    }
+
+    void EntityManager::SetVisible(bool isVisible)
+    {
+        if (m_isVisible == isVisible)
         {
             return;
         }
 
+        m_isVisible = isVisible;
+        if (!isVisible)
+        {
+            // Pose updates of the moving Entity would restore the hidden entities.
+            RemoveDynamicEntities();
+        }
         UpdatePose();
     }
 
+    int32_t EntityManager::GetRglEntityId() const
+    {
+        return m_rglEntityId;
+    }
+
     bool EntityManager::IsStatic() const
     {
         return m_isStatic;
@@ -60,7 +93,55 @@ namespace RGL
 
     void EntityManager::OnEntityActivated(const AZ::EntityId& entityId)
     {
+        // The static flag may only change while the Entity is inactive, so it is read on each activation.
         AZ::TransformBus::EventResult(m_isStatic, m_entityId, &AZ::TransformBus::Events::IsStaticTransform);
+        m_poseSource = AZ::TransformBus::FindFirstHandler(m_entityId);
+        if (!IsStatic())
+        {
+            // The RGL entities become dynamic once the Entity moves.
+            AZ::TransformNotificationBus::Handler::BusConnect(m_entityId);
+        }
+    }
+
+    void EntityManager::OnEntityDeactivated([[maybe_unused]] const AZ::EntityId& entityId)
+    {
+        AZ::TransformNotificationBus::Handler::BusDisconnect();
+        RemoveDynamicEntities();
+        m_poseSource = nullptr;
+    }
+
+    void EntityManager::OnTransformChanged([[maybe_unused]] const AZ::Transform& local, [[maybe_unused]] const AZ::Transform& world)
+    {
+        // The pose of the hidden entities is restored when they are shown again.
+        if (m_isVisible)
+        {
+            AddDynamicEntities();
+        }
+    }
+
+    void EntityManager::InitializeEntities()
+    {
+        for (rgl_entity_t entity : m_entities)
+        {
+            RGL_CHECK(rgl_entity_set_id(entity, m_rglEntityId));
+        }
+
+        // The intensity is reported by RGL only for the entities with an intensity texture.
+        if (ReflectivityRequestBus::HasHandlers(m_entityId))
+        {
+            AZ::u8 reflectivity = 0U;
+            ReflectivityRequestBus::EventResult(reflectivity, m_entityId, &ReflectivityRequests::GetReflectivity);
+            if (rgl_texture_t texture = MeshLibraryInterface::Get()->GetUniformIntensityTexture(reflectivity))
+            {
+                EnableTextureCoords();
+                for (rgl_entity_t entity : m_entities)
+                {
+                    RGL_CHECK(rgl_entity_set_intensity_texture(entity, texture));
+                }
+            }
+        }
+
+        UpdatePose();
     }
 
     void EntityManager::UpdatePose()
@@ -70,14 +151,52 @@ namespace RGL
             return;
         }
 
+        static constexpr rgl_mat3x4f CollapsedPose{};
+        const rgl_mat3x4f entityPose = m_isVisible ? GetWorldPose() : CollapsedPose;
+
+        auto* commandBuffer = SceneCommandBufferInterface::Get();
+        for (rgl_entity_t entity : m_entities)
+        {
+            commandBuffer->SetEntityPose(entity, entityPose);
+        }
+    }
+
+    void EntityManager::AddDynamicEntities()
+    {
+        if (!m_poseSource || IsStatic())
+        {
+            return;
+        }
+
+        for (rgl_entity_t entity : m_entities)
+        {
+            m_dynamicEntities.Add(m_poseSource, entity);
+        }
+    }
+
+    void EntityManager::RemoveDynamicEntities()
+    {
+        for (rgl_entity_t entity : m_entities)
+        {
+            m_dynamicEntities.Remove(entity);
+        }
+    }
+
+    rgl_mat3x4f EntityManager::GetWorldPose() const
+    {
         AZ::Transform transform = AZ::Transform::CreateIdentity();
         AZ::TransformBus::EventResult(transform, m_entityId, &AZ::TransformBus::Events::GetWorldTM);
 
-        const rgl_mat3x4f entityPose = Utils::RglMat3x4FromAzMatrix3x4(AZ::Matrix3x4::CreateFromTransform(transform));
+        return Utils::RglMat3x4FromAzMatrix3x4(AZ::Matrix3x4::CreateFromTransform(transform));
+    }
 
-        for (rgl_entity_t entity : m_entities)
+    void EntityManager::AppendEntitiesToSnapshot(Snapshot::SceneSnapshot& snapshot, Snapshot::EntityKind kind) const
+    {
+        const rgl_mat3x4f entityPose = GetWorldPose();
+        for (rgl_mesh_t mesh : m_entityMeshes)
         {
-            RGL_CHECK(rgl_entity_set_pose(entity, &entityPose));
+            [[maybe_unused]] const bool added = snapshot.AddEntity(mesh, entityPose, kind);
+            AZ_Warning(__func__, added, "Entity %s references a mesh which was not stored in the snapshot.", m_entityId.ToString().c_str());
         }
     }
 } // namespace RGL
\ No newline at end of file
@@ -16,20 +16,36 @@
 
 #include <AzCore/Component/EntityBus.h>
 #include <AzCore/Component/EntityId.h>
+#include <AzCore/Component/TransformBus.h>
 #include <AzCore/std/containers/vector.h>
+#include <Entity/DynamicEntityList.h>
+#include <Snapshot/SceneSnapshot.h>
 #include <rgl/api/core.h>
 
 namespace RGL
 {
-    class EntityManager : public AZ::EntityBus::Handler
+    class EntityManager
+        : public AZ::EntityBus::Handler
+        , protected AZ::TransformNotificationBus::Handler
     {
     public:
-        EntityManager(AZ::EntityId entityId);
+        //! @param entityId Entity represented by the RGL entities of this manager.
+        //! @param rglEntityId Id reported in the ENTITY_ID field for the points hitting the Entity (see EntityIdRegistry).
+        //! @param dynamicEntities List to which the RGL entities are added while the non-static Entity is moving.
+        EntityManager(AZ::EntityId entityId, int32_t rglEntityId, DynamicEntityList& dynamicEntities);
         EntityManager(const EntityManager& other) = default;
         EntityManager(EntityManager&& other);
         virtual ~EntityManager();
 
-        virtual void Update();
+        //! Appends the RGL entities managed by this EntityManager to the snapshot.
+        //! Meshes instantiated by the entities have to be stored in the snapshot beforehand.
+        virtual void AppendToSnapshot(Snapshot::SceneSnapshot& snapshot);
+
+        //! Hides the managed RGL entities by collapsing them to a point or restores their current world pose.
+        //! The poses are recorded in the scene command buffer. Hidden entities do not follow the Entity.
+        void SetVisible(bool isVisible);
+
+        [[nodiscard]] int32_t GetRglEntityId() const;
 
     protected:
         //! Is this Entity static?
@@ -37,13 +53,36 @@ namespace RGL
 
         // AZ::EntityBus::Handler implementation overrides
         void OnEntityActivated(const AZ::EntityId& entityId) override;
+        void OnEntityDeactivated(const AZ::EntityId& entityId) override;
+
+        // AZ::TransformNotificationBus::Handler overrides
+        void OnTransformChanged(const AZ::Transform& local, const AZ::Transform& world) override;
+
+        //! Sets the initial pose, the id and the reflectivity (see ReflectivityComponent) of the newly created m_entities.
+        void InitializeEntities();
+
+        //! Ensures that the meshes of m_entities have the texture coordinates required by the intensity textures.
+        virtual void EnableTextureCoords() = 0;
 
         //! Updates poses of all RGL entities managed by this EntityManager.
-        virtual void UpdatePose();
+        void UpdatePose();
+
+        //! Returns the current world pose of the managed Entity.
+        [[nodiscard]] rgl_mat3x4f GetWorldPose() const;
+
+        void AppendEntitiesToSnapshot(Snapshot::SceneSnapshot& snapshot, Snapshot::EntityKind kind) const;
 
         AZ::EntityId m_entityId;
+        int32_t m_rglEntityId;
         AZStd::vector<rgl_entity_t> m_entities;
+        AZStd::vector<rgl_mesh_t> m_entityMeshes; //!< Meshes instantiated by the corresponding m_entities.
     private:
+        void AddDynamicEntities();
+        void RemoveDynamicEntities();
+
+        DynamicEntityList& m_dynamicEntities;
+        AZ::TransformInterface* m_poseSource{ nullptr }; //!< Transform of the Entity, set while the Entity is active.
         bool m_isStatic{ false };
+        bool m_isVisible{ true };
     };
 } // namespace RGL
\ No newline at end of file
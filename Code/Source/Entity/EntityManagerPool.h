@@ -0,0 +1,128 @@
+/* Copyright 2020-2021, Robotec.ai sp. z o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <AzCore/Debug/Trace.h>
+#include <AzCore/std/containers/array.h>
+#include <AzCore/std/containers/vector.h>
+#include <AzCore/std/smart_ptr/unique_ptr.h>
+#include <AzCore/std/utils.h>
+
+namespace RGL
+{
+    //! Storage of entity managers of a single type.
+    //! Managers are constructed in place in fixed-size chunks, so they are stored contiguously and never move
+    //! (they are bus handlers, so their addresses have to stay valid). Slots of destroyed managers are reused.
+    template<typename ManagerType>
+    class EntityManagerPool
+    {
+    public:
+        static constexpr size_t ChunkSize = 256LU;
+
+        EntityManagerPool() = default;
+        EntityManagerPool(const EntityManagerPool& other) = delete;
+        EntityManagerPool& operator=(const EntityManagerPool& other) = delete;
+
+        ~EntityManagerPool()
+        {
+            Clear();
+        }
+
+        template<typename... Args>
+        ManagerType* Create(Args&&... args)
+        {
+            if (m_freeSlots.empty())
+            {
+                AddChunk();
+            }
+
+            Slot* slot = m_freeSlots.back();
+            m_freeSlots.pop_back();
+
+            auto* manager = new (slot->m_storage) ManagerType(AZStd::forward<Args>(args)...);
+            slot->m_isOccupied = true;
+            ++m_size;
+            return manager;
+        }
+
+        //! Destroys a manager created by this pool.
+        void Destroy(ManagerType* manager)
+        {
+            // The manager is constructed at the beginning of its slot.
+            auto* slot = reinterpret_cast<Slot*>(manager);
+            AZ_Assert(slot->m_isOccupied, "Attempted to destroy an entity manager which is not stored in the pool.");
+
+            manager->~ManagerType();
+            slot->m_isOccupied = false;
+            m_freeSlots.push_back(slot);
+            --m_size;
+        }
+
+        //! Destroys all the managers. The allocated chunks are kept for reuse.
+        void Clear()
+        {
+            ForEach(
+                [this](ManagerType& manager)
+                {
+                    Destroy(&manager);
+                });
+        }
+
+        //! Calls the function for every manager, in the storage order.
+        template<typename Function>
+        void ForEach(Function&& function)
+        {
+            for (auto& chunk : m_chunks)
+            {
+                for (Slot& slot : *chunk)
+                {
+                    if (slot.m_isOccupied)
+                    {
+                        function(*reinterpret_cast<ManagerType*>(slot.m_storage));
+                    }
+                }
+            }
+        }
+
+        [[nodiscard]] size_t GetSize() const
+        {
+            return m_size;
+        }
+
+    private:
+        struct Slot
+        {
+            alignas(ManagerType) unsigned char m_storage[sizeof(ManagerType)];
+            bool m_isOccupied{ false };
+        };
+
+        using Chunk = AZStd::array<Slot, ChunkSize>;
+
+        void AddChunk()
+        {
+            Chunk& chunk = *m_chunks.emplace_back(AZStd::make_unique<Chunk>());
+            // Slots are pushed in the reverse order, so that the managers are created starting from the chunk beginning.
+            m_freeSlots.reserve(m_freeSlots.size() + ChunkSize);
+            for (size_t slotIndex = ChunkSize; slotIndex > 0LU; --slotIndex)
+            {
+                m_freeSlots.push_back(&chunk[slotIndex - 1LU]);
+            }
+        }
+
+        AZStd::vector<AZStd::unique_ptr<Chunk>> m_chunks;
+        AZStd::vector<Slot*> m_freeSlots;
+        size_t m_size{ 0LU };
+    };
+} // namespace RGL
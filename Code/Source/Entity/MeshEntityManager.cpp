@@ -15,12 +15,13 @@
 #include <AzCore/Component/TransformBus.h>
 #include <Entity/MeshEntityManager.h>
 #include <Mesh/MeshLibraryBus.h>
+#include <Scene/SceneCommandBufferBus.h>
 #include <Utilities/RGLUtils.h>
 
 namespace RGL
 {
-    MeshEntityManager::MeshEntityManager(AZ::EntityId entityId)
-        : EntityManager{ entityId }
+    MeshEntityManager::MeshEntityManager(AZ::EntityId entityId, int32_t rglEntityId, DynamicEntityList& dynamicEntities)
+        : EntityManager{ entityId, rglEntityId, dynamicEntities }
     {
         AZ::Render::MeshComponentNotificationBus::Handler::BusConnect(entityId);
     }
@@ -48,20 +49,37 @@ namespace RGL
             return;
         }
 
+        // The farthest corner of the model bounds determines the bounding sphere used to track the scene changes around the entity.
+        const AZ::Aabb& modelBounds = modelAsset->GetAabb();
+        const float boundingRadius = modelBounds.GetMin().GetAbs().GetMax(modelBounds.GetMax().GetAbs()).GetLength();
+
+        auto* commandBuffer = SceneCommandBufferInterface::Get();
         m_entities.reserve(meshes.size());
+        m_entityMeshes.reserve(meshes.size());
         for (rgl_mesh_t mesh : meshes)
         {
             rgl_entity_t entity = nullptr;
             Utils::SafeRglEntityCreate(entity, mesh);
             if (entity)
             {
+                commandBuffer->SetEntityBoundingRadius(entity, boundingRadius);
                 m_entities.emplace_back(entity);
+                m_entityMeshes.emplace_back(mesh);
             }
         }
 
         if (!m_entities.empty())
         {
-            UpdatePose();
+            InitializeEntities();
+        }
+    }
+
+    void MeshEntityManager::EnableTextureCoords()
+    {
+        auto* meshLibrary = MeshLibraryInterface::Get();
+        for (rgl_mesh_t mesh : m_entityMeshes)
+        {
+            meshLibrary->EnableTextureCoords(mesh);
         }
     }
 } // namespace RGL
\ No newline at end of file
@@ -25,7 +25,7 @@ namespace RGL
         , protected AZ::Render::MeshComponentNotificationBus::Handler
     {
     public:
-        MeshEntityManager(AZ::EntityId entityId);
+        MeshEntityManager(AZ::EntityId entityId, int32_t rglEntityId, DynamicEntityList& dynamicEntities);
         MeshEntityManager(const MeshEntityManager& other) = default;
         MeshEntityManager(MeshEntityManager&& other);
         ~MeshEntityManager() override;
@@ -35,5 +35,8 @@ namespace RGL
         void OnModelReady(
             const AZ::Data::Asset<AZ::RPI::ModelAsset>& modelAsset,
             [[maybe_unused]] const AZ::Data::Instance<AZ::RPI::Model>& model) override;
+
+        // EntityManager overrides
+        void EnableTextureCoords() override;
     };
 } // namespace RGL
\ No newline at end of file
@@ -0,0 +1,61 @@
+/* Copyright 2020-2021, Robotec.ai sp. z o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <AzCore/Serialization/EditContext.h>
+#include <AzCore/Serialization/SerializeContext.h>
+#include <Entity/ReflectivityComponent.h>
+
+namespace RGL
+{
+    void ReflectivityComponent::Reflect(AZ::ReflectContext* context)
+    {
+        if (auto* serializeContext = azrtti_cast<AZ::SerializeContext*>(context))
+        {
+            serializeContext->Class<ReflectivityComponent, AZ::Component>()->Version(0)->Field(
+                "Reflectivity", &ReflectivityComponent::m_reflectivity);
+
+            if (auto* editContext = serializeContext->GetEditContext())
+            {
+                // clang-format off
+                editContext->Class<ReflectivityComponent>("RGL Reflectivity", "Lidar reflectivity of this entity.")
+                    ->ClassElement(AZ::Edit::ClassElements::EditorData, "")
+                        ->Attribute(AZ::Edit::Attributes::Category, "RGL")
+                        ->Attribute(AZ::Edit::Attributes::AppearsInAddComponentMenu, AZ_CRC_CE("Game"))
+                    ->DataElement(
+                        AZ::Edit::UIHandlers::Slider,
+                        &ReflectivityComponent::m_reflectivity,
+                        "Reflectivity",
+                        "Intensity reported for the hits on the entity (0-255). The entities without this component report 0.")
+                        ->Attribute(AZ::Edit::Attributes::Min, 0)
+                        ->Attribute(AZ::Edit::Attributes::Max, 255);
+                // clang-format on
+            }
+        }
+    }
+
+    void ReflectivityComponent::Activate()
+    {
+        ReflectivityRequestBus::Handler::BusConnect(GetEntityId());
+    }
+
+    void ReflectivityComponent::Deactivate()
+    {
+        ReflectivityRequestBus::Handler::BusDisconnect();
+    }
+
+    AZ::u8 ReflectivityComponent::GetReflectivity() const
+    {
+        return m_reflectivity;
+    }
+} // namespace RGL
@@ -0,0 +1,47 @@
+/* Copyright 2020-2021, Robotec.ai sp. z o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <AzCore/Component/Component.h>
+#include <RGL/ReflectivityBus.h>
+
+namespace RGL
+{
+    //! Component setting the lidar reflectivity of its entity. The reflectivity is applied when the RGL entities
+    //! of the entity are created and reported by RGL as the intensity of the hits, without any host-side processing.
+    class ReflectivityComponent
+        : public AZ::Component
+        , protected ReflectivityRequestBus::Handler
+    {
+    public:
+        AZ_COMPONENT(ReflectivityComponent, "{a2d7c5e1-3f84-4b96-8e0d-6c19f4b2a753}", AZ::Component);
+
+        ReflectivityComponent() = default;
+        ~ReflectivityComponent() override = default;
+
+        static void Reflect(AZ::ReflectContext* context);
+
+        // AZ::Component overrides
+        void Activate() override;
+        void Deactivate() override;
+
+    protected:
+        // ReflectivityRequestBus overrides
+        AZ::u8 GetReflectivity() const override;
+
+    private:
+        AZ::u8 m_reflectivity{ 100U };
+    };
+} // namespace RGL
@@ -0,0 +1,60 @@
+/* Copyright 2020-2021, Robotec.ai sp. z o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <AzCore/Serialization/EditContext.h>
+#include <AzCore/Serialization/SerializeContext.h>
+#include <Entity/SemanticClassComponent.h>
+
+namespace RGL
+{
+    void SemanticClassComponent::Reflect(AZ::ReflectContext* context)
+    {
+        if (auto* serializeContext = azrtti_cast<AZ::SerializeContext*>(context))
+        {
+            serializeContext->Class<SemanticClassComponent, AZ::Component>()->Version(0)->Field(
+                "ClassId", &SemanticClassComponent::m_classId);
+
+            if (auto* editContext = serializeContext->GetEditContext())
+            {
+                // clang-format off
+                editContext->Class<SemanticClassComponent>("RGL Semantic Class", "Semantic class of the lidar points hitting this entity.")
+                    ->ClassElement(AZ::Edit::ClassElements::EditorData, "")
+                        ->Attribute(AZ::Edit::Attributes::Category, "RGL")
+                        ->Attribute(AZ::Edit::Attributes::AppearsInAddComponentMenu, AZ_CRC_CE("Game"))
+                    ->DataElement(
+                        AZ::Edit::UIHandlers::Default,
+                        &SemanticClassComponent::m_classId,
+                        "Class Id",
+                        "Semantic class of the entity. The class 0 is reserved for the unlabeled entities.")
+                        ->Attribute(AZ::Edit::Attributes::Min, 0);
+                // clang-format on
+            }
+        }
+    }
+
+    void SemanticClassComponent::Activate()
+    {
+        SemanticClassRequestBus::Handler::BusConnect(GetEntityId());
+    }
+
+    void SemanticClassComponent::Deactivate()
+    {
+        SemanticClassRequestBus::Handler::BusDisconnect();
+    }
+
+    int32_t SemanticClassComponent::GetSemanticClassId() const
+    {
+        return m_classId;
+    }
+} // namespace RGL
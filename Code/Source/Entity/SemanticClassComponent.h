@@ -0,0 +1,46 @@
+/* Copyright 2020-2021, Robotec.ai sp. z o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <AzCore/Component/Component.h>
+#include <RGL/SemanticClassBus.h>
+
+namespace RGL
+{
+    //! Component assigning a semantic class to its entity, used to label the lidar points for segmentation datasets.
+    class SemanticClassComponent
+        : public AZ::Component
+        , protected SemanticClassRequestBus::Handler
+    {
+    public:
+        AZ_COMPONENT(SemanticClassComponent, "{4f0e2b7a-91c3-4d58-a6e4-3b8d5c17f902}", AZ::Component);
+
+        SemanticClassComponent() = default;
+        ~SemanticClassComponent() override = default;
+
+        static void Reflect(AZ::ReflectContext* context);
+
+        // AZ::Component overrides
+        void Activate() override;
+        void Deactivate() override;
+
+    protected:
+        // SemanticClassRequestBus overrides
+        int32_t GetSemanticClassId() const override;
+
+    private:
+        int32_t m_classId{ SemanticClassRequests::UnlabeledClassId };
+    };
+} // namespace RGL
@@ -16,6 +16,7 @@
 #include <AzCore/Serialization/SerializeContext.h>
 #include <AzFramework/Physics/HeightfieldProviderBus.h>
 #include <Entity/TerrainEntityManagerSystemComponent.h>
+#include <Scene/SceneCommandBufferBus.h>
 #include <Utilities/RGLUtils.h>
 
 namespace RGL
@@ -33,10 +34,12 @@ namespace RGL
     {
         UpdateWorldBounds();
         AzFramework::Terrain::TerrainDataNotificationBus::Handler::BusConnect();
+        SceneSnapshotRequestBus::Handler::BusConnect();
     }
 
     void TerrainEntityManagerSystemComponent::Deactivate()
     {
+        SceneSnapshotRequestBus::Handler::BusDisconnect();
         AzFramework::Terrain::TerrainDataNotificationBus::Handler::BusDisconnect();
     }
 
@@ -80,13 +83,13 @@ namespace RGL
     {
         if (m_rglEntity)
         {
-            RGL_CHECK(rgl_entity_destroy(m_rglEntity));
+            SceneCommandBufferInterface::Get()->DestroyEntity(m_rglEntity);
             m_rglEntity = nullptr;
         }
 
         if (m_rglMesh)
         {
-            RGL_CHECK(rgl_mesh_destroy(m_rglMesh));
+            SceneCommandBufferInterface::Get()->DestroyMesh(m_rglMesh);
             m_rglMesh = nullptr;
         }
     }
@@ -168,7 +171,7 @@ namespace RGL
             return;
         }
 
-        RGL_CHECK(rgl_entity_set_pose(m_rglEntity, &Utils::IdentityTransform));
+        SceneCommandBufferInterface::Get()->SetEntityPose(m_rglEntity, Utils::IdentityTransform);
     }
 
     void TerrainEntityManagerSystemComponent::UpdateDirtyRegion(const AZ::Aabb& dirtyRegion)
@@ -204,7 +207,7 @@ namespace RGL
             }
         }
 
-        RGL_CHECK(rgl_mesh_update_vertices(m_rglMesh, m_vertices.data(), aznumeric_cast<int32_t>(m_vertices.size())));
+        SceneCommandBufferInterface::Get()->UpdateMeshVertices(m_rglMesh, m_vertices);
     }
 
     void TerrainEntityManagerSystemComponent::OnTerrainDataChanged(const AZ::Aabb& dirtyRegion, TerrainDataChangedMask dataChangedMask)
@@ -219,4 +222,15 @@ namespace RGL
             UpdateDirtyRegion(dirtyRegion);
         }
     }
+
+    void TerrainEntityManagerSystemComponent::AppendToSnapshot(Snapshot::SceneSnapshot& snapshot)
+    {
+        if (!m_rglMesh || !m_rglEntity)
+        {
+            return;
+        }
+
+        snapshot.AddMesh(m_rglMesh, m_vertices.data(), m_vertices.size(), m_indices.data(), m_indices.size());
+        snapshot.AddEntity(m_rglMesh, Utils::IdentityTransform, Snapshot::EntityKind::Terrain);
+    }
 } // namespace RGL
@@ -17,6 +17,7 @@
 #include <AzCore/Component/Component.h>
 #include <AzFramework/Terrain/TerrainDataRequestBus.h>
 #include <AzFramework/Visibility/BoundsBus.h>
+#include <Snapshot/SceneSnapshotBus.h>
 #include <rgl/api/core.h>
 
 namespace RGL
@@ -27,6 +28,7 @@ namespace RGL
     class TerrainEntityManagerSystemComponent
         : public AZ::Component
         , private AzFramework::Terrain::TerrainDataNotificationBus::Handler
+        , private SceneSnapshotRequestBus::Handler
     {
     public:
         AZ_COMPONENT(TerrainEntityManagerSystemComponent, "{6de4556f-5621-4ec3-a587-b28988f79d8a}");
@@ -43,6 +45,9 @@ namespace RGL
         // AzFramework::Terrain::TerrainDataNotificationBus overrides
         void OnTerrainDataChanged(const AZ::Aabb& dirtyRegion, TerrainDataChangedMask dataChangedMask) override;
 
+        // SceneSnapshotRequestBus overrides
+        void AppendToSnapshot(Snapshot::SceneSnapshot& snapshot) override;
+
     protected:
         void Init() override;
         void Activate() override;
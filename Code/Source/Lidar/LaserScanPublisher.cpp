@@ -0,0 +1,132 @@
+/* Copyright 2020-2021, Robotec.ai sp. z o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <AzCore/Math/MathUtils.h>
+#include <Lidar/LaserScanPublisher.h>
+#include <ROS2/ROS2Bus.h>
+#include <rclcpp/qos.hpp>
+
+namespace RGL
+{
+    namespace
+    {
+        //! Maximum elevation (sine of the angle) and spacing error (in radians) of the rays in a planar scan.
+        constexpr float PlanarTolerance = 1e-3f;
+    } // namespace
+
+    LaserScanPublisher::LaserScanPublisher(const AZStd::string& topicName, const AZStd::string& frameId)
+        : m_topicName{ topicName }
+        , m_frameId{ frameId }
+    {
+        auto ros2Node = ROS2::ROS2Interface::Get()->GetNode();
+        m_publisher = ros2Node->create_publisher<sensor_msgs::msg::LaserScan>(topicName.c_str(), rclcpp::SensorDataQoS());
+        m_message.header.frame_id = frameId.c_str();
+    }
+
+    const AZStd::string& LaserScanPublisher::GetTopicName() const
+    {
+        return m_topicName;
+    }
+
+    const AZStd::string& LaserScanPublisher::GetFrameId() const
+    {
+        return m_frameId;
+    }
+
+    LaserScanPublisher::ScanAnglesResult LaserScanPublisher::ComputeScanAngles(
+        const AZStd::vector<rgl_mat3x4f>& rayPoses, ScanAngles& scanAngles)
+    {
+        if (rayPoses.size() < 2LU)
+        {
+            return ScanAnglesResult::TooFewRays;
+        }
+
+        // Rays are cast along the Z axis of their poses.
+        AZStd::vector<float> angles(rayPoses.size());
+        for (size_t rayIndex = 0LU; rayIndex < rayPoses.size(); ++rayIndex)
+        {
+            const rgl_mat3x4f& rayPose = rayPoses[rayIndex];
+            if (AZStd::abs(rayPose.value[2][2]) > PlanarTolerance)
+            {
+                return ScanAnglesResult::NotPlanar;
+            }
+
+            angles[rayIndex] = AZStd::atan2(rayPose.value[1][2], rayPose.value[0][2]);
+            if (rayIndex > 0LU)
+            {
+                const float step = angles[rayIndex] - angles[rayIndex - 1LU];
+                angles[rayIndex] -= AZ::Constants::TwoPi * AZStd::round(step / AZ::Constants::TwoPi);
+            }
+        }
+
+        const float angleIncrement = (angles.back() - angles.front()) / aznumeric_cast<float>(rayPoses.size() - 1LU);
+        for (size_t rayIndex = 1LU; rayIndex < angles.size(); ++rayIndex)
+        {
+            if (AZStd::abs(angles[rayIndex] - angles[rayIndex - 1LU] - angleIncrement) > PlanarTolerance)
+            {
+                return ScanAnglesResult::NotUniform;
+            }
+        }
+
+        scanAngles = { angles.front(), angles.back(), angleIncrement };
+        return ScanAnglesResult::Planar;
+    }
+
+    bool LaserScanPublisher::ConfigureScanAngles(const AZStd::vector<rgl_mat3x4f>& rayPoses)
+    {
+        m_isScanPlanar = false;
+        ScanAngles scanAngles;
+        switch (ComputeScanAngles(rayPoses, scanAngles))
+        {
+        case ScanAnglesResult::Planar:
+            break;
+        case ScanAnglesResult::TooFewRays:
+            AZ_Warning("RGL", false, "A LaserScan requires at least two rays. The scan is not published on %s.", m_topicName.c_str());
+            return false;
+        case ScanAnglesResult::NotPlanar:
+            AZ_Warning("RGL", false, "The lidar rays are not planar. The LaserScan is not published on %s.", m_topicName.c_str());
+            return false;
+        case ScanAnglesResult::NotUniform:
+            AZ_Warning(
+                "RGL", false, "The lidar rays are not uniformly spaced. The LaserScan is not published on %s.", m_topicName.c_str());
+            return false;
+        }
+
+        m_message.angle_min = scanAngles.m_angleMin;
+        m_message.angle_max = scanAngles.m_angleMax;
+        m_message.angle_increment = scanAngles.m_angleIncrement;
+        m_isScanPlanar = true;
+        return true;
+    }
+
+    bool LaserScanPublisher::IsScanPlanar() const
+    {
+        return m_isScanPlanar;
+    }
+
+    void LaserScanPublisher::Publish(const AZStd::vector<float>& distances, float minRange, float maxRange)
+    {
+        if (!m_isScanPlanar)
+        {
+            return;
+        }
+
+        m_message.header.stamp = ROS2::ROS2Interface::Get()->GetROSTimestamp();
+        m_message.range_min = minRange;
+        m_message.range_max = maxRange;
+        m_message.ranges.assign(distances.begin(), distances.end());
+
+        m_publisher->publish(m_message);
+    }
+} // namespace RGL
@@ -0,0 +1,72 @@
+/* Copyright 2020-2021, Robotec.ai sp. z o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <AzCore/std/containers/vector.h>
+#include <AzCore/std/string/string.h>
+#include <rclcpp/publisher.hpp>
+#include <rgl/api/core.h>
+#include <sensor_msgs/msg/laser_scan.hpp>
+
+namespace RGL
+{
+    //! Publishes the results of a planar lidar as LaserScan messages, filled directly from the distances yielded by the graph.
+    class LaserScanPublisher
+    {
+    public:
+        //! Angles of a planar scan, in radians around the Z axis of the lidar.
+        struct ScanAngles
+        {
+            float m_angleMin{ 0.0f };
+            float m_angleMax{ 0.0f };
+            float m_angleIncrement{ 0.0f };
+        };
+
+        enum class ScanAnglesResult
+        {
+            Planar,
+            TooFewRays,
+            NotPlanar,
+            NotUniform,
+        };
+
+        LaserScanPublisher(const AZStd::string& topicName, const AZStd::string& frameId);
+
+        //! Derives the scan angles from the ray poses. The angles are unwrapped, so that the scan may cross the -X axis.
+        //! @return Planar if the rays are uniformly spaced in the XY plane of the lidar, the reason of the rejection otherwise.
+        static ScanAnglesResult ComputeScanAngles(const AZStd::vector<rgl_mat3x4f>& rayPoses, ScanAngles& scanAngles);
+
+        [[nodiscard]] const AZStd::string& GetTopicName() const;
+        [[nodiscard]] const AZStd::string& GetFrameId() const;
+
+        //! Derives the scan angles from the ray poses. The rays have to be uniformly spaced in the XY plane of the lidar.
+        //! @return False if the rays do not form a planar scan. Such scans are not published.
+        bool ConfigureScanAngles(const AZStd::vector<rgl_mat3x4f>& rayPoses);
+        //! Returns true if the configured rays form a planar scan, i.e. the scans are published.
+        [[nodiscard]] bool IsScanPlanar() const;
+
+        //! Publishes the distances as the scan ranges, copied without any per-range conversion. The readings below
+        //! the minimum range and the rays without a return (reported by RGL with the maximum float distance) lie
+        //! outside of [range_min, range_max], so the LaserScan consumers discard them.
+        void Publish(const AZStd::vector<float>& distances, float minRange, float maxRange);
+
+    private:
+        AZStd::string m_topicName;
+        AZStd::string m_frameId;
+        bool m_isScanPlanar{ false };
+        rclcpp::Publisher<sensor_msgs::msg::LaserScan>::SharedPtr m_publisher;
+        sensor_msgs::msg::LaserScan m_message; //!< Reused between the scans to keep the capacity of the ranges.
+    };
+} // namespace RGL
@@ -0,0 +1,251 @@
+/* Copyright 2020-2021, Robotec.ai sp. z o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <AzCore/Math/MathUtils.h>
+#include <AzCore/Serialization/EditContext.h>
+#include <AzCore/Serialization/SerializeContext.h>
+#include <AzCore/std/algorithm.h>
+#include <Lidar/LidarCrop.h>
+#include <Utilities/RGLUtils.h>
+
+namespace RGL
+{
+    namespace
+    {
+        constexpr float ParallelEpsilon = 1e-9f;
+
+        //! Clips the ray parameter interval to the slab |origin + t * direction| <= halfExtent.
+        bool ClipToSlab(float origin, float direction, float halfExtent, float& enter, float& exit)
+        {
+            if (AZStd::abs(direction) < ParallelEpsilon)
+            {
+                return AZStd::abs(origin) <= halfExtent;
+            }
+
+            const float first = (-halfExtent - origin) / direction;
+            const float second = (halfExtent - origin) / direction;
+            enter = AZStd::max(enter, AZStd::min(first, second));
+            exit = AZStd::min(exit, AZStd::max(first, second));
+            return enter <= exit;
+        }
+
+        //! Computes the ray parameters at which the ray (in the volume local space) enters and exits the volume.
+        bool IntersectVolume(
+            const LidarCropVolume& volume, const AZ::Vector3& origin, const AZ::Vector3& direction, float& enter, float& exit)
+        {
+            enter = -AZStd::numeric_limits<float>::infinity();
+            exit = AZStd::numeric_limits<float>::infinity();
+
+            if (volume.m_shape == CropVolumeShape::Box)
+            {
+                const AZ::Vector3 halfExtents = volume.m_boxDimensions * 0.5f;
+                return ClipToSlab(origin.GetX(), direction.GetX(), halfExtents.GetX(), enter, exit) &&
+                    ClipToSlab(origin.GetY(), direction.GetY(), halfExtents.GetY(), enter, exit) &&
+                    ClipToSlab(origin.GetZ(), direction.GetZ(), halfExtents.GetZ(), enter, exit) && exit >= 0.0f;
+            }
+
+            // Lateral surface: |(origin + t * direction).xy| = radius
+            const float a = direction.GetX() * direction.GetX() + direction.GetY() * direction.GetY();
+            const float b = 2.0f * (origin.GetX() * direction.GetX() + origin.GetY() * direction.GetY());
+            const float radiusSquared = volume.m_cylinderRadius * volume.m_cylinderRadius;
+            const float c = origin.GetX() * origin.GetX() + origin.GetY() * origin.GetY() - radiusSquared;
+            if (a < ParallelEpsilon)
+            {
+                if (c > 0.0f)
+                {
+                    return false;
+                }
+            }
+            else
+            {
+                const float discriminant = b * b - 4.0f * a * c;
+                if (discriminant < 0.0f)
+                {
+                    return false;
+                }
+
+                const float root = AZStd::sqrt(discriminant);
+                enter = (-b - root) / (2.0f * a);
+                exit = (-b + root) / (2.0f * a);
+            }
+
+            return ClipToSlab(origin.GetZ(), direction.GetZ(), volume.m_cylinderHeight * 0.5f, enter, exit) && exit >= 0.0f;
+        }
+    } // namespace
+
+    void LidarCropVolume::Reflect(AZ::ReflectContext* context)
+    {
+        if (auto* serializeContext = azrtti_cast<AZ::SerializeContext*>(context))
+        {
+            serializeContext->Enum<CropVolumeShape>()->Value("Box", CropVolumeShape::Box)->Value("Cylinder", CropVolumeShape::Cylinder);
+            serializeContext->Enum<CropVolumeFrame>()->Value("Sensor", CropVolumeFrame::Sensor)->Value("World", CropVolumeFrame::World);
+
+            serializeContext->Class<LidarCropVolume>()
+                ->Version(0)
+                ->Field("Shape", &LidarCropVolume::m_shape)
+                ->Field("Frame", &LidarCropVolume::m_frame)
+                ->Field("Inclusive", &LidarCropVolume::m_isInclusive)
+                ->Field("Transform", &LidarCropVolume::m_transform)
+                ->Field("BoxDimensions", &LidarCropVolume::m_boxDimensions)
+                ->Field("CylinderRadius", &LidarCropVolume::m_cylinderRadius)
+                ->Field("CylinderHeight", &LidarCropVolume::m_cylinderHeight);
+
+            if (auto* editContext = serializeContext->GetEditContext())
+            {
+                // clang-format off
+                editContext->Class<LidarCropVolume>("Crop Volume", "")
+                    ->DataElement(AZ::Edit::UIHandlers::ComboBox, &LidarCropVolume::m_shape, "Shape", "")
+                        ->EnumAttribute(CropVolumeShape::Box, "Box")
+                        ->EnumAttribute(CropVolumeShape::Cylinder, "Cylinder")
+                        ->Attribute(AZ::Edit::Attributes::ChangeNotify, AZ::Edit::PropertyRefreshLevels::EntireTree)
+                    ->DataElement(
+                        AZ::Edit::UIHandlers::ComboBox,
+                        &LidarCropVolume::m_frame,
+                        "Frame",
+                        "Sensor volumes move with the lidar, while world volumes are fixed in the world.")
+                        ->EnumAttribute(CropVolumeFrame::Sensor, "Sensor")
+                        ->EnumAttribute(CropVolumeFrame::World, "World")
+                    ->DataElement(
+                        AZ::Edit::UIHandlers::Default,
+                        &LidarCropVolume::m_isInclusive,
+                        "Inclusive",
+                        "Should only the hits inside the volume be kept? Otherwise, the hits inside the volume are removed.")
+                    ->DataElement(
+                        AZ::Edit::UIHandlers::Default,
+                        &LidarCropVolume::m_transform,
+                        "Transform",
+                        "Pose of the volume center in its frame.")
+                    ->DataElement(AZ::Edit::UIHandlers::Default, &LidarCropVolume::m_boxDimensions, "Box Dimensions", "")
+                        ->Attribute(AZ::Edit::Attributes::Min, 0.0f)
+                        ->Attribute(AZ::Edit::Attributes::Visibility, &LidarCropVolume::IsBox)
+                    ->DataElement(AZ::Edit::UIHandlers::Default, &LidarCropVolume::m_cylinderRadius, "Cylinder Radius", "")
+                        ->Attribute(AZ::Edit::Attributes::Min, 0.0f)
+                        ->Attribute(AZ::Edit::Attributes::Visibility, &LidarCropVolume::IsCylinder)
+                    ->DataElement(AZ::Edit::UIHandlers::Default, &LidarCropVolume::m_cylinderHeight, "Cylinder Height", "")
+                        ->Attribute(AZ::Edit::Attributes::Min, 0.0f)
+                        ->Attribute(AZ::Edit::Attributes::Visibility, &LidarCropVolume::IsCylinder);
+                // clang-format on
+            }
+        }
+    }
+
+    bool LidarCropVolume::IsBox() const
+    {
+        return m_shape == CropVolumeShape::Box;
+    }
+
+    bool LidarCropVolume::IsCylinder() const
+    {
+        return m_shape == CropVolumeShape::Cylinder;
+    }
+
+    void LidarCrop::Configure(const AZStd::vector<LidarCropVolume>& volumes)
+    {
+        m_rayRangeVolumes.clear();
+        m_pointVolumes.clear();
+        m_hasSensorPointVolumes = false;
+        for (const LidarCropVolume& volume : volumes)
+        {
+            Volume cropVolume{ volume, AZ::Matrix3x4::CreateFromTransform(volume.m_transform).GetInverseFull() };
+            const bool isSensorVolume = volume.m_frame == CropVolumeFrame::Sensor;
+            if (isSensorVolume && !volume.m_isInclusive && ContainsLocalPoint(volume, cropVolume.m_inverseTransform.GetTranslation()))
+            {
+                m_rayRangeVolumes.push_back(AZStd::move(cropVolume));
+            }
+            else
+            {
+                m_hasSensorPointVolumes = m_hasSensorPointVolumes || isSensorVolume;
+                m_pointVolumes.push_back(AZStd::move(cropVolume));
+            }
+        }
+    }
+
+    bool LidarCrop::IsEnabled() const
+    {
+        return HasRayRanges() || IsPointFilterEnabled();
+    }
+
+    bool LidarCrop::HasRayRanges() const
+    {
+        return !m_rayRangeVolumes.empty();
+    }
+
+    bool LidarCrop::IsPointFilterEnabled() const
+    {
+        return !m_pointVolumes.empty();
+    }
+
+    const AZStd::vector<rgl_vec2f>& LidarCrop::ComputeRayRanges(const AZStd::vector<rgl_mat3x4f>& rayPoses, float maxRange)
+    {
+        m_rayRanges.resize(rayPoses.size());
+        for (size_t rayIndex = 0LU; rayIndex < rayPoses.size(); ++rayIndex)
+        {
+            // Rays are cast along the Z axis of their poses.
+            const AZ::Matrix3x4 rayPose = Utils::AzMatrix3x4FromRglMat3x4(rayPoses[rayIndex]);
+            const AZ::Vector3 rayOrigin = rayPose.GetTranslation();
+            const AZ::Vector3 rayDirection = rayPose.GetBasisZ();
+
+            float minRange = 0.0f;
+            for (const Volume& volume : m_rayRangeVolumes)
+            {
+                // The transforms preserve the ray parameter, so the intersection is expressed in distances along the ray.
+                const AZ::Vector3 localOrigin = volume.m_inverseTransform * rayOrigin;
+                const AZ::Vector3 localDirection = volume.m_inverseTransform.Multiply3x3(rayDirection);
+                float enter = 0.0f, exit = 0.0f;
+                if (IntersectVolume(volume.m_description, localOrigin, localDirection, enter, exit) && enter <= 0.0f)
+                {
+                    minRange = AZStd::max(minRange, exit); // The ray starts inside the volume and ignores the hits within it.
+                }
+            }
+
+            // The whole ray is cropped if it does not leave the volumes within the maximum range.
+            m_rayRanges[rayIndex] = { .value = { AZStd::min(minRange, maxRange), maxRange } };
+        }
+
+        return m_rayRanges;
+    }
+
+    const AZStd::vector<rgl_vec2f>& LidarCrop::GetRayRanges() const
+    {
+        return m_rayRanges;
+    }
+
+    bool LidarCrop::IsPointCropped(const AZ::Vector3& point, const AZ::Matrix3x4& inverseLidarPose) const
+    {
+        const AZ::Vector3 sensorPoint = m_hasSensorPointVolumes ? inverseLidarPose * point : point;
+        for (const Volume& volume : m_pointVolumes)
+        {
+            const bool isWorldVolume = volume.m_description.m_frame == CropVolumeFrame::World;
+            const AZ::Vector3 localPoint = volume.m_inverseTransform * (isWorldVolume ? point : sensorPoint);
+            if (ContainsLocalPoint(volume.m_description, localPoint) != volume.m_description.m_isInclusive)
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    bool LidarCrop::ContainsLocalPoint(const LidarCropVolume& volume, const AZ::Vector3& localPoint)
+    {
+        if (volume.m_shape == CropVolumeShape::Box)
+        {
+            return localPoint.GetAbs().IsLessEqualThan(volume.m_boxDimensions * 0.5f);
+        }
+
+        const float radialDistanceSquared = localPoint.GetX() * localPoint.GetX() + localPoint.GetY() * localPoint.GetY();
+        return radialDistanceSquared <= volume.m_cylinderRadius * volume.m_cylinderRadius &&
+            AZStd::abs(localPoint.GetZ()) <= volume.m_cylinderHeight * 0.5f;
+    }
+} // namespace RGL
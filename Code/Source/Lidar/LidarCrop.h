@@ -0,0 +1,109 @@
+/* Copyright 2020-2021, Robotec.ai sp. z o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <AzCore/Math/Matrix3x4.h>
+#include <AzCore/Math/Transform.h>
+#include <AzCore/RTTI/TypeInfoSimple.h>
+#include <AzCore/std/containers/vector.h>
+#include <rgl/api/core.h>
+
+namespace AZ
+{
+    class ReflectContext;
+} // namespace AZ
+
+namespace RGL
+{
+    enum class CropVolumeShape : AZ::u8
+    {
+        Box = 0, //!< Box centered on the volume origin.
+        Cylinder, //!< Cylinder centered on the volume origin, with its axis along the volume Z axis.
+    };
+
+    enum class CropVolumeFrame : AZ::u8
+    {
+        Sensor = 0, //!< The volume moves with the lidar.
+        World, //!< The volume is fixed in the world.
+    };
+
+    //! Volume limiting the space in which the lidar reports hits.
+    struct LidarCropVolume
+    {
+        AZ_TYPE_INFO(LidarCropVolume, "{3a3cf6d5-0d2b-4b8e-a1c4-5e6a9f5b7d20}");
+        static void Reflect(AZ::ReflectContext* context);
+
+        [[nodiscard]] bool IsBox() const;
+        [[nodiscard]] bool IsCylinder() const;
+
+        CropVolumeShape m_shape{ CropVolumeShape::Box };
+        CropVolumeFrame m_frame{ CropVolumeFrame::Sensor };
+        //! If set to true, only the hits inside the volume are kept. Otherwise, the hits inside the volume are removed.
+        bool m_isInclusive{ false };
+        AZ::Transform m_transform{ AZ::Transform::CreateIdentity() }; //!< Pose of the volume center in the volume frame.
+        AZ::Vector3 m_boxDimensions{ 1.0f };
+        float m_cylinderRadius{ 0.5f };
+        float m_cylinderHeight{ 1.0f };
+    };
+
+    //! Crops the lidar results to the crop volumes. Exclusive sensor frame volumes enclosing the lidar (e.g. the robot's
+    //! own body) are applied by the ray ranges node: each ray starts at the boundary of the volume, so the hits within it
+    //! never leave the graph. The rays of a convex volume enclosing their origin do not enter it again, so these ranges are exact.
+    //! All the other volumes are applied to the hit points after the trace, since clipping the rays to them would skip
+    //! occluders in front of an inclusive volume or the hits behind an exclusive one.
+    //! Inclusive volumes intersect, i.e. a hit is kept when it lies within all the inclusive volumes.
+    class LidarCrop
+    {
+    public:
+        void Configure(const AZStd::vector<LidarCropVolume>& volumes);
+        [[nodiscard]] bool IsEnabled() const;
+        //! Returns true if any of the volumes is applied by the ray ranges.
+        [[nodiscard]] bool HasRayRanges() const;
+        //! Returns true if any of the volumes is applied to the hit points after the trace.
+        [[nodiscard]] bool IsPointFilterEnabled() const;
+
+        //! Computes the range of each ray, limited by the maximum range and starting outside of the volumes enclosing the lidar.
+        //! The ranges do not depend on the lidar pose, so they are recomputed only when the rays or the maximum range change.
+        [[nodiscard]] const AZStd::vector<rgl_vec2f>& ComputeRayRanges(const AZStd::vector<rgl_mat3x4f>& rayPoses, float maxRange);
+        //! Returns the ranges of the last ComputeRayRanges call.
+        [[nodiscard]] const AZStd::vector<rgl_vec2f>& GetRayRanges() const;
+
+        //! Checks whether the hit point is removed by the volumes applied after the trace.
+        //! @param point Hit point in the world frame.
+        //! @param inverseLidarPose Transform from the world frame to the sensor frame.
+        [[nodiscard]] bool IsPointCropped(const AZ::Vector3& point, const AZ::Matrix3x4& inverseLidarPose) const;
+
+    private:
+        struct Volume
+        {
+            LidarCropVolume m_description;
+            AZ::Matrix3x4 m_inverseTransform; //!< Transform from the volume frame to the volume local space.
+        };
+
+        //! Checks whether the point, expressed in the volume local space, lies within the volume.
+        [[nodiscard]] static bool ContainsLocalPoint(const LidarCropVolume& volume, const AZ::Vector3& localPoint);
+
+        AZStd::vector<Volume> m_rayRangeVolumes; //!< Exclusive sensor frame volumes enclosing the lidar.
+        AZStd::vector<Volume> m_pointVolumes; //!< Volumes applied to the hit points.
+        bool m_hasSensorPointVolumes{ false };
+        AZStd::vector<rgl_vec2f> m_rayRanges;
+    };
+} // namespace RGL
+
+namespace AZ
+{
+    AZ_TYPE_INFO_SPECIALIZE(RGL::CropVolumeShape, "{9a0f1b0e-6a4f-4a8f-b9a5-2c1c8d7e3f41}");
+    AZ_TYPE_INFO_SPECIALIZE(RGL::CropVolumeFrame, "{c6e3d2a1-8b7f-4e55-9d2c-71f0a4b6e812}");
+} // namespace AZ
@@ -0,0 +1,177 @@
+/* Copyright 2020-2021, Robotec.ai sp. z o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <AzCore/Component/TransformBus.h>
+#include <AzCore/Math/MathUtils.h>
+#include <AzCore/std/algorithm.h>
+#include <Lidar/LidarGroup.h>
+#include <ROS2/ROS2Bus.h>
+#include <Scene/SceneCommandBufferBus.h>
+#include <Scene/SceneVisibilityBus.h>
+
+namespace RGL
+{
+    LidarGroup::LidarGroup(AZ::EntityId groupEntityId, const LidarGroupConfiguration& configuration, PipelineGraphPool& graphPool)
+        : m_groupEntityId{ groupEntityId }
+        , m_configuration{ configuration }
+        , m_graphPool{ &graphPool }
+    {
+        PipelineGraphPool::PooledGraph pooledGraph = m_graphPool->Acquire();
+        m_graph = AZStd::move(pooledGraph.m_graph);
+        m_rglRaycastResults = AZStd::move(pooledGraph.m_rglResults);
+        m_raycastResults = AZStd::move(pooledGraph.m_results);
+
+        // The merged points are only published, so they are always compacted.
+        m_graph->ConfigurePcPublisherNode(m_configuration.m_topicName, m_configuration.m_frameId, ROS2::QoS());
+        m_graph->SetIsPcPublishingEnabled(true);
+    }
+
+    LidarGroup::LidarGroup(LidarGroup&& other)
+        : m_groupEntityId{ other.m_groupEntityId }
+        , m_configuration{ AZStd::move(other.m_configuration) }
+        , m_graphPool{ other.m_graphPool }
+        , m_timeSinceScan{ other.m_timeSinceScan }
+        , m_memberRays{ AZStd::move(other.m_memberRays) }
+        , m_excludedEntities{ AZStd::move(other.m_excludedEntities) }
+        , m_rglRaycastResults{ AZStd::move(other.m_rglRaycastResults) }
+        , m_raycastResults{ AZStd::move(other.m_raycastResults) }
+        , m_graph{ AZStd::move(other.m_graph) }
+    {
+    }
+
+    LidarGroup::~LidarGroup()
+    {
+        if (m_graph)
+        {
+            m_graphPool->Release({ AZStd::move(m_graph), AZStd::move(m_rglRaycastResults), AZStd::move(m_raycastResults) });
+        }
+    }
+
+    bool LidarGroup::HasMember(AZ::EntityId lidarEntityId) const
+    {
+        return AZStd::find(m_configuration.m_memberEntities.begin(), m_configuration.m_memberEntities.end(), lidarEntityId) !=
+            m_configuration.m_memberEntities.end();
+    }
+
+    void LidarGroup::Update(float deltaTime, const AZStd::unordered_map<ROS2::LidarId, LidarRaycaster>& lidars)
+    {
+        const float scanPeriod = 1.0f / AZStd::max(m_configuration.m_frequency, 0.1f);
+        m_timeSinceScan += deltaTime;
+        if (m_timeSinceScan < scanPeriod)
+        {
+            return;
+        }
+
+        // Late scans are not caught up with, so a slow frame results in a single scan.
+        m_timeSinceScan = AZStd::fmod(m_timeSinceScan, scanPeriod);
+        Run(lidars);
+    }
+
+    void LidarGroup::Run(const AZStd::unordered_map<ROS2::LidarId, LidarRaycaster>& lidars)
+    {
+        AZ::Transform groupTransform = AZ::Transform::CreateIdentity();
+        AZ::TransformBus::EventResult(groupTransform, m_groupEntityId, &AZ::TransformBus::Events::GetWorldTM);
+        const AZ::Transform inverseGroupTransform = groupTransform.GetInverse();
+
+        // The members are combined in the configured order, so the layout of the merged point cloud is stable.
+        AZStd::vector<MemberRays> memberRays;
+        m_excludedEntities.clear();
+        for (const AZ::EntityId& memberEntityId : m_configuration.m_memberEntities)
+        {
+            for (const auto& [lidarId, lidar] : lidars)
+            {
+                if (lidar.GetLidarEntityId() != memberEntityId || !lidar.GetRayPattern())
+                {
+                    continue;
+                }
+
+                const AZ::Matrix3x4 memberPose =
+                    AZ::Matrix3x4::CreateFromTransform(inverseGroupTransform * lidar.GetCurrentLidarTransform());
+                memberRays.push_back({ lidar.GetRayPattern(), memberPose, lidar.GetMaxRange() });
+                const AZStd::vector<AZ::EntityId>& excludedEntities = lidar.GetExcludedEntities();
+                m_excludedEntities.insert(m_excludedEntities.end(), excludedEntities.begin(), excludedEntities.end());
+            }
+        }
+
+        if (!UpdateRayBatch(AZStd::move(memberRays)))
+        {
+            return;
+        }
+
+        // A single transform places the batch in the world and a single transform brings the points back to the group frame.
+        m_graph->ConfigureLidarTransformNode(AZ::Matrix3x4::CreateFromTransform(groupTransform));
+        m_graph->ConfigurePcTransformNode(AZ::Matrix3x4::CreateFromTransform(inverseGroupTransform));
+
+        const builtin_interfaces::msg::Time timestamp = ROS2::ROS2Interface::Get()->GetROSTimestamp();
+        RGL_CHECK(rgl_scene_set_time(nullptr, aznumeric_cast<AZ::u64>(timestamp.sec) * 1'000'000'000LU + timestamp.nanosec));
+
+        SceneVisibilityInterface::Get()->SetHiddenEntities(m_excludedEntities);
+        SceneCommandBufferInterface::Get()->Flush();
+        m_graph->Run();
+    }
+
+    void LidarGroup::BuildRayBatch(const AZStd::vector<MemberRays>& memberRays, RayBatch& rayBatch)
+    {
+        int32_t firstRingId = 0;
+        for (const MemberRays& member : memberRays)
+        {
+            const RayPattern& rayPattern = *member.m_rayPattern;
+            int32_t ringCount = 0;
+            for (size_t rayIndex = 0LU; rayIndex < rayPattern.m_rayPoses.size(); ++rayIndex)
+            {
+                rayBatch.m_rayPoses.push_back(
+                    Utils::RglMat3x4FromAzMatrix3x4(member.m_pose * Utils::AzMatrix3x4FromRglMat3x4(rayPattern.m_rayPoses[rayIndex])));
+                // The graph-side minimum range is zero, as for the individual lidars.
+                rayBatch.m_rayRanges.push_back({ .value = { 0.0f, member.m_maxRange } });
+
+                const int32_t ringId = rayPattern.m_ringIds.empty() ? 0 : rayPattern.m_ringIds[rayIndex % rayPattern.m_ringIds.size()];
+                rayBatch.m_ringIds.push_back(firstRingId + ringId);
+                ringCount = AZStd::max(ringCount, ringId + 1);
+            }
+            firstRingId += ringCount;
+        }
+    }
+
+    bool LidarGroup::UpdateRayBatch(AZStd::vector<MemberRays>&& memberRays)
+    {
+        const bool isBatchUpToDate = memberRays.size() == m_memberRays.size() &&
+            AZStd::equal(
+                memberRays.begin(),
+                memberRays.end(),
+                m_memberRays.begin(),
+                [](const MemberRays& lhs, const MemberRays& rhs)
+                {
+                    return lhs.m_rayPattern == rhs.m_rayPattern && lhs.m_maxRange == rhs.m_maxRange &&
+                        lhs.m_pose.IsClose(rhs.m_pose, ReusedPoseTolerance);
+                });
+        if (isBatchUpToDate)
+        {
+            return !m_memberRays.empty();
+        }
+
+        m_memberRays = AZStd::move(memberRays);
+        if (m_memberRays.empty())
+        {
+            return false;
+        }
+
+        RayBatch rayBatch;
+        BuildRayBatch(m_memberRays, rayBatch);
+
+        m_graph->ConfigureRayPosesNode(rayBatch.m_rayPoses);
+        m_graph->ConfigureRayRingIdsNode(rayBatch.m_ringIds);
+        m_graph->ConfigureRayRangesNode(rayBatch.m_rayRanges);
+        return true;
+    }
+} // namespace RGL
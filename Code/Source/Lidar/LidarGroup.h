@@ -0,0 +1,81 @@
+/* Copyright 2020-2021, Robotec.ai sp. z o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <AzCore/std/containers/unordered_map.h>
+#include <Lidar/LidarGroupBus.h>
+#include <Lidar/LidarRaycaster.h>
+#include <Lidar/PipelineGraphPool.h>
+
+namespace RGL
+{
+    //! Group of lidars traced together in a single run of a dedicated graph. The rays of the members are transformed to
+    //! the group frame and combined into one ray batch, and the merged points are published once in the group frame.
+    class LidarGroup
+    {
+    public:
+        //! Part of the ray batch contributed by a single member.
+        struct MemberRays
+        {
+            AZStd::shared_ptr<const RayPattern> m_rayPattern;
+            AZ::Matrix3x4 m_pose; //!< Pose of the member lidar in the group frame.
+            float m_maxRange;
+        };
+
+        //! Combined rays of all the members, in the group frame.
+        struct RayBatch
+        {
+            AZStd::vector<rgl_mat3x4f> m_rayPoses;
+            AZStd::vector<rgl_vec2f> m_rayRanges;
+            AZStd::vector<int32_t> m_ringIds;
+        };
+
+        LidarGroup(AZ::EntityId groupEntityId, const LidarGroupConfiguration& configuration, PipelineGraphPool& graphPool);
+        LidarGroup(LidarGroup&& other);
+        LidarGroup(const LidarGroup& other) = delete;
+        ~LidarGroup();
+
+        [[nodiscard]] bool HasMember(AZ::EntityId lidarEntityId) const;
+
+        //! Advances the group clock and traces the rays of all the members once a scan is due.
+        void Update(float deltaTime, const AZStd::unordered_map<ROS2::LidarId, LidarRaycaster>& lidars);
+
+        //! Combines the rays of the members. The rings of consecutive members are numbered one after another, so that
+        //! the merged rings remain distinct.
+        static void BuildRayBatch(const AZStd::vector<MemberRays>& memberRays, RayBatch& rayBatch);
+
+    private:
+        //! Traces and publishes the merged scan.
+        void Run(const AZStd::unordered_map<ROS2::LidarId, LidarRaycaster>& lidars);
+        //! Uploads the combined rays of the members, unless neither their patterns nor their poses changed.
+        //! @return False if none of the members has its rays configured.
+        bool UpdateRayBatch(AZStd::vector<MemberRays>&& memberRays);
+
+        //! Maximum difference of the member pose elements for which the uploaded ray batch is reused.
+        static constexpr float ReusedPoseTolerance = 1e-6f;
+
+        AZ::EntityId m_groupEntityId;
+        LidarGroupConfiguration m_configuration;
+        PipelineGraphPool* m_graphPool;
+        float m_timeSinceScan{ 0.0f };
+
+        AZStd::vector<MemberRays> m_memberRays; //!< Members contributing to the uploaded ray batch.
+        AZStd::vector<AZ::EntityId> m_excludedEntities; //!< Entities excluded by any of the members.
+
+        PipelineGraph::RaycastResults m_rglRaycastResults;
+        ROS2::RaycastResult m_raycastResults;
+        AZStd::unique_ptr<PipelineGraph> m_graph;
+    };
+} // namespace RGL
@@ -0,0 +1,61 @@
+/* Copyright 2020-2021, Robotec.ai sp. z o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <AzCore/Component/EntityId.h>
+#include <AzCore/Interface/Interface.h>
+#include <AzCore/RTTI/RTTI.h>
+#include <AzCore/std/containers/vector.h>
+#include <AzCore/std/string/string.h>
+
+namespace AZ
+{
+    class ReflectContext;
+}
+
+namespace RGL
+{
+    //! Structure describing a group of lidars whose points are merged into a single point cloud.
+    struct LidarGroupConfiguration
+    {
+        AZ_TYPE_INFO(LidarGroupConfiguration, "{9e906371-fa8b-4308-9618-8cce94dd34bc}");
+        static void Reflect(AZ::ReflectContext* context);
+
+        AZStd::vector<AZ::EntityId> m_memberEntities; //!< Entities of the member lidars.
+        AZStd::string m_topicName{ "merged_pc" }; //!< Topic of the merged point cloud.
+        AZStd::string m_frameId{ "base_link" }; //!< Frame of the merged point cloud, i.e. the frame of the group entity.
+        float m_frequency{ 10.0f }; //!< Frequency of the merged scans in Hz.
+    };
+
+    //! Interface used to register the lidar groups with the lidar system.
+    class LidarGroupRequests
+    {
+    public:
+        AZ_RTTI(LidarGroupRequests, "{75b27784-b3d4-4114-874b-6e81ce4b7787}");
+
+        //! Registers the group or replaces its configuration. The member lidars stop tracing and publishing on their own.
+        //! @param groupEntityId Entity defining the frame of the merged point cloud.
+        //! @param configuration Configuration of the group.
+        virtual void RegisterLidarGroup(AZ::EntityId groupEntityId, const LidarGroupConfiguration& configuration) = 0;
+
+        //! Unregisters the group. The member lidars return to tracing on their own.
+        virtual void UnregisterLidarGroup(AZ::EntityId groupEntityId) = 0;
+
+    protected:
+        ~LidarGroupRequests() = default;
+    };
+
+    using LidarGroupInterface = AZ::Interface<LidarGroupRequests>;
+} // namespace RGL
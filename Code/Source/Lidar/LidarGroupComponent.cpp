@@ -0,0 +1,99 @@
+/* Copyright 2020-2021, Robotec.ai sp. z o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <AzCore/Serialization/EditContext.h>
+#include <AzCore/Serialization/SerializeContext.h>
+#include <Lidar/LidarGroupComponent.h>
+
+namespace RGL
+{
+    void LidarGroupConfiguration::Reflect(AZ::ReflectContext* context)
+    {
+        if (auto* serializeContext = azrtti_cast<AZ::SerializeContext*>(context))
+        {
+            serializeContext->Class<LidarGroupConfiguration>()
+                ->Version(0)
+                ->Field("MemberEntities", &LidarGroupConfiguration::m_memberEntities)
+                ->Field("TopicName", &LidarGroupConfiguration::m_topicName)
+                ->Field("FrameId", &LidarGroupConfiguration::m_frameId)
+                ->Field("Frequency", &LidarGroupConfiguration::m_frequency);
+
+            if (auto* editContext = serializeContext->GetEditContext())
+            {
+                // clang-format off
+                editContext->Class<LidarGroupConfiguration>("RGL Lidar Group Configuration", "")
+                    ->DataElement(
+                        AZ::Edit::UIHandlers::Default,
+                        &LidarGroupConfiguration::m_memberEntities,
+                        "Member Lidars",
+                        "Entities of the lidars merged into the group. The members stop tracing and publishing on their own.")
+                    ->DataElement(
+                        AZ::Edit::UIHandlers::Default,
+                        &LidarGroupConfiguration::m_topicName,
+                        "Topic",
+                        "Topic of the merged point cloud.")
+                    ->DataElement(
+                        AZ::Edit::UIHandlers::Default,
+                        &LidarGroupConfiguration::m_frameId,
+                        "Frame",
+                        "Frame of the merged point cloud, matching the frame of this entity.")
+                    ->DataElement(
+                        AZ::Edit::UIHandlers::Default,
+                        &LidarGroupConfiguration::m_frequency,
+                        "Frequency",
+                        "Frequency of the merged scans in Hz.")
+                        ->Attribute(AZ::Edit::Attributes::Min, 0.1f);
+                // clang-format on
+            }
+        }
+    }
+
+    void LidarGroupComponent::Reflect(AZ::ReflectContext* context)
+    {
+        LidarGroupConfiguration::Reflect(context);
+
+        if (auto* serializeContext = azrtti_cast<AZ::SerializeContext*>(context))
+        {
+            serializeContext->Class<LidarGroupComponent, AZ::Component>()->Version(0)->Field(
+                "Configuration", &LidarGroupComponent::m_configuration);
+
+            if (auto* editContext = serializeContext->GetEditContext())
+            {
+                // clang-format off
+                editContext->Class<LidarGroupComponent>("RGL Lidar Group", "Merges the points of several RGL lidars into one point cloud.")
+                    ->ClassElement(AZ::Edit::ClassElements::EditorData, "")
+                        ->Attribute(AZ::Edit::Attributes::Category, "RGL")
+                        ->Attribute(AZ::Edit::Attributes::AppearsInAddComponentMenu, AZ_CRC_CE("Game"))
+                    ->DataElement(AZ::Edit::UIHandlers::Default, &LidarGroupComponent::m_configuration, "Configuration", "");
+                // clang-format on
+            }
+        }
+    }
+
+    void LidarGroupComponent::Activate()
+    {
+        if (auto* lidarGroups = LidarGroupInterface::Get())
+        {
+            lidarGroups->RegisterLidarGroup(GetEntityId(), m_configuration);
+        }
+    }
+
+    void LidarGroupComponent::Deactivate()
+    {
+        if (auto* lidarGroups = LidarGroupInterface::Get())
+        {
+            lidarGroups->UnregisterLidarGroup(GetEntityId());
+        }
+    }
+} // namespace RGL
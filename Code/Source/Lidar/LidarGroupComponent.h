@@ -0,0 +1,41 @@
+/* Copyright 2020-2021, Robotec.ai sp. z o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <AzCore/Component/Component.h>
+#include <Lidar/LidarGroupBus.h>
+
+namespace RGL
+{
+    //! Component merging the points of the listed lidars into a single point cloud in the frame of its entity.
+    //! The rays of all the members are traced in one graph run and published once (see LidarGroup).
+    class LidarGroupComponent : public AZ::Component
+    {
+    public:
+        AZ_COMPONENT(LidarGroupComponent, "{6c3ab284-326c-4d1c-a27f-ada4f8d78a9d}", AZ::Component);
+
+        LidarGroupComponent() = default;
+        ~LidarGroupComponent() override = default;
+
+        static void Reflect(AZ::ReflectContext* context);
+
+        // AZ::Component overrides
+        void Activate() override;
+        void Deactivate() override;
+
+    private:
+        LidarGroupConfiguration m_configuration;
+    };
+} // namespace RGL
@@ -0,0 +1,193 @@
+/* Copyright 2020-2021, Robotec.ai sp. z o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <AzCore/std/containers/array.h>
+#include <Lidar/LidarMultiReturn.h>
+#include <RGL/PointDecoding.h>
+#include <Utilities/RGLUtils.h>
+
+namespace RGL
+{
+    void LidarMultiReturn::Configure(LidarReturnMode mode, float beamDivergence)
+    {
+        m_mode = mode;
+        m_beamDivergence = beamDivergence;
+        m_hasSecondaryReturn.clear();
+        m_secondaryPoints.clear();
+    }
+
+    bool LidarMultiReturn::IsEnabled() const
+    {
+        return m_mode != LidarReturnMode::Single;
+    }
+
+    LidarReturnMode LidarMultiReturn::GetMode() const
+    {
+        return m_mode;
+    }
+
+    namespace
+    {
+        rgl_vec3f ComputeSubRayPoint(const rgl_mat3x4f& subRayPose, float distance, const AZ::Matrix3x4& lidarPose)
+        {
+            float point[3];
+            PointDecoding::DecodePoint(subRayPose.value, distance, point);
+            return Utils::RglVector3FromAzVec3f(lidarPose * AZ::Vector3(point[0], point[1], point[2]));
+        }
+    } // namespace
+
+    const AZStd::vector<rgl_mat3x4f>& LidarMultiReturn::ExpandRayPoses(const AZStd::vector<rgl_mat3x4f>& rayPoses)
+    {
+        // The rays are cast along the Z axis, so the sub-rays are tilted around the X and Y axes of their ray.
+        const float halfDivergence = 0.5f * m_beamDivergence;
+        const AZStd::array<AZ::Matrix3x4, SubRayCount> subRayTilts{
+            AZ::Matrix3x4::CreateIdentity(),
+            AZ::Matrix3x4::CreateRotationX(halfDivergence),
+            AZ::Matrix3x4::CreateRotationX(-halfDivergence),
+            AZ::Matrix3x4::CreateRotationY(halfDivergence),
+            AZ::Matrix3x4::CreateRotationY(-halfDivergence),
+        };
+
+        m_subRayPoses.clear();
+        m_subRayPoses.reserve(rayPoses.size() * SubRayCount);
+        for (const rgl_mat3x4f& rayPose : rayPoses)
+        {
+            const AZ::Matrix3x4 azRayPose = Utils::AzMatrix3x4FromRglMat3x4(rayPose);
+            for (const AZ::Matrix3x4& subRayTilt : subRayTilts)
+            {
+                m_subRayPoses.push_back(Utils::RglMat3x4FromAzMatrix3x4(azRayPose * subRayTilt));
+            }
+        }
+
+        return m_subRayPoses;
+    }
+
+    const AZStd::vector<rgl_mat3x4f>& LidarMultiReturn::GetSubRayPoses() const
+    {
+        return m_subRayPoses;
+    }
+
+    void LidarMultiReturn::ReduceResults(PipelineGraph::RaycastResults& results, const AZ::Matrix3x4& lidarPose, bool arePointsRequired)
+    {
+        const size_t rayCount = results.m_distance.size() / SubRayCount;
+        const bool hasPoints = !results.m_xyz.empty();
+        const bool computePoints = !hasPoints && arePointsRequired && m_subRayPoses.size() == results.m_distance.size();
+        const bool hasEntityIds = !results.m_entityId.empty();
+        const bool hasIntensities = !results.m_intensity.empty();
+        const bool isDual = m_mode == LidarReturnMode::Dual;
+        m_hasSecondaryReturn.assign(isDual ? rayCount : 0LU, false);
+        m_secondaryPoints.resize(isDual && (hasPoints || computePoints) ? rayCount : 0LU);
+        if (computePoints)
+        {
+            results.m_xyz.resize(rayCount);
+        }
+
+        // Each ray is written over the results of its first sub-ray at the latest, so the reduction is done in place.
+        for (size_t rayIndex = 0LU; rayIndex < rayCount; ++rayIndex)
+        {
+            const size_t firstSubRay = rayIndex * SubRayCount;
+            // The central sub-ray represents the rays without any hit.
+            size_t nearestSubRay = firstSubRay;
+            size_t farthestSubRay = firstSubRay;
+            bool isHit = false;
+            for (size_t subRay = firstSubRay; subRay < firstSubRay + SubRayCount; ++subRay)
+            {
+                if (!aznumeric_cast<bool>(results.m_isHit[subRay]))
+                {
+                    continue;
+                }
+
+                if (!isHit || results.m_distance[subRay] < results.m_distance[nearestSubRay])
+                {
+                    nearestSubRay = subRay;
+                }
+                if (!isHit || results.m_distance[subRay] > results.m_distance[farthestSubRay])
+                {
+                    farthestSubRay = subRay;
+                }
+                isHit = true;
+            }
+
+            if (isDual && isHit && results.m_distance[farthestSubRay] - results.m_distance[nearestSubRay] >= MinReturnSeparation)
+            {
+                m_hasSecondaryReturn[rayIndex] = true;
+                if (hasPoints)
+                {
+                    m_secondaryPoints[rayIndex] = results.m_xyz[farthestSubRay];
+                }
+                else if (computePoints)
+                {
+                    m_secondaryPoints[rayIndex] =
+                        ComputeSubRayPoint(m_subRayPoses[farthestSubRay], results.m_distance[farthestSubRay], lidarPose);
+                }
+            }
+
+            const size_t primarySubRay = m_mode == LidarReturnMode::Last ? farthestSubRay : nearestSubRay;
+            results.m_isHit[rayIndex] = results.m_isHit[primarySubRay];
+            results.m_distance[rayIndex] = results.m_distance[primarySubRay];
+            if (hasPoints)
+            {
+                results.m_xyz[rayIndex] = results.m_xyz[primarySubRay];
+            }
+            else if (computePoints)
+            {
+                // Rays without any hit report a zero point, as the graph does.
+                results.m_xyz[rayIndex] = aznumeric_cast<bool>(results.m_isHit[rayIndex])
+                    ? ComputeSubRayPoint(m_subRayPoses[primarySubRay], results.m_distance[rayIndex], lidarPose)
+                    : rgl_vec3f{};
+            }
+            if (hasEntityIds)
+            {
+                results.m_entityId[rayIndex] = results.m_entityId[primarySubRay];
+            }
+            if (hasIntensities)
+            {
+                results.m_intensity[rayIndex] = results.m_intensity[primarySubRay];
+            }
+        }
+
+        results.m_isHit.resize(rayCount);
+        results.m_distance.resize(rayCount);
+        if (hasPoints)
+        {
+            results.m_xyz.resize(rayCount);
+        }
+        if (hasEntityIds)
+        {
+            results.m_entityId.resize(rayCount);
+        }
+        if (hasIntensities)
+        {
+            results.m_intensity.resize(rayCount);
+        }
+    }
+
+    bool LidarMultiReturn::HasSecondaryReturn(size_t rayIndex) const
+    {
+        return rayIndex < m_hasSecondaryReturn.size() && m_hasSecondaryReturn[rayIndex];
+    }
+
+    const rgl_vec3f& LidarMultiReturn::GetSecondaryPoint(size_t rayIndex) const
+    {
+        return m_secondaryPoints[rayIndex];
+    }
+
+    void LidarMultiReturn::DiscardSecondaryReturn(size_t rayIndex)
+    {
+        if (rayIndex < m_hasSecondaryReturn.size())
+        {
+            m_hasSecondaryReturn[rayIndex] = false;
+        }
+    }
+} // namespace RGL
@@ -0,0 +1,94 @@
+/* Copyright 2020-2021, Robotec.ai sp. z o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <AzCore/RTTI/TypeInfoSimple.h>
+#include <AzCore/std/containers/vector.h>
+#include <Lidar/PipelineGraph.h>
+#include <rgl/api/core.h>
+
+namespace RGL
+{
+    enum class LidarReturnMode : AZ::u8
+    {
+        Single = 0, //!< One ray per beam, reporting its first hit.
+        First, //!< The nearest hit within the beam footprint.
+        Last, //!< The farthest hit within the beam footprint.
+        Dual, //!< Both the nearest and the farthest hit within the beam footprint, if they are far enough apart.
+    };
+
+    //! Simulates the multiple returns of a diverging beam within a single trace. Each ray is expanded into sub-rays covering
+    //! the beam footprint, and the results of the sub-rays are reduced to the returns of the ray on the host.
+    //! The returns are selected with the hits and the distances only, so the points of the sub-rays do not have to be
+    //! copied from the graph: the points of the selected sub-rays are computed from their poses and distances instead.
+    class LidarMultiReturn
+    {
+    public:
+        //! The central sub-ray and four sub-rays on the edge of the beam footprint.
+        static constexpr size_t SubRayCount = 5LU;
+        //! Minimum distance between the first and the last return for the last one to be reported in the dual mode.
+        static constexpr float MinReturnSeparation = 0.5f;
+
+        //! @param mode Returns reported for each ray.
+        //! @param beamDivergence Full angle of the beam cone in radians.
+        void Configure(LidarReturnMode mode, float beamDivergence);
+        [[nodiscard]] bool IsEnabled() const;
+        [[nodiscard]] LidarReturnMode GetMode() const;
+
+        //! Returns the sub-rays of all the rays, ordered by their rays. The sub-ray poses are kept to compute the points.
+        [[nodiscard]] const AZStd::vector<rgl_mat3x4f>& ExpandRayPoses(const AZStd::vector<rgl_mat3x4f>& rayPoses);
+        //! Returns the sub-rays of the last ExpandRayPoses call.
+        [[nodiscard]] const AZStd::vector<rgl_mat3x4f>& GetSubRayPoses() const;
+
+        //! Repeats each value of a ray for all its sub-rays.
+        template<typename ValueType>
+        [[nodiscard]] static AZStd::vector<ValueType> ExpandRayValues(const AZStd::vector<ValueType>& rayValues)
+        {
+            AZStd::vector<ValueType> subRayValues;
+            subRayValues.reserve(rayValues.size() * SubRayCount);
+            for (const ValueType& value : rayValues)
+            {
+                subRayValues.insert(subRayValues.end(), SubRayCount, value);
+            }
+            return subRayValues;
+        }
+
+        //! Reduces the sub-ray results to the primary return of each ray, in place. The results then match the rays.
+        //! In the dual mode, the primary return is the first one and the last returns are stored separately.
+        //! The results have to contain the hits and the distances, and may contain the points.
+        //! @param lidarPose Lidar pose of the trace, used to compute the points missing from the results.
+        //! @param arePointsRequired Determines whether the points are computed when the results do not contain them.
+        void ReduceResults(PipelineGraph::RaycastResults& results, const AZ::Matrix3x4& lidarPose, bool arePointsRequired);
+
+        //! Returns whether the ray has a last return besides its primary one. Valid after ReduceResults in the dual mode.
+        [[nodiscard]] bool HasSecondaryReturn(size_t rayIndex) const;
+        [[nodiscard]] const rgl_vec3f& GetSecondaryPoint(size_t rayIndex) const;
+        //! Removes the last return of the ray, e.g. when it is cropped.
+        void DiscardSecondaryReturn(size_t rayIndex);
+
+    private:
+        LidarReturnMode m_mode{ LidarReturnMode::Single };
+        float m_beamDivergence{ 0.0f };
+        AZStd::vector<rgl_mat3x4f> m_subRayPoses;
+
+        AZStd::vector<bool> m_hasSecondaryReturn;
+        AZStd::vector<rgl_vec3f> m_secondaryPoints;
+    };
+} // namespace RGL
+
+namespace AZ
+{
+    AZ_TYPE_INFO_SPECIALIZE(RGL::LidarReturnMode, "{c37112ad-72f4-4084-8f97-eae6ebcf7e0c}");
+} // namespace AZ
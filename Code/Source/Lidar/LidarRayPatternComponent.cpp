@@ -0,0 +1,84 @@
+/* Copyright 2020-2021, Robotec.ai sp. z o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <AzCore/Serialization/EditContext.h>
+#include <AzCore/Serialization/SerializeContext.h>
+#include <Lidar/LidarRayPatternComponent.h>
+
+namespace RGL
+{
+    void LidarRayPatternComponent::Reflect(AZ::ReflectContext* context)
+    {
+        if (auto* serializeContext = azrtti_cast<AZ::SerializeContext*>(context))
+        {
+            serializeContext->Enum<RayPatternId>()
+                ->Value("None", RayPatternId::None)
+                ->Value("VelodyneVlp16", RayPatternId::VelodyneVlp16)
+                ->Value("VelodyneHdl32e", RayPatternId::VelodyneHdl32e)
+                ->Value("OusterOs1_64", RayPatternId::OusterOs1_64)
+                ->Value("OusterOs1_128", RayPatternId::OusterOs1_128)
+                ->Value("HesaiAt128", RayPatternId::HesaiAt128);
+
+            serializeContext->Class<LidarRayPatternComponent, AZ::Component>()
+                ->Version(1)
+                ->Field("RayPatternId", &LidarRayPatternComponent::m_rayPatternId)
+                ->Field("SectorScanning", &LidarRayPatternComponent::m_isSectorScanningEnabled);
+
+            if (auto* editContext = serializeContext->GetEditContext())
+            {
+                // clang-format off
+                editContext->Class<LidarRayPatternComponent>("RGL Lidar Ray Pattern", "Built-in ray pattern of the RGL lidar on this entity.")
+                    ->ClassElement(AZ::Edit::ClassElements::EditorData, "")
+                        ->Attribute(AZ::Edit::Attributes::Category, "RGL")
+                        ->Attribute(AZ::Edit::Attributes::AppearsInAddComponentMenu, AZ_CRC_CE("Game"))
+                    ->DataElement(
+                        AZ::Edit::UIHandlers::ComboBox,
+                        &LidarRayPatternComponent::m_rayPatternId,
+                        "Ray Pattern",
+                        "Replaces the ray orientations of the lidar sensor. None keeps the orientations of the sensor.")
+                        ->EnumAttribute(RayPatternId::None, "None")
+                        ->EnumAttribute(RayPatternId::VelodyneVlp16, "Velodyne VLP-16")
+                        ->EnumAttribute(RayPatternId::VelodyneHdl32e, "Velodyne HDL-32E")
+                        ->EnumAttribute(RayPatternId::OusterOs1_64, "Ouster OS1-64")
+                        ->EnumAttribute(RayPatternId::OusterOs1_128, "Ouster OS1-128")
+                        ->EnumAttribute(RayPatternId::HesaiAt128, "Hesai AT128")
+                    ->DataElement(
+                        AZ::Edit::UIHandlers::Default,
+                        &LidarRayPatternComponent::m_isSectorScanningEnabled,
+                        "Sector Scanning",
+                        "Should every tick trace only the azimuth sector swept since the previous tick? "
+                        "The sectors are accumulated into the full scan, which spreads the raycasting cost across the frames.");
+                // clang-format on
+            }
+        }
+    }
+
+    RayPatternId LidarRayPatternComponent::GetRayPatternId() const
+    {
+        return m_rayPatternId;
+    }
+
+    bool LidarRayPatternComponent::IsSectorScanningEnabled() const
+    {
+        return m_isSectorScanningEnabled;
+    }
+
+    void LidarRayPatternComponent::Activate()
+    {
+    }
+
+    void LidarRayPatternComponent::Deactivate()
+    {
+    }
+} // namespace RGL
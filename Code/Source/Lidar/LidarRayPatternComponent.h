@@ -0,0 +1,45 @@
+/* Copyright 2020-2021, Robotec.ai sp. z o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <AzCore/Component/Component.h>
+#include <Lidar/RayPatternLibrary.h>
+
+namespace RGL
+{
+    //! Component configuring the ray pattern of the RGL lidar of its entity: the built-in pattern replacing
+    //! the ray orientations configured by the lidar sensor component and the sector scanning of the pattern.
+    class LidarRayPatternComponent : public AZ::Component
+    {
+    public:
+        AZ_COMPONENT(LidarRayPatternComponent, "{f6cd098f-7afe-4454-b712-f5cc1a85fa41}", AZ::Component);
+
+        LidarRayPatternComponent() = default;
+        ~LidarRayPatternComponent() override = default;
+
+        static void Reflect(AZ::ReflectContext* context);
+
+        [[nodiscard]] RayPatternId GetRayPatternId() const;
+        [[nodiscard]] bool IsSectorScanningEnabled() const;
+
+        // AZ::Component overrides
+        void Activate() override;
+        void Deactivate() override;
+
+    private:
+        RayPatternId m_rayPatternId{ RayPatternId::None };
+        bool m_isSectorScanningEnabled{ false };
+    };
+} // namespace RGL
@@ -12,28 +12,82 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <AzCore/Component/TransformBus.h>
+#include <AzCore/Math/MathUtils.h>
+#include <Entity/EntityIdRegistry.h>
 #include <Lidar/LidarRaycaster.h>
-#include <RGL/RGLBus.h>
+#include <Lidar/LidarScheduler.h>
 #include <ROS2/ROS2Bus.h>
+#include <Scene/SceneCommandBufferBus.h>
+#include <Scene/SceneVisibilityBus.h>
 #include <Utilities/RGLUtils.h>
 #include <rgl/api/extensions/ros2.h>
 
 namespace RGL
 {
-    LidarRaycaster::LidarRaycaster(const AZ::Uuid& uuid)
+    LidarRaycaster::LidarRaycaster(
+        const AZ::Uuid& uuid,
+        AZ::EntityId lidarEntityId,
+        PipelineGraphPool& graphPool,
+        RayPatternCache& rayPatternCache,
+        LidarScheduler& scheduler)
         : m_uuid{ uuid }
+        , m_lidarEntityId{ lidarEntityId }
+        , m_graphPool{ &graphPool }
+        , m_rayPatternCache{ &rayPatternCache }
+        , m_scheduler{ &scheduler }
     {
+        PipelineGraphPool::PooledGraph pooledGraph = m_graphPool->Acquire();
+        m_graph = AZStd::move(pooledGraph.m_graph);
+        m_rglRaycastResults = AZStd::move(pooledGraph.m_rglResults);
+        m_raycastResults = AZStd::move(pooledGraph.m_results);
+
         ROS2::LidarRaycasterRequestBus::Handler::BusConnect(ROS2::LidarId(uuid));
     }
 
     LidarRaycaster::LidarRaycaster(LidarRaycaster&& other)
         : m_uuid{ other.m_uuid }
+        , m_lidarEntityId{ other.m_lidarEntityId }
+        , m_graphPool{ other.m_graphPool }
+        , m_rayPatternCache{ other.m_rayPatternCache }
+        , m_scheduler{ other.m_scheduler }
         , m_isMaxRangeEnabled{ other.m_isMaxRangeEnabled }
+        , m_isResultEncodingEnabled{ other.m_isResultEncodingEnabled }
+        , m_isResultEncodingActive{ other.m_isResultEncodingActive }
+        , m_isRangeImageEnabled{ other.m_isRangeImageEnabled }
+        , m_isRangeImagePointsEnabled{ other.m_isRangeImagePointsEnabled }
+        , m_isRangeImageEntityIdsEnabled{ other.m_isRangeImageEntityIdsEnabled }
+        , m_isRangeImageIntensityEnabled{ other.m_isRangeImageIntensityEnabled }
+        , m_rangeImage{ AZStd::move(other.m_rangeImage) }
         , m_resultFlags{ other.m_resultFlags }
         , m_range{ other.m_range }
-        , m_graph{ std::move(other.m_graph) }
-        , m_rayTransforms{ AZStd::move(other.m_rayTransforms) }
+        , m_rayPattern{ AZStd::move(other.m_rayPattern) }
+        , m_lastLidarPose{ other.m_lastLidarPose }
+        , m_excludedEntities{ AZStd::move(other.m_excludedEntities) }
+        , m_isSectorScanningEnabled{ other.m_isSectorScanningEnabled }
+        , m_sensorOffset{ other.m_sensorOffset }
+        , m_sectorScan{ AZStd::move(other.m_sectorScan) }
+        , m_sectorResults{ AZStd::move(other.m_sectorResults) }
+        , m_hasPreparedScan{ other.m_hasPreparedScan }
+        , m_isGroupMember{ other.m_isGroupMember }
+        , m_resultProcessor{ AZStd::move(other.m_resultProcessor) }
+        , m_isMotionDistortionEnabled{ other.m_isMotionDistortionEnabled }
+        , m_scanDuration{ other.m_scanDuration }
+        , m_hasVelocityPose{ other.m_hasVelocityPose }
+        , m_velocityPose{ other.m_velocityPose }
+        , m_velocityPoseTime{ other.m_velocityPoseTime }
+        , m_laserScanPublisher{ AZStd::move(other.m_laserScanPublisher) }
+        , m_pointCloudFormat{ other.m_pointCloudFormat }
+        , m_pointCloudFields{ AZStd::move(other.m_pointCloudFields) }
+        , m_isEncodedFormatRejected{ other.m_isEncodedFormatRejected }
+        , m_pcTopicName{ AZStd::move(other.m_pcTopicName) }
+        , m_pcFrameId{ AZStd::move(other.m_pcFrameId) }
+        , m_rayPatternPublisher{ AZStd::move(other.m_rayPatternPublisher) }
+        , m_areResultsReusable{ other.m_areResultsReusable }
+        , m_resultsSceneVersion{ other.m_resultsSceneVersion }
         , m_rglRaycastResults{ AZStd::move(other.m_rglRaycastResults) }
+        , m_raycastResults{ AZStd::move(other.m_raycastResults) }
+        , m_graph{ AZStd::move(other.m_graph) }
     {
         other.BusDisconnect();
 
@@ -48,199 +102,812 @@ namespace RGL
         {
             ROS2::LidarRaycasterRequestBus::Handler::BusDisconnect();
         }
+
+        if (m_graph)
+        {
+            m_graphPool->Release({ AZStd::move(m_graph), AZStd::move(m_rglRaycastResults), AZStd::move(m_raycastResults) });
+        }
     }
 
-    void LidarRaycaster::ConfigureRayOrientations(const AZStd::vector<AZ::Vector3>& orientations)
+    void LidarRaycaster::AppendToSnapshot(Snapshot::SceneSnapshot& snapshot) const
     {
-        ValidateRayOrientations(orientations);
-        AZStd::vector<rgl_mat3x4f> rglRayTransforms;
-        rglRayTransforms.reserve(orientations.size());
-        for (const AZ::Vector3& orientation : orientations)
+        Snapshot::LidarData lidar;
+        lidar.m_pose = Utils::RglMat3x4FromAzMatrix3x4(m_lastLidarPose);
+        lidar.m_minRange = m_range.first;
+        lidar.m_maxRange = m_range.second;
+        m_graph->AppendToSnapshot(lidar);
+
+        // The ray data is recorded as uploaded by ApplyRayPattern and ApplyRayRanges.
+        const auto assign = [](auto& snapshotValues, const auto& values)
+        {
+            snapshotValues.assign(values.begin(), values.end());
+        };
+        if (!m_rayPattern)
+        {
+            // The default graph configuration contains a single ray.
+            lidar.m_rayPoses = { Utils::IdentityTransform };
+            lidar.m_ringIds = { 0 };
+        }
+        else if (ShouldEnableMultiReturn())
+        {
+            assign(lidar.m_rayPoses, m_resultProcessor.GetMultiReturn().GetSubRayPoses());
+            assign(lidar.m_ringIds, LidarMultiReturn::ExpandRayValues(m_rayPattern->m_ringIds));
+        }
+        else
         {
-            // Since we provide a transform for the Z axis unit vector we need an additional PI / 2 added to the pitch.
-            const AZ::Matrix3x4 rayTransform = AZ::Matrix3x4::CreateFromQuaternion(AZ::Quaternion::CreateFromEulerRadiansZYX({
-                orientation.GetX(),
-                -orientation.GetY() + AZ::Constants::HalfPi,
-                orientation.GetZ(),
-            }));
+            assign(lidar.m_rayPoses, m_rayPattern->m_rayPoses);
+            assign(lidar.m_ringIds, m_rayPattern->m_ringIds);
+        }
+
+        if (ShouldEnableMotionDistortion())
+        {
+            const AZStd::vector<float> timeOffsets = ComputeRayTimeOffsets();
+            assign(lidar.m_timeOffsets, ShouldEnableMultiReturn() ? LidarMultiReturn::ExpandRayValues(timeOffsets) : timeOffsets);
+        }
+
+        if (m_resultProcessor.GetCrop().HasRayRanges() && !m_isSectorScanningEnabled && m_rayPattern)
+        {
+            const AZStd::vector<rgl_vec2f>& rayRanges = m_resultProcessor.GetCrop().GetRayRanges();
+            assign(lidar.m_rayRanges, ShouldEnableMultiReturn() ? LidarMultiReturn::ExpandRayValues(rayRanges) : rayRanges);
+        }
+        else
+        {
+            lidar.m_rayRanges = { { .value = { 0.0f, m_range.second } } };
+        }
+
+        snapshot.AddLidar(AZStd::move(lidar));
+    }
+
+    void LidarRaycaster::ConfigureBuiltInRayPattern(RayPatternId patternId)
+    {
+        AZStd::shared_ptr<const RayPattern> rayPattern = m_rayPatternCache->GetRayPattern(patternId);
+        if (!rayPattern || rayPattern == m_rayPattern)
+        {
+            return;
+        }
+
+        m_rayPattern = AZStd::move(rayPattern);
+        ApplyRayPattern();
+    }
+
+    void LidarRaycaster::ApplySettings(const LidarSettings& settings)
+    {
+        m_areResultsReusable = false;
+        m_graph->ConfigureDownsampleNode(settings.m_downsampleLeafSize);
+        m_graph->SetIsDownsampleEnabled(settings.m_isDownsamplingEnabled);
+
+        m_resultProcessor.GetCrop().Configure(settings.m_cropVolumes);
+        m_resultProcessor.GetMultiReturn().Configure(settings.m_returnMode, AZ::DegToRad(settings.m_beamDivergence));
+        m_isMotionDistortionEnabled = settings.m_isMotionDistortionEnabled;
+        m_scanDuration = settings.m_scanDuration;
+        // Uploads the sub-rays of the multiple returns and the ray time offsets (if any) together with the cropped ranges.
+        ApplyRayPattern();
+
+        m_pointCloudFormat = settings.m_pointCloudFormat;
+        m_pointCloudFields = PointCloudFormats::GetFields(settings.m_pointCloudFormat, settings.m_customPointCloudFields);
+
+        m_isResultEncodingEnabled = settings.m_isResultEncodingEnabled;
+        m_isRangeImageEnabled = settings.m_isRangeImageEnabled;
+        m_isRangeImagePointsEnabled = settings.m_isRangeImagePointsEnabled;
+        m_isRangeImageEntityIdsEnabled = settings.m_isRangeImageEntityIdsEnabled;
+        m_isRangeImageIntensityEnabled = settings.m_isRangeImageIntensityEnabled;
+        ApplyLaserScanSettings(settings);
+
+        // The range image and the LaserScan require the results of all the rays.
+        m_graph->SetIsCompactEnabled(ShouldEnableCompact());
+        m_graph->SetIsPcPublishingEnabled(ShouldEnablePcPublishing());
+        UpdateYieldFields();
+        ConfigurePointFormat();
+    }
+
+    void LidarRaycaster::ConfigureSectorScanning(bool isEnabled)
+    {
+        m_areResultsReusable = false;
+        m_isSectorScanningEnabled = isEnabled;
+        ApplyRayPattern();
+
+        // The sector results are matched with their rays, so the points cannot be compacted nor published by the graph.
+        m_graph->SetIsCompactEnabled(ShouldEnableCompact());
+        m_graph->SetIsPcPublishingEnabled(ShouldEnablePcPublishing());
+        UpdateYieldFields();
+        ConfigurePointFormat();
+    }
+
+    bool LidarRaycaster::IsSectorScanningEnabled() const
+    {
+        return m_isSectorScanningEnabled;
+    }
+
+    void LidarRaycaster::AdvanceSectorScan(float deltaTime)
+    {
+        if (m_isSectorScanningEnabled && m_rayPattern)
+        {
+            m_sectorScan.Advance(deltaTime);
+        }
+    }
+
+    bool LidarRaycaster::HasDueSector() const
+    {
+        return m_isSectorScanningEnabled && m_rayPattern && !m_isGroupMember &&
+            m_sectorScan.GetDueRayCount() > m_sectorScan.GetTracedRayCount();
+    }
+
+    void LidarRaycaster::TraceDueSector()
+    {
+        if (HasDueSector())
+        {
+            TraceSector(AZ::Matrix3x4::CreateFromTransform(GetCurrentLidarTransform()), m_sectorScan.GetDueRayCount());
+        }
+    }
+
+    bool LidarRaycaster::CanPrepareScan() const
+    {
+        return !m_isGroupMember && !m_isSectorScanningEnabled && !m_graph->IsPcPublishingEnabled() && !m_laserScanPublisher;
+    }
+
+    void LidarRaycaster::PrepareScan()
+    {
+        m_hasPreparedScan = Raycast(GetCurrentLidarTransform());
+    }
+
+    bool LidarRaycaster::HasPreparedScan() const
+    {
+        return m_hasPreparedScan;
+    }
+
+    void LidarRaycaster::DiscardPreparedScan()
+    {
+        m_hasPreparedScan = false;
+    }
+
+    size_t LidarRaycaster::GetRayCount() const
+    {
+        // The default graph configuration contains a single ray.
+        return m_rayPattern ? m_rayPattern->m_rayPoses.size() : 1LU;
+    }
+
+    AZ::EntityId LidarRaycaster::GetLidarEntityId() const
+    {
+        return m_lidarEntityId;
+    }
+
+    const AZStd::shared_ptr<const RayPattern>& LidarRaycaster::GetRayPattern() const
+    {
+        return m_rayPattern;
+    }
+
+    float LidarRaycaster::GetMaxRange() const
+    {
+        return m_range.second;
+    }
+
+    const AZStd::vector<AZ::EntityId>& LidarRaycaster::GetExcludedEntities() const
+    {
+        return m_excludedEntities;
+    }
+
+    void LidarRaycaster::SetIsGroupMember(bool isGroupMember)
+    {
+        m_isGroupMember = isGroupMember;
+        m_hasPreparedScan = false;
+        m_graph->SetIsPcPublishingEnabled(ShouldEnablePcPublishing());
+    }
+
+    bool LidarRaycaster::IsGroupMember() const
+    {
+        return m_isGroupMember;
+    }
 
-            rglRayTransforms.push_back(Utils::RglMat3x4FromAzMatrix3x4(rayTransform));
+    void LidarRaycaster::ConfigureRayOrientations(const AZStd::vector<AZ::Vector3>& orientations)
+    {
+        if (m_rayPattern && m_rayPattern->m_patternId != RayPatternId::None)
+        {
+            return; // The built-in ray pattern takes precedence.
         }
 
-        m_rayTransforms.clear();
-        m_rayTransforms.reserve(rglRayTransforms.size());
-        for (rgl_mat3x4f transform : rglRayTransforms)
+        ValidateRayOrientations(orientations);
+        AZStd::shared_ptr<const RayPattern> rayPattern = m_rayPatternCache->GetRayPattern(orientations);
+        if (rayPattern == m_rayPattern)
         {
-            m_rayTransforms.push_back(Utils::AzMatrix3x4FromRglMat3x4(transform));
+            return;
         }
 
-        m_graph.ConfigureRayPosesNode(rglRayTransforms);
+        m_rayPattern = AZStd::move(rayPattern);
+        ApplyRayPattern();
     }
 
     void LidarRaycaster::ConfigureRayRange(float range)
     {
         ValidateRayRange(range);
+        m_areResultsReusable = false;
         m_range.second = range;
-        // We set the graph-side value of min range to zero to be able to distinguish rays below min range from the ones above max range.
-        m_graph.ConfigureRayRangesNode(0.0f, m_range.second);
+        ApplyRayRanges();
     }
 
     void LidarRaycaster::ConfigureMinimumRayRange(float range)
     {
+        m_areResultsReusable = false;
         m_range.first = range;
         // We omit updating the graph-side value of min range to be able to distinguish rays below min range from the ones above max range.
     }
 
     void LidarRaycaster::ConfigureRaycastResultFlags(ROS2::RaycastResultFlags flags)
     {
+        m_areResultsReusable = false;
         m_resultFlags = flags;
-        m_rglRaycastResults.m_fields.clear();
-        m_rglRaycastResults.m_isHit.clear();
-        m_rglRaycastResults.m_xyz.clear();
-        m_rglRaycastResults.m_distance.clear();
 
-        if ((flags & ROS2::RaycastResultFlags::Points) == ROS2::RaycastResultFlags::Points)
+        m_graph->SetIsCompactEnabled(ShouldEnableCompact());
+        m_graph->SetIsPcPublishingEnabled(ShouldEnablePcPublishing());
+        UpdateYieldFields();
+        ConfigurePointFormat();
+    }
+
+    ROS2::RaycastResult LidarRaycaster::PerformRaycast(const AZ::Transform& lidarTransform)
+    {
+        // The sensor offset is used to obtain the lidar pose of the raycasts traced before they are requested.
+        AZ::Transform entityTransform = AZ::Transform::CreateIdentity();
+        AZ::TransformBus::EventResult(entityTransform, m_lidarEntityId, &AZ::TransformBus::Events::GetWorldTM);
+        m_sensorOffset = entityTransform.GetInverse() * lidarTransform;
+
+        if (m_isGroupMember)
         {
-            m_rglRaycastResults.m_fields.push_back(RGL_FIELD_IS_HIT_I32);
-            m_rglRaycastResults.m_fields.push_back(RGL_FIELD_XYZ_F32);
+            // The rays are traced and published by the lidar group.
+            return {};
         }
 
-        if ((flags & ROS2::RaycastResultFlags::Ranges) == ROS2::RaycastResultFlags::Ranges)
+        m_scheduler->OnRaycastRequested(ROS2::LidarId(m_uuid));
+
+        if (m_hasPreparedScan)
         {
-            m_rglRaycastResults.m_fields.push_back(RGL_FIELD_DISTANCE_F32);
+            // The scan was traced in the previous frame to keep the frames within the budget (see LidarScheduler).
+            m_hasPreparedScan = false;
+            return m_raycastResults;
         }
 
-        m_graph.ConfigureYieldNodes(m_rglRaycastResults.m_fields.data(), m_rglRaycastResults.m_fields.size());
+        if (!Raycast(lidarTransform))
+        {
+            return {};
+        }
 
-        m_graph.SetIsCompactEnabled(ShouldEnableCompact());
-        m_graph.SetIsPcPublishingEnabled(ShouldEnablePcPublishing());
+        return m_raycastResults;
     }
 
-    ROS2::RaycastResult LidarRaycaster::PerformRaycast(const AZ::Transform& lidarTransform)
+    bool LidarRaycaster::Raycast(const AZ::Transform& lidarTransform)
     {
         const AZ::Matrix3x4 lidarPose = AZ::Matrix3x4::CreateFromTransform(lidarTransform);
+        // The scene version has to cover the mutations recorded since the last flush before the results are checked against it.
+        SceneCommandBufferInterface::Get()->Flush();
+        if (CanReuseResults(lidarPose))
+        {
+            // Neither the lidar nor anything within its range moved, so the graph would produce the same results.
+            UpdateRangeImage(m_rglRaycastResults);
+            if (m_laserScanPublisher)
+            {
+                m_laserScanPublisher->Publish(m_rglRaycastResults.m_distance, m_range.first, m_range.second);
+            }
+            return true;
+        }
+
+        m_areResultsReusable = false;
+        m_lastLidarPose = lidarPose;
+
+        m_graph->ConfigureLidarTransformNode(lidarPose);
 
-        m_graph.ConfigureLidarTransformNode(lidarPose);
-        if (m_graph.IsPcPublishingEnabled())
+        if (m_graph->IsPcPublishingEnabled())
         {
             // Transforms the obtained point-cloud from world to sensor frame of reference.
-            m_graph.ConfigurePcTransformNode(lidarPose.GetInverseFull());
+            m_graph->ConfigurePcTransformNode(lidarPose.GetInverseFull());
         }
 
-        m_graph.Run();
+        if (m_isSectorScanningEnabled && m_rayPattern)
+        {
+            TraceSector(lidarPose, m_sectorScan.GetRayCount());
+            m_sectorScan.Complete(m_raycastResults, ArePointsExpected(), AreRangesExpected() && !IsLaserScanPublished());
+            UpdateRangeImage(m_sectorResults);
+            if (m_laserScanPublisher)
+            {
+                m_laserScanPublisher->Publish(m_sectorResults.m_distance, m_range.first, m_range.second);
+            }
+            return true;
+        }
 
-        if (!m_graph.GetResults(m_rglRaycastResults))
+        if (m_graph->IsMotionDistortionEnabled())
         {
-            return {};
+            UpdateSensorVelocity(lidarPose);
+        }
+
+        const auto raycastStart = AZStd::chrono::steady_clock::now();
+        if (!RunGraph())
+        {
+            m_scheduler->ReportRaycastCost(ROS2::LidarId(m_uuid), GetRayCount(), AZStd::chrono::steady_clock::now() - raycastStart);
+            return false;
+        }
+
+        // Without a ray pattern, the graph traces the single ray of its default configuration.
+        static const AZStd::vector<rgl_mat3x4f> DefaultRayPoses{ Utils::IdentityTransform };
+        const AZStd::vector<rgl_mat3x4f>& rayPoses = m_rayPattern ? m_rayPattern->m_rayPoses : DefaultRayPoses;
+        m_resultProcessor.Process(m_rglRaycastResults, rayPoses, lidarPose, GetResultProcessingOptions(), m_raycastResults);
+
+        UpdateRangeImage(m_rglRaycastResults);
+        if (m_laserScanPublisher)
+        {
+            m_laserScanPublisher->Publish(m_rglRaycastResults.m_distance, m_range.first, m_range.second);
+        }
+
+        m_resultsSceneVersion = SceneCommandBufferInterface::Get()->GetSceneVersion();
+        m_areResultsReusable = true;
+
+        m_scheduler->ReportRaycastCost(ROS2::LidarId(m_uuid), GetRayCount(), AZStd::chrono::steady_clock::now() - raycastStart);
+        return true;
+    }
+
+    bool LidarRaycaster::CanReuseResults(const AZ::Matrix3x4& lidarPose) const
+    {
+        // Noisy results differ between the runs and the graph-side publisher has to run to publish the results again.
+        // The distorted results depend on the velocity, which has to be estimated again even if the lidar stopped.
+        if (!m_areResultsReusable || m_isSectorScanningEnabled || m_graph->IsNoiseEnabled() || m_graph->IsPcPublishingEnabled() ||
+            m_graph->IsMotionDistortionEnabled())
+        {
+            return false;
+        }
+
+        if (!lidarPose.IsClose(m_lastLidarPose, ReusedPoseTolerance))
+        {
+            return false;
+        }
+
+        return !SceneCommandBufferInterface::Get()->HasSceneChangedSince(m_resultsSceneVersion, lidarPose.GetTranslation(), m_range.second);
+    }
+
+    AZ::Transform LidarRaycaster::GetCurrentLidarTransform() const
+    {
+        AZ::Transform entityTransform = AZ::Transform::CreateIdentity();
+        AZ::TransformBus::EventResult(entityTransform, m_lidarEntityId, &AZ::TransformBus::Events::GetWorldTM);
+        return entityTransform * m_sensorOffset;
+    }
+
+    void LidarRaycaster::ConfigureNoiseParameters(
+        float angularNoiseStdDev, float distanceNoiseStdDevBase, float distanceNoiseStdDevRisePerMeter)
+    {
+        m_areResultsReusable = false;
+        m_graph->ConfigureAngularNoiseNode(angularNoiseStdDev);
+        m_graph->ConfigureDistanceNoiseNode(distanceNoiseStdDevBase, distanceNoiseStdDevRisePerMeter);
+        m_graph->SetIsNoiseEnabled(true);
+        UpdateYieldFields();
+        ConfigurePointFormat();
+    }
+
+    void LidarRaycaster::ExcludeEntities(const AZStd::vector<AZ::EntityId>& excludedEntities)
+    {
+        m_areResultsReusable = false;
+        m_excludedEntities = excludedEntities;
+    }
+
+    void LidarRaycaster::ConfigureMaxRangePointAddition(bool addMaxRangePoints)
+    {
+        m_areResultsReusable = false;
+        m_isMaxRangeEnabled = addMaxRangePoints;
+
+        // We need to configure if points should be compacted to minimize the CPU operations when retrieving raycast results.
+        m_graph->SetIsCompactEnabled(ShouldEnableCompact());
+        m_graph->SetIsPcPublishingEnabled(ShouldEnablePcPublishing());
+        UpdateYieldFields();
+        ConfigurePointFormat();
+    }
+
+    void LidarRaycaster::ConfigurePointCloudPublisher(
+        const AZStd::string& topicName, const AZStd::string& frameId, const ROS2::QoS& qosPolicy)
+    {
+        m_areResultsReusable = false;
+        m_pcTopicName = topicName;
+        m_pcFrameId = frameId;
+        m_graph->ConfigurePcPublisherNode(topicName, frameId, qosPolicy);
+        m_graph->SetIsPcPublishingEnabled(ShouldEnablePcPublishing());
+        ConfigurePointFormat();
+    }
+
+    bool LidarRaycaster::CanHandlePublishing()
+    {
+        // The point cloud of a group member is published by its group.
+        return m_isGroupMember || m_graph->IsPcPublishingEnabled() || IsLaserScanPublished();
+    }
+
+    void LidarRaycaster::UpdatePublisherTimestamp(AZ::u64 timestampNanoseconds)
+    {
+        RGL_CHECK(rgl_scene_set_time(nullptr, timestampNanoseconds));
+    }
+
+    void LidarRaycaster::ApplyRayPattern()
+    {
+        m_areResultsReusable = false;
+        if (!m_rayPattern)
+        {
+            return;
         }
 
-        bool pointsExpected = (m_resultFlags & ROS2::RaycastResultFlags::Points) == ROS2::RaycastResultFlags::Points;
-        bool distanceExpected = (m_resultFlags & ROS2::RaycastResultFlags::Ranges) == ROS2::RaycastResultFlags::Ranges;
+        if (m_isSectorScanningEnabled)
+        {
+            // The ring ids are uploaded together with the ray poses of each sector (see TraceSector).
+            m_sectorScan.Configure(m_rayPattern->m_rayPoses, m_rayPattern->m_ringIds);
+        }
+        else if (ShouldEnableMultiReturn())
+        {
+            m_graph->ConfigureRayPosesNode(m_resultProcessor.GetMultiReturn().ExpandRayPoses(m_rayPattern->m_rayPoses));
+            m_graph->ConfigureRayRingIdsNode(LidarMultiReturn::ExpandRayValues(m_rayPattern->m_ringIds));
+        }
+        else
+        {
+            m_graph->ConfigureRayPosesNode(m_rayPattern->m_rayPoses);
+            m_graph->ConfigureRayRingIdsNode(m_rayPattern->m_ringIds);
+        }
 
-        if (pointsExpected)
+        if (ShouldEnableMotionDistortion())
         {
-            m_raycastResults.m_points.resize(m_rglRaycastResults.m_xyz.size());
+            const AZStd::vector<float> timeOffsets = ComputeRayTimeOffsets();
+            m_graph->ConfigureRayTimeOffsetsNode(ShouldEnableMultiReturn() ? LidarMultiReturn::ExpandRayValues(timeOffsets) : timeOffsets);
         }
+        m_graph->SetIsMotionDistortionEnabled(ShouldEnableMotionDistortion());
 
-        if (distanceExpected)
+        if (m_laserScanPublisher)
+        {
+            m_laserScanPublisher->ConfigureScanAngles(m_rayPattern->m_rayPoses);
+        }
+        if (m_rayPatternPublisher)
         {
-            m_raycastResults.m_ranges.resize(m_rglRaycastResults.m_distance.size());
+            m_rayPatternPublisher->Publish(m_rayPattern->m_rayPoses);
         }
 
-        size_t usedPointIndex = 0LU;
-        const size_t resultsSize = pointsExpected ? m_raycastResults.m_points.size() : m_raycastResults.m_ranges.size();
-        const float maxRange = m_isMaxRangeEnabled ? m_range.second : AZStd::numeric_limits<float>::infinity();
-        for (size_t resultIndex = 0LU; resultIndex < resultsSize; ++resultIndex)
+        // The cropped ranges are computed for each ray of the pattern, while the sector scans use a single range.
+        ApplyRayRanges();
+    }
+
+    AZStd::vector<float> LidarRaycaster::ComputeRayTimeOffsets() const
+    {
+        return ComputeRayTimeOffsets(m_rayPattern->m_sweepFractions, m_scanDuration);
+    }
+
+    AZStd::vector<float> LidarRaycaster::ComputeRayTimeOffsets(const AZStd::vector<float>& sweepFractions, float scanDuration)
+    {
+        AZStd::vector<float> timeOffsets;
+        timeOffsets.reserve(sweepFractions.size());
+        for (float sweepFraction : sweepFractions)
+        {
+            timeOffsets.push_back(sweepFraction * scanDuration * 1000.0f);
+        }
+        return timeOffsets;
+    }
+
+    void LidarRaycaster::ApplyRayRanges()
+    {
+        if (!m_resultProcessor.GetCrop().HasRayRanges() || m_isSectorScanningEnabled || !m_rayPattern)
+        {
+            // We set the graph-side value of min range to zero to distinguish rays below min range from the ones above max range.
+            m_graph->ConfigureRayRangesNode(0.0f, m_range.second);
+            return;
+        }
+
+        const AZStd::vector<rgl_vec2f>& rayRanges =
+            m_resultProcessor.GetCrop().ComputeRayRanges(m_rayPattern->m_rayPoses, m_range.second);
+        m_graph->ConfigureRayRangesNode(ShouldEnableMultiReturn() ? LidarMultiReturn::ExpandRayValues(rayRanges) : rayRanges);
+    }
+
+    bool LidarRaycaster::RunGraph()
+    {
+        // Applies the scene mutations recorded since the last raycast. Only the first raycast in a tick issues any RGL calls,
+        // unless the lidars hide different entities.
+        SceneVisibilityInterface::Get()->SetHiddenEntities(m_excludedEntities);
+        SceneCommandBufferInterface::Get()->Flush();
+
+        m_graph->Run();
+        return m_graph->GetResults(m_rglRaycastResults);
+    }
+
+    void LidarRaycaster::TraceSector(const AZ::Matrix3x4& lidarPose, size_t rayCount)
+    {
+        const size_t firstRayIndex = m_sectorScan.GetTracedRayCount();
+        if (rayCount <= firstRayIndex)
         {
+            return;
+        }
+
+        const auto traceStart = AZStd::chrono::steady_clock::now();
+        const AZStd::vector<rgl_mat3x4f>& rayPoses = m_sectorScan.GetOrderedRayPoses();
+        m_graph->ConfigureRayPosesNode(rayPoses.data() + firstRayIndex, rayCount - firstRayIndex);
+        // RGL rejects the graphs with the ray count not divisible by the ring id count, so the ring ids have to match the sector.
+        m_graph->ConfigureRayRingIdsNode(m_sectorScan.GetOrderedRingIds().data() + firstRayIndex, rayCount - firstRayIndex);
+        m_graph->ConfigureLidarTransformNode(lidarPose);
+        const bool resultsRetrieved = RunGraph();
+        m_scheduler->ReportRaycastCost(ROS2::LidarId(m_uuid), rayCount - firstRayIndex, AZStd::chrono::steady_clock::now() - traceStart);
+        if (!resultsRetrieved)
+        {
+            return;
+        }
+
+        const bool pointsExpected = ArePointsExpected();
+        const bool rangesExpected = AreRangesExpected();
+        const bool areResultsAccumulated = m_isRangeImageEnabled || m_laserScanPublisher;
+        for (size_t rayIndex = firstRayIndex; rayIndex < rayCount; ++rayIndex)
+        {
+            const size_t resultIndex = rayIndex - firstRayIndex;
+            if (areResultsAccumulated)
+            {
+                StoreSectorResult(resultIndex, m_sectorScan.GetRayIndex(rayIndex));
+            }
+
+            bool isPointValid = false;
+            AZ::Vector3 point = AZ::Vector3::CreateZero();
             if (pointsExpected)
             {
-                const bool isHit = (m_graph.IsCompactEnabled()) || aznumeric_cast<bool>(m_rglRaycastResults.m_isHit[resultIndex]);
-                if (isHit)
+                if (aznumeric_cast<bool>(m_rglRaycastResults.m_isHit[resultIndex]))
                 {
-                    m_raycastResults.m_points[usedPointIndex] = Utils::AzVector3FromRglVec3f(m_rglRaycastResults.m_xyz[resultIndex]);
+                    isPointValid = true;
+                    point = Utils::AzVector3FromRglVec3f(m_rglRaycastResults.m_xyz[resultIndex]);
                 }
                 else if (m_isMaxRangeEnabled)
                 {
-                    const AZ::Vector4 maxVector = lidarPose * m_rayTransforms[resultIndex] * AZ::Vector4(0.0f, 0.0f, m_range.second, 1.0f);
-                    m_raycastResults.m_points[usedPointIndex] = maxVector.GetAsVector3();
-                }
-
-                if (isHit || m_isMaxRangeEnabled)
-                {
-                    ++usedPointIndex;
+                    const AZ::Vector4 maxVector =
+                        lidarPose * Utils::AzMatrix3x4FromRglMat3x4(rayPoses[rayIndex]) * AZ::Vector4(0.0f, 0.0f, m_range.second, 1.0f);
+                    isPointValid = true;
+                    point = maxVector.GetAsVector3();
                 }
             }
 
-            if (distanceExpected)
+            const float range = rangesExpected ? GetReportedRange(m_rglRaycastResults.m_distance[resultIndex]) : 0.0f;
+            m_sectorScan.StoreRayResult(rayIndex, isPointValid, point, range);
+        }
+
+        m_sectorScan.SetTracedRayCount(rayCount);
+    }
+
+    void LidarRaycaster::UpdateYieldFields()
+    {
+        m_areResultsReusable = false;
+        m_isResultEncodingActive = ShouldEncodeResults();
+        m_rglRaycastResults.m_fields.clear();
+        m_rglRaycastResults.m_isHit.clear();
+        m_rglRaycastResults.m_xyz.clear();
+        m_rglRaycastResults.m_distance.clear();
+        m_rglRaycastResults.m_rayIndex.clear();
+        m_rglRaycastResults.m_entityId.clear();
+        m_rglRaycastResults.m_intensity.clear();
+
+        if (m_isResultEncodingActive)
+        {
+            m_rglRaycastResults.m_fields.push_back(RGL_FIELD_RAY_IDX_U32);
+            m_rglRaycastResults.m_fields.push_back(RGL_FIELD_DISTANCE_F32);
+        }
+        else if (ShouldEnableMultiReturn())
+        {
+            // The returns are selected based on the hits and their distances, and their points are computed from the sub-ray poses.
+            // The noise and the motion distortion alter the rays, so the points have to be copied from the graph then.
+            m_rglRaycastResults.m_fields.push_back(RGL_FIELD_IS_HIT_I32);
+            if (AreHostPointsRequired() && (m_graph->IsNoiseEnabled() || ShouldEnableMotionDistortion()))
             {
-                float distance = m_rglRaycastResults.m_distance[resultIndex];
-                if (distance < m_range.first)
-                {
-                    distance = -AZStd::numeric_limits<float>::infinity();
-                }
-                else if (distance > m_range.second)
-                {
-                    distance = maxRange;
-                }
+                m_rglRaycastResults.m_fields.push_back(RGL_FIELD_XYZ_F32);
+            }
+        }
+        else if (AreHostPointsRequired())
+        {
+            m_rglRaycastResults.m_fields.push_back(RGL_FIELD_IS_HIT_I32);
+            m_rglRaycastResults.m_fields.push_back(RGL_FIELD_XYZ_F32);
+        }
+
+        if (AreRangesExpected() || m_isRangeImageEnabled || m_laserScanPublisher || ShouldEnableMultiReturn())
+        {
+            m_rglRaycastResults.m_fields.push_back(RGL_FIELD_DISTANCE_F32);
+        }
 
-                m_raycastResults.m_ranges[resultIndex] = distance;
+        if (m_isRangeImageEnabled && m_isRangeImageEntityIdsEnabled)
+        {
+            m_rglRaycastResults.m_fields.push_back(RGL_FIELD_ENTITY_ID_I32);
+        }
+
+        if (m_isRangeImageEnabled && m_isRangeImageIntensityEnabled)
+        {
+            m_rglRaycastResults.m_fields.push_back(RGL_FIELD_INTENSITY_F32);
+        }
+
+        m_graph->ConfigureYieldNodes(m_rglRaycastResults.m_fields.data(), m_rglRaycastResults.m_fields.size());
+    }
+
+    void LidarRaycaster::StoreSectorResult(size_t resultIndex, size_t rayIndex)
+    {
+        // The fields follow the yield of the graph, which is the same for all the sectors of the scan.
+        const auto storeField = [this, resultIndex, rayIndex](auto& accumulatedField, const auto& sectorField)
+        {
+            if (sectorField.empty())
+            {
+                accumulatedField.clear();
+                return;
             }
+
+            accumulatedField.resize(m_sectorScan.GetRayCount());
+            accumulatedField[rayIndex] = sectorField[resultIndex];
+        };
+
+        storeField(m_sectorResults.m_isHit, m_rglRaycastResults.m_isHit);
+        storeField(m_sectorResults.m_xyz, m_rglRaycastResults.m_xyz);
+        storeField(m_sectorResults.m_distance, m_rglRaycastResults.m_distance);
+        storeField(m_sectorResults.m_entityId, m_rglRaycastResults.m_entityId);
+        storeField(m_sectorResults.m_intensity, m_rglRaycastResults.m_intensity);
+    }
+
+    void LidarRaycaster::UpdateRangeImage(const PipelineGraph::RaycastResults& results)
+    {
+        if (!m_isRangeImageEnabled || !m_rayPattern)
+        {
+            return;
         }
 
-        if (pointsExpected)
+        const RangeImageLayout& layout = m_rayPattern->m_rangeImageLayout;
+        const size_t cellCount = layout.m_rayIndices.size();
+        m_rangeImage.m_rowCount = layout.m_rowCount;
+        m_rangeImage.m_columnCount = layout.m_columnCount;
+        m_rangeImage.m_ranges.resize(cellCount);
+        m_rangeImage.m_points.resize(m_isRangeImagePointsEnabled ? cellCount : 0LU);
+        m_rangeImage.m_entityIds.resize(m_isRangeImageEntityIdsEnabled ? cellCount : 0LU);
+        m_rangeImage.m_intensities.resize(m_isRangeImageIntensityEnabled ? cellCount : 0LU);
+
+        // The results are not compacted, so they are indexed by the rays.
+        for (size_t cell = 0LU; cell < cellCount; ++cell)
         {
-            m_raycastResults.m_points.resize(usedPointIndex);
+            const int32_t rayIndex = layout.m_rayIndices[cell];
+            if (rayIndex == RangeImageLayout::EmptyCell)
+            {
+                m_rangeImage.m_ranges[cell] = AZStd::numeric_limits<float>::infinity();
+            }
+            else
+            {
+                m_rangeImage.m_ranges[cell] = GetReportedRange(results.m_distance[rayIndex]);
+            }
+
+            if (m_isRangeImagePointsEnabled)
+            {
+                const bool isHit = rayIndex != RangeImageLayout::EmptyCell && aznumeric_cast<bool>(results.m_isHit[rayIndex]);
+                m_rangeImage.m_points[cell] = isHit ? Utils::AzVector3FromRglVec3f(results.m_xyz[rayIndex]) : AZ::Vector3::CreateZero();
+            }
+
+            if (m_isRangeImageEntityIdsEnabled)
+            {
+                m_rangeImage.m_entityIds[cell] =
+                    rayIndex == RangeImageLayout::EmptyCell ? EntityIdRegistry::InvalidId : results.m_entityId[rayIndex];
+            }
+
+            if (m_isRangeImageIntensityEnabled)
+            {
+                m_rangeImage.m_intensities[cell] = rayIndex == RangeImageLayout::EmptyCell ? 0.0f : results.m_intensity[rayIndex];
+            }
         }
 
-        return m_raycastResults;
+        LidarRangeImageNotificationBus::Event(m_lidarEntityId, &LidarRangeImageNotifications::OnRangeImageUpdated, m_rangeImage);
     }
 
-    void LidarRaycaster::ConfigureNoiseParameters(
-        float angularNoiseStdDev, float distanceNoiseStdDevBase, float distanceNoiseStdDevRisePerMeter)
+    void LidarRaycaster::ConfigurePointFormat()
     {
-        m_graph.ConfigureAngularNoiseNode(angularNoiseStdDev);
-        m_graph.ConfigureDistanceNoiseNode(distanceNoiseStdDevBase, distanceNoiseStdDevRisePerMeter);
-        m_graph.SetIsNoiseEnabled(true);
+        const bool isEncodedFormat = m_pointCloudFormat == PointCloudFormat::RayIndexDistance;
+        const bool areRaysAltered = m_graph->IsNoiseEnabled() || m_graph->IsDownsampleEnabled() || m_isMotionDistortionEnabled;
+        const bool isEncodedFormatRejected = isEncodedFormat && areRaysAltered;
+        AZ_Warning(
+            "RGL",
+            !isEncodedFormatRejected || m_isEncodedFormatRejected,
+            "The encoded point cloud format cannot be decoded with noise, downsampling or motion distortion. "
+            "Publishing the default format on %s instead.",
+            m_pcTopicName.c_str());
+        m_isEncodedFormatRejected = isEncodedFormatRejected;
+
+        if (isEncodedFormatRejected || m_pointCloudFields.empty())
+        {
+            m_graph->ConfigurePcFormatNode({ PipelineGraph::DefaultFields.begin(), PipelineGraph::DefaultFields.end() });
+        }
+        else
+        {
+            m_graph->ConfigurePcFormatNode(m_pointCloudFields);
+        }
+
+        // The consumers decode the encoded points with the ray poses, which are latched, so that late subscribers receive them as well.
+        if (!isEncodedFormat || isEncodedFormatRejected || m_pcTopicName.empty())
+        {
+            m_rayPatternPublisher.reset();
+            return;
+        }
+
+        const AZStd::string rayPatternTopic = m_pcTopicName + "/ray_pattern";
+        if (m_rayPatternPublisher && m_rayPatternPublisher->GetTopicName() == rayPatternTopic &&
+            m_rayPatternPublisher->GetFrameId() == m_pcFrameId)
+        {
+            return;
+        }
+
+        m_rayPatternPublisher = AZStd::make_unique<RayPatternPublisher>(rayPatternTopic, m_pcFrameId);
+        if (m_rayPattern)
+        {
+            m_rayPatternPublisher->Publish(m_rayPattern->m_rayPoses);
+        }
     }
 
-    void LidarRaycaster::ExcludeEntities(const AZStd::vector<AZ::EntityId>& excludedEntities)
+    void LidarRaycaster::ApplyLaserScanSettings(const LidarSettings& settings)
     {
-        for (const auto& entity : excludedEntities)
+        if (settings.m_laserScanTopic.empty())
+        {
+            m_laserScanPublisher.reset();
+            return;
+        }
+
+        if (m_laserScanPublisher && m_laserScanPublisher->GetTopicName() == settings.m_laserScanTopic &&
+            m_laserScanPublisher->GetFrameId() == settings.m_laserScanFrameId)
+        {
+            return;
+        }
+
+        m_laserScanPublisher = AZStd::make_unique<LaserScanPublisher>(settings.m_laserScanTopic, settings.m_laserScanFrameId);
+        if (m_rayPattern)
         {
-            RGLInterface::Get()->ExcludeEntity(entity);
+            m_laserScanPublisher->ConfigureScanAngles(m_rayPattern->m_rayPoses);
         }
     }
 
-    void LidarRaycaster::ConfigureMaxRangePointAddition(bool addMaxRangePoints)
+    void LidarRaycaster::UpdateSensorVelocity(const AZ::Matrix3x4& lidarPose)
     {
-        m_isMaxRangeEnabled = addMaxRangePoints;
+        const builtin_interfaces::msg::Time timestamp = ROS2::ROS2Interface::Get()->GetROSTimestamp();
+        const double time = aznumeric_cast<double>(timestamp.sec) + aznumeric_cast<double>(timestamp.nanosec) * 1e-9;
+        const double elapsedTime = time - m_velocityPoseTime;
+        if (m_hasVelocityPose && elapsedTime > 0.0)
+        {
+            AZ::Vector3 linearVelocity;
+            AZ::Vector3 angularVelocity;
+            ComputeSensorVelocity(m_velocityPose, lidarPose, elapsedTime, linearVelocity, angularVelocity);
+            m_graph->ConfigureSensorVelocity(linearVelocity, angularVelocity);
+        }
 
-        // We need to configure if points should be compacted to minimize the CPU operations when retrieving raycast results.
-        m_graph.SetIsCompactEnabled(ShouldEnableCompact());
-        m_graph.SetIsPcPublishingEnabled(ShouldEnablePcPublishing());
+        m_hasVelocityPose = true;
+        m_velocityPose = lidarPose;
+        m_velocityPoseTime = time;
     }
 
-    void LidarRaycaster::ConfigurePointCloudPublisher(
-        const AZStd::string& topicName, const AZStd::string& frameId, const ROS2::QoS& qosPolicy)
+    void LidarRaycaster::ComputeSensorVelocity(
+        const AZ::Matrix3x4& previousPose,
+        const AZ::Matrix3x4& pose,
+        double elapsedTime,
+        AZ::Vector3& linearVelocity,
+        AZ::Vector3& angularVelocity)
     {
-        m_graph.ConfigurePcPublisherNode(topicName, frameId, qosPolicy);
-        m_graph.SetIsPcPublishingEnabled(ShouldEnablePcPublishing());
+        // The motion since the previous raycast, expressed in the frame of the lidar.
+        const AZ::Matrix3x4 motion = previousPose.GetInverseFull() * pose;
+        const float inverseElapsedTime = aznumeric_cast<float>(1.0 / elapsedTime);
+        linearVelocity = motion.GetTranslation() * inverseElapsedTime;
+        angularVelocity = AZ::Quaternion::CreateFromMatrix3x4(motion).GetEulerRadians() * inverseElapsedTime;
     }
 
-    bool LidarRaycaster::CanHandlePublishing()
+    float LidarRaycaster::GetReportedRange(float distance) const
     {
-        return m_graph.IsPcPublishingEnabled();
+        return LidarResultProcessor::GetReportedRange(distance, GetResultProcessingOptions());
     }
 
-    void LidarRaycaster::UpdatePublisherTimestamp(AZ::u64 timestampNanoseconds)
+    LidarResultProcessor::Options LidarRaycaster::GetResultProcessingOptions() const
     {
-        RGL_CHECK(rgl_scene_set_time(nullptr, timestampNanoseconds));
+        LidarResultProcessor::Options options;
+        options.m_minRange = m_range.first;
+        options.m_maxRange = m_range.second;
+        options.m_isMaxRangeEnabled = m_isMaxRangeEnabled;
+        options.m_arePointsExpected = ArePointsExpected();
+        // The ranges published as a LaserScan are not converted for the lidar sensor, which leaves the publishing to us.
+        options.m_areRangesExpected = AreRangesExpected() && !IsLaserScanPublished();
+        options.m_arePointsEncoded = m_isResultEncodingActive;
+        options.m_isMultiReturnEnabled = ShouldEnableMultiReturn();
+        options.m_isCropEnabled = ShouldCropPoints();
+        options.m_areHostPointsRequired = AreHostPointsRequired();
+        return options;
     }
 
     bool LidarRaycaster::ArePointsExpected() const
     {
         return (m_resultFlags & ROS2::RaycastResultFlags::Points) == ROS2::RaycastResultFlags::Points;
     }
+    bool LidarRaycaster::AreHostPointsRequired() const
+    {
+        return ArePointsExpected() || (m_isRangeImageEnabled && m_isRangeImagePointsEnabled) || ShouldCropPoints();
+    }
+
     bool LidarRaycaster::AreRangesExpected() const
     {
         return (m_resultFlags & ROS2::RaycastResultFlags::Ranges) == ROS2::RaycastResultFlags::Ranges;
@@ -248,11 +915,39 @@ namespace RGL
 
     bool LidarRaycaster::ShouldEnableCompact() const
     {
-        return !AreRangesExpected() && !m_isMaxRangeEnabled;
+        return !AreRangesExpected() && !m_isMaxRangeEnabled && !m_isSectorScanningEnabled && !m_isRangeImageEnabled &&
+            !m_laserScanPublisher && !m_resultProcessor.GetMultiReturn().IsEnabled();
     }
 
     bool LidarRaycaster::ShouldEnablePcPublishing() const
     {
-        return m_graph.IsPublisherConfigured() && !AreRangesExpected() && !m_isMaxRangeEnabled;
+        // The points filtered by the crop volumes are removed on the host.
+        return m_graph->IsPublisherConfigured() && ShouldEnableCompact() && !m_isGroupMember && !ShouldCropPoints();
+    }
+
+    bool LidarRaycaster::IsLaserScanPublished() const
+    {
+        return m_laserScanPublisher && m_laserScanPublisher->IsScanPlanar();
+    }
+
+    bool LidarRaycaster::ShouldEnableMotionDistortion() const
+    {
+        return m_isMotionDistortionEnabled && !m_isSectorScanningEnabled && m_rayPattern;
+    }
+
+    bool LidarRaycaster::ShouldEnableMultiReturn() const
+    {
+        return m_resultProcessor.GetMultiReturn().IsEnabled() && !m_isSectorScanningEnabled;
+    }
+
+    bool LidarRaycaster::ShouldEncodeResults() const
+    {
+        return m_isResultEncodingEnabled && ShouldEnableCompact() && !m_graph->IsNoiseEnabled() && !m_graph->IsDownsampleEnabled() &&
+            !ShouldEnableMotionDistortion() && !ShouldCropPoints();
+    }
+
+    bool LidarRaycaster::ShouldCropPoints() const
+    {
+        return m_resultProcessor.GetCrop().IsPointFilterEnabled() && !m_isSectorScanningEnabled;
     }
 } // namespace RGL
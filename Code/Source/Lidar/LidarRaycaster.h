@@ -14,21 +14,103 @@
  */
 #pragma once
 
+#include <Lidar/LaserScanPublisher.h>
+#include <Lidar/LidarResultProcessor.h>
+#include <Lidar/LidarSectorScan.h>
+#include <Lidar/LidarSettingsComponent.h>
 #include <Lidar/PipelineGraph.h>
+#include <Lidar/PipelineGraphPool.h>
+#include <Lidar/RayPatternCache.h>
+#include <Lidar/RayPatternPublisher.h>
+#include <RGL/LidarRangeImageBus.h>
 #include <ROS2/Lidar/LidarRaycasterBus.h>
+#include <Snapshot/SceneSnapshot.h>
 #include <Utilities/RGLUtils.h>
 #include <rgl/api/core.h>
 
 namespace RGL
 {
+    class LidarScheduler;
+
     class LidarRaycaster : protected ROS2::LidarRaycasterRequestBus::Handler
     {
     public:
-        explicit LidarRaycaster(const AZ::Uuid& uuid);
+        //! @param uuid Identifier of the lidar.
+        //! @param lidarEntityId Entity of the lidar sensor, providing the lidar pose of the raycasts not requested by the sensor.
+        //! @param graphPool Pool providing the pipeline graph. The graph is returned to the pool on destruction.
+        //! @param rayPatternCache Cache providing the ray patterns shared with other lidars.
+        //! @param scheduler Scheduler receiving the raycast timings.
+        LidarRaycaster(
+            const AZ::Uuid& uuid,
+            AZ::EntityId lidarEntityId,
+            PipelineGraphPool& graphPool,
+            RayPatternCache& rayPatternCache,
+            LidarScheduler& scheduler);
         LidarRaycaster(LidarRaycaster&& other);
         LidarRaycaster(const LidarRaycaster& other) = delete;
         ~LidarRaycaster() override;
 
+        //! Replaces the ray orientations with the built-in ray pattern. While a built-in pattern is in use,
+        //! the orientations configured by the lidar sensor are ignored. RayPatternId::None has no effect.
+        void ConfigureBuiltInRayPattern(RayPatternId patternId);
+
+        //! Applies the RGL-specific settings of the lidar. The points are downsampled only when the results do not have to
+        //! match the rays, i.e. without ranges, max range points or sector scanning (see PipelineGraph::IsDownsampleEnabled).
+        //! The crop volumes are not applied to the sector scans. The multiple returns and the motion distortion are not simulated
+        //! with the sector scanning either, while the range image and the LaserScan are assembled from the traced sectors.
+        void ApplySettings(const LidarSettings& settings);
+
+        //! Enables the sector scanning, in which every tick traces only the rays swept since the previous tick.
+        //! The raycasts requested by the lidar sensor return the accumulated full scan instead of tracing all the rays at once.
+        void ConfigureSectorScanning(bool isEnabled);
+        [[nodiscard]] bool IsSectorScanningEnabled() const;
+
+        //! Advances the sector scan. Has no effect unless the sector scanning is enabled.
+        void AdvanceSectorScan(float deltaTime);
+        [[nodiscard]] bool HasDueSector() const;
+        //! Traces the sector of the rays swept since the last traced one.
+        void TraceDueSector();
+
+        //! Checks whether the scan can be traced ahead of its request. The scans published by the graph or as a LaserScan
+        //! are not prepared, since they would be published at once, a frame early and with a stale timestamp.
+        [[nodiscard]] bool CanPrepareScan() const;
+        //! Traces the scan ahead of its request, using the current pose of the lidar entity.
+        //! The next raycast requested by the lidar sensor returns the prepared scan.
+        void PrepareScan();
+        [[nodiscard]] bool HasPreparedScan() const;
+        void DiscardPreparedScan();
+
+        [[nodiscard]] size_t GetRayCount() const;
+        [[nodiscard]] AZ::EntityId GetLidarEntityId() const;
+        //! Returns the ray pattern of the lidar or nullptr until the ray orientations are configured.
+        [[nodiscard]] const AZStd::shared_ptr<const RayPattern>& GetRayPattern() const;
+        [[nodiscard]] float GetMaxRange() const;
+        [[nodiscard]] const AZStd::vector<AZ::EntityId>& GetExcludedEntities() const;
+        //! Returns the current transform of the lidar, based on its entity and the sensor offset.
+        [[nodiscard]] AZ::Transform GetCurrentLidarTransform() const;
+
+        //! Marks the lidar as a member of a lidar group, which traces and publishes its rays (see LidarGroup).
+        //! The raycasts of a member return no results and its point cloud is not published on its own.
+        void SetIsGroupMember(bool isGroupMember);
+        [[nodiscard]] bool IsGroupMember() const;
+
+        //! Appends the effective graph configuration of this lidar, including its ray data, to the snapshot.
+        //! The sector scans are recorded as the full scans of their ray pattern.
+        void AppendToSnapshot(Snapshot::SceneSnapshot& snapshot) const;
+
+        //! Computes the time offset (in milliseconds) of each ray from its part of the sweep.
+        //! @param scanDuration Duration of a single rotation in seconds.
+        [[nodiscard]] static AZStd::vector<float> ComputeRayTimeOffsets(const AZStd::vector<float>& sweepFractions, float scanDuration);
+        //! Estimates the lidar velocity from the motion between two poses, expressed in the frame of the previous pose.
+        //! @param linearVelocity Set to the linear velocity in meters per second.
+        //! @param angularVelocity Set to the rates of the Euler angles in radians per second.
+        static void ComputeSensorVelocity(
+            const AZ::Matrix3x4& previousPose,
+            const AZ::Matrix3x4& pose,
+            double elapsedTime,
+            AZ::Vector3& linearVelocity,
+            AZ::Vector3& angularVelocity);
+
     protected:
         // LidarRaycasterRequestBus overrides
         void ConfigureRayOrientations(const AZStd::vector<AZ::Vector3>& orientations) override;
@@ -55,21 +137,109 @@ namespace RGL
 
     private:
         AZ::Uuid m_uuid;
+        AZ::EntityId m_lidarEntityId;
+        PipelineGraphPool* m_graphPool;
+        RayPatternCache* m_rayPatternCache;
+        LidarScheduler* m_scheduler;
 
         bool m_isMaxRangeEnabled{ false }; //!< Determines whether max range point addition is enabled.
+        bool m_isResultEncodingEnabled{ false }; //!< Determines whether the points may be transferred as ray indices and distances.
+        bool m_isResultEncodingActive{ false }; //!< Set if the points are currently transferred as ray indices and distances.
+        bool m_isRangeImageEnabled{ false };
+        bool m_isRangeImagePointsEnabled{ false };
+        bool m_isRangeImageEntityIdsEnabled{ false };
+        bool m_isRangeImageIntensityEnabled{ false };
+        LidarRangeImage m_rangeImage;
         ROS2::RaycastResultFlags m_resultFlags{ ROS2::RaycastResultFlags::Points };
 
         AZStd::pair<float, float> m_range{ 0.0f, 1.0f };
-        AZStd::vector<AZ::Matrix3x4> m_rayTransforms{ AZ::Matrix3x4::CreateIdentity() };
+        AZStd::shared_ptr<const RayPattern> m_rayPattern; //!< Null until the ray orientations are configured.
+        AZ::Matrix3x4 m_lastLidarPose{ AZ::Matrix3x4::CreateIdentity() }; //!< Lidar pose used in the last raycast.
+        AZStd::vector<AZ::EntityId> m_excludedEntities; //!< Entities invisible to this lidar only.
+
+        bool m_isSectorScanningEnabled{ false };
+        AZ::Transform m_sensorOffset{ AZ::Transform::CreateIdentity() }; //!< Lidar transform relative to its entity.
+        LidarSectorScan m_sectorScan;
+        //! Graph results of the sector scan rays, in the configured order of the rays. Accumulated only for the range image
+        //! and the LaserScan, which require the results of all the rays.
+        PipelineGraph::RaycastResults m_sectorResults;
+        bool m_hasPreparedScan{ false };
+        bool m_isGroupMember{ false };
+        LidarResultProcessor m_resultProcessor; //!< Crop and multiple returns of the full scans.
+        bool m_isMotionDistortionEnabled{ false };
+        float m_scanDuration{ 0.1f }; //!< Duration of a single rotation in seconds, over which the ray time offsets are spread.
+        bool m_hasVelocityPose{ false }; //!< Set once a raycast provided the pose from which the velocity is estimated.
+        AZ::Matrix3x4 m_velocityPose{ AZ::Matrix3x4::CreateIdentity() }; //!< Lidar pose of the last distorted raycast.
+        double m_velocityPoseTime{ 0.0 }; //!< ROS time of the last distorted raycast in seconds.
+        AZStd::unique_ptr<LaserScanPublisher> m_laserScanPublisher; //!< Null unless a LaserScan topic is configured.
+        PointCloudFormat m_pointCloudFormat{ PointCloudFormat::Default };
+        AZStd::vector<rgl_field_t> m_pointCloudFields; //!< Fields of the point cloud format requested by the settings.
+        bool m_isEncodedFormatRejected{ false }; //!< Set while the encoded format is replaced by the default one.
+        AZStd::string m_pcTopicName; //!< Topic of the point cloud published through RGL, empty until configured.
+        AZStd::string m_pcFrameId;
+        AZStd::unique_ptr<RayPatternPublisher> m_rayPatternPublisher; //!< Null unless the published point cloud is encoded.
+
+        //! Maximum difference of the lidar pose elements for which the results of the previous raycast are reused.
+        static constexpr float ReusedPoseTolerance = 1e-6f;
+        bool m_areResultsReusable{ false }; //!< Set by successful raycasts and cleared by any configuration change.
+        AZ::u64 m_resultsSceneVersion{ 0LU }; //!< Scene version traced by the last raycast.
 
         PipelineGraph::RaycastResults m_rglRaycastResults;
         ROS2::RaycastResult m_raycastResults;
 
-        PipelineGraph m_graph;
+        AZStd::unique_ptr<PipelineGraph> m_graph;
+
+        //! Uploads the ray pattern to the graph or, with the sector scanning enabled, to the sector scan.
+        void ApplyRayPattern();
+        //! Computes the time offsets of the rays of the pattern for the configured scan duration.
+        [[nodiscard]] AZStd::vector<float> ComputeRayTimeOffsets() const;
+        //! Uploads the ray ranges to the graph, starting outside of the crop volumes enclosing the lidar (see LidarCrop).
+        void ApplyRayRanges();
+        //! Traces all the rays (or the rest of the sector scan) from the given pose and fills the raycast results.
+        [[nodiscard]] bool Raycast(const AZ::Transform& lidarTransform);
+        //! Checks whether the results of the last raycast are still valid for the given lidar pose.
+        //! The scene command buffer has to be flushed before, so that the scene version covers all the recorded mutations.
+        [[nodiscard]] bool CanReuseResults(const AZ::Matrix3x4& lidarPose) const;
+        //! Runs the graph with the excluded entities hidden and retrieves the results.
+        [[nodiscard]] bool RunGraph();
+        //! Traces the rays of the sector scan up to the given count (in the azimuth order) and stores their results.
+        void TraceSector(const AZ::Matrix3x4& lidarPose, size_t rayCount);
+        //! Selects the fields yielded by the graph, based on the requested results and the result encoding.
+        void UpdateYieldFields();
+        //! Stores the graph result at the given index under the configured ray index in the accumulated sector results.
+        void StoreSectorResult(size_t resultIndex, size_t rayIndex);
+        //! Organizes the results of the last raycast into the range image and notifies its handlers.
+        //! @param results Graph results of all the rays, in the configured order of the rays.
+        void UpdateRangeImage(const PipelineGraph::RaycastResults& results);
+        //! Configures the format of the point cloud published through RGL and the publisher of its ray pattern.
+        //! The encoded points are decoded along the undisturbed rays, so the encoded format is replaced by the default one
+        //! while the noise, the downsampling or the motion distortion alter the points.
+        void ConfigurePointFormat();
+        //! Creates, replaces or removes the LaserScan publisher to match the settings.
+        void ApplyLaserScanSettings(const LidarSettings& settings);
+        //! Estimates the lidar velocity from the pose of the previous raycast and configures the motion distortion with it.
+        void UpdateSensorVelocity(const AZ::Matrix3x4& lidarPose);
+        //! Maps the distance to the range reported to the lidar sensor.
+        [[nodiscard]] float GetReportedRange(float distance) const;
+        //! Derives the processing of the full scan results from the configuration and the requested results.
+        [[nodiscard]] LidarResultProcessor::Options GetResultProcessingOptions() const;
 
         [[nodiscard]] bool ArePointsExpected() const;
         [[nodiscard]] bool AreRangesExpected() const;
+        //! Checks whether the points of the hits are needed on the host, i.e. by the lidar sensor, the range image or the crop.
+        [[nodiscard]] bool AreHostPointsRequired() const;
         [[nodiscard]] bool ShouldEnableCompact() const;
         [[nodiscard]] bool ShouldEnablePcPublishing() const;
+        //! Checks whether the scan is published as a LaserScan, which replaces the publishing of the lidar sensor.
+        [[nodiscard]] bool IsLaserScanPublished() const;
+        //! The sector scans trace a varying subset of the rays, so the motion distortion is not applied to them.
+        [[nodiscard]] bool ShouldEnableMotionDistortion() const;
+        //! The sector scans trace the rays of the pattern directly, so the multiple returns are not simulated for them.
+        [[nodiscard]] bool ShouldEnableMultiReturn() const;
+        //! The encoded points are decoded with the ray poses, so the rays cannot be altered by the noise or the motion distortion,
+        //! nor the points merged.
+        [[nodiscard]] bool ShouldEncodeResults() const;
+        //! The crop volumes which cannot be applied by the ray ranges filter the points on the host, except for the sector scans.
+        [[nodiscard]] bool ShouldCropPoints() const;
     };
 } // namespace RGL
@@ -0,0 +1,204 @@
+/* Copyright 2020-2021, Robotec.ai sp. z o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <AzCore/Casting/numeric_cast.h>
+#include <AzCore/std/limits.h>
+#include <Entity/EntityIdRegistry.h>
+#include <Lidar/LidarResultProcessor.h>
+#include <RGL/PointDecoding.h>
+#include <Utilities/RGLUtils.h>
+
+namespace RGL
+{
+    LidarCrop& LidarResultProcessor::GetCrop()
+    {
+        return m_crop;
+    }
+
+    const LidarCrop& LidarResultProcessor::GetCrop() const
+    {
+        return m_crop;
+    }
+
+    LidarMultiReturn& LidarResultProcessor::GetMultiReturn()
+    {
+        return m_multiReturn;
+    }
+
+    const LidarMultiReturn& LidarResultProcessor::GetMultiReturn() const
+    {
+        return m_multiReturn;
+    }
+
+    void LidarResultProcessor::Process(
+        PipelineGraph::RaycastResults& graphResults,
+        const AZStd::vector<rgl_mat3x4f>& rayPoses,
+        const AZ::Matrix3x4& lidarPose,
+        const Options& options,
+        ROS2::RaycastResult& results)
+    {
+        const bool isDualReturn = options.m_isMultiReturnEnabled && m_multiReturn.GetMode() == LidarReturnMode::Dual;
+        if (options.m_isMultiReturnEnabled)
+        {
+            // From here on, the results match the rays.
+            m_multiReturn.ReduceResults(graphResults, lidarPose, options.m_areHostPointsRequired);
+        }
+
+        m_isCropped.clear();
+        if (options.m_isCropEnabled)
+        {
+            CropResults(graphResults, lidarPose);
+        }
+
+        // The encoded points are decoded separately.
+        const bool pointsExpected = options.m_arePointsExpected && !options.m_arePointsEncoded;
+        if (pointsExpected)
+        {
+            // The last returns of the dual mode are interleaved with the first ones.
+            results.m_points.resize(graphResults.m_xyz.size() * (isDualReturn ? 2LU : 1LU));
+        }
+
+        if (options.m_areRangesExpected)
+        {
+            results.m_ranges.resize(graphResults.m_distance.size());
+        }
+        else
+        {
+            results.m_ranges.clear();
+        }
+
+        size_t usedPointIndex = 0LU;
+        const size_t resultsSize = pointsExpected ? graphResults.m_xyz.size() : results.m_ranges.size();
+        for (size_t resultIndex = 0LU; resultIndex < resultsSize; ++resultIndex)
+        {
+            if (pointsExpected)
+            {
+                // The compacted results contain only hits, except for the ones removed by the crop volumes.
+                const bool isHit = aznumeric_cast<bool>(graphResults.m_isHit[resultIndex]);
+                const bool isCropped = !m_isCropped.empty() && m_isCropped[resultIndex];
+                if (isHit)
+                {
+                    results.m_points[usedPointIndex] = Utils::AzVector3FromRglVec3f(graphResults.m_xyz[resultIndex]);
+                }
+                else if (options.m_isMaxRangeEnabled && !isCropped)
+                {
+                    const AZ::Vector4 maxVector = lidarPose * Utils::AzMatrix3x4FromRglMat3x4(rayPoses[resultIndex]) *
+                        AZ::Vector4(0.0f, 0.0f, options.m_maxRange, 1.0f);
+                    results.m_points[usedPointIndex] = maxVector.GetAsVector3();
+                }
+
+                if (isHit || (options.m_isMaxRangeEnabled && !isCropped))
+                {
+                    ++usedPointIndex;
+                }
+
+                if (isDualReturn && m_multiReturn.HasSecondaryReturn(resultIndex))
+                {
+                    results.m_points[usedPointIndex] = Utils::AzVector3FromRglVec3f(m_multiReturn.GetSecondaryPoint(resultIndex));
+                    ++usedPointIndex;
+                }
+            }
+
+            if (options.m_areRangesExpected)
+            {
+                results.m_ranges[resultIndex] = GetReportedRange(graphResults.m_distance[resultIndex], options);
+            }
+        }
+
+        if (pointsExpected)
+        {
+            results.m_points.resize(usedPointIndex);
+        }
+
+        if (options.m_arePointsEncoded)
+        {
+            DecodePoints(graphResults, rayPoses, lidarPose, results);
+        }
+    }
+
+    float LidarResultProcessor::GetReportedRange(float distance, const Options& options)
+    {
+        if (distance < options.m_minRange)
+        {
+            return -AZStd::numeric_limits<float>::infinity();
+        }
+
+        // The rays without any hit are traced at a finite distance, so that only the cropped rays are infinite.
+        if (distance == AZStd::numeric_limits<float>::infinity())
+        {
+            return distance;
+        }
+
+        if (distance > options.m_maxRange)
+        {
+            return options.m_isMaxRangeEnabled ? options.m_maxRange : AZStd::numeric_limits<float>::infinity();
+        }
+
+        return distance;
+    }
+
+    void LidarResultProcessor::CropResults(PipelineGraph::RaycastResults& graphResults, const AZ::Matrix3x4& lidarPose)
+    {
+        const AZ::Matrix3x4 inverseLidarPose = lidarPose.GetInverseFull();
+        m_isCropped.assign(graphResults.m_isHit.size(), false);
+        for (size_t resultIndex = 0LU; resultIndex < graphResults.m_isHit.size(); ++resultIndex)
+        {
+            if (m_multiReturn.HasSecondaryReturn(resultIndex) &&
+                m_crop.IsPointCropped(Utils::AzVector3FromRglVec3f(m_multiReturn.GetSecondaryPoint(resultIndex)), inverseLidarPose))
+            {
+                m_multiReturn.DiscardSecondaryReturn(resultIndex);
+            }
+
+            if (!aznumeric_cast<bool>(graphResults.m_isHit[resultIndex]) ||
+                !m_crop.IsPointCropped(Utils::AzVector3FromRglVec3f(graphResults.m_xyz[resultIndex]), inverseLidarPose))
+            {
+                continue;
+            }
+
+            // The cropped hits are reported as the rays without any hit.
+            m_isCropped[resultIndex] = true;
+            graphResults.m_isHit[resultIndex] = 0;
+            if (!graphResults.m_distance.empty())
+            {
+                graphResults.m_distance[resultIndex] = AZStd::numeric_limits<float>::infinity();
+            }
+            if (!graphResults.m_entityId.empty())
+            {
+                graphResults.m_entityId[resultIndex] = EntityIdRegistry::InvalidId;
+            }
+            if (!graphResults.m_intensity.empty())
+            {
+                graphResults.m_intensity[resultIndex] = 0.0f;
+            }
+        }
+    }
+
+    void LidarResultProcessor::DecodePoints(
+        const PipelineGraph::RaycastResults& graphResults,
+        const AZStd::vector<rgl_mat3x4f>& rayPoses,
+        const AZ::Matrix3x4& lidarPose,
+        ROS2::RaycastResult& results)
+    {
+        const AZStd::vector<uint32_t>& rayIndices = graphResults.m_rayIndex;
+        const AZStd::vector<float>& distances = graphResults.m_distance;
+
+        results.m_points.resize(rayIndices.size());
+        for (size_t pointIndex = 0LU; pointIndex < rayIndices.size(); ++pointIndex)
+        {
+            float point[3];
+            PointDecoding::DecodePoint(rayPoses[rayIndices[pointIndex]].value, distances[pointIndex], point);
+            results.m_points[pointIndex] = lidarPose * AZ::Vector3(point[0], point[1], point[2]);
+        }
+    }
+} // namespace RGL
@@ -0,0 +1,84 @@
+/* Copyright 2020-2021, Robotec.ai sp. z o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <AzCore/Math/Matrix3x4.h>
+#include <AzCore/std/containers/vector.h>
+#include <Lidar/LidarCrop.h>
+#include <Lidar/LidarMultiReturn.h>
+#include <Lidar/PipelineGraph.h>
+#include <ROS2/Lidar/LidarRaycasterBus.h>
+#include <rgl/api/core.h>
+
+namespace RGL
+{
+    //! Host-side processing of the graph results of a full scan. Reduces the sub-ray results of the multiple returns, removes
+    //! the hits within the crop volumes and converts the results to the points and ranges reported to the lidar sensor.
+    //! The results of the sector scans are assembled by LidarSectorScan instead.
+    class LidarResultProcessor
+    {
+    public:
+        //! Processing of a single scan, derived from the lidar configuration and the requested results.
+        struct Options
+        {
+            float m_minRange{ 0.0f };
+            float m_maxRange{ 1.0f };
+            bool m_isMaxRangeEnabled{ false }; //!< Adds a point at the max range along each ray without any hit.
+            bool m_arePointsExpected{ false };
+            bool m_areRangesExpected{ false };
+            bool m_arePointsEncoded{ false }; //!< The points are transferred as ray indices and distances (see PointDecoding).
+            bool m_isMultiReturnEnabled{ false }; //!< The graph results contain the sub-rays of the multiple returns.
+            bool m_isCropEnabled{ false }; //!< The crop volumes filter the hit points.
+            //! The points of the hits are needed on the host, e.g. by the range image, even if they are not expected.
+            bool m_areHostPointsRequired{ false };
+        };
+
+        [[nodiscard]] LidarCrop& GetCrop();
+        [[nodiscard]] const LidarCrop& GetCrop() const;
+        [[nodiscard]] LidarMultiReturn& GetMultiReturn();
+        [[nodiscard]] const LidarMultiReturn& GetMultiReturn() const;
+
+        //! Processes the graph results in place and fills the results reported to the lidar sensor.
+        //! Afterwards, the graph results match the rays of the pattern, unless they are compacted.
+        //! @param rayPoses Ray poses of the pattern in the lidar frame, indexed by the ray indices of the results.
+        //! @param lidarPose Lidar pose of the trace.
+        void Process(
+            PipelineGraph::RaycastResults& graphResults,
+            const AZStd::vector<rgl_mat3x4f>& rayPoses,
+            const AZ::Matrix3x4& lidarPose,
+            const Options& options,
+            ROS2::RaycastResult& results);
+
+        //! Maps the distance to the range reported to the lidar sensor: negative infinity below the minimum range, and
+        //! the maximum range (with the max range points) or infinity above the maximum range. The infinite distance of the
+        //! cropped rays is always reported as infinity.
+        [[nodiscard]] static float GetReportedRange(float distance, const Options& options);
+
+    private:
+        //! Reports the hits removed by the crop volumes as the rays without any hit, at an infinite distance.
+        void CropResults(PipelineGraph::RaycastResults& graphResults, const AZ::Matrix3x4& lidarPose);
+        //! Decodes the points transferred as ray indices and distances.
+        static void DecodePoints(
+            const PipelineGraph::RaycastResults& graphResults,
+            const AZStd::vector<rgl_mat3x4f>& rayPoses,
+            const AZ::Matrix3x4& lidarPose,
+            ROS2::RaycastResult& results);
+
+        LidarCrop m_crop;
+        LidarMultiReturn m_multiReturn;
+        //! Results removed by the crop volumes. Unlike the rays without any hit, they get no max range point.
+        AZStd::vector<bool> m_isCropped;
+    };
+} // namespace RGL
@@ -0,0 +1,316 @@
+/* Copyright 2020-2021, Robotec.ai sp. z o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <AzCore/Console/IConsole.h>
+#include <AzCore/std/algorithm.h>
+#include <AzCore/std/sort.h>
+#include <AzCore/std/string/conversions.h>
+#include <Lidar/LidarScheduler.h>
+
+namespace RGL
+{
+    AZ_CVAR(
+        float,
+        rgl_lidar_frame_budget_ms,
+        0.0f,
+        nullptr,
+        AZ::ConsoleFunctorFlags::DontReplicate,
+        "Time per frame available for the lidar raycasts, in milliseconds. Zero disables the scheduling.");
+
+    static void rgl_lidar_schedule_stats([[maybe_unused]] const AZ::ConsoleCommandContainer& arguments)
+    {
+        const LidarScheduler* scheduler = LidarSchedulerInterface::Get();
+        if (!scheduler)
+        {
+            AZ_Error("RGL", false, "The lidar scheduler is not available.");
+            return;
+        }
+
+        const LidarScheduler::Metrics& metrics = scheduler->GetMetrics();
+        AZ_Printf(
+            "RGL",
+            "Lidar scheduler: %s prepared scans, %s discarded scans, %s postponed sectors, %s frames over budget, %s deadline misses.\n",
+            AZStd::to_string(metrics.m_preparedScans).c_str(),
+            AZStd::to_string(metrics.m_discardedScans).c_str(),
+            AZStd::to_string(metrics.m_postponedSectors).c_str(),
+            AZStd::to_string(metrics.m_overBudgetFrames).c_str(),
+            AZStd::to_string(metrics.m_deadlineMisses).c_str());
+    }
+
+    AZ_CONSOLEFREEFUNC(rgl_lidar_schedule_stats, AZ::ConsoleFunctorFlags::DontReplicate, "Prints the lidar scheduler metrics.");
+
+    namespace
+    {
+        //! Weight of the latest measurement in the moving averages of the costs.
+        constexpr float CostSmoothing = 0.2f;
+        //! Minimum time between the consecutive deadline miss warnings, in seconds.
+        constexpr float WarningInterval = 5.0f;
+
+        void UpdateAverage(float& average, float value)
+        {
+            average = average > 0.0f ? average + CostSmoothing * (value - average) : value;
+        }
+    } // namespace
+
+    LidarScheduler::LidarScheduler()
+    {
+        if (!LidarSchedulerInterface::Get())
+        {
+            LidarSchedulerInterface::Register(this);
+        }
+    }
+
+    LidarScheduler::~LidarScheduler()
+    {
+        if (LidarSchedulerInterface::Get() == this)
+        {
+            LidarSchedulerInterface::Unregister(this);
+        }
+    }
+
+    void LidarScheduler::OnRaycastRequested(ROS2::LidarId lidarId)
+    {
+        LidarTiming& timing = m_timings[lidarId];
+        if (timing.m_lastRequestTime >= 0.0f)
+        {
+            timing.m_requestPeriod = m_time - timing.m_lastRequestTime;
+        }
+        timing.m_lastRequestTime = m_time;
+    }
+
+    void LidarScheduler::ReportRaycastCost(ROS2::LidarId lidarId, size_t rayCount, AZStd::chrono::nanoseconds cost)
+    {
+        const float seconds = AZStd::chrono::duration<float>(cost).count();
+        m_frameCost += seconds;
+
+        if (rayCount == 0LU)
+        {
+            return;
+        }
+
+        const float secondsPerRay = seconds / static_cast<float>(rayCount);
+        UpdateAverage(m_timings[lidarId].m_secondsPerRay, secondsPerRay);
+        UpdateAverage(m_secondsPerRay, secondsPerRay);
+    }
+
+    void LidarScheduler::RemoveLidar(ROS2::LidarId lidarId)
+    {
+        m_timings.erase(lidarId);
+    }
+
+    void LidarScheduler::Update(float deltaTime, AZStd::unordered_map<ROS2::LidarId, LidarRaycaster>& lidars)
+    {
+        m_time += deltaTime;
+        ++m_updateIndex;
+
+        // Prepared scans which were not requested in time would be stale.
+        const auto isExpired = [this](const PreparedScan& preparedScan)
+        {
+            return IsPreparedScanExpired(preparedScan.m_updateIndex, m_updateIndex);
+        };
+        for (const PreparedScan& preparedScan : m_preparedScans)
+        {
+            auto lidarIt = lidars.find(preparedScan.m_lidarId);
+            if (isExpired(preparedScan) && lidarIt != lidars.end() && lidarIt->second.HasPreparedScan())
+            {
+                lidarIt->second.DiscardPreparedScan();
+                ++m_metrics.m_discardedScans;
+            }
+        }
+        m_preparedScans.erase(AZStd::remove_if(m_preparedScans.begin(), m_preparedScans.end(), isExpired), m_preparedScans.end());
+
+        for (auto& [lidarId, lidar] : lidars)
+        {
+            lidar.AdvanceSectorScan(deltaTime);
+        }
+
+        const float budget = rgl_lidar_frame_budget_ms * 0.001f;
+        if (budget <= 0.0f)
+        {
+            for (auto& [lidarId, lidar] : lidars)
+            {
+                lidar.TraceDueSector();
+            }
+
+            m_frameCost = 0.0f;
+            return;
+        }
+
+        // The raycasts measured since the last update are attributed to the current frame.
+        if (m_frameCost > budget)
+        {
+            ++m_metrics.m_overBudgetFrames;
+        }
+
+        float spareBudget = PrepareDueScans(budget, AZStd::max(budget - m_frameCost, 0.0f), deltaTime, lidars);
+
+        for (auto& [lidarId, lidar] : lidars)
+        {
+            if (!lidar.HasDueSector())
+            {
+                continue;
+            }
+
+            if (spareBudget <= 0.0f)
+            {
+                // The swept sector keeps growing and is traced in a later frame or with the requested scan at the latest.
+                ++m_metrics.m_postponedSectors;
+                continue;
+            }
+
+            const float frameCost = m_frameCost;
+            lidar.TraceDueSector();
+            spareBudget -= m_frameCost - frameCost;
+        }
+
+        // The work done in this update belongs to the current frame.
+        m_frameCost = 0.0f;
+    }
+
+    float LidarScheduler::PrepareDueScans(
+        float budget, float spareBudget, float deltaTime, AZStd::unordered_map<ROS2::LidarId, LidarRaycaster>& lidars)
+    {
+        AZStd::vector<DueScan> dueScans;
+        for (auto& [lidarId, lidar] : lidars)
+        {
+            auto timingIt = m_timings.find(lidarId);
+            if (timingIt == m_timings.end() || timingIt->second.m_requestPeriod <= 0.0f || lidar.IsSectorScanningEnabled() ||
+                lidar.HasPreparedScan())
+            {
+                continue;
+            }
+
+            // The lidar sensors request a raycast in the first frame after their period elapses.
+            LidarTiming& timing = timingIt->second;
+            if (timing.m_lastRequestTime + timing.m_requestPeriod > m_time + deltaTime)
+            {
+                continue;
+            }
+
+            const float cost = EstimateCost(lidarId, lidar.GetRayCount());
+            if (cost > budget && !timing.m_isOverBudgetReported)
+            {
+                AZ_Warning(
+                    "RGL",
+                    false,
+                    "The raycast of the lidar on entity %s alone is estimated at %.2f ms, which exceeds the frame budget of %.2f ms.",
+                    lidar.GetLidarEntityId().ToString().c_str(),
+                    cost * 1000.0f,
+                    budget * 1000.0f);
+                timing.m_isOverBudgetReported = true;
+            }
+
+            dueScans.push_back({ lidarId, cost, lidar.CanPrepareScan() });
+        }
+
+        const float excessCost = PrepareScans(
+            dueScans,
+            budget,
+            spareBudget,
+            [this, &lidars](const DueScan& dueScan)
+            {
+                const float frameCost = m_frameCost;
+                lidars.find(dueScan.m_lidarId)->second.PrepareScan();
+                m_preparedScans.push_back({ dueScan.m_lidarId, m_updateIndex });
+                ++m_metrics.m_preparedScans;
+                return m_frameCost - frameCost;
+            });
+
+        if (excessCost > 0.0f)
+        {
+            ++m_metrics.m_deadlineMisses;
+            if (m_time - m_lastWarningTime >= WarningInterval)
+            {
+                AZ_Warning(
+                    "RGL",
+                    false,
+                    "The lidar raycasts due in the next frame are expected to exceed the frame budget by %.2f ms (%s deadline misses so far).",
+                    excessCost * 1000.0f,
+                    AZStd::to_string(m_metrics.m_deadlineMisses).c_str());
+                m_lastWarningTime = m_time;
+            }
+        }
+
+        return spareBudget;
+    }
+
+    float LidarScheduler::PrepareScans(
+        AZStd::vector<DueScan>& dueScans, float budget, float& spareBudget, const PrepareScanFunction& prepareScan)
+    {
+        float excessCost = -budget;
+        for (const DueScan& dueScan : dueScans)
+        {
+            excessCost += dueScan.m_cost;
+        }
+
+        if (excessCost <= 0.0f)
+        {
+            return excessCost;
+        }
+
+        // The most expensive scans are moved first, so that the fewest lidars are phase-shifted.
+        AZStd::sort(
+            dueScans.begin(),
+            dueScans.end(),
+            [](const DueScan& lhs, const DueScan& rhs)
+            {
+                return lhs.m_cost > rhs.m_cost;
+            });
+
+        for (const DueScan& dueScan : dueScans)
+        {
+            if (excessCost <= 0.0f)
+            {
+                break;
+            }
+
+            if (!dueScan.m_canPrepare || dueScan.m_cost > spareBudget)
+            {
+                continue;
+            }
+
+            spareBudget -= prepareScan(dueScan);
+            excessCost -= dueScan.m_cost;
+        }
+
+        return excessCost;
+    }
+
+    bool LidarScheduler::IsPreparedScanExpired(AZ::u64 preparationUpdateIndex, AZ::u64 updateIndex)
+    {
+        // The scans prepared in the previous update are requested in the current frame, which may still be ahead if the
+        // lidar sensors tick after the RGL system component.
+        return preparationUpdateIndex + 1LU < updateIndex;
+    }
+
+    void LidarScheduler::Clear()
+    {
+        m_timings.clear();
+        m_preparedScans.clear();
+        m_frameCost = 0.0f;
+    }
+
+    const LidarScheduler::Metrics& LidarScheduler::GetMetrics() const
+    {
+        return m_metrics;
+    }
+
+    float LidarScheduler::EstimateCost(ROS2::LidarId lidarId, size_t rayCount) const
+    {
+        auto timingIt = m_timings.find(lidarId);
+        const float secondsPerRay =
+            timingIt != m_timings.end() && timingIt->second.m_secondsPerRay > 0.0f ? timingIt->second.m_secondsPerRay : m_secondsPerRay;
+        return secondsPerRay * static_cast<float>(rayCount);
+    }
+} // namespace RGL
@@ -0,0 +1,122 @@
+/* Copyright 2020-2021, Robotec.ai sp. z o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <AzCore/Interface/Interface.h>
+#include <AzCore/RTTI/RTTI.h>
+#include <AzCore/std/chrono/chrono.h>
+#include <AzCore/std/containers/unordered_map.h>
+#include <AzCore/std/containers/vector.h>
+#include <AzCore/std/functional.h>
+#include <AzCore/std/limits.h>
+#include <Lidar/LidarRaycaster.h>
+#include <ROS2/Lidar/LidarSystemBus.h>
+
+namespace RGL
+{
+    //! Scheduler keeping the lidar raycasts of each frame under the budget set with the rgl_lidar_frame_budget_ms console variable.
+    //! The cost of each lidar is estimated from its ray count and the past timings. When the raycasts expected in the next frame
+    //! exceed the budget, some of them are traced ahead of time in the current frame (phase-shifted by a frame) if it has budget
+    //! to spare. The sectors of the lidars with the sector scanning enabled are postponed while the frame is over budget.
+    //! A prepared scan is kept until the end of the frame following its preparation, whether the lidar sensors tick
+    //! before or after the RGL system component.
+    class LidarScheduler
+    {
+    public:
+        AZ_RTTI(LidarScheduler, "{8d087d64-97fc-43a8-8628-c5032d955761}");
+
+        struct Metrics
+        {
+            AZ::u64 m_preparedScans{ 0LU }; //!< Scans traced a frame ahead of their request.
+            AZ::u64 m_discardedScans{ 0LU }; //!< Prepared scans which were not requested in the next frame.
+            AZ::u64 m_postponedSectors{ 0LU }; //!< Sector traces postponed to a later frame.
+            AZ::u64 m_overBudgetFrames{ 0LU }; //!< Frames in which the measured raycasting time exceeded the budget.
+            AZ::u64 m_deadlineMisses{ 0LU }; //!< Frames expected to exceed the budget even after the rescheduling.
+        };
+
+        //! Scan of a lidar due in the next frame.
+        struct DueScan
+        {
+            ROS2::LidarId m_lidarId;
+            float m_cost; //!< Estimated cost in seconds.
+            bool m_canPrepare; //!< The scans which cannot be prepared still count towards the cost of the next frame.
+        };
+
+        //! Traces the due scan ahead of time and returns its measured cost in seconds.
+        using PrepareScanFunction = AZStd::function<float(const DueScan&)>;
+
+        LidarScheduler();
+        LidarScheduler(const LidarScheduler& other) = delete;
+        virtual ~LidarScheduler();
+
+        //! Records the raycast request of the lidar sensor. The requests are used to predict the next one.
+        void OnRaycastRequested(ROS2::LidarId lidarId);
+
+        //! Records the time spent on tracing the given number of rays of the lidar.
+        void ReportRaycastCost(ROS2::LidarId lidarId, size_t rayCount, AZStd::chrono::nanoseconds cost);
+
+        //! Forgets the timings of the destroyed lidar.
+        void RemoveLidar(ROS2::LidarId lidarId);
+
+        //! Schedules the raycasts of the lidars for the current and the next frame.
+        void Update(float deltaTime, AZStd::unordered_map<ROS2::LidarId, LidarRaycaster>& lidars);
+
+        void Clear();
+
+        [[nodiscard]] const Metrics& GetMetrics() const;
+
+        //! Returns the estimated cost of a full scan of the lidar, in seconds.
+        [[nodiscard]] float EstimateCost(ROS2::LidarId lidarId, size_t rayCount) const;
+
+        //! Prepares the due scans, the most expensive ones first, until the cost of the next frame fits the budget.
+        //! Only the scans fitting the budget left in the current frame are prepared.
+        //! @param spareBudget Budget left in the current frame, reduced by the measured costs of the prepared scans.
+        //! @return Cost by which the next frame is still expected to exceed the budget, not positive if it fits the budget.
+        static float PrepareScans(
+            AZStd::vector<DueScan>& dueScans, float budget, float& spareBudget, const PrepareScanFunction& prepareScan);
+
+        //! Returns true if the scan prepared in the given update was not requested in time and would be stale.
+        [[nodiscard]] static bool IsPreparedScanExpired(AZ::u64 preparationUpdateIndex, AZ::u64 updateIndex);
+
+    private:
+        struct LidarTiming
+        {
+            float m_secondsPerRay{ 0.0f }; //!< Exponential moving average of the measured costs.
+            float m_lastRequestTime{ -1.0f }; //!< Negative until the first request.
+            float m_requestPeriod{ 0.0f }; //!< Zero until the second request.
+            bool m_isOverBudgetReported{ false };
+        };
+
+        struct PreparedScan
+        {
+            ROS2::LidarId m_lidarId;
+            AZ::u64 m_updateIndex; //!< Update in which the scan was prepared.
+        };
+
+        //! Schedules the lidars due in the next frame. Returns the budget left in the current frame.
+        float PrepareDueScans(float budget, float spareBudget, float deltaTime, AZStd::unordered_map<ROS2::LidarId, LidarRaycaster>& lidars);
+
+        AZStd::unordered_map<ROS2::LidarId, LidarTiming> m_timings;
+        AZStd::vector<PreparedScan> m_preparedScans; //!< Scans prepared in the last two updates.
+        AZ::u64 m_updateIndex{ 0LU };
+        float m_secondsPerRay{ 0.0f }; //!< Average over all the lidars, used for the lidars without any timings.
+        float m_time{ 0.0f };
+        float m_frameCost{ 0.0f }; //!< Raycasting time measured since the last update.
+        float m_lastWarningTime{ -AZStd::numeric_limits<float>::infinity() };
+        Metrics m_metrics;
+    };
+
+    using LidarSchedulerInterface = AZ::Interface<LidarScheduler>;
+} // namespace RGL
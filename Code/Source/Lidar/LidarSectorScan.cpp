@@ -0,0 +1,140 @@
+/* Copyright 2020-2021, Robotec.ai sp. z o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <AzCore/Math/MathUtils.h>
+#include <AzCore/std/sort.h>
+#include <Lidar/LidarSectorScan.h>
+
+namespace RGL
+{
+    void LidarSectorScan::Configure(const AZStd::vector<rgl_mat3x4f>& rayPoses, const AZStd::vector<int32_t>& ringIds)
+    {
+        // The rays are cast along their Z axis, so the azimuth is the heading of the third column of the pose.
+        AZStd::vector<float> azimuths(rayPoses.size());
+        for (size_t rayIndex = 0LU; rayIndex < rayPoses.size(); ++rayIndex)
+        {
+            azimuths[rayIndex] = AZStd::atan2(rayPoses[rayIndex].value[1][2], rayPoses[rayIndex].value[0][2]);
+        }
+
+        m_rayOrder.resize(rayPoses.size());
+        for (size_t rayIndex = 0LU; rayIndex < m_rayOrder.size(); ++rayIndex)
+        {
+            m_rayOrder[rayIndex] = rayIndex;
+        }
+
+        AZStd::stable_sort(
+            m_rayOrder.begin(),
+            m_rayOrder.end(),
+            [&azimuths](size_t lhs, size_t rhs)
+            {
+                return azimuths[lhs] < azimuths[rhs];
+            });
+
+        AZ_Assert(ringIds.size() == rayPoses.size(), "Each ray of the sector scan requires its ring id.");
+        m_orderedRayPoses.resize(rayPoses.size());
+        m_orderedRingIds.resize(rayPoses.size());
+        for (size_t orderedIndex = 0LU; orderedIndex < m_rayOrder.size(); ++orderedIndex)
+        {
+            m_orderedRayPoses[orderedIndex] = rayPoses[m_rayOrder[orderedIndex]];
+            m_orderedRingIds[orderedIndex] = ringIds[m_rayOrder[orderedIndex]];
+        }
+
+        m_points.assign(rayPoses.size(), AZ::Vector3::CreateZero());
+        m_isPointValid.assign(rayPoses.size(), false);
+        m_ranges.assign(rayPoses.size(), 0.0f);
+        m_tracedRayCount = 0LU;
+        m_elapsedTime = 0.0f;
+    }
+
+    void LidarSectorScan::Advance(float deltaTime)
+    {
+        m_elapsedTime += deltaTime;
+    }
+
+    size_t LidarSectorScan::GetRayCount() const
+    {
+        return m_rayOrder.size();
+    }
+
+    size_t LidarSectorScan::GetTracedRayCount() const
+    {
+        return m_tracedRayCount;
+    }
+
+    size_t LidarSectorScan::GetDueRayCount() const
+    {
+        if (m_scanPeriod <= 0.0f)
+        {
+            // The whole first scan is traced when it is requested.
+            return m_tracedRayCount;
+        }
+
+        const float scanProgress = AZStd::min(m_elapsedTime / m_scanPeriod, 1.0f);
+        return AZStd::max(m_tracedRayCount, static_cast<size_t>(scanProgress * static_cast<float>(GetRayCount())));
+    }
+
+    const AZStd::vector<rgl_mat3x4f>& LidarSectorScan::GetOrderedRayPoses() const
+    {
+        return m_orderedRayPoses;
+    }
+
+    const AZStd::vector<int32_t>& LidarSectorScan::GetOrderedRingIds() const
+    {
+        return m_orderedRingIds;
+    }
+
+    size_t LidarSectorScan::GetRayIndex(size_t orderedIndex) const
+    {
+        return m_rayOrder[orderedIndex];
+    }
+
+    void LidarSectorScan::StoreRayResult(size_t orderedIndex, bool isPointValid, const AZ::Vector3& point, float range)
+    {
+        const size_t rayIndex = m_rayOrder[orderedIndex];
+        m_isPointValid[rayIndex] = isPointValid;
+        m_points[rayIndex] = point;
+        m_ranges[rayIndex] = range;
+    }
+
+    void LidarSectorScan::SetTracedRayCount(size_t tracedRayCount)
+    {
+        m_tracedRayCount = tracedRayCount;
+    }
+
+    void LidarSectorScan::Complete(ROS2::RaycastResult& results, bool pointsExpected, bool rangesExpected)
+    {
+        results.m_points.clear();
+        results.m_ranges.clear();
+
+        if (pointsExpected)
+        {
+            for (size_t rayIndex = 0LU; rayIndex < m_points.size(); ++rayIndex)
+            {
+                if (m_isPointValid[rayIndex])
+                {
+                    results.m_points.push_back(m_points[rayIndex]);
+                }
+            }
+        }
+
+        if (rangesExpected)
+        {
+            results.m_ranges.assign(m_ranges.begin(), m_ranges.end());
+        }
+
+        m_scanPeriod = m_elapsedTime;
+        m_elapsedTime = 0.0f;
+        m_tracedRayCount = 0LU;
+    }
+} // namespace RGL
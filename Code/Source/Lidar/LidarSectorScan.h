@@ -0,0 +1,70 @@
+/* Copyright 2020-2021, Robotec.ai sp. z o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <AzCore/Math/Vector3.h>
+#include <AzCore/std/containers/vector.h>
+#include <ROS2/Lidar/LidarRaycasterBus.h>
+#include <rgl/api/core.h>
+
+namespace RGL
+{
+    //! Incremental scan of a rotating lidar. Each tick traces only the azimuth sector swept since the previous tick
+    //! and the sectors are accumulated into the full scan, completed once per raycast requested by the lidar sensor.
+    class LidarSectorScan
+    {
+    public:
+        //! Orders the rays by azimuth and starts a new scan.
+        //! @param ringIds Ring id of each ray, reordered together with the rays.
+        void Configure(const AZStd::vector<rgl_mat3x4f>& rayPoses, const AZStd::vector<int32_t>& ringIds);
+
+        //! Advances the scan time. The scan period is the time between the two most recent completed scans.
+        void Advance(float deltaTime);
+
+        [[nodiscard]] size_t GetRayCount() const;
+        [[nodiscard]] size_t GetTracedRayCount() const;
+        //! Returns the number of rays (in the azimuth order) which should be traced by now.
+        [[nodiscard]] size_t GetDueRayCount() const;
+
+        //! Returns the ray poses ordered by azimuth.
+        [[nodiscard]] const AZStd::vector<rgl_mat3x4f>& GetOrderedRayPoses() const;
+        //! Returns the ring ids of the rays ordered by azimuth.
+        [[nodiscard]] const AZStd::vector<int32_t>& GetOrderedRingIds() const;
+        //! Returns the configured index of the ray at the given position of the azimuth order.
+        [[nodiscard]] size_t GetRayIndex(size_t orderedIndex) const;
+
+        //! Stores the result of the ray at the given position of the azimuth order.
+        //! @param isPointValid Determines whether the ray produced a point (a hit or a max range point).
+        void StoreRayResult(size_t orderedIndex, bool isPointValid, const AZ::Vector3& point, float range);
+        void SetTracedRayCount(size_t tracedRayCount);
+
+        //! Writes the accumulated scan to the results, in the configured order of the rays, and starts the next scan.
+        void Complete(ROS2::RaycastResult& results, bool pointsExpected, bool rangesExpected);
+
+    private:
+        AZStd::vector<size_t> m_rayOrder; //!< Indices of the configured rays, ordered by azimuth.
+        AZStd::vector<rgl_mat3x4f> m_orderedRayPoses;
+        AZStd::vector<int32_t> m_orderedRingIds;
+
+        // Results indexed by the configured ray index.
+        AZStd::vector<AZ::Vector3> m_points;
+        AZStd::vector<bool> m_isPointValid;
+        AZStd::vector<float> m_ranges;
+
+        size_t m_tracedRayCount{ 0LU };
+        float m_elapsedTime{ 0.0f };
+        float m_scanPeriod{ 0.0f }; //!< Zero until the first scan is completed.
+    };
+} // namespace RGL
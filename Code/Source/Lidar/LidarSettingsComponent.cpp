@@ -0,0 +1,238 @@
+/* Copyright 2020-2021, Robotec.ai sp. z o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <AzCore/Serialization/EditContext.h>
+#include <AzCore/Serialization/SerializeContext.h>
+#include <Lidar/LidarSettingsComponent.h>
+
+namespace RGL
+{
+    void LidarSettings::Reflect(AZ::ReflectContext* context)
+    {
+        LidarCropVolume::Reflect(context);
+        PointCloudFormats::Reflect(context);
+
+        if (auto* serializeContext = azrtti_cast<AZ::SerializeContext*>(context))
+        {
+            serializeContext->Enum<LidarReturnMode>()
+                ->Value("Single", LidarReturnMode::Single)
+                ->Value("First", LidarReturnMode::First)
+                ->Value("Last", LidarReturnMode::Last)
+                ->Value("Dual", LidarReturnMode::Dual);
+
+            serializeContext->Class<LidarSettings>()
+                ->Version(9)
+                ->Field("Downsampling", &LidarSettings::m_isDownsamplingEnabled)
+                ->Field("DownsampleLeafSize", &LidarSettings::m_downsampleLeafSize)
+                ->Field("CropVolumes", &LidarSettings::m_cropVolumes)
+                ->Field("PointCloudFormat", &LidarSettings::m_pointCloudFormat)
+                ->Field("CustomPointCloudFields", &LidarSettings::m_customPointCloudFields)
+                ->Field("ResultEncoding", &LidarSettings::m_isResultEncodingEnabled)
+                ->Field("RangeImage", &LidarSettings::m_isRangeImageEnabled)
+                ->Field("RangeImagePoints", &LidarSettings::m_isRangeImagePointsEnabled)
+                ->Field("RangeImageEntityIds", &LidarSettings::m_isRangeImageEntityIdsEnabled)
+                ->Field("RangeImageIntensity", &LidarSettings::m_isRangeImageIntensityEnabled)
+                ->Field("LaserScanTopic", &LidarSettings::m_laserScanTopic)
+                ->Field("LaserScanFrameId", &LidarSettings::m_laserScanFrameId)
+                ->Field("ReturnMode", &LidarSettings::m_returnMode)
+                ->Field("BeamDivergence", &LidarSettings::m_beamDivergence)
+                ->Field("MotionDistortion", &LidarSettings::m_isMotionDistortionEnabled)
+                ->Field("ScanDuration", &LidarSettings::m_scanDuration);
+
+            if (auto* editContext = serializeContext->GetEditContext())
+            {
+                // clang-format off
+                editContext->Class<LidarSettings>("RGL Lidar Settings", "")
+                    ->DataElement(
+                        AZ::Edit::UIHandlers::Default,
+                        &LidarSettings::m_isDownsamplingEnabled,
+                        "Downsampling",
+                        "Should the points be downsampled with a voxel grid? "
+                        "Applies only to the lidars returning or publishing points only.")
+                    ->DataElement(
+                        AZ::Edit::UIHandlers::Default,
+                        &LidarSettings::m_downsampleLeafSize,
+                        "Leaf Size",
+                        "Voxel dimensions of the downsampling grid in meters.")
+                        ->Attribute(AZ::Edit::Attributes::Min, 0.001f)
+                    ->DataElement(
+                        AZ::Edit::UIHandlers::Default,
+                        &LidarSettings::m_cropVolumes,
+                        "Crop Volumes",
+                        "Volumes limiting the space in which the hits are reported, e.g. to remove the hits on the robot's own body.")
+                    ->DataElement(
+                        AZ::Edit::UIHandlers::ComboBox,
+                        &LidarSettings::m_pointCloudFormat,
+                        "Point Cloud Format",
+                        "Layout of the point cloud published by RGL. Applies only when the point cloud is published through RGL. "
+                        "The encoded layout is replaced by the default one with noise, downsampling or motion distortion.")
+                        ->EnumAttribute(PointCloudFormat::Default, "Default (is_hit, xyz)")
+                        ->EnumAttribute(PointCloudFormat::Xyz, "xyz")
+                        ->EnumAttribute(PointCloudFormat::XyzIntensity, "xyz, intensity")
+                        ->EnumAttribute(PointCloudFormat::XyzIntensityRing, "xyz, intensity, ring")
+                        ->EnumAttribute(PointCloudFormat::XyzIntensityRingDistance, "xyz, intensity, ring, distance")
+                        ->EnumAttribute(PointCloudFormat::RayIndexDistance, "Encoded (ray index, distance)")
+                        ->EnumAttribute(PointCloudFormat::Custom, "Custom")
+                        ->Attribute(AZ::Edit::Attributes::ChangeNotify, AZ::Edit::PropertyRefreshLevels::EntireTree)
+                    ->DataElement(
+                        AZ::Edit::UIHandlers::Default,
+                        &LidarSettings::m_customPointCloudFields,
+                        "Custom Fields",
+                        "Fields of the custom point cloud layout, in order.")
+                        ->Attribute(AZ::Edit::Attributes::Visibility, &LidarSettings::IsCustomPointCloudFormat)
+                    ->DataElement(
+                        AZ::Edit::UIHandlers::Default,
+                        &LidarSettings::m_isResultEncodingEnabled,
+                        "Result Encoding",
+                        "Should the points be transferred from the graph as ray indices and distances (8 instead of 16 bytes per point)? "
+                        "Applies only to the lidars returning compacted points only, without noise, downsampling and motion distortion.")
+                    ->DataElement(
+                        AZ::Edit::UIHandlers::Default,
+                        &LidarSettings::m_isRangeImageEnabled,
+                        "Range Image",
+                        "Should the results be organized into a range image with one row per beam and one column per azimuth step? "
+                        "Disables the compaction and the point cloud publishing through RGL. Not available with the sector scanning.")
+                        ->Attribute(AZ::Edit::Attributes::ChangeNotify, AZ::Edit::PropertyRefreshLevels::EntireTree)
+                    ->DataElement(
+                        AZ::Edit::UIHandlers::Default,
+                        &LidarSettings::m_isRangeImagePointsEnabled,
+                        "Range Image Points",
+                        "Should the range image include the hit points besides the ranges?")
+                        ->Attribute(AZ::Edit::Attributes::Visibility, &LidarSettings::IsRangeImageEnabled)
+                    ->DataElement(
+                        AZ::Edit::UIHandlers::Default,
+                        &LidarSettings::m_isRangeImageEntityIdsEnabled,
+                        "Range Image Entity Ids",
+                        "Should the range image include the ids of the hit entities? "
+                        "The ids map to the entities and their semantic classes through the RGL request bus.")
+                        ->Attribute(AZ::Edit::Attributes::Visibility, &LidarSettings::IsRangeImageEnabled)
+                    ->DataElement(
+                        AZ::Edit::UIHandlers::Default,
+                        &LidarSettings::m_isRangeImageIntensityEnabled,
+                        "Range Image Intensity",
+                        "Should the range image include the hit intensities, given by the RGL Reflectivity of the hit entities?")
+                        ->Attribute(AZ::Edit::Attributes::Visibility, &LidarSettings::IsRangeImageEnabled)
+                    ->DataElement(
+                        AZ::Edit::UIHandlers::Default,
+                        &LidarSettings::m_laserScanTopic,
+                        "LaserScan Topic",
+                        "Topic of the LaserScan published directly from the ray distances. Leave empty to disable. "
+                        "The rays have to be uniformly spaced in the XY plane of the lidar. Not available with the sector scanning.")
+                        ->Attribute(AZ::Edit::Attributes::ChangeNotify, AZ::Edit::PropertyRefreshLevels::EntireTree)
+                    ->DataElement(
+                        AZ::Edit::UIHandlers::Default,
+                        &LidarSettings::m_laserScanFrameId,
+                        "LaserScan Frame",
+                        "Frame of the published LaserScan.")
+                        ->Attribute(AZ::Edit::Attributes::Visibility, &LidarSettings::IsLaserScanEnabled)
+                    ->DataElement(
+                        AZ::Edit::UIHandlers::ComboBox,
+                        &LidarSettings::m_returnMode,
+                        "Return Mode",
+                        "Returns reported for each ray. Except for Single, every ray is traced as five sub-rays covering the beam "
+                        "footprint: the trace costs five times more, the hits and distances of all the sub-rays are copied to the host "
+                        "and reduced there, and the compaction and the point cloud publishing through RGL are disabled.")
+                        ->EnumAttribute(LidarReturnMode::Single, "Single")
+                        ->EnumAttribute(LidarReturnMode::First, "First")
+                        ->EnumAttribute(LidarReturnMode::Last, "Last")
+                        ->EnumAttribute(LidarReturnMode::Dual, "Dual (first and last)")
+                        ->Attribute(AZ::Edit::Attributes::ChangeNotify, AZ::Edit::PropertyRefreshLevels::EntireTree)
+                    ->DataElement(
+                        AZ::Edit::UIHandlers::Default,
+                        &LidarSettings::m_beamDivergence,
+                        "Beam Divergence",
+                        "Full angle of the beam cone in degrees.")
+                        ->Attribute(AZ::Edit::Attributes::Min, 0.0f)
+                        ->Attribute(AZ::Edit::Attributes::Suffix, " deg")
+                        ->Attribute(AZ::Edit::Attributes::Visibility, &LidarSettings::IsMultiReturnEnabled)
+                    ->DataElement(
+                        AZ::Edit::UIHandlers::Default,
+                        &LidarSettings::m_isMotionDistortionEnabled,
+                        "Motion Distortion",
+                        "Should each ray be fired from the lidar pose reached after its time offset within the scan? "
+                        "The lidar velocity is estimated from the consecutive raycasts. Not available with the sector scanning.")
+                        ->Attribute(AZ::Edit::Attributes::ChangeNotify, AZ::Edit::PropertyRefreshLevels::EntireTree)
+                    ->DataElement(
+                        AZ::Edit::UIHandlers::Default,
+                        &LidarSettings::m_scanDuration,
+                        "Scan Duration",
+                        "Duration of a single rotation of the lidar in seconds, over which the ray time offsets are spread by azimuth.")
+                        ->Attribute(AZ::Edit::Attributes::Min, 0.0f)
+                        ->Attribute(AZ::Edit::Attributes::Suffix, " s")
+                        ->Attribute(AZ::Edit::Attributes::Visibility, &LidarSettings::IsMotionDistortionEnabled);
+                // clang-format on
+            }
+        }
+    }
+
+    bool LidarSettings::IsCustomPointCloudFormat() const
+    {
+        return m_pointCloudFormat == PointCloudFormat::Custom;
+    }
+
+    bool LidarSettings::IsRangeImageEnabled() const
+    {
+        return m_isRangeImageEnabled;
+    }
+
+    bool LidarSettings::IsLaserScanEnabled() const
+    {
+        return !m_laserScanTopic.empty();
+    }
+
+    bool LidarSettings::IsMultiReturnEnabled() const
+    {
+        return m_returnMode != LidarReturnMode::Single;
+    }
+
+    bool LidarSettings::IsMotionDistortionEnabled() const
+    {
+        return m_isMotionDistortionEnabled;
+    }
+
+    void LidarSettingsComponent::Reflect(AZ::ReflectContext* context)
+    {
+        LidarSettings::Reflect(context);
+
+        if (auto* serializeContext = azrtti_cast<AZ::SerializeContext*>(context))
+        {
+            serializeContext->Class<LidarSettingsComponent, AZ::Component>()->Version(0)->Field(
+                "Settings", &LidarSettingsComponent::m_settings);
+
+            if (auto* editContext = serializeContext->GetEditContext())
+            {
+                // clang-format off
+                editContext->Class<LidarSettingsComponent>("RGL Lidar Settings", "RGL-specific settings of the lidar on this entity.")
+                    ->ClassElement(AZ::Edit::ClassElements::EditorData, "")
+                        ->Attribute(AZ::Edit::Attributes::Category, "RGL")
+                        ->Attribute(AZ::Edit::Attributes::AppearsInAddComponentMenu, AZ_CRC_CE("Game"))
+                    ->DataElement(AZ::Edit::UIHandlers::Default, &LidarSettingsComponent::m_settings, "Settings", "");
+                // clang-format on
+            }
+        }
+    }
+
+    const LidarSettings& LidarSettingsComponent::GetSettings() const
+    {
+        return m_settings;
+    }
+
+    void LidarSettingsComponent::Activate()
+    {
+    }
+
+    void LidarSettingsComponent::Deactivate()
+    {
+    }
+} // namespace RGL
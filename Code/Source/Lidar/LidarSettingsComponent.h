@@ -0,0 +1,81 @@
+/* Copyright 2020-2021, Robotec.ai sp. z o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <AzCore/Component/Component.h>
+#include <AzCore/Math/Vector3.h>
+#include <AzCore/std/string/string.h>
+#include <Lidar/LidarCrop.h>
+#include <Lidar/LidarMultiReturn.h>
+#include <Lidar/PointCloudFormat.h>
+
+namespace RGL
+{
+    //! Structure describing the RGL-specific processing of the lidar results.
+    struct LidarSettings
+    {
+        AZ_TYPE_INFO(LidarSettings, "{692a4228-c5d1-4fef-8040-0adf261efba8}");
+        static void Reflect(AZ::ReflectContext* context);
+
+        [[nodiscard]] bool IsCustomPointCloudFormat() const;
+        [[nodiscard]] bool IsRangeImageEnabled() const;
+        [[nodiscard]] bool IsLaserScanEnabled() const;
+        [[nodiscard]] bool IsMultiReturnEnabled() const;
+        [[nodiscard]] bool IsMotionDistortionEnabled() const;
+
+        //! If set to true, the points are downsampled with a voxel grid before they are published or returned.
+        bool m_isDownsamplingEnabled{ false };
+        AZ::Vector3 m_downsampleLeafSize{ 0.1f }; //!< Voxel dimensions of the downsampling grid in meters.
+        AZStd::vector<LidarCropVolume> m_cropVolumes; //!< Volumes cropping the lidar results (see LidarCrop).
+        PointCloudFormat m_pointCloudFormat{ PointCloudFormat::Default }; //!< Layout of the point cloud published by RGL.
+        AZStd::vector<PointCloudField> m_customPointCloudFields; //!< Fields of the PointCloudFormat::Custom layout.
+        //! If set to true, the points are transferred from the graph as ray indices and distances, and decoded on the host.
+        bool m_isResultEncodingEnabled{ false };
+        //! If set to true, the results are also organized into a range image (see LidarRangeImageNotificationBus).
+        bool m_isRangeImageEnabled{ false };
+        bool m_isRangeImagePointsEnabled{ false }; //!< If set to true, the range image includes the hit points.
+        bool m_isRangeImageEntityIdsEnabled{ false }; //!< If set to true, the range image includes the ids of the hit entities.
+        bool m_isRangeImageIntensityEnabled{ false }; //!< If set to true, the range image includes the hit intensities.
+        //! Topic of the LaserScan published directly from the distances of a planar lidar. Empty to disable the publishing.
+        AZStd::string m_laserScanTopic;
+        AZStd::string m_laserScanFrameId; //!< Frame of the published LaserScan.
+        LidarReturnMode m_returnMode{ LidarReturnMode::Single }; //!< Returns reported for each ray (see LidarMultiReturn).
+        float m_beamDivergence{ 0.2f }; //!< Full angle of the beam cone in degrees, used by the multiple returns.
+        //! If set to true, each ray is fired from the lidar pose reached after its time offset within the scan.
+        bool m_isMotionDistortionEnabled{ false };
+        float m_scanDuration{ 0.1f }; //!< Duration of a single rotation of the lidar in seconds.
+    };
+
+    //! Component applying the RGL lidar settings to the lidar of its entity.
+    class LidarSettingsComponent : public AZ::Component
+    {
+    public:
+        AZ_COMPONENT(LidarSettingsComponent, "{076d179b-98db-40bf-adba-a116f4078f7b}", AZ::Component);
+
+        LidarSettingsComponent() = default;
+        ~LidarSettingsComponent() override = default;
+
+        static void Reflect(AZ::ReflectContext* context);
+
+        [[nodiscard]] const LidarSettings& GetSettings() const;
+
+        // AZ::Component overrides
+        void Activate() override;
+        void Deactivate() override;
+
+    private:
+        LidarSettings m_settings;
+    };
+} // namespace RGL
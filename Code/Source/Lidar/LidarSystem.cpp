@@ -12,13 +12,22 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <AzCore/Component/ComponentApplicationBus.h>
+#include <AzCore/Component/Entity.h>
+#include <AzCore/std/algorithm.h>
+#include <Lidar/LidarRayPatternComponent.h>
+#include <Lidar/LidarSettingsComponent.h>
 #include <Lidar/LidarSystem.h>
 #include <ROS2/Lidar/LidarRegistrarBus.h>
 
 namespace RGL
 {
     LidarSystem::LidarSystem(LidarSystem&& lidarSystem)
-        : m_lidars{ AZStd::move(lidarSystem.m_lidars) }
+        : m_graphPool{ AZStd::move(lidarSystem.m_graphPool) }
+        , m_rayPatternCache{ AZStd::move(lidarSystem.m_rayPatternCache) }
+        , m_scheduler{ AZStd::move(lidarSystem.m_scheduler) }
+        , m_lidars{ AZStd::move(lidarSystem.m_lidars) }
+        , m_lidarGroups{ AZStd::move(lidarSystem.m_lidarGroups) }
     {
         lidarSystem.BusDisconnect();
     }
@@ -36,27 +45,119 @@ namespace RGL
         auto* lidarSystemManagerInterface = ROS2::LidarRegistrarInterface::Get();
         AZ_Assert(lidarSystemManagerInterface != nullptr, "The ROS2 LidarSystem Manager interface was inaccessible.");
         lidarSystemManagerInterface->RegisterLidarSystem(name, description, SupportedFeatures);
+
+        if (!LidarGroupInterface::Get())
+        {
+            LidarGroupInterface::Register(this);
+        }
     }
 
     void LidarSystem::Deactivate()
     {
+        if (LidarGroupInterface::Get() == this)
+        {
+            LidarGroupInterface::Unregister(this);
+        }
+
         ROS2::LidarSystemRequestBus::Handler::BusDisconnect();
     }
 
     void LidarSystem::Clear()
     {
+        m_lidarGroups.clear();
         m_lidars.clear();
+        m_graphPool->Clear();
+        m_scheduler->Clear();
+    }
+
+    void LidarSystem::Update(float deltaTime)
+    {
+        m_scheduler->Update(deltaTime, m_lidars);
+
+        for (auto& [groupEntityId, lidarGroup] : m_lidarGroups)
+        {
+            lidarGroup.Update(deltaTime, m_lidars);
+        }
+    }
+
+    void LidarSystem::AppendToSnapshot(Snapshot::SceneSnapshot& snapshot) const
+    {
+        for (const auto& [lidarId, lidar] : m_lidars)
+        {
+            lidar.AppendToSnapshot(snapshot);
+        }
     }
 
     ROS2::LidarId LidarSystem::CreateLidar(AZ::EntityId lidarEntityId)
     {
         const AZ::Uuid lidarUuid = AZ::Uuid::CreateRandom();
-        m_lidars.emplace(lidarUuid, LidarRaycaster(lidarUuid));
+        auto [lidarIt, isInserted] =
+            m_lidars.emplace(lidarUuid, LidarRaycaster(lidarUuid, lidarEntityId, *m_graphPool, *m_rayPatternCache, *m_scheduler));
+
+        // The lidar entity is found regardless of its activation state, so the order of its components does not matter.
+        if (const AZ::Entity* lidarEntity = AZ::Interface<AZ::ComponentApplicationRequests>::Get()->FindEntity(lidarEntityId))
+        {
+            if (const auto* rayPatternComponent = lidarEntity->FindComponent<LidarRayPatternComponent>())
+            {
+                lidarIt->second.ConfigureBuiltInRayPattern(rayPatternComponent->GetRayPatternId());
+                if (rayPatternComponent->IsSectorScanningEnabled())
+                {
+                    lidarIt->second.ConfigureSectorScanning(true);
+                }
+            }
+
+            if (const auto* settingsComponent = lidarEntity->FindComponent<LidarSettingsComponent>())
+            {
+                lidarIt->second.ApplySettings(settingsComponent->GetSettings());
+            }
+        }
+
+        for (const auto& [groupEntityId, lidarGroup] : m_lidarGroups)
+        {
+            if (lidarGroup.HasMember(lidarEntityId))
+            {
+                lidarIt->second.SetIsGroupMember(true);
+                break;
+            }
+        }
+
         return ROS2::LidarId(lidarUuid);
     }
 
     void LidarSystem::DestroyLidar(ROS2::LidarId lidarId)
     {
         m_lidars.erase(lidarId);
+        m_scheduler->RemoveLidar(lidarId);
+    }
+
+    void LidarSystem::RegisterLidarGroup(AZ::EntityId groupEntityId, const LidarGroupConfiguration& configuration)
+    {
+        m_lidarGroups.erase(groupEntityId);
+        m_lidarGroups.emplace(groupEntityId, LidarGroup(groupEntityId, configuration, *m_graphPool));
+        UpdateGroupMembership();
+    }
+
+    void LidarSystem::UnregisterLidarGroup(AZ::EntityId groupEntityId)
+    {
+        m_lidarGroups.erase(groupEntityId);
+        UpdateGroupMembership();
+    }
+
+    void LidarSystem::UpdateGroupMembership()
+    {
+        for (auto& [lidarId, lidar] : m_lidars)
+        {
+            const bool isGroupMember = AZStd::any_of(
+                m_lidarGroups.begin(),
+                m_lidarGroups.end(),
+                [&lidar](const auto& group)
+                {
+                    return group.second.HasMember(lidar.GetLidarEntityId());
+                });
+            if (isGroupMember != lidar.IsGroupMember())
+            {
+                lidar.SetIsGroupMember(isGroupMember);
+            }
+        }
     }
 } // namespace RGL
\ No newline at end of file
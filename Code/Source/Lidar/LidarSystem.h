@@ -14,12 +14,17 @@
  */
 #pragma once
 
+#include <Lidar/LidarGroup.h>
+#include <Lidar/LidarGroupBus.h>
 #include <Lidar/LidarRaycaster.h>
+#include <Lidar/LidarScheduler.h>
 #include <ROS2/Lidar/LidarSystemBus.h>
 
 namespace RGL
 {
-    class LidarSystem : protected ROS2::LidarSystemRequestBus::Handler
+    class LidarSystem
+        : protected ROS2::LidarSystemRequestBus::Handler
+        , protected LidarGroupRequests
     {
     public:
         LidarSystem() = default;
@@ -33,12 +38,31 @@ namespace RGL
         //! Deletes all lidar raycasters created by this system.
         void Clear();
 
+        //! Schedules the raycasts of the lidars within the frame budget and traces the due sectors of the sector scanning lidars.
+        //! The lidar groups trace the rays of their members at their own frequencies.
+        void Update(float deltaTime);
+
+        //! Appends all lidars created by this system to the snapshot.
+        void AppendToSnapshot(Snapshot::SceneSnapshot& snapshot) const;
+
     protected:
         // LidarSystemRequestBus overrides
         ROS2::LidarId CreateLidar(AZ::EntityId lidarEntityId) override;
         void DestroyLidar(ROS2::LidarId lidarId) override;
 
+        // LidarGroupRequests overrides
+        void RegisterLidarGroup(AZ::EntityId groupEntityId, const LidarGroupConfiguration& configuration) override;
+        void UnregisterLidarGroup(AZ::EntityId groupEntityId) override;
+
     private:
+        //! Marks the lidars which belong to any of the groups.
+        void UpdateGroupMembership();
+
+        //! Allocated separately, since the lidars keep pointers to them. Declared before the lidars, which release their graphs on destruction.
+        AZStd::unique_ptr<PipelineGraphPool> m_graphPool{ AZStd::make_unique<PipelineGraphPool>() };
+        AZStd::unique_ptr<RayPatternCache> m_rayPatternCache{ AZStd::make_unique<RayPatternCache>() };
+        AZStd::unique_ptr<LidarScheduler> m_scheduler{ AZStd::make_unique<LidarScheduler>() };
         AZStd::unordered_map<ROS2::LidarId, LidarRaycaster> m_lidars;
+        AZStd::unordered_map<AZ::EntityId, LidarGroup> m_lidarGroups;
     };
 } // namespace RGL
@@ -12,28 +12,33 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <AzCore/std/algorithm.h>
 #include <Lidar/PipelineGraph.h>
 #include <Utilities/RGLUtils.h>
+#include <rgl/api/extensions/pcl.h>
 #include <rgl/api/extensions/ros2.h>
 
 namespace RGL
 {
+    void PipelineGraph::RaycastResults::Clear()
+    {
+        m_fields.assign(DefaultFields.begin(), DefaultFields.end());
+        m_isHit.clear();
+        m_xyz.clear();
+        m_distance.clear();
+        m_rayIndex.clear();
+        m_entityId.clear();
+        m_intensity.clear();
+    }
+
     PipelineGraph::PipelineGraph()
     {
-        ConfigureRayPosesNode({Utils::IdentityTransform});
-        ConfigureRayRangesNode(0.0f, 1.0f);
-        ConfigureLidarTransformNode(AZ::Matrix3x4::CreateIdentity());
-        RGL_CHECK(rgl_node_raytrace(&m_nodes.m_rayTrace, nullptr));
+        ConfigureDefaultParameters();
+        ConfigureRaytraceNode();
         RGL_CHECK(rgl_node_points_compact(&m_nodes.m_pointsCompact));
-        ConfigureAngularNoiseNode(0.0f);
-        ConfigureDistanceNoiseNode(0.0f, 0.0f);
-        ConfigureYieldNodes(DefaultFields.data(), DefaultFields.size());
-
-        ConfigurePcTransformNode(AZ::Matrix3x4::CreateIdentity());
-        RGL_CHECK(rgl_node_points_format(&m_nodes.m_pcPublishFormat, DefaultFields.data(), aznumeric_cast<int32_t>(DefaultFields.size())));
 
         // Non-conditional connections
-        RGL_CHECK(rgl_graph_node_add_child(m_nodes.m_rayPoses, m_nodes.m_rayRanges));
+        RGL_CHECK(rgl_graph_node_add_child(m_nodes.m_rayPoses, m_nodes.m_rayRingIds));
         RGL_CHECK(rgl_graph_node_add_child(m_nodes.m_rayRanges, m_nodes.m_lidarTransform));
         RGL_CHECK(rgl_graph_node_add_child(m_nodes.m_compactYield, m_nodes.m_pointsYield));
         RGL_CHECK(rgl_graph_node_add_child(m_nodes.m_pointCloudTransform, m_nodes.m_pcPublishFormat));
@@ -45,6 +50,15 @@ namespace RGL
         : m_nodes{ other.m_nodes }
         , m_activeFeatures{ other.m_activeFeatures }
         , m_conditionalConnections(std::move(other.m_conditionalConnections))
+        , m_linearVelocity{ other.m_linearVelocity }
+        , m_angularVelocity{ other.m_angularVelocity }
+        , m_angularNoiseStdDev{ other.m_angularNoiseStdDev }
+        , m_distanceNoiseStdDevBase{ other.m_distanceNoiseStdDevBase }
+        , m_distanceNoiseStdDevRisePerMeter{ other.m_distanceNoiseStdDevRisePerMeter }
+        , m_downsampleLeafSize{ other.m_downsampleLeafSize }
+        , m_resultFields{ AZStd::move(other.m_resultFields) }
+        , m_pcFormatFields{ AZStd::move(other.m_pcFormatFields) }
+        , m_intermediateFields{ AZStd::move(other.m_intermediateFields) }
     {
         other.m_nodes = {};
         other.m_conditionalConnections.clear();
@@ -61,6 +75,8 @@ namespace RGL
         // one (or two) rgl_graph_destroy API call(s).
         SetIsNoiseEnabled(true);
         SetIsCompactEnabled(true);
+        SetIsDownsampleEnabled(true);
+        SetIsMotionDistortionEnabled(true);
         if (IsPublisherConfigured())
         {
             SetIsPcPublishingEnabled(true);
@@ -73,6 +89,20 @@ namespace RGL
         rgl_graph_destroy(m_nodes.m_rayPoses);
     }
 
+    void PipelineGraph::Reset()
+    {
+        if (IsPublisherConfigured())
+        {
+            SetIsPcPublishingEnabled(false);
+            DestroyPcPublisherNode();
+        }
+
+        m_activeFeatures = PipelineFeatureFlags::PointsCompact;
+        UpdateConnections();
+        ConfigureDefaultParameters();
+        ConfigureRaytraceNode();
+    }
+
     bool PipelineGraph::IsCompactEnabled() const
     {
         return IsFeatureEnabled(PipelineFeatureFlags::PointsCompact);
@@ -85,10 +115,24 @@ namespace RGL
     {
         return IsFeatureEnabled(PipelineFeatureFlags::Noise);
     }
+    bool PipelineGraph::IsDownsampleEnabled() const
+    {
+        return IsFeatureEnabled(PipelineFeatureFlags::PointsDownsample) && IsCompactEnabled();
+    }
+    bool PipelineGraph::IsMotionDistortionEnabled() const
+    {
+        return IsFeatureEnabled(PipelineFeatureFlags::MotionDistortion);
+    }
 
     void PipelineGraph::ConfigureRayPosesNode(const AZStd::vector<rgl_mat3x4f>& rayPoses)
     {
-        RGL_CHECK(rgl_node_rays_from_mat3x4f(&m_nodes.m_rayPoses, rayPoses.data(), aznumeric_cast<int32_t>(rayPoses.size())));
+        ConfigureRayPosesNode(rayPoses.data(), rayPoses.size());
+    }
+
+    void PipelineGraph::ConfigureRayPosesNode(const rgl_mat3x4f* rayPoses, size_t rayCount)
+    {
+        RGL_CHECK_BYTES(
+            rgl_node_rays_from_mat3x4f(&m_nodes.m_rayPoses, rayPoses, aznumeric_cast<int32_t>(rayCount)), rayCount * sizeof(rgl_mat3x4f));
     }
 
     void PipelineGraph::ConfigureRayRangesNode(float minRange, float maxRange)
@@ -97,11 +141,47 @@ namespace RGL
         RGL_CHECK(rgl_node_rays_set_range(&m_nodes.m_rayRanges, &range, 1));
     }
 
+    void PipelineGraph::ConfigureRayRangesNode(const AZStd::vector<rgl_vec2f>& rayRanges)
+    {
+        RGL_CHECK_BYTES(
+            rgl_node_rays_set_range(&m_nodes.m_rayRanges, rayRanges.data(), aznumeric_cast<int32_t>(rayRanges.size())),
+            rayRanges.size() * sizeof(rgl_vec2f));
+    }
+
+    void PipelineGraph::ConfigureRayRingIdsNode(const AZStd::vector<int32_t>& ringIds)
+    {
+        ConfigureRayRingIdsNode(ringIds.data(), ringIds.size());
+    }
+
+    void PipelineGraph::ConfigureRayRingIdsNode(const int32_t* ringIds, size_t ringIdCount)
+    {
+        RGL_CHECK_BYTES(
+            rgl_node_rays_set_ring_ids(&m_nodes.m_rayRingIds, ringIds, aznumeric_cast<int32_t>(ringIdCount)),
+            ringIdCount * sizeof(int32_t));
+    }
+
+    void PipelineGraph::ConfigureRayTimeOffsetsNode(const AZStd::vector<float>& timeOffsets)
+    {
+        RGL_CHECK_BYTES(
+            rgl_node_rays_set_time_offsets(&m_nodes.m_rayTimeOffsets, timeOffsets.data(), aznumeric_cast<int32_t>(timeOffsets.size())),
+            timeOffsets.size() * sizeof(float));
+    }
+
+    void PipelineGraph::ConfigureSensorVelocity(const AZ::Vector3& linearVelocity, const AZ::Vector3& angularVelocity)
+    {
+        m_linearVelocity = Utils::RglVector3FromAzVec3f(linearVelocity);
+        m_angularVelocity = Utils::RglVector3FromAzVec3f(angularVelocity);
+        if (IsMotionDistortionEnabled())
+        {
+            ConfigureRaytraceNode();
+        }
+    }
+
     void PipelineGraph::ConfigureYieldNodes(const rgl_field_t* fields, size_t size)
     {
+        m_resultFields.assign(fields, fields + size);
         RGL_CHECK(rgl_node_points_yield(&m_nodes.m_pointsYield, fields, aznumeric_cast<int32_t>(size)));
-        RGL_CHECK(rgl_node_points_yield(&m_nodes.m_rayTraceYield, fields, aznumeric_cast<int32_t>(size)));
-        RGL_CHECK(rgl_node_points_yield(&m_nodes.m_compactYield, fields, aznumeric_cast<int32_t>(size)));
+        ConfigureIntermediateYieldNodes();
     }
 
     void PipelineGraph::ConfigureLidarTransformNode(const AZ::Matrix3x4& lidarTransform)
@@ -119,12 +199,28 @@ namespace RGL
     void PipelineGraph::ConfigureAngularNoiseNode(float angularNoiseStdDev)
     {
         RGL_CHECK(rgl_node_gaussian_noise_angular_ray(&m_nodes.m_angularNoise, 0.0f, angularNoiseStdDev, RGL_AXIS_Z));
+        m_angularNoiseStdDev = angularNoiseStdDev;
     }
 
     void PipelineGraph::ConfigureDistanceNoiseNode(float distanceNoiseStdDevBase, float distanceNoiseStdDevRisePerMeter)
     {
         RGL_CHECK(
             rgl_node_gaussian_noise_distance(&m_nodes.m_distanceNoise, 0.0f, distanceNoiseStdDevBase, distanceNoiseStdDevRisePerMeter));
+        m_distanceNoiseStdDevBase = distanceNoiseStdDevBase;
+        m_distanceNoiseStdDevRisePerMeter = distanceNoiseStdDevRisePerMeter;
+    }
+
+    void PipelineGraph::ConfigureDownsampleNode(const AZ::Vector3& leafSize)
+    {
+        RGL_CHECK(rgl_node_points_downsample(&m_nodes.m_pointsDownsample, leafSize.GetX(), leafSize.GetY(), leafSize.GetZ()));
+        m_downsampleLeafSize = Utils::RglVector3FromAzVec3f(leafSize);
+    }
+
+    void PipelineGraph::ConfigurePcFormatNode(const AZStd::vector<rgl_field_t>& fields)
+    {
+        RGL_CHECK(rgl_node_points_format(&m_nodes.m_pcPublishFormat, fields.data(), aznumeric_cast<int32_t>(fields.size())));
+        m_pcFormatFields = fields;
+        ConfigureIntermediateYieldNodes();
     }
 
     void PipelineGraph::ConfigurePcPublisherNode(const AZStd::string& topicName, const AZStd::string& frameId, const ROS2::QoS& qosPolicy)
@@ -168,11 +264,68 @@ namespace RGL
         SetIsFeatureEnabled(PipelineFeatureFlags::Noise, value);
     }
 
+    void PipelineGraph::SetIsDownsampleEnabled(bool value)
+    {
+        SetIsFeatureEnabled(PipelineFeatureFlags::PointsDownsample, value);
+    }
+
+    void PipelineGraph::SetIsMotionDistortionEnabled(bool value)
+    {
+        if (value == IsMotionDistortionEnabled())
+        {
+            return;
+        }
+
+        SetIsFeatureEnabled(PipelineFeatureFlags::MotionDistortion, value);
+        ConfigureRaytraceNode();
+    }
+
     void PipelineGraph::Run()
     {
         RGL_CHECK(rgl_graph_run(m_nodes.m_rayPoses));
     }
 
+    void PipelineGraph::AppendToSnapshot(Snapshot::LidarData& lidar) const
+    {
+        using Snapshot::NodeType;
+
+        // The chain of the active conditional connections (see InitializeConditionalConnections).
+        lidar.m_nodes = { NodeType::RayPoses, NodeType::RayRingIds };
+        if (IsMotionDistortionEnabled())
+        {
+            lidar.m_nodes.push_back(NodeType::RayTimeOffsets);
+        }
+        lidar.m_nodes.insert(lidar.m_nodes.end(), { NodeType::RayRanges, NodeType::LidarTransform });
+        if (IsNoiseEnabled())
+        {
+            lidar.m_nodes.push_back(NodeType::AngularNoise);
+        }
+        lidar.m_nodes.push_back(IsMotionDistortionEnabled() ? NodeType::DistortedRayTrace : NodeType::RayTrace);
+        if (IsNoiseEnabled())
+        {
+            lidar.m_nodes.push_back(NodeType::DistanceNoise);
+        }
+        lidar.m_nodes.push_back(NodeType::IntermediateYield);
+        if (IsCompactEnabled())
+        {
+            lidar.m_nodes.push_back(NodeType::PointsCompact);
+        }
+        if (IsDownsampleEnabled())
+        {
+            lidar.m_nodes.push_back(NodeType::PointsDownsample);
+        }
+        lidar.m_nodes.insert(lidar.m_nodes.end(), { NodeType::IntermediateYield, NodeType::ResultsYield });
+
+        lidar.m_angularNoiseStdDev = m_angularNoiseStdDev;
+        lidar.m_distanceNoiseStdDevBase = m_distanceNoiseStdDevBase;
+        lidar.m_distanceNoiseStdDevRisePerMeter = m_distanceNoiseStdDevRisePerMeter;
+        lidar.m_downsampleLeafSize = m_downsampleLeafSize;
+        lidar.m_linearVelocity = m_linearVelocity;
+        lidar.m_angularVelocity = m_angularVelocity;
+        lidar.m_intermediateFields.assign(m_intermediateFields.begin(), m_intermediateFields.end());
+        lidar.m_resultFields.assign(m_resultFields.begin(), m_resultFields.end());
+    }
+
     bool PipelineGraph::GetResults(RaycastResults& results) const
     {
         bool success = true;
@@ -189,6 +342,15 @@ namespace RGL
             case RGL_FIELD_DISTANCE_F32:
                 success = success && GetResult(results.m_distance, RGL_FIELD_DISTANCE_F32);
                 break;
+            case RGL_FIELD_RAY_IDX_U32:
+                success = success && GetResult(results.m_rayIndex, RGL_FIELD_RAY_IDX_U32);
+                break;
+            case RGL_FIELD_ENTITY_ID_I32:
+                success = success && GetResult(results.m_entityId, RGL_FIELD_ENTITY_ID_I32);
+                break;
+            case RGL_FIELD_INTENSITY_F32:
+                success = success && GetResult(results.m_intensity, RGL_FIELD_INTENSITY_F32);
+                break;
             default:
                 success = false;
                 AZ_Assert(false, "Invalid result field type!");
@@ -199,6 +361,74 @@ namespace RGL
         return success;
     }
 
+    void PipelineGraph::ConfigureDefaultParameters()
+    {
+        ConfigureRayPosesNode({ Utils::IdentityTransform });
+        ConfigureRayRingIdsNode({ 0 });
+        ConfigureRayTimeOffsetsNode({ 0.0f });
+        ConfigureRayRangesNode(0.0f, 1.0f);
+        ConfigureLidarTransformNode(AZ::Matrix3x4::CreateIdentity());
+        ConfigureAngularNoiseNode(0.0f);
+        ConfigureDistanceNoiseNode(0.0f, 0.0f);
+        ConfigureDownsampleNode(AZ::Vector3(DefaultDownsampleLeafSize));
+        ConfigureYieldNodes(DefaultFields.data(), DefaultFields.size());
+        ConfigurePcTransformNode(AZ::Matrix3x4::CreateIdentity());
+        ConfigurePcFormatNode({ DefaultFields.begin(), DefaultFields.end() });
+    }
+
+    void PipelineGraph::ConfigureIntermediateYieldNodes()
+    {
+        // The compaction requires the hits, while the downsampling and the point cloud transform require the points.
+        AZStd::vector<rgl_field_t> fields{ DefaultFields.begin(), DefaultFields.end() };
+        const auto addFields = [&fields](const AZStd::vector<rgl_field_t>& addedFields)
+        {
+            for (rgl_field_t field : addedFields)
+            {
+                const bool isPadding = field == RGL_FIELD_PADDING_8 || field == RGL_FIELD_PADDING_16 || field == RGL_FIELD_PADDING_32;
+                if (!isPadding && AZStd::find(fields.begin(), fields.end(), field) == fields.end())
+                {
+                    fields.push_back(field);
+                }
+            }
+        };
+        addFields(m_resultFields);
+        addFields(m_pcFormatFields);
+
+        RGL_CHECK(rgl_node_points_yield(&m_nodes.m_rayTraceYield, fields.data(), aznumeric_cast<int32_t>(fields.size())));
+        RGL_CHECK(rgl_node_points_yield(&m_nodes.m_compactYield, fields.data(), aznumeric_cast<int32_t>(fields.size())));
+        m_intermediateFields = AZStd::move(fields);
+    }
+
+    void PipelineGraph::ConfigureRaytraceNode()
+    {
+        if (IsMotionDistortionEnabled())
+        {
+            RGL_CHECK(rgl_node_raytrace_with_distortion(&m_nodes.m_rayTrace, nullptr, &m_linearVelocity, &m_angularVelocity));
+            return;
+        }
+
+        RGL_CHECK(rgl_node_raytrace(&m_nodes.m_rayTrace, nullptr));
+    }
+
+    void PipelineGraph::DestroyPcPublisherNode()
+    {
+        // The publisher is disconnected when publishing is disabled, so only the publisher node is destroyed.
+        AZ_Assert(!IsPcPublishingEnabled(), "The point cloud publisher node has to be disconnected before its destruction.");
+        RGL_CHECK(rgl_graph_destroy(m_nodes.m_pointCloudPublish));
+
+        const rgl_node_t publisherNode = m_nodes.m_pointCloudPublish;
+        m_conditionalConnections.erase(
+            AZStd::remove_if(
+                m_conditionalConnections.begin(),
+                m_conditionalConnections.end(),
+                [publisherNode](const ConditionalConnection& connection)
+                {
+                    return connection.GetChild() == publisherNode;
+                }),
+            m_conditionalConnections.end());
+        m_nodes.m_pointCloudPublish = nullptr;
+    }
+
     bool PipelineGraph::IsFeatureEnabled(PipelineGraph::PipelineFeatureFlags feature) const
     {
         return m_activeFeatures & feature;
@@ -230,15 +460,40 @@ namespace RGL
             return graph.IsCompactEnabled();
         };
 
+        const ConditionType NoCompactCondition = [](const PipelineGraph& graph)
+        {
+            return !graph.IsCompactEnabled();
+        };
+
+        const ConditionType CompactWithoutDownsampleCondition = [](const PipelineGraph& graph)
+        {
+            return graph.IsCompactEnabled() && !graph.IsDownsampleEnabled();
+        };
+
+        const ConditionType DownsampleCondition = [](const PipelineGraph& graph)
+        {
+            return graph.IsDownsampleEnabled();
+        };
+
         const ConditionType PublishingCondition = [](const PipelineGraph& graph)
         {
             return graph.IsPcPublishingEnabled();
         };
 
+        const ConditionType MotionDistortionCondition = [](const PipelineGraph& graph)
+        {
+            return graph.IsMotionDistortionEnabled();
+        };
+
         // clang-format off
+        AddConditionalNode(m_nodes.m_rayTimeOffsets, m_nodes.m_rayRingIds, m_nodes.m_rayRanges, MotionDistortionCondition);
         AddConditionalNode(m_nodes.m_angularNoise, m_nodes.m_lidarTransform, m_nodes.m_rayTrace, NoiseCondition);
         AddConditionalNode(m_nodes.m_distanceNoise, m_nodes.m_rayTrace, m_nodes.m_rayTraceYield, NoiseCondition);
-        AddConditionalNode(m_nodes.m_pointsCompact, m_nodes.m_rayTraceYield, m_nodes.m_compactYield, CompactCondition);
+        AddConditionalConnection(m_nodes.m_rayTraceYield, m_nodes.m_pointsCompact, CompactCondition);
+        AddConditionalConnection(m_nodes.m_rayTraceYield, m_nodes.m_compactYield, NoCompactCondition);
+        AddConditionalConnection(m_nodes.m_pointsCompact, m_nodes.m_compactYield, CompactWithoutDownsampleCondition);
+        AddConditionalConnection(m_nodes.m_pointsCompact, m_nodes.m_pointsDownsample, DownsampleCondition);
+        AddConditionalConnection(m_nodes.m_pointsDownsample, m_nodes.m_compactYield, DownsampleCondition);
         AddConditionalConnection(m_nodes.m_compactYield, m_nodes.m_pointCloudTransform, PublishingCondition);
         // clang-format on
         if (IsPublisherConfigured())
@@ -17,34 +17,42 @@
 #include <AzCore/Math/Matrix3x3.h>
 #include <AzCore/std/containers/array.h>
 #include <ROS2/Communication/QoS.h>
+#include <Snapshot/SceneSnapshot.h>
 #include <rgl/api/core.h>
 #include <Utilities/RGLUtils.h>
 
 namespace RGL
 {
     //! Class that manages the RGL pipeline graph construction, which depends on
-    //! three conditions: point-cloud compact, noise and publication. The diagram
+    //! five conditions: point-cloud compact, downsampling, noise, motion distortion and publication. The diagram
     //! representation of this graph can be found under static/PipelineGraph.mmd.
     class PipelineGraph
     {
-    private:
+    public:
         static constexpr AZStd::array<rgl_field_t, 2> DefaultFields{ RGL_FIELD_IS_HIT_I32, RGL_FIELD_XYZ_F32 };
+        static constexpr float DefaultDownsampleLeafSize = 0.1f;
 
-    public:
         struct RaycastResults
         {
             AZStd::vector<rgl_field_t> m_fields{ DefaultFields.data(), DefaultFields.data() + DefaultFields.size() };
             AZStd::vector<int32_t> m_isHit;
             AZStd::vector<rgl_vec3f> m_xyz;
             AZStd::vector<float> m_distance;
+            AZStd::vector<uint32_t> m_rayIndex;
+            AZStd::vector<int32_t> m_entityId;
+            AZStd::vector<float> m_intensity;
+
+            //! Clears all the results and restores the default fields. The buffers keep their capacity.
+            void Clear();
         };
 
         struct Nodes
         {
-            rgl_node_t m_rayPoses{ nullptr }, m_rayRanges{ nullptr }, m_lidarTransform{ nullptr }, m_angularNoise{ nullptr },
-                m_rayTrace{ nullptr }, m_distanceNoise{ nullptr }, m_rayTraceYield{ nullptr }, m_pointsCompact{ nullptr },
-                m_compactYield{ nullptr }, m_pointsYield{ nullptr }, m_pointCloudTransform{ nullptr }, m_pcPublishFormat{ nullptr },
-                m_pointCloudPublish{ nullptr };
+            rgl_node_t m_rayPoses{ nullptr }, m_rayRingIds{ nullptr }, m_rayTimeOffsets{ nullptr }, m_rayRanges{ nullptr },
+                m_lidarTransform{ nullptr },
+                m_angularNoise{ nullptr }, m_rayTrace{ nullptr }, m_distanceNoise{ nullptr }, m_rayTraceYield{ nullptr },
+                m_pointsCompact{ nullptr }, m_pointsDownsample{ nullptr }, m_compactYield{ nullptr }, m_pointsYield{ nullptr },
+                m_pointCloudTransform{ nullptr }, m_pcPublishFormat{ nullptr }, m_pointCloudPublish{ nullptr };
         };
 
         PipelineGraph();
@@ -52,29 +60,60 @@ namespace RGL
         PipelineGraph(PipelineGraph&& other);
         ~PipelineGraph();
 
+        //! Restores the default configuration of the graph, so that it can be reused by another lidar.
+        //! The point cloud publisher node is destroyed, since it keeps the ROS 2 topic advertised.
+        void Reset();
+
         [[nodiscard]] bool IsCompactEnabled() const;
         [[nodiscard]] bool IsPcPublishingEnabled() const;
         [[nodiscard]] bool IsNoiseEnabled() const;
+        //! Downsampling requires the compacted points, so it is active only when the compaction is enabled as well.
+        [[nodiscard]] bool IsDownsampleEnabled() const;
+        [[nodiscard]] bool IsMotionDistortionEnabled() const;
         [[nodiscard]] bool IsPublisherConfigured() const
         {
             return m_nodes.m_pointCloudPublish;
         }
 
         void ConfigureRayPosesNode(const AZStd::vector<rgl_mat3x4f>& rayPoses);
+        void ConfigureRayPosesNode(const rgl_mat3x4f* rayPoses, size_t rayCount);
         void ConfigureRayRangesNode(float minRange, float maxRange);
+        //! Configures a separate range for each ray. The number of ranges has to match the number of rays.
+        void ConfigureRayRangesNode(const AZStd::vector<rgl_vec2f>& rayRanges);
+        //! Configures the ring id of each ray. With fewer ring ids than rays, the ring ids are repeated,
+        //! so the number of rays has to be a multiple of the number of ring ids.
+        void ConfigureRayRingIdsNode(const AZStd::vector<int32_t>& ringIds);
+        void ConfigureRayRingIdsNode(const int32_t* ringIds, size_t ringIdCount);
+        //! Configures the time offset (in milliseconds) of each ray. The number of offsets has to match the number of rays.
+        void ConfigureRayTimeOffsetsNode(const AZStd::vector<float>& timeOffsets);
+        //! Configures the velocities of the sensor (in its frame) used by the motion distortion.
+        //! @param linearVelocity Linear velocity in meters per second.
+        //! @param angularVelocity Roll, pitch and yaw rates in radians per second.
+        void ConfigureSensorVelocity(const AZ::Vector3& linearVelocity, const AZ::Vector3& angularVelocity);
+        //! Configures the fields of the raycast results. The yield nodes inside the graph also pass the fields
+        //! required by their child nodes, since RGL yield nodes pass only their own fields.
         void ConfigureYieldNodes(const rgl_field_t* fields, size_t size);
         void ConfigureLidarTransformNode(const AZ::Matrix3x4& lidarTransform);
         void ConfigurePcTransformNode(const AZ::Matrix3x4& pcTransform);
         void ConfigureAngularNoiseNode(float angularNoiseStdDev);
         void ConfigureDistanceNoiseNode(float distanceNoiseStdDevBase, float distanceNoiseStdDevRisePerMeter);
+        void ConfigureDownsampleNode(const AZ::Vector3& leafSize);
+        //! Configures the fields (and their order) of the published point cloud.
+        void ConfigurePcFormatNode(const AZStd::vector<rgl_field_t>& fields);
         void ConfigurePcPublisherNode(const AZStd::string& topicName, const AZStd::string& frameId, const ROS2::QoS& qosPolicy);
 
         void SetIsCompactEnabled(bool value);
         void SetIsPcPublishingEnabled(bool value);
         void SetIsNoiseEnabled(bool value);
+        void SetIsDownsampleEnabled(bool value);
+        //! With the motion distortion, each ray is fired from the sensor pose reached after its time offset.
+        void SetIsMotionDistortionEnabled(bool value);
 
         void Run();
 
+        //! Records the active nodes and their parameters, except for the ray data configured by the owner of the graph.
+        void AppendToSnapshot(Snapshot::LidarData& lidar) const;
+
         //! Get the raycast results.
         //! @param results Raycast results destination.
         //! @return If successful returns true, otherwise returns false.
@@ -88,7 +127,9 @@ namespace RGL
             Noise                   = 1,
             PointsCompact           = 1 << 1,
             PointCloudPublishing    = 1 << 2,
-            All                     = Noise | PointsCompact | PointCloudPublishing,
+            PointsDownsample        = 1 << 3,
+            MotionDistortion        = 1 << 4,
+            All                     = Noise | PointsCompact | PointCloudPublishing | PointsDownsample | MotionDistortion,
         };
         // clang-format on
 
@@ -100,6 +141,11 @@ namespace RGL
             ConditionalConnection(rgl_node_t parent, rgl_node_t child, const ConditionType& condition, bool activate = false);
             void Update(const PipelineGraph& graph);
 
+            [[nodiscard]] rgl_node_t GetChild() const
+            {
+                return m_child;
+            }
+
         private:
             bool m_isActive;
             ConditionType m_condition;
@@ -125,10 +171,20 @@ namespace RGL
 
             result.resize(resultSize);
             bool success = false;
-            Utils::ErrorCheck(rgl_graph_get_result_data(m_nodes.m_pointsYield, rglFieldType, result.data()), __FILE__, __LINE__, &success);
+            Utils::ErrorCheck(
+                RGL_TRACE(rgl_graph_get_result_data(m_nodes.m_pointsYield, rglFieldType, result.data()), result.size() * sizeof(FieldType)),
+                __FILE__,
+                __LINE__,
+                &success);
             return success;
         }
 
+        void ConfigureDefaultParameters();
+        //! Configures the yield nodes preceding the compaction, downsampling and publishing with all the fields they require.
+        void ConfigureIntermediateYieldNodes();
+        //! Configures the raytrace node with or without the motion distortion, depending on the active features.
+        void ConfigureRaytraceNode();
+        void DestroyPcPublisherNode();
         void SetIsFeatureEnabled(PipelineFeatureFlags feature, bool value);
         void InitializeConditionalConnections();
         void UpdateConnections();
@@ -141,6 +197,15 @@ namespace RGL
 
         PipelineFeatureFlags m_activeFeatures{ PointsCompact };
         Nodes m_nodes;
+        rgl_vec3f m_linearVelocity{};
+        rgl_vec3f m_angularVelocity{};
+        float m_angularNoiseStdDev{ 0.0f };
+        float m_distanceNoiseStdDevBase{ 0.0f };
+        float m_distanceNoiseStdDevRisePerMeter{ 0.0f };
+        rgl_vec3f m_downsampleLeafSize{};
+        AZStd::vector<rgl_field_t> m_resultFields;
+        AZStd::vector<rgl_field_t> m_pcFormatFields;
+        AZStd::vector<rgl_field_t> m_intermediateFields; //!< Fields of the yield nodes preceding the compaction and publishing.
         std::vector<ConditionalConnection> m_conditionalConnections;
     };
 } // namespace RGL
@@ -0,0 +1,120 @@
+/* Copyright 2020-2021, Robotec.ai sp. z o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <AzCore/Console/IConsole.h>
+#include <AzCore/std/string/conversions.h>
+#include <Lidar/PipelineGraphPool.h>
+
+namespace RGL
+{
+    AZ_CVAR(
+        uint32_t,
+        rgl_graph_pool_capacity,
+        32U,
+        nullptr,
+        AZ::ConsoleFunctorFlags::DontReplicate,
+        "Maximum number of pipeline graphs kept for reuse after their lidars are destroyed.");
+
+    static void rgl_graph_pool_stats([[maybe_unused]] const AZ::ConsoleCommandContainer& arguments)
+    {
+        const PipelineGraphPool* graphPool = PipelineGraphPoolInterface::Get();
+        if (!graphPool)
+        {
+            AZ_Error("RGL", false, "The pipeline graph pool is not available.");
+            return;
+        }
+
+        const PipelineGraphPool::Metrics& metrics = graphPool->GetMetrics();
+        AZ_Printf(
+            "RGL",
+            "Pipeline graph pool: %zu pooled, %s hits, %s misses, %s releases, %s discards.\n",
+            graphPool->GetSize(),
+            AZStd::to_string(metrics.m_hits).c_str(),
+            AZStd::to_string(metrics.m_misses).c_str(),
+            AZStd::to_string(metrics.m_releases).c_str(),
+            AZStd::to_string(metrics.m_discards).c_str());
+    }
+
+    AZ_CONSOLEFREEFUNC(rgl_graph_pool_stats, AZ::ConsoleFunctorFlags::DontReplicate, "Prints the pipeline graph pool metrics.");
+
+    PipelineGraphPool::PipelineGraphPool()
+    {
+        if (!PipelineGraphPoolInterface::Get())
+        {
+            PipelineGraphPoolInterface::Register(this);
+        }
+    }
+
+    PipelineGraphPool::~PipelineGraphPool()
+    {
+        if (PipelineGraphPoolInterface::Get() == this)
+        {
+            PipelineGraphPoolInterface::Unregister(this);
+        }
+    }
+
+    PipelineGraphPool::PooledGraph PipelineGraphPool::Acquire()
+    {
+        if (m_pooledGraphs.empty())
+        {
+            ++m_metrics.m_misses;
+            return PooledGraph{ AZStd::make_unique<PipelineGraph>() };
+        }
+
+        ++m_metrics.m_hits;
+        PooledGraph pooledGraph = AZStd::move(m_pooledGraphs.back());
+        m_pooledGraphs.pop_back();
+        return pooledGraph;
+    }
+
+    void PipelineGraphPool::Release(PooledGraph&& pooledGraph)
+    {
+        if (!pooledGraph.m_graph)
+        {
+            return;
+        }
+
+        if (m_pooledGraphs.size() >= rgl_graph_pool_capacity)
+        {
+            ++m_metrics.m_discards;
+            pooledGraph.m_graph.reset();
+            return;
+        }
+
+        ++m_metrics.m_releases;
+        pooledGraph.m_graph->Reset();
+
+        // The buffers are cleared, but keep their capacity.
+        pooledGraph.m_rglResults.Clear();
+        pooledGraph.m_results.m_points.clear();
+        pooledGraph.m_results.m_ranges.clear();
+
+        m_pooledGraphs.push_back(AZStd::move(pooledGraph));
+    }
+
+    void PipelineGraphPool::Clear()
+    {
+        m_pooledGraphs.clear();
+    }
+
+    size_t PipelineGraphPool::GetSize() const
+    {
+        return m_pooledGraphs.size();
+    }
+
+    const PipelineGraphPool::Metrics& PipelineGraphPool::GetMetrics() const
+    {
+        return m_metrics;
+    }
+} // namespace RGL
@@ -0,0 +1,72 @@
+/* Copyright 2020-2021, Robotec.ai sp. z o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <AzCore/Interface/Interface.h>
+#include <AzCore/RTTI/RTTI.h>
+#include <AzCore/std/containers/vector.h>
+#include <AzCore/std/smart_ptr/unique_ptr.h>
+#include <Lidar/PipelineGraph.h>
+#include <ROS2/Lidar/LidarRaycasterBus.h>
+
+namespace RGL
+{
+    //! Pool of pipeline graphs (and their result buffers) released by destroyed lidars.
+    //! Graphs are reset on release and handed out to the newly created lidars, so that spawning lidars
+    //! does not create and destroy all the RGL nodes each time.
+    class PipelineGraphPool
+    {
+    public:
+        AZ_RTTI(PipelineGraphPool, "{229baa92-c246-44d2-91de-6dd2295e33c7}");
+
+        //! Graph with the result buffers of a single lidar.
+        struct PooledGraph
+        {
+            AZStd::unique_ptr<PipelineGraph> m_graph;
+            PipelineGraph::RaycastResults m_rglResults;
+            ROS2::RaycastResult m_results;
+        };
+
+        struct Metrics
+        {
+            AZ::u64 m_hits{ 0LU }; //!< Graphs acquired from the pool.
+            AZ::u64 m_misses{ 0LU }; //!< Graphs created because the pool was empty.
+            AZ::u64 m_releases{ 0LU }; //!< Graphs returned to the pool.
+            AZ::u64 m_discards{ 0LU }; //!< Graphs destroyed because the pool was full.
+        };
+
+        PipelineGraphPool();
+        PipelineGraphPool(const PipelineGraphPool& other) = delete;
+        virtual ~PipelineGraphPool();
+
+        //! Returns a graph in the default configuration, reusing a pooled one if available.
+        [[nodiscard]] PooledGraph Acquire();
+
+        //! Resets the graph and stores it for reuse. The graph is destroyed if the pool is full (see rgl_graph_pool_capacity).
+        void Release(PooledGraph&& pooledGraph);
+
+        //! Destroys all the pooled graphs.
+        void Clear();
+
+        [[nodiscard]] size_t GetSize() const;
+        [[nodiscard]] const Metrics& GetMetrics() const;
+
+    private:
+        AZStd::vector<PooledGraph> m_pooledGraphs;
+        Metrics m_metrics;
+    };
+
+    using PipelineGraphPoolInterface = AZ::Interface<PipelineGraphPool>;
+} // namespace RGL
@@ -0,0 +1,117 @@
+/* Copyright 2020-2021, Robotec.ai sp. z o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <AzCore/Serialization/SerializeContext.h>
+#include <Lidar/PipelineGraph.h>
+#include <Lidar/PointCloudFormat.h>
+
+namespace RGL
+{
+    namespace
+    {
+        rgl_field_t GetRglField(PointCloudField field)
+        {
+            switch (field)
+            {
+            case PointCloudField::Xyz:
+                return RGL_FIELD_XYZ_F32;
+            case PointCloudField::Intensity:
+                return RGL_FIELD_INTENSITY_F32;
+            case PointCloudField::RingId:
+                return RGL_FIELD_RING_ID_U16;
+            case PointCloudField::Distance:
+                return RGL_FIELD_DISTANCE_F32;
+            case PointCloudField::EntityId:
+                return RGL_FIELD_ENTITY_ID_I32;
+            case PointCloudField::RayIndex:
+                return RGL_FIELD_RAY_IDX_U32;
+            case PointCloudField::Padding8:
+                return RGL_FIELD_PADDING_8;
+            case PointCloudField::Padding16:
+                return RGL_FIELD_PADDING_16;
+            case PointCloudField::Padding32:
+                return RGL_FIELD_PADDING_32;
+            case PointCloudField::TimeStamp:
+                return RGL_FIELD_TIME_STAMP_F64;
+            }
+
+            AZ_Assert(false, "Unknown point cloud field.");
+            return RGL_FIELD_PADDING_8;
+        }
+    } // namespace
+
+    namespace PointCloudFormats
+    {
+        void Reflect(AZ::ReflectContext* context)
+        {
+            if (auto* serializeContext = azrtti_cast<AZ::SerializeContext*>(context))
+            {
+                serializeContext->Enum<PointCloudFormat>()
+                    ->Value("Default", PointCloudFormat::Default)
+                    ->Value("Xyz", PointCloudFormat::Xyz)
+                    ->Value("XyzIntensity", PointCloudFormat::XyzIntensity)
+                    ->Value("XyzIntensityRing", PointCloudFormat::XyzIntensityRing)
+                    ->Value("XyzIntensityRingDistance", PointCloudFormat::XyzIntensityRingDistance)
+                    ->Value("Custom", PointCloudFormat::Custom)
+                    ->Value("RayIndexDistance", PointCloudFormat::RayIndexDistance);
+
+                serializeContext->Enum<PointCloudField>()
+                    ->Value("Xyz", PointCloudField::Xyz)
+                    ->Value("Intensity", PointCloudField::Intensity)
+                    ->Value("RingId", PointCloudField::RingId)
+                    ->Value("Distance", PointCloudField::Distance)
+                    ->Value("EntityId", PointCloudField::EntityId)
+                    ->Value("RayIndex", PointCloudField::RayIndex)
+                    ->Value("Padding8", PointCloudField::Padding8)
+                    ->Value("Padding16", PointCloudField::Padding16)
+                    ->Value("Padding32", PointCloudField::Padding32)
+                    ->Value("TimeStamp", PointCloudField::TimeStamp);
+            }
+        }
+
+        AZStd::vector<rgl_field_t> GetFields(PointCloudFormat format, const AZStd::vector<PointCloudField>& customFields)
+        {
+            switch (format)
+            {
+            case PointCloudFormat::Xyz:
+                return { RGL_FIELD_XYZ_F32 };
+            case PointCloudFormat::XyzIntensity:
+                return { RGL_FIELD_XYZ_F32, RGL_FIELD_INTENSITY_F32 };
+            case PointCloudFormat::XyzIntensityRing:
+                return { RGL_FIELD_XYZ_F32, RGL_FIELD_INTENSITY_F32, RGL_FIELD_RING_ID_U16 };
+            case PointCloudFormat::XyzIntensityRingDistance:
+                return { RGL_FIELD_XYZ_F32, RGL_FIELD_INTENSITY_F32, RGL_FIELD_RING_ID_U16, RGL_FIELD_DISTANCE_F32 };
+            case PointCloudFormat::RayIndexDistance:
+                return { RGL_FIELD_RAY_IDX_U32, RGL_FIELD_DISTANCE_F32 };
+            case PointCloudFormat::Custom:
+                if (!customFields.empty())
+                {
+                    AZStd::vector<rgl_field_t> fields;
+                    fields.reserve(customFields.size());
+                    for (PointCloudField field : customFields)
+                    {
+                        fields.push_back(GetRglField(field));
+                    }
+                    return fields;
+                }
+
+                AZ_Warning("RGL", false, "The custom point cloud format has no fields. Using the default format instead.");
+                [[fallthrough]];
+            case PointCloudFormat::Default:
+            default:
+                return { PipelineGraph::DefaultFields.begin(), PipelineGraph::DefaultFields.end() };
+            }
+        }
+    } // namespace PointCloudFormats
+} // namespace RGL
@@ -0,0 +1,70 @@
+/* Copyright 2020-2021, Robotec.ai sp. z o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <AzCore/RTTI/TypeInfoSimple.h>
+#include <AzCore/std/containers/vector.h>
+#include <rgl/api/core.h>
+
+namespace AZ
+{
+    class ReflectContext;
+} // namespace AZ
+
+namespace RGL
+{
+    //! Layouts of the point clouds published by the RGL graph. All the layouts except Default are padding-free.
+    enum class PointCloudFormat : AZ::u8
+    {
+        Default = 0, //!< is_hit (int32), x, y, z (float32).
+        Xyz, //!< x, y, z (float32).
+        XyzIntensity, //!< x, y, z, intensity (float32).
+        XyzIntensityRing, //!< x, y, z, intensity (float32), ring (uint16), as published by the Velodyne driver without time.
+        XyzIntensityRingDistance, //!< x, y, z, intensity (float32), ring (uint16), distance (float32).
+        Custom, //!< Fields listed in the lidar settings.
+        //! Ray index (uint32), distance (float32). Decodable with the ray poses of the lidar (see RGL/PointDecoding.h).
+        RayIndexDistance,
+    };
+
+    //! Point fields available to the custom point cloud format.
+    enum class PointCloudField : AZ::u8
+    {
+        Xyz = 0,
+        Intensity,
+        RingId,
+        Distance,
+        EntityId,
+        RayIndex,
+        Padding8,
+        Padding16,
+        Padding32,
+        TimeStamp, //!< Time at which the ray of the point was fired, in seconds (float64).
+    };
+
+    namespace PointCloudFormats
+    {
+        void Reflect(AZ::ReflectContext* context);
+
+        //! Returns the RGL fields of the format, in the order of the published point layout.
+        //! @param customFields Fields of the Custom format. Ignored by the other formats.
+        [[nodiscard]] AZStd::vector<rgl_field_t> GetFields(PointCloudFormat format, const AZStd::vector<PointCloudField>& customFields);
+    } // namespace PointCloudFormats
+} // namespace RGL
+
+namespace AZ
+{
+    AZ_TYPE_INFO_SPECIALIZE(RGL::PointCloudFormat, "{5d1e3f7c-2b64-4d8e-9a31-0f6c7b2e4a58}");
+    AZ_TYPE_INFO_SPECIALIZE(RGL::PointCloudField, "{b84c0e92-7f13-45a6-8d2e-c39a16f5e0d7}");
+} // namespace AZ
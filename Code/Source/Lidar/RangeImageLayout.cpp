@@ -0,0 +1,66 @@
+/* Copyright 2020-2021, Robotec.ai sp. z o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <AzCore/Math/MathUtils.h>
+#include <AzCore/std/algorithm.h>
+#include <Lidar/RangeImageLayout.h>
+
+namespace RGL
+{
+    RangeImageLayout RangeImageLayout::Create(const AZStd::vector<rgl_mat3x4f>& rayPoses, const AZStd::vector<int32_t>& ringIds)
+    {
+        AZ_Assert(rayPoses.size() == ringIds.size(), "Each ray requires its ring id.");
+
+        RangeImageLayout layout;
+        for (int32_t ringId : ringIds)
+        {
+            layout.m_rowCount = AZStd::max(layout.m_rowCount, aznumeric_cast<size_t>(ringId) + 1LU);
+        }
+
+        AZStd::vector<AZStd::vector<int32_t>> ringRays(layout.m_rowCount);
+        for (size_t rayIndex = 0LU; rayIndex < ringIds.size(); ++rayIndex)
+        {
+            ringRays[ringIds[rayIndex]].push_back(aznumeric_cast<int32_t>(rayIndex));
+        }
+
+        // Rays are cast along the Z axis of their poses.
+        AZStd::vector<float> azimuths(rayPoses.size());
+        for (size_t rayIndex = 0LU; rayIndex < rayPoses.size(); ++rayIndex)
+        {
+            azimuths[rayIndex] = AZStd::atan2(rayPoses[rayIndex].value[1][2], rayPoses[rayIndex].value[0][2]);
+        }
+
+        for (AZStd::vector<int32_t>& rays : ringRays)
+        {
+            AZStd::stable_sort(
+                rays.begin(),
+                rays.end(),
+                [&azimuths](int32_t lhs, int32_t rhs)
+                {
+                    return azimuths[lhs] < azimuths[rhs];
+                });
+            layout.m_columnCount = AZStd::max(layout.m_columnCount, rays.size());
+        }
+
+        layout.m_rayIndices.assign(layout.m_rowCount * layout.m_columnCount, EmptyCell);
+        for (size_t ring = 0LU; ring < ringRays.size(); ++ring)
+        {
+            // The highest ring is the top row of the image.
+            const size_t row = layout.m_rowCount - 1LU - ring;
+            AZStd::copy(ringRays[ring].begin(), ringRays[ring].end(), layout.m_rayIndices.begin() + row * layout.m_columnCount);
+        }
+
+        return layout;
+    }
+} // namespace RGL
@@ -0,0 +1,37 @@
+/* Copyright 2020-2021, Robotec.ai sp. z o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <AzCore/std/containers/vector.h>
+#include <rgl/api/core.h>
+
+namespace RGL
+{
+    //! Mapping of the rays of a ray pattern to the cells of the range image (see LidarRangeImage).
+    struct RangeImageLayout
+    {
+        //! Value of the cells not covered by any ray, e.g. in rings with fewer rays than the others.
+        static constexpr int32_t EmptyCell = -1;
+
+        //! Assigns the rays of each ring to the columns by increasing azimuth.
+        //! @param rayPoses Ray poses of the pattern in the lidar frame.
+        //! @param ringIds Ring of each ray, numbered from the lowest elevation up.
+        [[nodiscard]] static RangeImageLayout Create(const AZStd::vector<rgl_mat3x4f>& rayPoses, const AZStd::vector<int32_t>& ringIds);
+
+        size_t m_rowCount{ 0LU };
+        size_t m_columnCount{ 0LU };
+        AZStd::vector<int32_t> m_rayIndices; //!< Row-major index of the ray of each cell or EmptyCell.
+    };
+} // namespace RGL
@@ -0,0 +1,172 @@
+/* Copyright 2020-2021, Robotec.ai sp. z o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <AzCore/Math/MathUtils.h>
+#include <AzCore/Math/Matrix3x4.h>
+#include <AzCore/Math/Quaternion.h>
+#include <AzCore/std/algorithm.h>
+#include <AzCore/std/hash.h>
+#include <Lidar/RayPatternCache.h>
+#include <Utilities/RGLUtils.h>
+
+namespace RGL
+{
+    namespace
+    {
+        size_t HashOrientations(const AZStd::vector<AZ::Vector3>& orientations)
+        {
+            size_t hash = orientations.size();
+            for (const AZ::Vector3& orientation : orientations)
+            {
+                AZStd::hash_combine(hash, orientation.GetX());
+                AZStd::hash_combine(hash, orientation.GetY());
+                AZStd::hash_combine(hash, orientation.GetZ());
+            }
+            return hash;
+        }
+
+        rgl_mat3x4f CreateRayPose(const AZ::Vector3& orientation)
+        {
+            // Since we provide a transform for the Z axis unit vector we need an additional PI / 2 added to the pitch.
+            const AZ::Matrix3x4 rayTransform = AZ::Matrix3x4::CreateFromQuaternion(AZ::Quaternion::CreateFromEulerRadiansZYX({
+                orientation.GetX(),
+                -orientation.GetY() + AZ::Constants::HalfPi,
+                orientation.GetZ(),
+            }));
+
+            return Utils::RglMat3x4FromAzMatrix3x4(rayTransform);
+        }
+
+        //! Assigns the rays to rings by their elevation, so that the rays fired by the same channel share a ring id.
+        AZStd::vector<int32_t> ComputeRingIds(const AZStd::vector<rgl_mat3x4f>& rayPoses)
+        {
+            // Elevations are compared in steps of 1e-4 rad to absorb the floating point errors of the ray pose generation.
+            constexpr float ElevationStep = 1e-4f;
+
+            AZStd::vector<int32_t> elevationSteps;
+            elevationSteps.reserve(rayPoses.size());
+            for (const rgl_mat3x4f& rayPose : rayPoses)
+            {
+                // Rays are cast along the Z axis of their poses.
+                const float elevation = AZStd::asin(AZStd::clamp(rayPose.value[2][2], -1.0f, 1.0f));
+                elevationSteps.push_back(aznumeric_cast<int32_t>(AZStd::round(elevation / ElevationStep)));
+            }
+
+            AZStd::vector<int32_t> ringElevations = elevationSteps;
+            AZStd::sort(ringElevations.begin(), ringElevations.end());
+            ringElevations.erase(AZStd::unique(ringElevations.begin(), ringElevations.end()), ringElevations.end());
+
+            AZStd::vector<int32_t> ringIds;
+            ringIds.reserve(rayPoses.size());
+            for (int32_t elevationStep : elevationSteps)
+            {
+                const auto ringIt = AZStd::lower_bound(ringElevations.begin(), ringElevations.end(), elevationStep);
+                ringIds.push_back(aznumeric_cast<int32_t>(AZStd::distance(ringElevations.begin(), ringIt)));
+            }
+            return ringIds;
+        }
+
+        //! Computes the part of the rotation after which each ray is fired. The rotation sweeps the azimuths in the ascending
+        //! order starting from -PI, as the sector scans do.
+        AZStd::vector<float> ComputeSweepFractions(const AZStd::vector<rgl_mat3x4f>& rayPoses)
+        {
+            AZStd::vector<float> sweepFractions;
+            sweepFractions.reserve(rayPoses.size());
+            for (const rgl_mat3x4f& rayPose : rayPoses)
+            {
+                const float azimuth = AZStd::atan2(rayPose.value[1][2], rayPose.value[0][2]);
+                sweepFractions.push_back(AZStd::clamp((azimuth + AZ::Constants::Pi) / AZ::Constants::TwoPi, 0.0f, 1.0f));
+            }
+            return sweepFractions;
+        }
+    } // namespace
+
+    AZStd::shared_ptr<const RayPattern> RayPatternCache::GetRayPattern(const AZStd::vector<AZ::Vector3>& orientations)
+    {
+        RemoveExpiredPatterns();
+
+        const size_t hash = HashOrientations(orientations);
+        auto [rangeBegin, rangeEnd] = m_patterns.equal_range(hash);
+        for (auto patternIt = rangeBegin; patternIt != rangeEnd; ++patternIt)
+        {
+            AZStd::shared_ptr<const RayPattern> pattern = patternIt->second.lock();
+            if (pattern && pattern->m_orientations == orientations)
+            {
+                return pattern;
+            }
+        }
+
+        auto pattern = AZStd::make_shared<RayPattern>();
+        pattern->m_orientations = orientations;
+        pattern->m_rayPoses.reserve(orientations.size());
+        for (const AZ::Vector3& orientation : orientations)
+        {
+            pattern->m_rayPoses.push_back(CreateRayPose(orientation));
+        }
+        pattern->m_ringIds = ComputeRingIds(pattern->m_rayPoses);
+        pattern->m_sweepFractions = ComputeSweepFractions(pattern->m_rayPoses);
+        pattern->m_rangeImageLayout = RangeImageLayout::Create(pattern->m_rayPoses, pattern->m_ringIds);
+
+        m_patterns.emplace(hash, pattern);
+        return pattern;
+    }
+
+    AZStd::shared_ptr<const RayPattern> RayPatternCache::GetRayPattern(RayPatternId patternId)
+    {
+        const RayPatternDescription* description = RayPatternLibrary::GetDescription(patternId);
+        if (description == nullptr)
+        {
+            return nullptr;
+        }
+
+        AZStd::weak_ptr<const RayPattern>& cachedPattern = m_builtInPatterns[static_cast<AZ::u8>(patternId)];
+        if (AZStd::shared_ptr<const RayPattern> pattern = cachedPattern.lock())
+        {
+            return pattern;
+        }
+
+        auto pattern = AZStd::make_shared<RayPattern>();
+        pattern->m_patternId = patternId;
+        pattern->m_rayPoses = RayPatternLibrary::GenerateRayPoses(*description);
+        pattern->m_ringIds = ComputeRingIds(pattern->m_rayPoses);
+        pattern->m_sweepFractions = ComputeSweepFractions(pattern->m_rayPoses);
+        pattern->m_rangeImageLayout = RangeImageLayout::Create(pattern->m_rayPoses, pattern->m_ringIds);
+        AZ_Printf("RGL", "Generated the %s ray pattern with %zu rays.", description->m_name, pattern->m_rayPoses.size());
+
+        cachedPattern = pattern;
+        return pattern;
+    }
+
+    size_t RayPatternCache::GetSize() const
+    {
+        size_t size = 0LU;
+        for (const auto& [hash, pattern] : m_patterns)
+        {
+            size += pattern.expired() ? 0LU : 1LU;
+        }
+        for (const auto& [patternId, pattern] : m_builtInPatterns)
+        {
+            size += pattern.expired() ? 0LU : 1LU;
+        }
+        return size;
+    }
+
+    void RayPatternCache::RemoveExpiredPatterns()
+    {
+        for (auto patternIt = m_patterns.begin(); patternIt != m_patterns.end();)
+        {
+            patternIt = patternIt->second.expired() ? m_patterns.erase(patternIt) : AZStd::next(patternIt);
+        }
+    }
+} // namespace RGL
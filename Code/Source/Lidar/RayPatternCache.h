@@ -0,0 +1,62 @@
+/* Copyright 2020-2021, Robotec.ai sp. z o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <AzCore/Math/Vector3.h>
+#include <AzCore/std/containers/unordered_map.h>
+#include <AzCore/std/containers/vector.h>
+#include <AzCore/std/smart_ptr/shared_ptr.h>
+#include <AzCore/std/smart_ptr/weak_ptr.h>
+#include <Lidar/RangeImageLayout.h>
+#include <Lidar/RayPatternLibrary.h>
+#include <rgl/api/core.h>
+
+namespace RGL
+{
+    //! Ray poses generated from the ray orientations of a lidar.
+    struct RayPattern
+    {
+        RayPatternId m_patternId{ RayPatternId::None }; //!< Built-in pattern the poses were generated from, if any.
+        AZStd::vector<AZ::Vector3> m_orientations; //!< Source orientations, compared on lookup to resolve hash collisions.
+        AZStd::vector<rgl_mat3x4f> m_rayPoses;
+        //! Ring (channel) of each ray, numbered from the lowest elevation up.
+        AZStd::vector<int32_t> m_ringIds;
+        //! Part of the lidar rotation (from 0 to 1) after which each ray is fired, used to derive the ray time offsets.
+        AZStd::vector<float> m_sweepFractions;
+        RangeImageLayout m_rangeImageLayout;
+    };
+
+    //! Cache sharing the ray patterns between lidars configured with identical ray orientations.
+    //! The orientations are converted to ray poses once, and a pattern is released together with its last user.
+    class RayPatternCache
+    {
+    public:
+        //! Returns the ray pattern generated from the orientations (Euler angles in radians).
+        //! The pattern is shared with all the other users of the same orientations.
+        [[nodiscard]] AZStd::shared_ptr<const RayPattern> GetRayPattern(const AZStd::vector<AZ::Vector3>& orientations);
+
+        //! Returns the built-in ray pattern, generated on first use, or nullptr for RayPatternId::None.
+        [[nodiscard]] AZStd::shared_ptr<const RayPattern> GetRayPattern(RayPatternId patternId);
+
+        //! Returns the number of patterns currently in use.
+        [[nodiscard]] size_t GetSize() const;
+
+    private:
+        void RemoveExpiredPatterns();
+
+        AZStd::unordered_multimap<size_t, AZStd::weak_ptr<const RayPattern>> m_patterns;
+        AZStd::unordered_map<AZ::u8, AZStd::weak_ptr<const RayPattern>> m_builtInPatterns;
+    };
+} // namespace RGL
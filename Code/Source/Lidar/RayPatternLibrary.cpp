@@ -0,0 +1,122 @@
+/* Copyright 2020-2021, Robotec.ai sp. z o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <AzCore/Math/MathUtils.h>
+#include <AzCore/std/containers/array.h>
+#include <Lidar/RayPatternLibrary.h>
+
+namespace RGL::RayPatternLibrary
+{
+    namespace
+    {
+        //! Returns elevations of channels spread uniformly from the top to the bottom one.
+        template<size_t ChannelCount>
+        constexpr AZStd::array<float, ChannelCount> CreateUniformElevations(float topElevation, float bottomElevation)
+        {
+            AZStd::array<float, ChannelCount> elevations{};
+            for (size_t channel = 0LU; channel < ChannelCount; ++channel)
+            {
+                elevations[channel] =
+                    topElevation + (bottomElevation - topElevation) * static_cast<float>(channel) / static_cast<float>(ChannelCount - 1LU);
+            }
+            return elevations;
+        }
+
+        // clang-format off
+        constexpr AZStd::array<float, 16> Vlp16Elevations{
+            -15.0f, 1.0f, -13.0f, 3.0f, -11.0f, 5.0f, -9.0f, 7.0f, -7.0f, 9.0f, -5.0f, 11.0f, -3.0f, 13.0f, -1.0f, 15.0f,
+        };
+
+        constexpr AZStd::array<float, 32> Hdl32eElevations{
+            -30.67f, -9.33f, -29.33f, -8.0f, -28.0f, -6.67f, -26.67f, -5.33f, -25.33f, -4.0f, -24.0f, -2.67f, -22.67f, -1.33f, -21.33f, 0.0f,
+            -20.0f, 1.33f, -18.67f, 2.67f, -17.33f, 4.0f, -16.0f, 5.33f, -14.67f, 6.67f, -13.33f, 8.0f, -12.0f, 9.33f, -10.67f, 10.67f,
+        };
+        // clang-format on
+
+        constexpr AZStd::array<float, 64> Os1_64Elevations = CreateUniformElevations<64>(22.5f, -22.5f);
+        constexpr AZStd::array<float, 128> Os1_128Elevations = CreateUniformElevations<128>(22.5f, -22.5f);
+        //! Nominal, uniformly spread channels of the 25.4 degree vertical field of view.
+        constexpr AZStd::array<float, 128> At128Elevations = CreateUniformElevations<128>(12.9f, -12.5f);
+
+        const RayPatternDescription Vlp16{ "Velodyne VLP-16", Vlp16Elevations, 360.0f, 1800LU };
+        const RayPatternDescription Hdl32e{ "Velodyne HDL-32E", Hdl32eElevations, 360.0f, 2250LU };
+        const RayPatternDescription Os1_64{ "Ouster OS1-64", Os1_64Elevations, 360.0f, 1024LU };
+        const RayPatternDescription Os1_128{ "Ouster OS1-128", Os1_128Elevations, 360.0f, 1024LU };
+        const RayPatternDescription At128{ "Hesai AT128", At128Elevations, 120.0f, 1200LU };
+    } // namespace
+
+    const RayPatternDescription* GetDescription(RayPatternId patternId)
+    {
+        switch (patternId)
+        {
+        case RayPatternId::VelodyneVlp16:
+            return &Vlp16;
+        case RayPatternId::VelodyneHdl32e:
+            return &Hdl32e;
+        case RayPatternId::OusterOs1_64:
+            return &Os1_64;
+        case RayPatternId::OusterOs1_128:
+            return &Os1_128;
+        case RayPatternId::HesaiAt128:
+            return &At128;
+        default:
+            return nullptr;
+        }
+    }
+
+    AZStd::vector<rgl_mat3x4f> GenerateRayPoses(const RayPatternDescription& description)
+    {
+        const size_t channelCount = description.m_elevations.size();
+        const size_t columnCount = description.m_columnCount;
+
+        // The sines and cosines are computed once per channel and per column, so that the ray poses are built with products only.
+        AZStd::vector<float> elevationSines(channelCount), elevationCosines(channelCount);
+        for (size_t channel = 0LU; channel < channelCount; ++channel)
+        {
+            const float elevation = AZ::DegToRad(description.m_elevations[channel]);
+            elevationSines[channel] = AZStd::sin(elevation);
+            elevationCosines[channel] = AZStd::cos(elevation);
+        }
+
+        // A full rotation does not repeat the first column, a limited field of view includes both of its edges.
+        const bool isFullRotation = description.m_horizontalFov >= 360.0f;
+        const float horizontalFov = AZ::DegToRad(description.m_horizontalFov);
+        const float azimuthStep = horizontalFov / static_cast<float>(isFullRotation ? columnCount : AZStd::max(columnCount - 1LU, 1LU));
+        const float firstAzimuth = isFullRotation ? 0.0f : -0.5f * horizontalFov;
+
+        AZStd::vector<rgl_mat3x4f> rayPoses(columnCount * channelCount);
+        for (size_t column = 0LU; column < columnCount; ++column)
+        {
+            const float azimuth = firstAzimuth + azimuthStep * static_cast<float>(column);
+            const float azimuthSine = AZStd::sin(azimuth);
+            const float azimuthCosine = AZStd::cos(azimuth);
+
+            rgl_mat3x4f* columnPoses = rayPoses.data() + column * channelCount;
+            for (size_t channel = 0LU; channel < channelCount; ++channel)
+            {
+                // Equal to the pose created from the (0, elevation, azimuth) ray orientation: a yaw rotation applied after
+                // the pitch which turns the ray's Z axis towards the elevation (see RayPatternCache).
+                const float sine = elevationSines[channel];
+                const float cosine = elevationCosines[channel];
+                columnPoses[channel] = { .value = {
+                                             { azimuthCosine * sine, -azimuthSine, azimuthCosine * cosine, 0.0f },
+                                             { azimuthSine * sine, azimuthCosine, azimuthSine * cosine, 0.0f },
+                                             { -cosine, 0.0f, sine, 0.0f },
+                                         } };
+            }
+        }
+
+        return rayPoses;
+    }
+} // namespace RGL::RayPatternLibrary
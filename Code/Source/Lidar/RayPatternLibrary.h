@@ -0,0 +1,58 @@
+/* Copyright 2020-2021, Robotec.ai sp. z o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <AzCore/RTTI/TypeInfoSimple.h>
+#include <AzCore/std/containers/span.h>
+#include <AzCore/std/containers/vector.h>
+#include <rgl/api/core.h>
+
+namespace RGL
+{
+    //! Identifiers of the built-in ray patterns.
+    enum class RayPatternId : AZ::u8
+    {
+        None = 0, //!< The ray orientations provided by the lidar sensor are used.
+        VelodyneVlp16,
+        VelodyneHdl32e,
+        OusterOs1_64,
+        OusterOs1_128,
+        HesaiAt128,
+    };
+
+    //! Description of a lidar ray pattern as a set of channels (beams) swept across the azimuth.
+    struct RayPatternDescription
+    {
+        const char* m_name;
+        //! Channel elevations in degrees, listed in the firing order of the channels within a single column.
+        AZStd::span<const float> m_elevations;
+        float m_horizontalFov; //!< Horizontal field of view in degrees, centered on the sensor's X axis.
+        size_t m_columnCount; //!< Number of azimuth columns (horizontal resolution) in a single scan.
+    };
+
+    namespace RayPatternLibrary
+    {
+        //! Returns the description of the built-in pattern, or nullptr for RayPatternId::None.
+        [[nodiscard]] const RayPatternDescription* GetDescription(RayPatternId patternId);
+
+        //! Generates the ray poses of the pattern, column by column, each column listing the channels in the firing order.
+        [[nodiscard]] AZStd::vector<rgl_mat3x4f> GenerateRayPoses(const RayPatternDescription& description);
+    } // namespace RayPatternLibrary
+} // namespace RGL
+
+namespace AZ
+{
+    AZ_TYPE_INFO_SPECIALIZE(RGL::RayPatternId, "{16c00ee3-903f-4d59-9e9e-1e71b5d693df}");
+} // namespace AZ
@@ -0,0 +1,66 @@
+/* Copyright 2020-2021, Robotec.ai sp. z o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <AzCore/Math/Quaternion.h>
+#include <Lidar/RayPatternPublisher.h>
+#include <ROS2/ROS2Bus.h>
+#include <Utilities/RGLUtils.h>
+#include <rclcpp/qos.hpp>
+
+namespace RGL
+{
+    RayPatternPublisher::RayPatternPublisher(const AZStd::string& topicName, const AZStd::string& frameId)
+        : m_topicName{ topicName }
+        , m_frameId{ frameId }
+    {
+        auto ros2Node = ROS2::ROS2Interface::Get()->GetNode();
+        m_publisher = ros2Node->create_publisher<geometry_msgs::msg::PoseArray>(
+            topicName.c_str(), rclcpp::QoS(1).reliable().transient_local());
+    }
+
+    const AZStd::string& RayPatternPublisher::GetTopicName() const
+    {
+        return m_topicName;
+    }
+
+    const AZStd::string& RayPatternPublisher::GetFrameId() const
+    {
+        return m_frameId;
+    }
+
+    void RayPatternPublisher::Publish(const AZStd::vector<rgl_mat3x4f>& rayPoses)
+    {
+        geometry_msgs::msg::PoseArray message;
+        message.header.stamp = ROS2::ROS2Interface::Get()->GetROSTimestamp();
+        message.header.frame_id = m_frameId.c_str();
+        message.poses.resize(rayPoses.size());
+        for (size_t rayIndex = 0LU; rayIndex < rayPoses.size(); ++rayIndex)
+        {
+            const AZ::Matrix3x4 rayPose = Utils::AzMatrix3x4FromRglMat3x4(rayPoses[rayIndex]);
+            const AZ::Vector3 position = rayPose.GetTranslation();
+            const AZ::Quaternion orientation = AZ::Quaternion::CreateFromMatrix3x4(rayPose);
+
+            geometry_msgs::msg::Pose& pose = message.poses[rayIndex];
+            pose.position.x = position.GetX();
+            pose.position.y = position.GetY();
+            pose.position.z = position.GetZ();
+            pose.orientation.x = orientation.GetX();
+            pose.orientation.y = orientation.GetY();
+            pose.orientation.z = orientation.GetZ();
+            pose.orientation.w = orientation.GetW();
+        }
+
+        m_publisher->publish(message);
+    }
+} // namespace RGL
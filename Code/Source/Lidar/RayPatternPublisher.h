@@ -0,0 +1,43 @@
+/* Copyright 2020-2021, Robotec.ai sp. z o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <AzCore/std/string/string.h>
+#include <geometry_msgs/msg/pose_array.hpp>
+#include <rclcpp/publisher.hpp>
+#include <rgl/api/core.h>
+
+namespace RGL
+{
+    //! Publishes the ray poses of a lidar as a PoseArray on a latched (transient local) topic, so that the consumers
+    //! of the encoded point clouds (see RGL/PointDecoding.h) receive the poses needed to decode them, whenever they subscribe.
+    class RayPatternPublisher
+    {
+    public:
+        RayPatternPublisher(const AZStd::string& topicName, const AZStd::string& frameId);
+
+        [[nodiscard]] const AZStd::string& GetTopicName() const;
+        [[nodiscard]] const AZStd::string& GetFrameId() const;
+
+        //! Publishes the ray poses, in the order of the ray indices of the encoded points.
+        //! The rays are cast along the Z axis of their poses.
+        void Publish(const AZStd::vector<rgl_mat3x4f>& rayPoses);
+
+    private:
+        AZStd::string m_topicName;
+        AZStd::string m_frameId;
+        rclcpp::Publisher<geometry_msgs::msg::PoseArray>::SharedPtr m_publisher;
+    };
+} // namespace RGL
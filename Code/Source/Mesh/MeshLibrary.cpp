@@ -12,6 +12,7 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <AzCore/Asset/AssetManager.h>
 #include <Mesh/MeshLibrary.h>
 #include <Utilities/RGLUtils.h>
 #include <rgl/api/core.h>
@@ -30,6 +31,8 @@ namespace RGL
 
     MeshLibrary::MeshLibrary(MeshLibrary&& meshLibrary)
         : m_meshPointersMap{ AZStd::move(meshLibrary.m_meshPointersMap) }
+        , m_meshSources{ AZStd::move(meshLibrary.m_meshSources) }
+        , m_intensityTextures{ AZStd::move(meshLibrary.m_intensityTextures) }
     {
         meshLibrary.BusDisconnect();
         MeshLibraryInterface::Unregister(&meshLibrary);
@@ -59,7 +62,45 @@ namespace RGL
             }
         }
 
+        for (const auto& [intensity, texture] : m_intensityTextures)
+        {
+            RGL_CHECK(rgl_texture_destroy(texture));
+        }
+
         m_meshPointersMap.clear();
+        m_meshSources.clear();
+        m_intensityTextures.clear();
+    }
+
+    void MeshLibrary::AppendToSnapshot(Snapshot::SceneSnapshot& snapshot) const
+    {
+        for (const auto& [assetId, meshPointers] : m_meshPointersMap)
+        {
+            if (meshPointers.empty())
+            {
+                continue;
+            }
+
+            auto modelAsset =
+                AZ::Data::AssetManager::Instance().GetAsset<AZ::RPI::ModelAsset>(assetId, AZ::Data::AssetLoadBehavior::PreLoad);
+            modelAsset.BlockUntilLoadComplete();
+            if (!modelAsset.IsReady())
+            {
+                AZ_Warning(
+                    __func__, false, "Unable to load the model asset %s. Its meshes are skipped.", assetId.ToString<AZStd::string>().c_str());
+                continue;
+            }
+
+            const auto lodAssets = modelAsset->GetLodAssets();
+            const auto meshes = lodAssets.begin()->Get()->GetMeshes();
+            for (Mesh* meshPointer : meshPointers)
+            {
+                const auto& mesh = meshes[m_meshSources.at(meshPointer).m_meshIndex];
+                const AZStd::span<const rgl_vec3f> vertices = mesh.GetSemanticBufferTyped<rgl_vec3f>(AZ::Name("POSITION"));
+                const AZStd::span<const rgl_vec3i> indices = mesh.GetIndexBufferTyped<rgl_vec3i>();
+                snapshot.AddMesh(meshPointer, vertices.data(), vertices.size(), indices.data(), indices.size());
+            }
+        }
     }
 
     AZStd::vector<rgl_mesh_t> MeshLibrary::StoreModelAsset(const AZ::Data::Asset<AZ::RPI::ModelAsset>& modelAsset)
@@ -78,8 +119,9 @@ namespace RGL
 
         AZStd::vector<rgl_mesh_t> meshPointers;
         meshPointers.reserve(meshes.size());
-        for (auto& mesh : meshes)
+        for (size_t meshIndex = 0LU; meshIndex < meshes.size(); ++meshIndex)
         {
+            const auto& mesh = meshes[meshIndex];
             const AZStd::span<const rgl_vec3f> vertices = mesh.GetSemanticBufferTyped<rgl_vec3f>(AZ::Name("POSITION"));
             const AZStd::span<const rgl_vec3i> indices = mesh.GetIndexBufferTyped<rgl_vec3i>();
 
@@ -91,9 +133,41 @@ namespace RGL
             }
 
             meshPointers.emplace_back(meshPointer);
+            m_meshSources.insert({ meshPointer, MeshSource{ assetId, meshIndex, vertices.size() } });
         }
 
         m_meshPointersMap.insert({ assetId, meshPointers });
         return meshPointers;
     }
+
+    rgl_texture_t MeshLibrary::GetUniformIntensityTexture(AZ::u8 intensity)
+    {
+        if (auto textureIt = m_intensityTextures.find(intensity); textureIt != m_intensityTextures.end())
+        {
+            return textureIt->second;
+        }
+
+        rgl_texture_t texture = nullptr;
+        bool success = false;
+        Utils::ErrorCheck(RGL_TRACE(rgl_texture_create(&texture, &intensity, 1, 1), sizeof(intensity)), __FILE__, __LINE__, &success);
+        if (!success)
+        {
+            return nullptr;
+        }
+
+        m_intensityTextures.emplace(intensity, texture);
+        return texture;
+    }
+
+    void MeshLibrary::EnableTextureCoords(rgl_mesh_t mesh)
+    {
+        auto meshSourceIt = m_meshSources.find(mesh);
+        if (meshSourceIt == m_meshSources.end() || meshSourceIt->second.m_hasTextureCoords)
+        {
+            return;
+        }
+
+        Utils::SetUniformTextureCoords(mesh, meshSourceIt->second.m_vertexCount);
+        meshSourceIt->second.m_hasTextureCoords = true;
+    }
 } // namespace RGL
@@ -18,6 +18,7 @@
 #include <AzCore/Asset/AssetCommon.h>
 #include <AzCore/std/containers/unordered_map.h>
 #include <Mesh/MeshLibraryBus.h>
+#include <Snapshot/SceneSnapshot.h>
 #include <rgl/api/core.h>
 
 namespace RGL
@@ -35,11 +36,29 @@ namespace RGL
         //! Deletes all meshes stored by the Library.
         void Clear();
 
+        //! Appends geometry of all meshes stored by the Library to the snapshot.
+        //! The model assets are loaded again (blocking), since the library does not keep them loaded.
+        void AppendToSnapshot(Snapshot::SceneSnapshot& snapshot) const;
+
     protected:
         // MeshLibraryRequestBus overrides
         AZStd::vector<rgl_mesh_t> StoreModelAsset(const AZ::Data::Asset<AZ::RPI::ModelAsset>& modelAsset) override;
+        rgl_texture_t GetUniformIntensityTexture(AZ::u8 intensity) override;
+        void EnableTextureCoords(rgl_mesh_t mesh) override;
 
     private:
+        //! Source of the RGL mesh geometry. Used to retrieve the geometry without keeping its copy on the host side.
+        //! Only the asset id is kept, so that the library does not keep the model assets loaded.
+        struct MeshSource
+        {
+            AZ::Data::AssetId m_modelAssetId;
+            size_t m_meshIndex; //!< Index of the mesh in the highest LOD of the model asset.
+            size_t m_vertexCount;
+            bool m_hasTextureCoords{ false };
+        };
+
         AZStd::unordered_map<AZ::Data::AssetId, AZStd::vector<Mesh*>> m_meshPointersMap;
+        AZStd::unordered_map<Mesh*, MeshSource> m_meshSources;
+        AZStd::unordered_map<AZ::u8, rgl_texture_t> m_intensityTextures;
     };
 } // namespace RGL
\ No newline at end of file
@@ -19,6 +19,7 @@
 #include <AzCore/Interface/Interface.h>
 
 struct Mesh;
+struct Texture;
 
 namespace RGL
 {
@@ -34,6 +35,15 @@ namespace RGL
         //! @return List of RGL meshes created using the provided model asset.
         virtual AZStd::vector<Mesh*> StoreModelAsset(const AZ::Data::Asset<AZ::RPI::ModelAsset>& modelAsset) = 0;
 
+        //! Returns a single-texel RGL texture reporting the intensity for every hit. The textures are shared by the entities.
+        //! The texture applies only to the meshes with texture coordinates (see EnableTextureCoords).
+        //! @param intensity Intensity reported for the hits, in the 0-255 range of the RGL texels.
+        virtual Texture* GetUniformIntensityTexture(AZ::u8 intensity) = 0;
+
+        //! Uploads constant texture coordinates to the mesh stored by the library, unless it already has them.
+        //! Called when the mesh is first used by an entity with reflectivity.
+        virtual void EnableTextureCoords(Mesh* mesh) = 0;
+
     protected:
         ~MeshLibraryRequests() = default;
     };
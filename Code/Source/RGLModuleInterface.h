@@ -16,7 +16,12 @@
 
 #include <AzCore/Memory/SystemAllocator.h>
 #include <AzCore/Module/Module.h>
+#include <Entity/ReflectivityComponent.h>
+#include <Entity/SemanticClassComponent.h>
 #include <Entity/TerrainEntityManagerSystemComponent.h>
+#include <Lidar/LidarGroupComponent.h>
+#include <Lidar/LidarRayPatternComponent.h>
+#include <Lidar/LidarSettingsComponent.h>
 #include <RGLSystemComponent.h>
 
 namespace RGL
@@ -38,6 +43,11 @@ namespace RGL
                 {
                     RGLSystemComponent::CreateDescriptor(),
                     TerrainEntityManagerSystemComponent::CreateDescriptor(),
+                    LidarRayPatternComponent::CreateDescriptor(),
+                    LidarGroupComponent::CreateDescriptor(),
+                    LidarSettingsComponent::CreateDescriptor(),
+                    ReflectivityComponent::CreateDescriptor(),
+                    SemanticClassComponent::CreateDescriptor(),
                 });
         }
 
@@ -13,17 +13,36 @@
  * limitations under the License.
  */
 #include <AtomLyIntegration/CommonFeatures/Mesh/MeshComponentConstants.h>
+#include <AzCore/Console/IConsole.h>
+#include <AzCore/std/algorithm.h>
+#include <AzCore/std/sort.h>
 #include <AzFramework/Entity/EntityContext.h>
 #include <AzFramework/Entity/GameEntityContextBus.h>
-#include <Entity/ActorEntityManager.h>
-#include <Entity/EntityManager.h>
-#include <Entity/MeshEntityManager.h>
 #include <Integration/Components/ActorComponent.h>
+#include <RGL/SemanticClassBus.h>
 #include <RGLSystemComponent.h>
+#include <Snapshot/SceneSnapshotBus.h>
 #include <Utilities/RGLUtils.h>
 
 namespace RGL
 {
+    static void rgl_export_scene_snapshot(const AZ::ConsoleCommandContainer& arguments)
+    {
+        if (arguments.size() != 1LU)
+        {
+            AZ_Error("RGL", false, "Usage: rgl_export_scene_snapshot <file path>");
+            return;
+        }
+
+        if (RGLInterface::Get()->ExportSceneSnapshot(AZStd::string{ arguments.front() }))
+        {
+            AZ_Printf("RGL", "Scene snapshot written to %.*s.\n", AZ_STRING_ARG(arguments.front()));
+        }
+    }
+
+    AZ_CONSOLEFREEFUNC(
+        rgl_export_scene_snapshot, AZ::ConsoleFunctorFlags::DontReplicate, "Writes the current RGL scene to a binary snapshot file.");
+
     void RGLSystemComponent::Reflect(AZ::ReflectContext* context)
     {
         if (AZ::SerializeContext* serializeContext = azrtti_cast<AZ::SerializeContext*>(context))
@@ -66,6 +85,11 @@ namespace RGL
         {
             RGLInterface::Register(this);
         }
+
+        if (!SceneVisibilityInterface::Get())
+        {
+            SceneVisibilityInterface::Register(this);
+        }
     }
 
     RGLSystemComponent::~RGLSystemComponent()
@@ -74,6 +98,11 @@ namespace RGL
         {
             RGLInterface::Unregister(this);
         }
+
+        if (SceneVisibilityInterface::Get() == this)
+        {
+            SceneVisibilityInterface::Unregister(this);
+        }
     }
 
     void RGLSystemComponent::Activate()
@@ -96,15 +125,18 @@ namespace RGL
         AzFramework::EntityContextEventBus::Handler::BusDisconnect();
         AZ::TickBus::Handler::BusDisconnect();
 
-        m_entityManagers.clear();
+        DestroyEntityManagers();
         m_meshLibrary.Clear();
         m_rglLidarSystem.Clear();
+        m_raycastQuery.Clear();
+        // All the RGL objects are destroyed by the cleanup, so the recorded mutations are obsolete.
+        m_sceneCommandBuffer.Clear();
         RGL_CHECK(rgl_cleanup());
     }
 
     void RGLSystemComponent::ExcludeEntity(const AZ::EntityId& excludedEntityId)
     {
-        if (!m_entityManagers.erase(excludedEntityId))
+        if (!DestroyEntityManager(excludedEntityId))
         {
             m_excludedEntities.insert(excludedEntityId);
         }
@@ -120,49 +152,211 @@ namespace RGL
         return m_sceneConfig;
     }
 
-    void RGLSystemComponent::OnEntityContextCreateEntity(AZ::Entity& entity)
+    bool RGLSystemComponent::ExportSceneSnapshot(const AZStd::string& filePath)
     {
-        if (m_excludedEntities.contains(entity.GetId()))
+        Snapshot::SceneSnapshot snapshot;
+
+        // Meshes have to be stored before the entities instantiating them.
+        m_meshLibrary.AppendToSnapshot(snapshot);
+        m_meshEntityManagers.ForEach(
+            [&snapshot](MeshEntityManager& entityManager)
+            {
+                entityManager.AppendToSnapshot(snapshot);
+            });
+        m_actorEntityManagers.ForEach(
+            [&snapshot](ActorEntityManager& entityManager)
+            {
+                entityManager.AppendToSnapshot(snapshot);
+            });
+        SceneSnapshotRequestBus::Broadcast(&SceneSnapshotRequests::AppendToSnapshot, snapshot);
+        m_rglLidarSystem.AppendToSnapshot(snapshot);
+
+        const bool success = snapshot.Save(filePath.c_str());
+        AZ_Error(__func__, success, "Unable to write the RGL scene snapshot to %s.", filePath.c_str());
+        return success;
+    }
+
+    AZ::EntityId RGLSystemComponent::GetEntityIdByRglId(int32_t rglEntityId) const
+    {
+        return m_entityIdRegistry.GetEntityId(rglEntityId);
+    }
+
+    int32_t RGLSystemComponent::GetSemanticClassId(int32_t rglEntityId) const
+    {
+        int32_t classId = SemanticClassRequests::UnlabeledClassId;
+        if (const AZ::EntityId entityId = m_entityIdRegistry.GetEntityId(rglEntityId); entityId.IsValid())
+        {
+            SemanticClassRequestBus::EventResult(classId, entityId, &SemanticClassRequests::GetSemanticClassId);
+        }
+        return classId;
+    }
+
+    bool RGLSystemComponent::RaycastBatch(
+        const AZStd::vector<AZ::Vector3>& origins,
+        const AZStd::vector<AZ::Vector3>& directions,
+        float maxRange,
+        bool includeEntityIds,
+        bool includeExcludedEntities,
+        RaycastBatchResults& results)
+    {
+        return m_raycastQuery.Raycast(origins, directions, maxRange, includeEntityIds, includeExcludedEntities, results);
+    }
+
+    bool RGLSystemComponent::RaycastBatchPoses(
+        const AZStd::vector<AZ::Matrix3x4>& rayPoses,
+        float maxRange,
+        bool includeEntityIds,
+        bool includeExcludedEntities,
+        RaycastBatchResults& results)
+    {
+        return m_raycastQuery.Raycast(rayPoses, maxRange, includeEntityIds, includeExcludedEntities, results);
+    }
+
+    void RGLSystemComponent::SetHiddenEntities(const AZStd::vector<AZ::EntityId>& entityIds)
+    {
+        m_requestedHiddenEntities.assign(entityIds.begin(), entityIds.end());
+        AZStd::sort(m_requestedHiddenEntities.begin(), m_requestedHiddenEntities.end());
+        m_requestedHiddenEntities.erase(
+            AZStd::unique(m_requestedHiddenEntities.begin(), m_requestedHiddenEntities.end()), m_requestedHiddenEntities.end());
+        if (m_requestedHiddenEntities == m_hiddenEntities)
         {
             return;
         }
 
-        AZStd::shared_ptr<EntityManager> entityManager;
-        if (entity.FindComponent<EMotionFX::Integration::ActorComponent>())
+        for (const AZ::EntityId& entityId : m_hiddenEntities)
         {
-            entityManager = AZStd::make_shared<ActorEntityManager>(entity.GetId());
+            if (!AZStd::binary_search(m_requestedHiddenEntities.begin(), m_requestedHiddenEntities.end(), entityId))
+            {
+                SetEntityVisible(entityId, true);
+            }
         }
-        else if (entity.FindComponent(AZ::Render::MeshComponentTypeId))
+
+        for (const AZ::EntityId& entityId : m_requestedHiddenEntities)
         {
-            entityManager = AZStd::make_shared<MeshEntityManager>(entity.GetId());
+            if (!AZStd::binary_search(m_hiddenEntities.begin(), m_hiddenEntities.end(), entityId))
+            {
+                SetEntityVisible(entityId, false);
+            }
         }
-        else
+
+        m_hiddenEntities.swap(m_requestedHiddenEntities);
+    }
+
+    void RGLSystemComponent::SetEntityVisible(const AZ::EntityId& entityId, bool isVisible)
+    {
+        auto managerIt = m_entityManagers.find(entityId);
+        if (managerIt == m_entityManagers.end())
         {
             return;
         }
 
-        [[maybe_unused]] bool inserted = m_entityManagers.emplace(entity.GetId(), entityManager).second;
-        AZ_Error(__func__, inserted, "Object with provided entityId already exists.");
+        AZStd::visit(
+            [isVisible](auto* entityManager)
+            {
+                entityManager->SetVisible(isVisible);
+            },
+            managerIt->second);
+    }
+
+    void RGLSystemComponent::OnEntityContextCreateEntity(AZ::Entity& entity)
+    {
+        if (m_excludedEntities.contains(entity.GetId()))
+        {
+            return;
+        }
+
+        if (m_entityManagers.contains(entity.GetId()))
+        {
+            AZ_Error(__func__, false, "Object with provided entityId already exists.");
+            return;
+        }
+
+        if (entity.FindComponent<EMotionFX::Integration::ActorComponent>())
+        {
+            const int32_t rglEntityId = m_entityIdRegistry.Acquire(entity.GetId());
+            m_entityManagers.emplace(entity.GetId(), m_actorEntityManagers.Create(entity.GetId(), rglEntityId, m_dynamicEntities));
+        }
+        else if (entity.FindComponent(AZ::Render::MeshComponentTypeId))
+        {
+            const int32_t rglEntityId = m_entityIdRegistry.Acquire(entity.GetId());
+            m_entityManagers.emplace(entity.GetId(), m_meshEntityManagers.Create(entity.GetId(), rglEntityId, m_dynamicEntities));
+        }
     }
 
     void RGLSystemComponent::OnEntityContextDestroyEntity(const AZ::EntityId& id)
     {
-        m_entityManagers.erase(id);
+        DestroyEntityManager(id);
     }
 
     void RGLSystemComponent::OnEntityContextReset()
     {
-        m_entityManagers.clear();
+        DestroyEntityManagers();
         m_meshLibrary.Clear();
         m_rglLidarSystem.Clear();
+        m_raycastQuery.Clear();
+        // All the RGL objects are destroyed by the cleanup, so the recorded mutations are obsolete.
+        m_sceneCommandBuffer.Clear();
         RGL_CHECK(rgl_cleanup());
     }
 
     void RGLSystemComponent::OnTick(float deltaTime, AZ::ScriptTimePoint time)
     {
-        for (auto& [entityId, entityManager] : m_entityManagers)
+        if (m_sceneConfig.m_isSkinnedMeshUpdateEnabled)
         {
-            entityManager->Update();
+            m_actorEntityManagers.ForEach(
+                [](ActorEntityManager& entityManager)
+                {
+                    entityManager.UpdateMeshVertices();
+                });
         }
+
+        m_dynamicEntities.UpdatePoses(m_sceneCommandBuffer);
+        m_rglLidarSystem.Update(deltaTime);
+        // Without any lidar graph run in this tick, the destroyed entities and meshes would be kept alive until the next one.
+        m_sceneCommandBuffer.FlushDestructions();
+
+#ifdef RGL_API_TRACING_ENABLED
+        Tracing::ApiTracer::Get().EndTick();
+#endif
+    }
+
+    bool RGLSystemComponent::DestroyEntityManager(const AZ::EntityId& entityId)
+    {
+        auto managerIt = m_entityManagers.find(entityId);
+        if (managerIt == m_entityManagers.end())
+        {
+            return false;
+        }
+
+        AZStd::visit(
+            [this](auto* entityManager)
+            {
+                using ManagerType = AZStd::remove_pointer_t<decltype(entityManager)>;
+                m_entityIdRegistry.Release(entityManager->GetRglEntityId());
+                if constexpr (AZStd::is_same_v<ManagerType, MeshEntityManager>)
+                {
+                    m_meshEntityManagers.Destroy(entityManager);
+                }
+                else
+                {
+                    m_actorEntityManagers.Destroy(entityManager);
+                }
+            },
+            managerIt->second);
+        m_entityManagers.erase(managerIt);
+        if (auto hiddenIt = AZStd::find(m_hiddenEntities.begin(), m_hiddenEntities.end(), entityId); hiddenIt != m_hiddenEntities.end())
+        {
+            m_hiddenEntities.erase(hiddenIt);
+        }
+        return true;
+    }
+
+    void RGLSystemComponent::DestroyEntityManagers()
+    {
+        m_entityManagers.clear();
+        m_hiddenEntities.clear();
+        m_meshEntityManagers.Clear();
+        m_actorEntityManagers.Clear();
+        m_entityIdRegistry.Clear();
     }
 } // namespace RGL
@@ -17,18 +17,26 @@
 #include <AzCore/Component/Component.h>
 #include <AzCore/Component/TickBus.h>
 #include <AzCore/Math/Vector3.h>
+#include <AzCore/std/containers/variant.h>
 #include <AzFramework/Entity/EntityContextBus.h>
+#include <Entity/ActorEntityManager.h>
+#include <Entity/DynamicEntityList.h>
+#include <Entity/EntityIdRegistry.h>
+#include <Entity/EntityManagerPool.h>
+#include <Entity/MeshEntityManager.h>
 #include <Lidar/LidarSystem.h>
 #include <Mesh/MeshLibrary.h>
 #include <RGL/RGLBus.h>
+#include <Scene/RaycastQuery.h>
+#include <Scene/SceneCommandBuffer.h>
+#include <Scene/SceneVisibilityBus.h>
 
 namespace RGL
 {
-    class EntityManager;
-
     class RGLSystemComponent
         : public AZ::Component
         , protected RGLRequestBus::Handler
+        , protected SceneVisibilityRequests
         , protected AzFramework::EntityContextEventBus::Handler
         , protected AZ::TickBus::Handler
 
@@ -55,6 +63,25 @@ namespace RGL
         void ExcludeEntity(const AZ::EntityId& excludedEntityId) override;
         void SetSceneConfiguration(const SceneConfiguration& config) override;
         [[nodiscard]] const SceneConfiguration& GetSceneConfiguration() const override;
+        bool ExportSceneSnapshot(const AZStd::string& filePath) override;
+        [[nodiscard]] AZ::EntityId GetEntityIdByRglId(int32_t rglEntityId) const override;
+        [[nodiscard]] int32_t GetSemanticClassId(int32_t rglEntityId) const override;
+        bool RaycastBatch(
+            const AZStd::vector<AZ::Vector3>& origins,
+            const AZStd::vector<AZ::Vector3>& directions,
+            float maxRange,
+            bool includeEntityIds,
+            bool includeExcludedEntities,
+            RaycastBatchResults& results) override;
+        bool RaycastBatchPoses(
+            const AZStd::vector<AZ::Matrix3x4>& rayPoses,
+            float maxRange,
+            bool includeEntityIds,
+            bool includeExcludedEntities,
+            RaycastBatchResults& results) override;
+
+        // SceneVisibilityRequests overrides
+        void SetHiddenEntities(const AZStd::vector<AZ::EntityId>& entityIds) override;
 
         // AzFramework::EntityContextEventBus overrides
         void OnEntityContextCreateEntity(AZ::Entity& entity) override;
@@ -65,11 +92,28 @@ namespace RGL
         void OnTick([[maybe_unused]] float deltaTime, [[maybe_unused]] AZ::ScriptTimePoint time) override;
 
     private:
+        using EntityManagerPointer = AZStd::variant<MeshEntityManager*, ActorEntityManager*>;
+
+        //! Destroys the manager of the entity. Returns false if the entity is not managed.
+        bool DestroyEntityManager(const AZ::EntityId& entityId);
+        void DestroyEntityManagers();
+        //! Hides or restores the RGL entities of the entity. Does nothing if the entity is not managed.
+        void SetEntityVisible(const AZ::EntityId& entityId, bool isVisible);
+
         LidarSystem m_rglLidarSystem;
 
         MeshLibrary m_meshLibrary;
         AZStd::set<AZ::EntityId> m_excludedEntities;
+        AZStd::vector<AZ::EntityId> m_hiddenEntities; //!< Sorted entities hidden for the graph runs.
+        AZStd::vector<AZ::EntityId> m_requestedHiddenEntities; //!< Kept to reuse its memory.
         SceneConfiguration m_sceneConfig;
-        AZStd::unordered_map<AZ::EntityId, AZStd::shared_ptr<EntityManager>> m_entityManagers;
+        //! Declared before the entity managers, which record the destruction of their RGL entities on destruction.
+        SceneCommandBuffer m_sceneCommandBuffer;
+        DynamicEntityList m_dynamicEntities;
+        EntityIdRegistry m_entityIdRegistry;
+        RaycastQuery m_raycastQuery{ m_entityIdRegistry };
+        EntityManagerPool<MeshEntityManager> m_meshEntityManagers;
+        EntityManagerPool<ActorEntityManager> m_actorEntityManagers;
+        AZStd::unordered_map<AZ::EntityId, EntityManagerPointer> m_entityManagers; //!< Used only for the lookups by EntityId.
     };
 } // namespace RGL
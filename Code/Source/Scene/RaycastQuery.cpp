@@ -0,0 +1,160 @@
+/* Copyright 2020-2021, Robotec.ai sp. z o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <AzCore/Casting/numeric_cast.h>
+#include <AzCore/Math/Quaternion.h>
+#include <AzCore/std/limits.h>
+#include <Scene/RaycastQuery.h>
+#include <Scene/SceneCommandBufferBus.h>
+#include <Scene/SceneVisibilityBus.h>
+#include <Utilities/RGLUtils.h>
+
+namespace RGL
+{
+    RaycastQuery::RaycastQuery(const EntityIdRegistry& entityIdRegistry)
+        : m_entityIdRegistry{ entityIdRegistry }
+    {
+    }
+
+    bool RaycastQuery::Raycast(
+        const AZStd::vector<AZ::Vector3>& origins,
+        const AZStd::vector<AZ::Vector3>& directions,
+        float maxRange,
+        bool includeEntityIds,
+        bool includeExcludedEntities,
+        RaycastBatchResults& results)
+    {
+        if (origins.size() != directions.size())
+        {
+            AZ_Error(__func__, false, "The batched raycast requires one direction per origin.");
+            return false;
+        }
+
+        m_rays.resize(origins.size());
+        for (size_t rayIndex = 0LU; rayIndex < origins.size(); ++rayIndex)
+        {
+            // The zero direction cannot be normalized and would produce a NaN ray pose.
+            if (directions[rayIndex].IsZero())
+            {
+                AZ_Error(__func__, false, "The direction of the ray %zu of the batched raycast has zero length.", rayIndex);
+                m_rays.clear();
+                return false;
+            }
+
+            const AZ::Quaternion rotation =
+                AZ::Quaternion::CreateShortestArc(AZ::Vector3::CreateAxisZ(), directions[rayIndex].GetNormalized());
+            m_rays[rayIndex] =
+                Utils::RglMat3x4FromAzMatrix3x4(AZ::Matrix3x4::CreateFromQuaternionAndTranslation(rotation, origins[rayIndex]));
+        }
+
+        return RunGraph(maxRange, includeEntityIds, includeExcludedEntities, results);
+    }
+
+    bool RaycastQuery::Raycast(
+        const AZStd::vector<AZ::Matrix3x4>& rayPoses,
+        float maxRange,
+        bool includeEntityIds,
+        bool includeExcludedEntities,
+        RaycastBatchResults& results)
+    {
+        m_rays.resize(rayPoses.size());
+        for (size_t rayIndex = 0LU; rayIndex < rayPoses.size(); ++rayIndex)
+        {
+            m_rays[rayIndex] = Utils::RglMat3x4FromAzMatrix3x4(rayPoses[rayIndex]);
+        }
+
+        return RunGraph(maxRange, includeEntityIds, includeExcludedEntities, results);
+    }
+
+    void RaycastQuery::Clear()
+    {
+        m_graph.reset();
+    }
+
+    void RaycastQuery::ConvertResults(
+        const PipelineGraph::RaycastResults& rglResults,
+        size_t rayCount,
+        bool includeEntityIds,
+        const EntityIdRegistry& entityIdRegistry,
+        RaycastBatchResults& results)
+    {
+        results.m_distances.resize(rayCount);
+        results.m_points.resize(rayCount);
+        results.m_entityIds.resize(includeEntityIds ? rayCount : 0LU);
+        for (size_t rayIndex = 0LU; rayIndex < rayCount; ++rayIndex)
+        {
+            const bool isHit = aznumeric_cast<bool>(rglResults.m_isHit[rayIndex]);
+            results.m_distances[rayIndex] = isHit ? rglResults.m_distance[rayIndex] : AZStd::numeric_limits<float>::infinity();
+            results.m_points[rayIndex] = isHit ? Utils::AzVector3FromRglVec3f(rglResults.m_xyz[rayIndex]) : AZ::Vector3::CreateZero();
+            if (includeEntityIds)
+            {
+                results.m_entityIds[rayIndex] = isHit ? entityIdRegistry.GetEntityId(rglResults.m_entityId[rayIndex]) : AZ::EntityId{};
+            }
+        }
+    }
+
+    bool RaycastQuery::RunGraph(float maxRange, bool includeEntityIds, bool includeExcludedEntities, RaycastBatchResults& results)
+    {
+        results.m_distances.clear();
+        results.m_points.clear();
+        results.m_entityIds.clear();
+        if (maxRange <= 0.0f)
+        {
+            AZ_Error(__func__, false, "The batched raycast requires a positive maximum range.");
+            return false;
+        }
+
+        if (m_rays.empty())
+        {
+            return true;
+        }
+
+        if (!m_graph)
+        {
+            m_graph = AZStd::make_unique<PipelineGraph>();
+            // The results have to be indexed by the rays.
+            m_graph->SetIsCompactEnabled(false);
+            m_areEntityIdsYielded = !includeEntityIds;
+        }
+
+        if (m_areEntityIdsYielded != includeEntityIds)
+        {
+            m_rglResults.m_fields = { RGL_FIELD_IS_HIT_I32, RGL_FIELD_XYZ_F32, RGL_FIELD_DISTANCE_F32 };
+            if (includeEntityIds)
+            {
+                m_rglResults.m_fields.push_back(RGL_FIELD_ENTITY_ID_I32);
+            }
+            m_graph->ConfigureYieldNodes(m_rglResults.m_fields.data(), m_rglResults.m_fields.size());
+            m_areEntityIdsYielded = includeEntityIds;
+        }
+
+        m_graph->ConfigureRayPosesNode(m_rays);
+        m_graph->ConfigureRayRangesNode(0.0f, maxRange);
+
+        if (includeExcludedEntities)
+        {
+            // Showing the entities hidden from the lidars records their poses, which invalidates the reusable lidar results.
+            SceneVisibilityInterface::Get()->SetHiddenEntities({});
+        }
+        SceneCommandBufferInterface::Get()->Flush();
+        m_graph->Run();
+        if (!m_graph->GetResults(m_rglResults))
+        {
+            return false;
+        }
+
+        ConvertResults(m_rglResults, m_rays.size(), includeEntityIds, m_entityIdRegistry, results);
+        return true;
+    }
+} // namespace RGL
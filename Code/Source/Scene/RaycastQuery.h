@@ -0,0 +1,68 @@
+/* Copyright 2020-2021, Robotec.ai sp. z o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <AzCore/std/smart_ptr/unique_ptr.h>
+#include <Entity/EntityIdRegistry.h>
+#include <Lidar/PipelineGraph.h>
+#include <RGL/RGLBus.h>
+
+namespace RGL
+{
+    //! Batched raycasts against the RGL scene on behalf of the other gems (see RGLRequests::RaycastBatch).
+    //! All the batches are traced with one cached graph, created on the first query, so the queries do not create any nodes.
+    class RaycastQuery
+    {
+    public:
+        explicit RaycastQuery(const EntityIdRegistry& entityIdRegistry);
+        RaycastQuery(const RaycastQuery& other) = delete;
+
+        bool Raycast(
+            const AZStd::vector<AZ::Vector3>& origins,
+            const AZStd::vector<AZ::Vector3>& directions,
+            float maxRange,
+            bool includeEntityIds,
+            bool includeExcludedEntities,
+            RaycastBatchResults& results);
+        bool Raycast(
+            const AZStd::vector<AZ::Matrix3x4>& rayPoses,
+            float maxRange,
+            bool includeEntityIds,
+            bool includeExcludedEntities,
+            RaycastBatchResults& results);
+
+        //! Destroys the cached graph. Has to be called before the RGL cleanup.
+        void Clear();
+
+        //! Converts the graph results of the rays, which are not compacted, into the results indexed by the rays.
+        //! The rays without a hit are reported at an infinite distance with a zero point and an invalid EntityId.
+        static void ConvertResults(
+            const PipelineGraph::RaycastResults& rglResults,
+            size_t rayCount,
+            bool includeEntityIds,
+            const EntityIdRegistry& entityIdRegistry,
+            RaycastBatchResults& results);
+
+    private:
+        //! Traces m_rays and converts the results.
+        bool RunGraph(float maxRange, bool includeEntityIds, bool includeExcludedEntities, RaycastBatchResults& results);
+
+        const EntityIdRegistry& m_entityIdRegistry;
+        AZStd::unique_ptr<PipelineGraph> m_graph;
+        bool m_areEntityIdsYielded{ false };
+        AZStd::vector<rgl_mat3x4f> m_rays;
+        PipelineGraph::RaycastResults m_rglResults;
+    };
+} // namespace RGL
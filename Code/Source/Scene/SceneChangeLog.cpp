@@ -0,0 +1,141 @@
+/* Copyright 2020-2021, Robotec.ai sp. z o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <Scene/SceneChangeLog.h>
+
+namespace RGL
+{
+    namespace
+    {
+        //! Returns the largest scale of the pose axes.
+        float GetMaxScale(const rgl_mat3x4f& pose)
+        {
+            float maxScale = 0.0f;
+            for (size_t column = 0LU; column < 3LU; ++column)
+            {
+                const AZ::Vector3 axis(pose.value[0][column], pose.value[1][column], pose.value[2][column]);
+                maxScale = AZStd::max(maxScale, axis.GetLength());
+            }
+            return maxScale;
+        }
+    } // namespace
+
+    void SceneChangeLog::SetEntityBoundingRadius(rgl_entity_t entity, float radius)
+    {
+        m_entityBounds[entity].m_localRadius = radius;
+    }
+
+    void SceneChangeLog::RecordPoseChange(rgl_entity_t entity, const rgl_mat3x4f& pose)
+    {
+        EntityBounds& bounds = m_entityBounds[entity];
+
+        // Both the region left by the entity and the one it moved to are changed.
+        if (bounds.m_radius > 0.0f)
+        {
+            RecordChange(bounds.m_center, bounds.m_radius);
+        }
+
+        bounds.m_center = AZ::Vector3(pose.value[0][3], pose.value[1][3], pose.value[2][3]);
+        constexpr float UnknownRadius = AZStd::numeric_limits<float>::infinity();
+        bounds.m_radius = bounds.m_localRadius == UnknownRadius ? UnknownRadius : bounds.m_localRadius * GetMaxScale(pose);
+        RecordChange(bounds.m_center, bounds.m_radius);
+    }
+
+    void SceneChangeLog::RecordEntityDestruction(rgl_entity_t entity)
+    {
+        auto boundsIt = m_entityBounds.find(entity);
+        if (boundsIt == m_entityBounds.end())
+        {
+            RecordGlobalChange();
+            return;
+        }
+
+        if (boundsIt->second.m_radius > 0.0f)
+        {
+            RecordChange(boundsIt->second.m_center, boundsIt->second.m_radius);
+        }
+        m_entityBounds.erase(boundsIt);
+    }
+
+    void SceneChangeLog::RecordGlobalChange()
+    {
+        RecordChange(AZ::Vector3::CreateZero(), AZStd::numeric_limits<float>::infinity());
+    }
+
+    void SceneChangeLog::Commit()
+    {
+        if (!m_hasPendingChanges)
+        {
+            return;
+        }
+
+        ++m_version;
+        m_hasPendingChanges = false;
+
+        if (m_changes.size() > Capacity)
+        {
+            const auto firstKeptChange = m_changes.begin() + m_changes.size() / 2LU;
+            m_trackedSinceVersion = AZStd::prev(firstKeptChange)->m_version;
+            m_changes.erase(m_changes.begin(), firstKeptChange);
+        }
+    }
+
+    void SceneChangeLog::Reset()
+    {
+        m_entityBounds.clear();
+        RecordGlobalChange();
+        Commit();
+    }
+
+    AZ::u64 SceneChangeLog::GetVersion() const
+    {
+        return m_version;
+    }
+
+    bool SceneChangeLog::HasChangedSince(AZ::u64 version, const AZ::Vector3& center, float radius) const
+    {
+        if (version >= m_version)
+        {
+            return false;
+        }
+
+        if (version < m_trackedSinceVersion)
+        {
+            return true;
+        }
+
+        // The changes are ordered by version, so only the tail of the log is checked.
+        for (auto changeIt = m_changes.rbegin(); changeIt != m_changes.rend() && changeIt->m_version > version; ++changeIt)
+        {
+            if (changeIt->m_center.GetDistance(center) <= changeIt->m_radius + radius)
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    void SceneChangeLog::RecordChange(const AZ::Vector3& center, float radius)
+    {
+        // Changes of the whole scene supersede the other changes of the same version.
+        if (!m_changes.empty() && m_changes.back().m_version == m_version + 1LU && m_changes.back().m_radius == AZStd::numeric_limits<float>::infinity())
+        {
+            return;
+        }
+
+        m_changes.push_back({ m_version + 1LU, center, radius });
+        m_hasPendingChanges = true;
+    }
+} // namespace RGL
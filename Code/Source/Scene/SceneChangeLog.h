@@ -0,0 +1,76 @@
+/* Copyright 2020-2021, Robotec.ai sp. z o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <AzCore/Math/Vector3.h>
+#include <AzCore/std/containers/unordered_map.h>
+#include <AzCore/std/containers/vector.h>
+#include <AzCore/std/limits.h>
+#include <rgl/api/core.h>
+
+namespace RGL
+{
+    //! Log of the regions of the RGL scene changed by the recent mutations, stored as bounding spheres tagged with the scene version.
+    //! Mutations of the entities with an unknown bounding radius and mesh updates (possibly instantiated anywhere) change the
+    //! whole scene.
+    class SceneChangeLog
+    {
+    public:
+        //! Maximum number of logged changes. When exceeded, the older half of the log is dropped and the queries
+        //! about the versions before the remaining changes report the whole scene as changed.
+        static constexpr size_t Capacity = 4096LU;
+
+        //! Sets the radius of the sphere around the entity origin (in the entity space) containing its mesh.
+        void SetEntityBoundingRadius(rgl_entity_t entity, float radius);
+
+        void RecordPoseChange(rgl_entity_t entity, const rgl_mat3x4f& pose);
+        void RecordEntityDestruction(rgl_entity_t entity);
+        void RecordGlobalChange();
+
+        //! Advances the scene version if any change was recorded since the last commit.
+        void Commit();
+
+        //! Forgets all the entities and marks the whole scene as changed.
+        void Reset();
+
+        [[nodiscard]] AZ::u64 GetVersion() const;
+
+        //! Checks whether any change committed after the given version intersects the sphere.
+        [[nodiscard]] bool HasChangedSince(AZ::u64 version, const AZ::Vector3& center, float radius) const;
+
+    private:
+        struct Change
+        {
+            AZ::u64 m_version;
+            AZ::Vector3 m_center;
+            float m_radius; //!< Infinite for the changes of the whole scene.
+        };
+
+        struct EntityBounds
+        {
+            float m_localRadius{ AZStd::numeric_limits<float>::infinity() };
+            AZ::Vector3 m_center{ AZ::Vector3::CreateZero() };
+            float m_radius{ 0.0f }; //!< Radius in the world space. Zero until the first pose is set.
+        };
+
+        void RecordChange(const AZ::Vector3& center, float radius);
+
+        AZStd::unordered_map<rgl_entity_t, EntityBounds> m_entityBounds;
+        AZStd::vector<Change> m_changes;
+        AZ::u64 m_version{ 0LU };
+        AZ::u64 m_trackedSinceVersion{ 0LU }; //!< Changes committed up to this version may be missing from the log.
+        bool m_hasPendingChanges{ false };
+    };
+} // namespace RGL
@@ -0,0 +1,188 @@
+/* Copyright 2020-2021, Robotec.ai sp. z o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <Scene/SceneCommandBuffer.h>
+#include <Utilities/RGLUtils.h>
+
+namespace RGL
+{
+    SceneCommandBuffer::SceneCommandBuffer()
+    {
+        if (!SceneCommandBufferInterface::Get())
+        {
+            SceneCommandBufferInterface::Register(this);
+        }
+    }
+
+    SceneCommandBuffer::~SceneCommandBuffer()
+    {
+        if (SceneCommandBufferInterface::Get() == this)
+        {
+            SceneCommandBufferInterface::Unregister(this);
+        }
+    }
+
+    void SceneCommandBuffer::Clear()
+    {
+        ClearCommands();
+        m_changeLog.Reset();
+    }
+
+    void SceneCommandBuffer::ClearCommands()
+    {
+        m_poseCommands.clear();
+        m_poseCommandIndices.clear();
+        m_verticesCommandCount = 0LU;
+        m_verticesCommandIndices.clear();
+        m_entitiesToDestroy.clear();
+        m_meshesToDestroy.clear();
+    }
+
+    bool SceneCommandBuffer::IsEmpty() const
+    {
+        return m_poseCommands.empty() && m_verticesCommandCount == 0LU && m_entitiesToDestroy.empty() && m_meshesToDestroy.empty();
+    }
+
+    void SceneCommandBuffer::SetEntityPose(rgl_entity_t entity, const rgl_mat3x4f& pose)
+    {
+        if (auto commandIt = m_poseCommandIndices.find(entity); commandIt != m_poseCommandIndices.end())
+        {
+            m_poseCommands[commandIt->second].m_pose = pose;
+            return;
+        }
+
+        m_poseCommandIndices.emplace(entity, m_poseCommands.size());
+        m_poseCommands.push_back({ entity, pose });
+    }
+
+    void SceneCommandBuffer::UpdateMeshVertices(rgl_mesh_t mesh, AZStd::span<const rgl_vec3f> vertices)
+    {
+        size_t commandIndex = m_verticesCommandCount;
+        if (auto commandIt = m_verticesCommandIndices.find(mesh); commandIt != m_verticesCommandIndices.end())
+        {
+            commandIndex = commandIt->second;
+        }
+        else
+        {
+            m_verticesCommandIndices.emplace(mesh, commandIndex);
+            ++m_verticesCommandCount;
+            if (m_verticesCommands.size() < m_verticesCommandCount)
+            {
+                m_verticesCommands.emplace_back();
+            }
+        }
+
+        VerticesCommand& command = m_verticesCommands[commandIndex];
+        command.m_mesh = mesh;
+        command.m_vertices.assign(vertices.begin(), vertices.end());
+    }
+
+    void SceneCommandBuffer::DestroyEntity(rgl_entity_t entity)
+    {
+        if (auto commandIt = m_poseCommandIndices.find(entity); commandIt != m_poseCommandIndices.end())
+        {
+            m_poseCommands[commandIt->second].m_entity = nullptr;
+            m_poseCommandIndices.erase(commandIt);
+        }
+
+        m_entitiesToDestroy.push_back(entity);
+    }
+
+    void SceneCommandBuffer::DestroyMesh(rgl_mesh_t mesh)
+    {
+        if (auto commandIt = m_verticesCommandIndices.find(mesh); commandIt != m_verticesCommandIndices.end())
+        {
+            m_verticesCommands[commandIt->second].m_mesh = nullptr;
+            m_verticesCommandIndices.erase(commandIt);
+        }
+
+        m_meshesToDestroy.push_back(mesh);
+    }
+
+    void SceneCommandBuffer::Flush()
+    {
+        if (IsEmpty())
+        {
+            return;
+        }
+
+        for (size_t commandIndex = 0LU; commandIndex < m_verticesCommandCount; ++commandIndex)
+        {
+            const VerticesCommand& command = m_verticesCommands[commandIndex];
+            if (command.m_mesh)
+            {
+                RGL_CHECK_BYTES(
+                    rgl_mesh_update_vertices(command.m_mesh, command.m_vertices.data(), aznumeric_cast<int32_t>(command.m_vertices.size())),
+                    command.m_vertices.size() * sizeof(rgl_vec3f));
+                m_changeLog.RecordGlobalChange();
+            }
+        }
+
+        for (const PoseCommand& command : m_poseCommands)
+        {
+            if (command.m_entity)
+            {
+                RGL_CHECK_BYTES(rgl_entity_set_pose(command.m_entity, &command.m_pose), sizeof(rgl_mat3x4f));
+                m_changeLog.RecordPoseChange(command.m_entity, command.m_pose);
+            }
+        }
+
+        ApplyDestructions();
+        m_changeLog.Commit();
+        ClearCommands();
+    }
+
+    void SceneCommandBuffer::FlushDestructions()
+    {
+        if (m_entitiesToDestroy.empty() && m_meshesToDestroy.empty())
+        {
+            return;
+        }
+
+        ApplyDestructions();
+        m_changeLog.Commit();
+        m_entitiesToDestroy.clear();
+        m_meshesToDestroy.clear();
+    }
+
+    void SceneCommandBuffer::ApplyDestructions()
+    {
+        // Entities are destroyed first, so that no mesh is destroyed while still instantiated.
+        for (rgl_entity_t entity : m_entitiesToDestroy)
+        {
+            RGL_CHECK(rgl_entity_destroy(entity));
+            m_changeLog.RecordEntityDestruction(entity);
+        }
+
+        for (rgl_mesh_t mesh : m_meshesToDestroy)
+        {
+            RGL_CHECK(rgl_mesh_destroy(mesh));
+        }
+    }
+
+    void SceneCommandBuffer::SetEntityBoundingRadius(rgl_entity_t entity, float radius)
+    {
+        m_changeLog.SetEntityBoundingRadius(entity, radius);
+    }
+
+    AZ::u64 SceneCommandBuffer::GetSceneVersion() const
+    {
+        return m_changeLog.GetVersion();
+    }
+
+    bool SceneCommandBuffer::HasSceneChangedSince(AZ::u64 version, const AZ::Vector3& center, float radius) const
+    {
+        return m_changeLog.HasChangedSince(version, center, radius);
+    }
+} // namespace RGL
@@ -0,0 +1,83 @@
+/* Copyright 2020-2021, Robotec.ai sp. z o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <AzCore/std/containers/unordered_map.h>
+#include <AzCore/std/containers/vector.h>
+#include <Scene/SceneChangeLog.h>
+#include <Scene/SceneCommandBufferBus.h>
+
+namespace RGL
+{
+    //! Gem-side buffer of RGL scene mutations, coalesced per tick.
+    //! Poses and vertex updates are deduplicated per RGL object (the last one wins) and updates of objects
+    //! destroyed before the flush are dropped. All the RGL calls mutating the scene are issued by Flush and FlushDestructions.
+    class SceneCommandBuffer : public SceneCommandBufferRequests
+    {
+    public:
+        SceneCommandBuffer();
+        ~SceneCommandBuffer();
+
+        //! Drops all recorded mutations without applying them (e.g. when the whole RGL scene is cleaned up).
+        //! The whole scene is marked as changed.
+        void Clear();
+
+        [[nodiscard]] bool IsEmpty() const;
+
+        //! Applies only the recorded destructions, so that the destroyed RGL objects are released at the end of every tick,
+        //! even if no lidar flushes the buffer. The poses and vertex updates are kept to be coalesced with the next ones.
+        void FlushDestructions();
+
+        // SceneCommandBufferRequests overrides
+        void SetEntityPose(rgl_entity_t entity, const rgl_mat3x4f& pose) override;
+        void UpdateMeshVertices(rgl_mesh_t mesh, AZStd::span<const rgl_vec3f> vertices) override;
+        void DestroyEntity(rgl_entity_t entity) override;
+        void DestroyMesh(rgl_mesh_t mesh) override;
+        void Flush() override;
+        void SetEntityBoundingRadius(rgl_entity_t entity, float radius) override;
+        AZ::u64 GetSceneVersion() const override;
+        bool HasSceneChangedSince(AZ::u64 version, const AZ::Vector3& center, float radius) const override;
+
+    private:
+        struct PoseCommand
+        {
+            rgl_entity_t m_entity;
+            rgl_mat3x4f m_pose;
+        };
+
+        struct VerticesCommand
+        {
+            rgl_mesh_t m_mesh;
+            AZStd::vector<rgl_vec3f> m_vertices;
+        };
+
+        //! Commands are stored in vectors to preserve the recording order. The maps point to the command of each object.
+        AZStd::vector<PoseCommand> m_poseCommands;
+        AZStd::unordered_map<rgl_entity_t, size_t> m_poseCommandIndices;
+        //! Vertex buffers of the executed commands are kept (up to m_verticesCommandCount) to reuse their memory.
+        AZStd::vector<VerticesCommand> m_verticesCommands;
+        size_t m_verticesCommandCount{ 0LU };
+        AZStd::unordered_map<rgl_mesh_t, size_t> m_verticesCommandIndices;
+
+        AZStd::vector<rgl_entity_t> m_entitiesToDestroy;
+        AZStd::vector<rgl_mesh_t> m_meshesToDestroy;
+
+        SceneChangeLog m_changeLog;
+
+        void ClearCommands();
+        //! Destroys the recorded entities and meshes and records the changes. The change log is not committed.
+        void ApplyDestructions();
+    };
+} // namespace RGL
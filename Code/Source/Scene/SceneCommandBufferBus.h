@@ -0,0 +1,66 @@
+/* Copyright 2020-2021, Robotec.ai sp. z o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <AzCore/Interface/Interface.h>
+#include <AzCore/Math/Vector3.h>
+#include <AzCore/std/containers/span.h>
+#include <rgl/api/core.h>
+
+namespace RGL
+{
+    //! Interface recording the RGL scene mutations issued during a tick.
+    //! Recorded mutations are applied to the RGL scene only when the buffer is flushed,
+    //! which happens right before the first lidar graph run, so every raycast sees a consistent scene.
+    //! The destructions are additionally applied at the end of every tick.
+    class SceneCommandBufferRequests
+    {
+    public:
+        AZ_RTTI(SceneCommandBufferRequests, "{a879a91c-191c-4401-8d6a-bf58ff79512c}");
+
+        //! Records a new pose of the RGL entity. Only the last pose recorded before the flush is applied.
+        virtual void SetEntityPose(rgl_entity_t entity, const rgl_mat3x4f& pose) = 0;
+
+        //! Records new vertex positions of the RGL mesh. The vertices are copied, so the provided buffer may be reused.
+        //! Only the last vertices recorded before the flush are applied.
+        virtual void UpdateMeshVertices(rgl_mesh_t mesh, AZStd::span<const rgl_vec3f> vertices) = 0;
+
+        //! Records destruction of the RGL entity. Pending updates of the entity are dropped.
+        virtual void DestroyEntity(rgl_entity_t entity) = 0;
+
+        //! Records destruction of the RGL mesh. Pending updates of the mesh are dropped.
+        //! Meshes are destroyed after the entities, so the mesh may still be instantiated by entities destroyed in the same tick.
+        virtual void DestroyMesh(rgl_mesh_t mesh) = 0;
+
+        //! Applies all recorded mutations to the RGL scene. Does nothing if no mutations were recorded since the last flush.
+        //! Advances the scene version if any mutation was applied.
+        virtual void Flush() = 0;
+
+        //! Sets the radius of the sphere around the entity origin (in the entity space) containing its mesh.
+        //! Mutations of the entities without a known radius are treated as changes of the whole scene.
+        virtual void SetEntityBoundingRadius(rgl_entity_t entity, float radius) = 0;
+
+        //! Returns the version of the RGL scene, advanced by every flush applying any mutation.
+        [[nodiscard]] virtual AZ::u64 GetSceneVersion() const = 0;
+
+        //! Checks whether the mutations applied after the given scene version changed anything within the sphere.
+        [[nodiscard]] virtual bool HasSceneChangedSince(AZ::u64 version, const AZ::Vector3& center, float radius) const = 0;
+
+    protected:
+        ~SceneCommandBufferRequests() = default;
+    };
+
+    using SceneCommandBufferInterface = AZ::Interface<SceneCommandBufferRequests>;
+} // namespace RGL
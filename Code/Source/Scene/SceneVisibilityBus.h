@@ -0,0 +1,43 @@
+/* Copyright 2020-2021, Robotec.ai sp. z o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <AzCore/Component/EntityId.h>
+#include <AzCore/Interface/Interface.h>
+#include <AzCore/std/containers/vector.h>
+
+namespace RGL
+{
+    //! Interface used to hide Entities from a single lidar.
+    //! RGL does not provide per-entity visibility masks, so the RGL entities of hidden Entities are collapsed
+    //! to a point. They stay collapsed until a graph run with a different set of hidden Entities, so consecutive runs
+    //! hiding the same Entities do not modify the scene.
+    class SceneVisibilityRequests
+    {
+    public:
+        AZ_RTTI(SceneVisibilityRequests, "{2ccf99ac-9763-4fc9-9baa-6df00451cb93}");
+
+        //! Hides exactly the provided Entities. The Entities hidden by the previous call and not provided are restored
+        //! to their current world pose. Has to be called before every graph run, with no Entities if none are excluded.
+        //! The poses are recorded in the scene command buffer, which has to be flushed before the graph run.
+        //! Entities which are not represented in the RGL scene are ignored.
+        virtual void SetHiddenEntities(const AZStd::vector<AZ::EntityId>& entityIds) = 0;
+
+    protected:
+        ~SceneVisibilityRequests() = default;
+    };
+
+    using SceneVisibilityInterface = AZ::Interface<SceneVisibilityRequests>;
+} // namespace RGL
@@ -0,0 +1,247 @@
+/* Copyright 2020-2021, Robotec.ai sp. z o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <Snapshot/SceneSnapshot.h>
+#include <cstring>
+#include <fstream>
+
+namespace RGL::Snapshot
+{
+    namespace
+    {
+        // The file is written in the host byte order. Snapshots are meant to be replayed on the same kind of machine they were
+        // recorded on, so no endianness conversion is performed.
+        constexpr char Magic[8] = { 'R', 'G', 'L', 'S', 'N', 'A', 'P', '\0' };
+
+        template<typename T>
+        void WriteValue(std::ofstream& stream, const T& value)
+        {
+            stream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+        }
+
+        template<typename T>
+        void WriteArray(std::ofstream& stream, const std::vector<T>& values)
+        {
+            WriteValue(stream, static_cast<uint32_t>(values.size()));
+            stream.write(reinterpret_cast<const char*>(values.data()), static_cast<std::streamsize>(values.size() * sizeof(T)));
+        }
+
+        template<typename T>
+        bool ReadValue(std::ifstream& stream, T& value)
+        {
+            stream.read(reinterpret_cast<char*>(&value), sizeof(T));
+            return stream.good();
+        }
+
+        template<typename T>
+        bool ReadArray(std::ifstream& stream, std::vector<T>& values)
+        {
+            uint32_t size = 0U;
+            if (!ReadValue(stream, size))
+            {
+                return false;
+            }
+
+            values.resize(size);
+            stream.read(reinterpret_cast<char*>(values.data()), static_cast<std::streamsize>(values.size() * sizeof(T)));
+            return stream.good();
+        }
+    } // namespace
+
+    uint32_t SceneSnapshot::AddMesh(
+        rgl_mesh_t mesh, const rgl_vec3f* vertices, size_t vertexCount, const rgl_vec3i* indices, size_t indexCount)
+    {
+        if (auto meshIndexIt = m_meshIndices.find(mesh); meshIndexIt != m_meshIndices.end())
+        {
+            return meshIndexIt->second;
+        }
+
+        const auto meshIndex = static_cast<uint32_t>(m_meshes.size());
+        MeshData& meshData = m_meshes.emplace_back();
+        meshData.m_vertices.assign(vertices, vertices + vertexCount);
+        meshData.m_indices.assign(indices, indices + indexCount);
+
+        m_meshIndices.emplace(mesh, meshIndex);
+        return meshIndex;
+    }
+
+    bool SceneSnapshot::ContainsMesh(rgl_mesh_t mesh) const
+    {
+        return m_meshIndices.find(mesh) != m_meshIndices.end();
+    }
+
+    bool SceneSnapshot::AddEntity(rgl_mesh_t mesh, const rgl_mat3x4f& pose, EntityKind kind)
+    {
+        auto meshIndexIt = m_meshIndices.find(mesh);
+        if (meshIndexIt == m_meshIndices.end())
+        {
+            return false;
+        }
+
+        m_entities.push_back({ meshIndexIt->second, kind, pose });
+        return true;
+    }
+
+    void SceneSnapshot::AddLidar(LidarData lidar)
+    {
+        m_lidars.push_back(std::move(lidar));
+    }
+
+    const std::vector<MeshData>& SceneSnapshot::GetMeshes() const
+    {
+        return m_meshes;
+    }
+
+    const std::vector<EntityData>& SceneSnapshot::GetEntities() const
+    {
+        return m_entities;
+    }
+
+    const std::vector<LidarData>& SceneSnapshot::GetLidars() const
+    {
+        return m_lidars;
+    }
+
+    bool SceneSnapshot::Save(const std::string& filePath) const
+    {
+        std::ofstream stream(filePath, std::ios::binary | std::ios::trunc);
+        if (!stream.is_open())
+        {
+            return false;
+        }
+
+        stream.write(Magic, sizeof(Magic));
+        WriteValue(stream, FormatVersion);
+
+        WriteValue(stream, static_cast<uint32_t>(m_meshes.size()));
+        for (const MeshData& mesh : m_meshes)
+        {
+            WriteArray(stream, mesh.m_vertices);
+            WriteArray(stream, mesh.m_indices);
+        }
+
+        WriteValue(stream, static_cast<uint32_t>(m_entities.size()));
+        for (const EntityData& entity : m_entities)
+        {
+            WriteValue(stream, entity.m_meshIndex);
+            WriteValue(stream, static_cast<uint8_t>(entity.m_kind));
+            WriteValue(stream, entity.m_pose);
+        }
+
+        WriteValue(stream, static_cast<uint32_t>(m_lidars.size()));
+        for (const LidarData& lidar : m_lidars)
+        {
+            WriteValue(stream, lidar.m_pose);
+            WriteValue(stream, lidar.m_minRange);
+            WriteValue(stream, lidar.m_maxRange);
+            WriteArray(stream, lidar.m_nodes);
+            WriteArray(stream, lidar.m_rayPoses);
+            WriteArray(stream, lidar.m_ringIds);
+            WriteArray(stream, lidar.m_timeOffsets);
+            WriteArray(stream, lidar.m_rayRanges);
+            WriteValue(stream, lidar.m_angularNoiseStdDev);
+            WriteValue(stream, lidar.m_distanceNoiseStdDevBase);
+            WriteValue(stream, lidar.m_distanceNoiseStdDevRisePerMeter);
+            WriteValue(stream, lidar.m_downsampleLeafSize);
+            WriteValue(stream, lidar.m_linearVelocity);
+            WriteValue(stream, lidar.m_angularVelocity);
+            WriteArray(stream, lidar.m_intermediateFields);
+            WriteArray(stream, lidar.m_resultFields);
+        }
+
+        return stream.good();
+    }
+
+    bool SceneSnapshot::Load(const std::string& filePath)
+    {
+        std::ifstream stream(filePath, std::ios::binary);
+        if (!stream.is_open())
+        {
+            return false;
+        }
+
+        char magic[sizeof(Magic)];
+        stream.read(magic, sizeof(magic));
+        uint32_t version = 0U;
+        if (!stream.good() || std::memcmp(magic, Magic, sizeof(Magic)) != 0 || !ReadValue(stream, version) || version != FormatVersion)
+        {
+            return false;
+        }
+
+        m_meshes.clear();
+        m_entities.clear();
+        m_lidars.clear();
+        m_meshIndices.clear();
+
+        uint32_t meshCount = 0U;
+        if (!ReadValue(stream, meshCount))
+        {
+            return false;
+        }
+
+        m_meshes.resize(meshCount);
+        for (MeshData& mesh : m_meshes)
+        {
+            if (!ReadArray(stream, mesh.m_vertices) || !ReadArray(stream, mesh.m_indices))
+            {
+                return false;
+            }
+        }
+
+        uint32_t entityCount = 0U;
+        if (!ReadValue(stream, entityCount))
+        {
+            return false;
+        }
+
+        m_entities.resize(entityCount);
+        for (EntityData& entity : m_entities)
+        {
+            uint8_t kind = 0U;
+            if (!ReadValue(stream, entity.m_meshIndex) || !ReadValue(stream, kind) || !ReadValue(stream, entity.m_pose))
+            {
+                return false;
+            }
+
+            if (entity.m_meshIndex >= meshCount)
+            {
+                return false;
+            }
+            entity.m_kind = static_cast<EntityKind>(kind);
+        }
+
+        uint32_t lidarCount = 0U;
+        if (!ReadValue(stream, lidarCount))
+        {
+            return false;
+        }
+
+        m_lidars.resize(lidarCount);
+        for (LidarData& lidar : m_lidars)
+        {
+            if (!ReadValue(stream, lidar.m_pose) || !ReadValue(stream, lidar.m_minRange) || !ReadValue(stream, lidar.m_maxRange) ||
+                !ReadArray(stream, lidar.m_nodes) || !ReadArray(stream, lidar.m_rayPoses) || !ReadArray(stream, lidar.m_ringIds) ||
+                !ReadArray(stream, lidar.m_timeOffsets) || !ReadArray(stream, lidar.m_rayRanges) ||
+                !ReadValue(stream, lidar.m_angularNoiseStdDev) || !ReadValue(stream, lidar.m_distanceNoiseStdDevBase) ||
+                !ReadValue(stream, lidar.m_distanceNoiseStdDevRisePerMeter) || !ReadValue(stream, lidar.m_downsampleLeafSize) ||
+                !ReadValue(stream, lidar.m_linearVelocity) || !ReadValue(stream, lidar.m_angularVelocity) ||
+                !ReadArray(stream, lidar.m_intermediateFields) || !ReadArray(stream, lidar.m_resultFields))
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+} // namespace RGL::Snapshot
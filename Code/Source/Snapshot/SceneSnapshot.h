@@ -0,0 +1,125 @@
+/* Copyright 2020-2021, Robotec.ai sp. z o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <cstdint>
+#include <rgl/api/core.h>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Note: This file intentionally depends only on the standard library and the RGL API so that
+// it can be compiled into tools which do not link against the engine (see Tools/SnapshotBenchmark).
+namespace RGL::Snapshot
+{
+    //! Describes how an entity behaves in the scene and therefore how it is treated during a replay.
+    enum class EntityKind : uint8_t
+    {
+        Static = 0, //!< Entity with a static transform.
+        Dynamic = 1, //!< Entity whose pose is updated every tick.
+        Skinned = 2, //!< Entity whose pose and mesh vertices are updated every tick.
+        Terrain = 3, //!< Terrain mesh entity.
+    };
+
+    struct MeshData
+    {
+        std::vector<rgl_vec3f> m_vertices;
+        std::vector<rgl_vec3i> m_indices;
+    };
+
+    struct EntityData
+    {
+        uint32_t m_meshIndex{ 0U };
+        EntityKind m_kind{ EntityKind::Static };
+        rgl_mat3x4f m_pose{};
+    };
+
+    //! Node of a lidar graph. The active nodes of a lidar form a chain, from the ray poses to the yield of the results.
+    enum class NodeType : uint8_t
+    {
+        RayPoses = 0,
+        RayRingIds = 1,
+        RayTimeOffsets = 2,
+        RayRanges = 3,
+        LidarTransform = 4,
+        AngularNoise = 5,
+        RayTrace = 6,
+        DistortedRayTrace = 7, //!< Raytrace with the motion distortion.
+        DistanceNoise = 8,
+        PointsCompact = 9,
+        PointsDownsample = 10,
+        IntermediateYield = 11, //!< Yield of the fields required by the following nodes.
+        ResultsYield = 12, //!< Yield of the results retrieved by the lidar.
+    };
+
+    //! Effective graph configuration of a lidar, as traced in the last raycast.
+    struct LidarData
+    {
+        rgl_mat3x4f m_pose{}; //!< Last pose used for raycasting.
+        float m_minRange{ 0.0f };
+        float m_maxRange{ 1.0f };
+        std::vector<NodeType> m_nodes; //!< Active nodes, excluding the point cloud publishing.
+        std::vector<rgl_mat3x4f> m_rayPoses; //!< Poses of the traced rays, i.e. of the sub-rays with multiple returns.
+        std::vector<int32_t> m_ringIds;
+        std::vector<float> m_timeOffsets; //!< Time offset of each ray in milliseconds.
+        std::vector<rgl_vec2f> m_rayRanges; //!< Range of each ray, or a single range of all the rays.
+        float m_angularNoiseStdDev{ 0.0f };
+        float m_distanceNoiseStdDevBase{ 0.0f };
+        float m_distanceNoiseStdDevRisePerMeter{ 0.0f };
+        rgl_vec3f m_downsampleLeafSize{};
+        rgl_vec3f m_linearVelocity{}; //!< Sensor velocity of the motion distortion, in meters per second.
+        rgl_vec3f m_angularVelocity{}; //!< Sensor roll, pitch and yaw rates of the motion distortion, in radians per second.
+        std::vector<rgl_field_t> m_intermediateFields;
+        std::vector<rgl_field_t> m_resultFields;
+    };
+
+    //! Compact binary representation of the RGL scene: meshes, entities with their poses and lidars with their graph configurations.
+    //! Meshes are deduplicated by their RGL handle, so entities sharing a mesh only store its index.
+    class SceneSnapshot
+    {
+    public:
+        static constexpr uint32_t FormatVersion = 2U;
+
+        //! Stores a copy of the mesh geometry. Adding an already stored mesh has no effect.
+        //! @return Index of the mesh inside the snapshot.
+        uint32_t AddMesh(rgl_mesh_t mesh, const rgl_vec3f* vertices, size_t vertexCount, const rgl_vec3i* indices, size_t indexCount);
+        [[nodiscard]] bool ContainsMesh(rgl_mesh_t mesh) const;
+
+        //! Adds an entity instantiating a mesh previously stored with AddMesh.
+        //! @return False if the mesh was not stored in this snapshot.
+        bool AddEntity(rgl_mesh_t mesh, const rgl_mat3x4f& pose, EntityKind kind);
+        void AddLidar(LidarData lidar);
+
+        [[nodiscard]] const std::vector<MeshData>& GetMeshes() const;
+        [[nodiscard]] const std::vector<EntityData>& GetEntities() const;
+        [[nodiscard]] const std::vector<LidarData>& GetLidars() const;
+
+        //! Writes the snapshot to a binary file.
+        //! @return If successful returns true, otherwise returns false.
+        bool Save(const std::string& filePath) const;
+
+        //! Replaces the contents of this snapshot with the ones read from a binary file.
+        //! @return If successful returns true, otherwise returns false.
+        bool Load(const std::string& filePath);
+
+    private:
+        std::vector<MeshData> m_meshes;
+        std::vector<EntityData> m_entities;
+        std::vector<LidarData> m_lidars;
+
+        //! Maps RGL mesh handles to mesh indices. Only used while building the snapshot and never serialized.
+        std::unordered_map<rgl_mesh_t, uint32_t> m_meshIndices;
+    };
+} // namespace RGL::Snapshot
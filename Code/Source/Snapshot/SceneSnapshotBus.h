@@ -0,0 +1,45 @@
+/* Copyright 2020-2021, Robotec.ai sp. z o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <AzCore/EBus/EBus.h>
+#include <Snapshot/SceneSnapshot.h>
+
+namespace RGL
+{
+    //! Bus used to collect scene parts which are not managed by the RGLSystemComponent (e.g. terrain) into a snapshot.
+    class SceneSnapshotRequests
+    {
+    public:
+        //! Appends all RGL meshes and entities managed by the handler to the snapshot.
+        //! @param snapshot Snapshot being built.
+        virtual void AppendToSnapshot(Snapshot::SceneSnapshot& snapshot) = 0;
+
+    protected:
+        ~SceneSnapshotRequests() = default;
+    };
+
+    class SceneSnapshotBusTraits : public AZ::EBusTraits
+    {
+    public:
+        //////////////////////////////////////////////////////////////////////////
+        // EBusTraits overrides
+        static constexpr AZ::EBusHandlerPolicy HandlerPolicy = AZ::EBusHandlerPolicy::Multiple;
+        static constexpr AZ::EBusAddressPolicy AddressPolicy = AZ::EBusAddressPolicy::Single;
+        //////////////////////////////////////////////////////////////////////////
+    };
+
+    using SceneSnapshotRequestBus = AZ::EBus<SceneSnapshotRequests, SceneSnapshotBusTraits>;
+} // namespace RGL
@@ -0,0 +1,301 @@
+/* Copyright 2020-2021, Robotec.ai sp. z o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <AzCore/Console/IConsole.h>
+#include <AzCore/IO/SystemFile.h>
+#include <AzCore/StringFunc/StringFunc.h>
+#include <AzCore/std/string/conversions.h>
+#include <Utilities/ApiTracer.h>
+
+namespace RGL::Tracing
+{
+    namespace
+    {
+        //! Returns the index of the power of two bucket the value falls into (0 for zero, i for [2^(i-1), 2^i)).
+        size_t GetLog2Bucket(AZ::u64 value, size_t bucketCount)
+        {
+            size_t bucket = 0LU;
+            while (value > 0LU && bucket + 1LU < bucketCount)
+            {
+                value >>= 1LU;
+                ++bucket;
+            }
+            return bucket;
+        }
+    } // namespace
+
+#ifdef RGL_API_TRACING_ENABLED
+    static void rgl_trace_export(const AZ::ConsoleCommandContainer& arguments)
+    {
+        if (arguments.size() != 1LU)
+        {
+            AZ_Error("RGL", false, "Usage: rgl_trace_export <file path>");
+            return;
+        }
+
+        if (ApiTracer::Get().ExportHistograms(AZStd::string{ arguments.front() }))
+        {
+            AZ_Printf("RGL", "RGL API trace written to %.*s.\n", AZ_STRING_ARG(arguments.front()));
+        }
+    }
+
+    static void rgl_trace_reset([[maybe_unused]] const AZ::ConsoleCommandContainer& arguments)
+    {
+        ApiTracer::Get().Reset();
+    }
+
+    static void rgl_trace_enable(const AZ::ConsoleCommandContainer& arguments)
+    {
+        ApiTracer::Get().SetEnabled(arguments.empty() || arguments.front() != "0");
+    }
+
+    AZ_CONSOLEFREEFUNC(rgl_trace_export, AZ::ConsoleFunctorFlags::DontReplicate, "Writes the RGL API call statistics to a CSV file.");
+    AZ_CONSOLEFREEFUNC(rgl_trace_reset, AZ::ConsoleFunctorFlags::DontReplicate, "Clears the RGL API call statistics.");
+    AZ_CONSOLEFREEFUNC(rgl_trace_enable, AZ::ConsoleFunctorFlags::DontReplicate, "Enables (1) or disables (0) RGL API call tracing.");
+#endif
+
+    ApiTracer& ApiTracer::Get()
+    {
+        static ApiTracer Tracer;
+        return Tracer;
+    }
+
+    CallId ApiTracer::RegisterCall(const char* callExpression)
+    {
+        AZStd::string name{ callExpression };
+        if (const size_t argumentsStart = name.find('('); argumentsStart != AZStd::string::npos)
+        {
+            name.resize(argumentsStart);
+        }
+        AZ::StringFunc::TrimWhiteSpace(name, true, true);
+
+        AZStd::lock_guard lock(m_mutex);
+        if (auto callIdIt = m_callIds.find(name); callIdIt != m_callIds.end())
+        {
+            return callIdIt->second;
+        }
+
+        if (m_names.size() == MaxCallCount)
+        {
+            AZ_Warning("RGL", false, "Too many RGL API functions to trace. Calls of %s are not recorded.", name.c_str());
+            return InvalidCallId;
+        }
+
+        const CallId callId = m_names.size();
+        m_names.push_back(name);
+        m_callIds.emplace(AZStd::move(name), callId);
+        return callId;
+    }
+
+    void ApiTracer::Record(CallId callId, AZStd::chrono::nanoseconds latency, size_t byteCount)
+    {
+        if (callId == InvalidCallId || !m_isEnabled.load(AZStd::memory_order_relaxed))
+        {
+            return;
+        }
+
+        CallCounters& counters = m_counters[callId];
+        const auto latencyNs = aznumeric_cast<AZ::u64>(latency.count());
+        counters.m_callCount.fetch_add(1LU, AZStd::memory_order_relaxed);
+        counters.m_byteCount.fetch_add(byteCount, AZStd::memory_order_relaxed);
+        counters.m_totalLatencyNs.fetch_add(latencyNs, AZStd::memory_order_relaxed);
+
+        AZ::u64 maxLatencyNs = counters.m_maxLatencyNs.load(AZStd::memory_order_relaxed);
+        while (latencyNs > maxLatencyNs &&
+               !counters.m_maxLatencyNs.compare_exchange_weak(maxLatencyNs, latencyNs, AZStd::memory_order_relaxed))
+        {
+        }
+
+        const auto latencyUs = aznumeric_cast<AZ::u64>(AZStd::chrono::duration_cast<AZStd::chrono::microseconds>(latency).count());
+        counters.m_latencyHistogram[GetLog2Bucket(latencyUs, LatencyBucketCount)].fetch_add(1LU, AZStd::memory_order_relaxed);
+
+        counters.m_tickCallCount.fetch_add(1LU, AZStd::memory_order_relaxed);
+        counters.m_tickByteCount.fetch_add(byteCount, AZStd::memory_order_relaxed);
+    }
+
+    void ApiTracer::EndTick()
+    {
+        if (!m_isEnabled.load(AZStd::memory_order_relaxed))
+        {
+            return;
+        }
+
+        AZStd::lock_guard lock(m_mutex);
+        ++m_tickCount;
+        for (CallId callId = 0LU; callId < m_names.size(); ++callId)
+        {
+            CallCounters& counters = m_counters[callId];
+            const AZ::u64 tickCallCount = counters.m_tickCallCount.exchange(0LU, AZStd::memory_order_relaxed);
+            const AZ::u64 tickByteCount = counters.m_tickByteCount.exchange(0LU, AZStd::memory_order_relaxed);
+
+            TickStatistics& statistics = m_tickStatistics[callId];
+            statistics.m_maxTickCallCount = AZStd::max(statistics.m_maxTickCallCount, tickCallCount);
+            statistics.m_maxTickByteCount = AZStd::max(statistics.m_maxTickByteCount, tickByteCount);
+            ++statistics.m_tickCallsHistogram[GetLog2Bucket(tickCallCount, TickCallsBucketCount)];
+        }
+    }
+
+    void ApiTracer::Reset()
+    {
+        AZStd::lock_guard lock(m_mutex);
+        m_tickCount = 0LU;
+        for (CallId callId = 0LU; callId < m_names.size(); ++callId)
+        {
+            ResetCounters(callId);
+        }
+    }
+
+    void ApiTracer::ResetCounters(CallId callId)
+    {
+        // Calls recorded concurrently with the reset may be partially kept, which is acceptable for statistics.
+        CallCounters& counters = m_counters[callId];
+        counters.m_callCount.store(0LU, AZStd::memory_order_relaxed);
+        counters.m_byteCount.store(0LU, AZStd::memory_order_relaxed);
+        counters.m_totalLatencyNs.store(0LU, AZStd::memory_order_relaxed);
+        counters.m_maxLatencyNs.store(0LU, AZStd::memory_order_relaxed);
+        for (AZStd::atomic<AZ::u64>& bucketCount : counters.m_latencyHistogram)
+        {
+            bucketCount.store(0LU, AZStd::memory_order_relaxed);
+        }
+        counters.m_tickCallCount.store(0LU, AZStd::memory_order_relaxed);
+        counters.m_tickByteCount.store(0LU, AZStd::memory_order_relaxed);
+        m_tickStatistics[callId] = TickStatistics{};
+    }
+
+    bool ApiTracer::IsEnabled() const
+    {
+        return m_isEnabled.load(AZStd::memory_order_relaxed);
+    }
+
+    void ApiTracer::SetEnabled(bool isEnabled)
+    {
+        m_isEnabled.store(isEnabled, AZStd::memory_order_relaxed);
+    }
+
+    AZStd::vector<ApiTracer::CallStatistics> ApiTracer::GetStatistics() const
+    {
+        AZStd::lock_guard lock(m_mutex);
+        AZStd::vector<CallStatistics> statistics(m_names.size());
+        for (CallId callId = 0LU; callId < m_names.size(); ++callId)
+        {
+            const CallCounters& counters = m_counters[callId];
+            const TickStatistics& tickStatistics = m_tickStatistics[callId];
+            CallStatistics& callStatistics = statistics[callId];
+            callStatistics.m_name = m_names[callId];
+            callStatistics.m_callCount = counters.m_callCount.load(AZStd::memory_order_relaxed);
+            callStatistics.m_byteCount = counters.m_byteCount.load(AZStd::memory_order_relaxed);
+            callStatistics.m_totalLatency = AZStd::chrono::nanoseconds(counters.m_totalLatencyNs.load(AZStd::memory_order_relaxed));
+            callStatistics.m_maxLatency = AZStd::chrono::nanoseconds(counters.m_maxLatencyNs.load(AZStd::memory_order_relaxed));
+            for (size_t bucket = 0LU; bucket < LatencyBucketCount; ++bucket)
+            {
+                callStatistics.m_latencyHistogram[bucket] = counters.m_latencyHistogram[bucket].load(AZStd::memory_order_relaxed);
+            }
+            callStatistics.m_maxTickCallCount = tickStatistics.m_maxTickCallCount;
+            callStatistics.m_maxTickByteCount = tickStatistics.m_maxTickByteCount;
+            callStatistics.m_tickCallsHistogram = tickStatistics.m_tickCallsHistogram;
+            callStatistics.m_tickCallCount = counters.m_tickCallCount.load(AZStd::memory_order_relaxed);
+            callStatistics.m_tickByteCount = counters.m_tickByteCount.load(AZStd::memory_order_relaxed);
+        }
+        return statistics;
+    }
+
+    AZ::u64 ApiTracer::GetCallCount(const AZStd::string& name) const
+    {
+        AZStd::lock_guard lock(m_mutex);
+        if (auto callIdIt = m_callIds.find(name); callIdIt != m_callIds.end())
+        {
+            return m_counters[callIdIt->second].m_callCount.load(AZStd::memory_order_relaxed);
+        }
+        return 0LU;
+    }
+
+    AZ::u64 ApiTracer::GetTickCount() const
+    {
+        AZStd::lock_guard lock(m_mutex);
+        return m_tickCount;
+    }
+
+    bool ApiTracer::ExportHistograms(const AZStd::string& filePath) const
+    {
+        const AZStd::vector<CallStatistics> statistics = GetStatistics();
+        const auto tickCount = aznumeric_cast<double>(AZStd::max(GetTickCount(), AZ::u64{ 1LU }));
+
+        AZStd::string csv{ "function,calls,bytes,total_us,max_us,calls_per_tick,bytes_per_tick,max_calls_per_tick,max_bytes_per_tick" };
+        for (size_t bucket = 0LU; bucket < LatencyBucketCount; ++bucket)
+        {
+            csv.append(",latency_lt_").append(AZStd::to_string(AZ::u64{ 1LU } << bucket)).append("us");
+        }
+        for (size_t bucket = 0LU; bucket < TickCallsBucketCount; ++bucket)
+        {
+            csv.append(",ticks_with_calls_lt_").append(AZStd::to_string(AZ::u64{ 1LU } << bucket));
+        }
+        csv += '\n';
+
+        for (const CallStatistics& callStatistics : statistics)
+        {
+            const auto totalUs = AZStd::chrono::duration_cast<AZStd::chrono::microseconds>(callStatistics.m_totalLatency).count();
+            const auto maxUs = AZStd::chrono::duration_cast<AZStd::chrono::microseconds>(callStatistics.m_maxLatency).count();
+
+            csv.append(callStatistics.m_name)
+                .append(",")
+                .append(AZStd::to_string(callStatistics.m_callCount))
+                .append(",")
+                .append(AZStd::to_string(callStatistics.m_byteCount))
+                .append(",")
+                .append(AZStd::to_string(totalUs))
+                .append(",")
+                .append(AZStd::to_string(maxUs))
+                .append(",")
+                .append(AZStd::to_string(aznumeric_cast<double>(callStatistics.m_callCount) / tickCount))
+                .append(",")
+                .append(AZStd::to_string(aznumeric_cast<double>(callStatistics.m_byteCount) / tickCount))
+                .append(",")
+                .append(AZStd::to_string(callStatistics.m_maxTickCallCount))
+                .append(",")
+                .append(AZStd::to_string(callStatistics.m_maxTickByteCount));
+
+            for (AZ::u64 bucketCount : callStatistics.m_latencyHistogram)
+            {
+                csv.append(",").append(AZStd::to_string(bucketCount));
+            }
+            for (AZ::u64 bucketCount : callStatistics.m_tickCallsHistogram)
+            {
+                csv.append(",").append(AZStd::to_string(bucketCount));
+            }
+            csv += '\n';
+        }
+
+        AZ::IO::SystemFile file;
+        if (!file.Open(filePath.c_str(), AZ::IO::SystemFile::SF_OPEN_CREATE | AZ::IO::SystemFile::SF_OPEN_WRITE_ONLY))
+        {
+            AZ_Error(__func__, false, "Unable to open %s for writing.", filePath.c_str());
+            return false;
+        }
+
+        return file.Write(csv.data(), csv.size()) == csv.size();
+    }
+
+    ScopedCall::ScopedCall(CallId callId, size_t byteCount)
+        : m_callId{ callId }
+        , m_byteCount{ byteCount }
+        , m_start{ AZStd::chrono::steady_clock::now() }
+    {
+    }
+
+    ScopedCall::~ScopedCall()
+    {
+        const auto latency = AZStd::chrono::duration_cast<AZStd::chrono::nanoseconds>(AZStd::chrono::steady_clock::now() - m_start);
+        ApiTracer::Get().Record(m_callId, latency, m_byteCount);
+    }
+} // namespace RGL::Tracing
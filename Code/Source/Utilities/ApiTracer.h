@@ -0,0 +1,148 @@
+/* Copyright 2020-2021, Robotec.ai sp. z o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <AzCore/std/chrono/chrono.h>
+#include <AzCore/std/containers/array.h>
+#include <AzCore/std/containers/unordered_map.h>
+#include <AzCore/std/containers/vector.h>
+#include <AzCore/std/parallel/atomic.h>
+#include <AzCore/std/parallel/mutex.h>
+#include <AzCore/std/string/string.h>
+
+namespace RGL::Tracing
+{
+    using CallId = size_t;
+
+    //! Records call counts, transferred bytes and latencies of the RGL API calls made by the gem.
+    //! Calls are recorded through the RGL_CHECK family of macros when the gem is compiled with the
+    //! RGL_API_TRACING CMake option. Statistics are aggregated per API function and per tick.
+    //! Calls are recorded with atomic counters, so that tracing does not serialize the threads calling RGL.
+    class ApiTracer
+    {
+    public:
+        //! Latency histogram buckets. Bucket i contains calls which took [2^(i-1), 2^i) microseconds (bucket 0 - below 1us).
+        static constexpr size_t LatencyBucketCount = 16LU;
+        //! Per-tick call count histogram buckets. Bucket i contains ticks with [2^(i-1), 2^i) calls (bucket 0 - no calls).
+        static constexpr size_t TickCallsBucketCount = 24LU;
+        //! Maximum number of distinct API functions. Calls of the functions registered above this limit are not recorded.
+        static constexpr size_t MaxCallCount = 128LU;
+        static constexpr CallId InvalidCallId = MaxCallCount;
+
+        struct CallStatistics
+        {
+            AZStd::string m_name;
+            AZ::u64 m_callCount{ 0LU };
+            AZ::u64 m_byteCount{ 0LU };
+            AZStd::chrono::nanoseconds m_totalLatency{ 0 };
+            AZStd::chrono::nanoseconds m_maxLatency{ 0 };
+            AZStd::array<AZ::u64, LatencyBucketCount> m_latencyHistogram{};
+
+            AZ::u64 m_maxTickCallCount{ 0LU };
+            AZ::u64 m_maxTickByteCount{ 0LU };
+            AZStd::array<AZ::u64, TickCallsBucketCount> m_tickCallsHistogram{};
+
+            // Accumulated during the current tick.
+            AZ::u64 m_tickCallCount{ 0LU };
+            AZ::u64 m_tickByteCount{ 0LU };
+        };
+
+        static ApiTracer& Get();
+
+        //! Returns the identifier of the API function called in the provided expression.
+        //! The expression is expected to be a call like "rgl_entity_set_pose(entity, &pose)".
+        CallId RegisterCall(const char* callExpression);
+
+        void Record(CallId callId, AZStd::chrono::nanoseconds latency, size_t byteCount);
+
+        //! Closes the current tick and accumulates its per-tick statistics.
+        void EndTick();
+
+        //! Clears all recorded statistics.
+        void Reset();
+
+        [[nodiscard]] bool IsEnabled() const;
+        void SetEnabled(bool isEnabled);
+
+        [[nodiscard]] AZStd::vector<CallStatistics> GetStatistics() const;
+        //! Returns the number of recorded calls of the API function with the given name (e.g. "rgl_entity_set_pose").
+        [[nodiscard]] AZ::u64 GetCallCount(const AZStd::string& name) const;
+        [[nodiscard]] AZ::u64 GetTickCount() const;
+
+        //! Writes the per-function statistics with the latency and per-tick call count histograms to a CSV file.
+        //! @return If successful returns true, otherwise returns false.
+        bool ExportHistograms(const AZStd::string& filePath) const;
+
+    private:
+        //! Counters updated by the calls, which may be recorded concurrently.
+        struct CallCounters
+        {
+            AZStd::atomic<AZ::u64> m_callCount{ 0LU };
+            AZStd::atomic<AZ::u64> m_byteCount{ 0LU };
+            AZStd::atomic<AZ::u64> m_totalLatencyNs{ 0LU };
+            AZStd::atomic<AZ::u64> m_maxLatencyNs{ 0LU };
+            AZStd::array<AZStd::atomic<AZ::u64>, LatencyBucketCount> m_latencyHistogram{};
+            AZStd::atomic<AZ::u64> m_tickCallCount{ 0LU };
+            AZStd::atomic<AZ::u64> m_tickByteCount{ 0LU };
+        };
+
+        //! Per-tick statistics, updated only when closing a tick.
+        struct TickStatistics
+        {
+            AZ::u64 m_maxTickCallCount{ 0LU };
+            AZ::u64 m_maxTickByteCount{ 0LU };
+            AZStd::array<AZ::u64, TickCallsBucketCount> m_tickCallsHistogram{};
+        };
+
+        ApiTracer() = default;
+
+        void ResetCounters(CallId callId);
+
+        //! Guards the registration, the per-tick statistics and the snapshots. Recording a call does not lock it.
+        mutable AZStd::mutex m_mutex;
+        AZStd::atomic_bool m_isEnabled{ true };
+        AZ::u64 m_tickCount{ 0LU };
+        AZStd::array<CallCounters, MaxCallCount> m_counters;
+        AZStd::array<TickStatistics, MaxCallCount> m_tickStatistics;
+        AZStd::vector<AZStd::string> m_names;
+        AZStd::unordered_map<AZStd::string, CallId> m_callIds;
+    };
+
+    //! Records the latency of a single API call on destruction.
+    class ScopedCall
+    {
+    public:
+        ScopedCall(CallId callId, size_t byteCount);
+        ~ScopedCall();
+
+    private:
+        CallId m_callId;
+        size_t m_byteCount;
+        AZStd::chrono::steady_clock::time_point m_start;
+    };
+} // namespace RGL::Tracing
+
+#ifdef RGL_API_TRACING_ENABLED
+//! Evaluates the RGL API call x and records it in the ApiTracer along with the provided number of transferred bytes.
+#define RGL_TRACE(x, byteCount)                                                                                                            \
+    ([&]()                                                                                                                                 \
+     {                                                                                                                                     \
+         static const RGL::Tracing::CallId CallId = RGL::Tracing::ApiTracer::Get().RegisterCall(#x);                                       \
+         RGL::Tracing::ScopedCall scopedCall(CallId, byteCount);                                                                           \
+         return x;                                                                                                                         \
+     }())
+#else
+#define RGL_TRACE(x, byteCount) (x)
+#endif
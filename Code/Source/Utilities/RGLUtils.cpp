@@ -7,6 +7,7 @@
  */
 #include <AzCore/Casting/numeric_cast.h>
 #include <AzCore/std/containers/unordered_set.h>
+#include <AzCore/std/containers/vector.h>
 #include <AzCore/std/string/conversions.h>
 #include <Utilities/RGLUtils.h>
 #include <iostream>
@@ -19,7 +20,9 @@ namespace RGL::Utils
     {
         bool success = false;
         ErrorCheck(
-            rgl_mesh_create(&targetMesh, vertices, aznumeric_cast<int32_t>(vertexCount), indices, aznumeric_cast<int32_t>(indexCount)),
+            RGL_TRACE(
+                rgl_mesh_create(&targetMesh, vertices, aznumeric_cast<int32_t>(vertexCount), indices, aznumeric_cast<int32_t>(indexCount)),
+                vertexCount * sizeof(rgl_vec3f) + indexCount * sizeof(rgl_vec3i)),
             __FILE__,
             __LINE__,
             &success);
@@ -31,10 +34,17 @@ namespace RGL::Utils
         }
     }
 
+    void SetUniformTextureCoords(rgl_mesh_t mesh, size_t vertexCount)
+    {
+        const AZStd::vector<rgl_vec2f> textureCoords(vertexCount, rgl_vec2f{ { 0.0f, 0.0f } });
+        RGL_CHECK_BYTES(
+            rgl_mesh_set_texture_coords(mesh, textureCoords.data(), aznumeric_cast<int32_t>(vertexCount)), vertexCount * sizeof(rgl_vec2f));
+    }
+
     void SafeRglEntityCreate(rgl_entity_t& targetEntity, rgl_mesh_t mesh)
     {
         bool success = false;
-        ErrorCheck(rgl_entity_create(&targetEntity, nullptr, mesh), __FILE__, __LINE__, &success);
+        ErrorCheck(RGL_TRACE(rgl_entity_create(&targetEntity, nullptr, mesh), 0LU), __FILE__, __LINE__, &success);
         if (!success && !targetEntity)
         {
             RGL_CHECK(rgl_entity_destroy(targetEntity));
@@ -9,6 +9,7 @@
 
 #include <rgl/api/core.h>
 #include <AzCore/Math/Matrix3x4.h>
+#include <Utilities/ApiTracer.h>
 
 namespace RGL::Utils
 {
@@ -17,6 +18,10 @@ namespace RGL::Utils
     void SafeRglMeshCreate(
         rgl_mesh_t& targetMesh, const rgl_vec3f* vertices, size_t vertexCount, const rgl_vec3i* indices, size_t indexCount);
 
+    //! Sets constant texture coordinates for all the vertices of the mesh, so that the uniform intensity textures apply to it.
+    //! The coordinates take 8 bytes per vertex on the device, so they are set only for the meshes of the entities with reflectivity.
+    void SetUniformTextureCoords(rgl_mesh_t mesh, size_t vertexCount);
+
     //! Creates an RGL entity ensuring that if it cannot be created the targetEntity is set to nullptr.
     //! This function should be preferred over the rgl_entity_create function.
     void SafeRglEntityCreate(rgl_entity_t& targetEntity, rgl_mesh_t mesh);
@@ -32,7 +37,10 @@ namespace RGL::Utils
 
     //! Macro used for calling the ErrorCheck function.
     //! Each status returned by RGL API should be passed to it.
-#define RGL_CHECK(x) RGL::Utils::ErrorCheck(x, __FILE__, __LINE__)
+#define RGL_CHECK(x) RGL::Utils::ErrorCheck(RGL_TRACE(x, 0LU), __FILE__, __LINE__)
+
+    //! Same as RGL_CHECK, but additionally reports the number of bytes transferred by the call to the ApiTracer.
+#define RGL_CHECK_BYTES(x, byteCount) RGL::Utils::ErrorCheck(RGL_TRACE(x, byteCount), __FILE__, __LINE__)
 
     rgl_mat3x4f RglMat3x4FromAzMatrix3x4(const AZ::Matrix3x4& azMatrix);
     AZ::Matrix3x4 AzMatrix3x4FromRglMat3x4(const rgl_mat3x4f& rglMatrix);
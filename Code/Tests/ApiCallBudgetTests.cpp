@@ -0,0 +1,120 @@
+/* Copyright 2020-2021, Robotec.ai sp. z o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <AzTest/AzTest.h>
+#include <Lidar/PipelineGraph.h>
+#include <Scene/SceneCommandBuffer.h>
+#include <Utilities/ApiTracer.h>
+#include <Utilities/RGLUtils.h>
+
+namespace RGL
+{
+    //! Regression checks of the number of RGL API calls issued by the gem, catching e.g. pose spam or redundant graph
+    //! reconfiguration. They require the RGL_API_TRACING CMake option and run without a GPU with the RGL_CPU_BACKEND option.
+    class ApiCallBudgetTest : public ::testing::Test
+    {
+    protected:
+        void SetUp() override
+        {
+#ifndef RGL_API_TRACING_ENABLED
+            GTEST_SKIP() << "The RGL API calls are traced only with the RGL_API_TRACING CMake option.";
+#endif
+        }
+
+        void TearDown() override
+        {
+            RGL_CHECK(rgl_cleanup());
+        }
+
+        static AZ::u64 GetCallCount(const char* name)
+        {
+            return Tracing::ApiTracer::Get().GetCallCount(name);
+        }
+
+        static rgl_entity_t CreateEntity()
+        {
+            const rgl_vec3f vertices[] = { { { 0.0f, 0.0f, 0.0f } }, { { 1.0f, 0.0f, 0.0f } }, { { 0.0f, 1.0f, 0.0f } } };
+            const rgl_vec3i indices[] = { { { 0, 1, 2 } } };
+            rgl_mesh_t mesh = nullptr;
+            rgl_entity_t entity = nullptr;
+            RGL_CHECK(rgl_mesh_create(&mesh, vertices, 3, indices, 1));
+            RGL_CHECK(rgl_entity_create(&entity, nullptr, mesh));
+            return entity;
+        }
+    };
+
+    TEST_F(ApiCallBudgetTest, PosesAreSetOncePerFlush)
+    {
+        const rgl_entity_t entity = CreateEntity();
+        SceneCommandBuffer commandBuffer;
+        Tracing::ApiTracer::Get().Reset();
+
+        for (float offset : { 1.0f, 2.0f, 3.0f })
+        {
+            commandBuffer.SetEntityPose(entity, Utils::RglMat3x4FromAzMatrix3x4(AZ::Matrix3x4::CreateTranslation(AZ::Vector3(offset))));
+        }
+        commandBuffer.Flush();
+        // Nothing was recorded since the last flush.
+        commandBuffer.Flush();
+
+        EXPECT_EQ(GetCallCount("rgl_entity_set_pose"), 1LU);
+    }
+
+    TEST_F(ApiCallBudgetTest, PosesOfDestroyedEntitiesAreDropped)
+    {
+        const rgl_entity_t entity = CreateEntity();
+        SceneCommandBuffer commandBuffer;
+        Tracing::ApiTracer::Get().Reset();
+
+        commandBuffer.SetEntityPose(entity, Utils::RglMat3x4FromAzMatrix3x4(AZ::Matrix3x4::CreateIdentity()));
+        commandBuffer.DestroyEntity(entity);
+        commandBuffer.FlushDestructions();
+        commandBuffer.Flush();
+
+        EXPECT_EQ(GetCallCount("rgl_entity_set_pose"), 0LU);
+        EXPECT_EQ(GetCallCount("rgl_entity_destroy"), 1LU);
+    }
+
+    TEST_F(ApiCallBudgetTest, UnchangedFeaturesDoNotReconnectTheGraph)
+    {
+        PipelineGraph graph;
+        Tracing::ApiTracer::Get().Reset();
+
+        graph.SetIsCompactEnabled(graph.IsCompactEnabled());
+        graph.SetIsNoiseEnabled(graph.IsNoiseEnabled());
+        graph.SetIsDownsampleEnabled(false);
+        graph.SetIsMotionDistortionEnabled(graph.IsMotionDistortionEnabled());
+
+        EXPECT_EQ(GetCallCount("rgl_graph_node_add_child"), 0LU);
+        EXPECT_EQ(GetCallCount("rgl_graph_node_remove_child"), 0LU);
+    }
+
+    TEST_F(ApiCallBudgetTest, RunningTheGraphDoesNotReconfigureIt)
+    {
+        PipelineGraph graph;
+        graph.ConfigureRayPosesNode({ Utils::RglMat3x4FromAzMatrix3x4(AZ::Matrix3x4::CreateIdentity()) });
+        Tracing::ApiTracer::Get().Reset();
+
+        graph.Run();
+        graph.Run();
+
+        AZ::u64 callCount = 0LU;
+        for (const Tracing::ApiTracer::CallStatistics& statistics : Tracing::ApiTracer::Get().GetStatistics())
+        {
+            callCount += statistics.m_callCount;
+        }
+        EXPECT_EQ(GetCallCount("rgl_graph_run"), 2LU);
+        EXPECT_EQ(callCount, 2LU);
+    }
+} // namespace RGL
@@ -0,0 +1,183 @@
+/* Copyright 2020-2021, Robotec.ai sp. z o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <AzCore/std/containers/unordered_map.h>
+#include <AzTest/AzTest.h>
+#include <Entity/DynamicEntityList.h>
+
+namespace RGL
+{
+    namespace
+    {
+        rgl_entity_t MakeEntity(uintptr_t handle)
+        {
+            return reinterpret_cast<rgl_entity_t>(handle);
+        }
+
+        //! Transform returning a fixed world pose.
+        class FakeTransform : public AZ::TransformInterface
+        {
+        public:
+            explicit FakeTransform(const AZ::Vector3& translation)
+                : m_transform{ AZ::Transform::CreateTranslation(translation) }
+            {
+            }
+
+            void BindTransformChangedEventHandler(AZ::TransformChangedEvent::Handler&) override
+            {
+            }
+            void BindParentChangedEventHandler(AZ::ParentChangedEvent::Handler&) override
+            {
+            }
+            void BindChildChangedEventHandler(AZ::ChildChangedEvent::Handler&) override
+            {
+            }
+            void NotifyChildChangedEvent(AZ::ChildChangeType, AZ::EntityId) override
+            {
+            }
+            const AZ::Transform& GetLocalTM() override
+            {
+                return m_transform;
+            }
+            void SetLocalTM(const AZ::Transform& transform) override
+            {
+                m_transform = transform;
+            }
+            const AZ::Transform& GetWorldTM() override
+            {
+                return m_transform;
+            }
+            void SetWorldTM(const AZ::Transform& transform) override
+            {
+                m_transform = transform;
+            }
+            void GetLocalAndWorld(AZ::Transform& localTransform, AZ::Transform& worldTransform) override
+            {
+                localTransform = m_transform;
+                worldTransform = m_transform;
+            }
+
+        private:
+            AZ::Transform m_transform;
+        };
+
+        //! Command buffer recording the poses only.
+        class PoseRecorder : public SceneCommandBufferRequests
+        {
+        public:
+            void SetEntityPose(rgl_entity_t entity, const rgl_mat3x4f& pose) override
+            {
+                m_poses[entity] = pose;
+                ++m_poseCount;
+            }
+            void UpdateMeshVertices(rgl_mesh_t, AZStd::span<const rgl_vec3f>) override
+            {
+            }
+            void DestroyEntity(rgl_entity_t) override
+            {
+            }
+            void DestroyMesh(rgl_mesh_t) override
+            {
+            }
+            void Flush() override
+            {
+            }
+            void SetEntityBoundingRadius(rgl_entity_t, float) override
+            {
+            }
+            AZ::u64 GetSceneVersion() const override
+            {
+                return 0LU;
+            }
+            bool HasSceneChangedSince(AZ::u64, const AZ::Vector3&, float) const override
+            {
+                return false;
+            }
+
+            AZStd::unordered_map<rgl_entity_t, rgl_mat3x4f> m_poses;
+            size_t m_poseCount{ 0LU };
+        };
+    } // namespace
+
+    TEST(DynamicEntityListTest, MovedEntitiesGetTheWorldPose)
+    {
+        FakeTransform transform(AZ::Vector3(1.0f, 2.0f, 3.0f));
+        DynamicEntityList entityList;
+        PoseRecorder commandBuffer;
+        entityList.Add(&transform, MakeEntity(1LU));
+        entityList.Add(&transform, MakeEntity(2LU));
+        entityList.UpdatePoses(commandBuffer);
+
+        ASSERT_EQ(commandBuffer.m_poseCount, 2LU);
+        const rgl_mat3x4f& pose = commandBuffer.m_poses[MakeEntity(1LU)];
+        EXPECT_FLOAT_EQ(pose.value[0][3], 1.0f);
+        EXPECT_FLOAT_EQ(pose.value[1][3], 2.0f);
+        EXPECT_FLOAT_EQ(pose.value[2][3], 3.0f);
+    }
+
+    TEST(DynamicEntityListTest, IdleEntitiesAreNotUpdated)
+    {
+        FakeTransform transform(AZ::Vector3::CreateZero());
+        DynamicEntityList entityList;
+        PoseRecorder commandBuffer;
+        entityList.Add(&transform, MakeEntity(1LU));
+        entityList.UpdatePoses(commandBuffer);
+        entityList.UpdatePoses(commandBuffer);
+        EXPECT_EQ(commandBuffer.m_poseCount, 1LU);
+
+        // Adding a listed entity marks it as moved again.
+        entityList.Add(&transform, MakeEntity(1LU));
+        entityList.UpdatePoses(commandBuffer);
+        EXPECT_EQ(commandBuffer.m_poseCount, 2LU);
+        EXPECT_EQ(entityList.GetSize(), 1LU);
+    }
+
+    TEST(DynamicEntityListTest, IdleEntitiesAreRemovedAfterTheLimit)
+    {
+        FakeTransform transform(AZ::Vector3::CreateZero());
+        DynamicEntityList entityList;
+        PoseRecorder commandBuffer;
+        entityList.Add(&transform, MakeEntity(1LU));
+        for (uint32_t tick = 0U; tick < DynamicEntityList::IdleTickLimit; ++tick)
+        {
+            entityList.UpdatePoses(commandBuffer);
+        }
+        EXPECT_EQ(entityList.GetSize(), 1LU);
+
+        entityList.UpdatePoses(commandBuffer);
+        EXPECT_EQ(entityList.GetSize(), 0LU);
+    }
+
+    TEST(DynamicEntityListTest, RemovalKeepsTheOtherEntities)
+    {
+        FakeTransform transform(AZ::Vector3::CreateZero());
+        DynamicEntityList entityList;
+        PoseRecorder commandBuffer;
+        for (uintptr_t handle = 1LU; handle <= 3LU; ++handle)
+        {
+            entityList.Add(&transform, MakeEntity(handle));
+        }
+        entityList.Remove(MakeEntity(1LU));
+        entityList.Remove(MakeEntity(4LU));
+        EXPECT_EQ(entityList.GetSize(), 2LU);
+
+        entityList.UpdatePoses(commandBuffer);
+        EXPECT_EQ(commandBuffer.m_poseCount, 2LU);
+        EXPECT_FALSE(commandBuffer.m_poses.contains(MakeEntity(1LU)));
+
+        // The moved entity is still found after the removal reordered the list.
+        entityList.Remove(MakeEntity(3LU));
+        EXPECT_EQ(entityList.GetSize(), 1LU);
+    }
+} // namespace RGL
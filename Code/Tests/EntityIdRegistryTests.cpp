@@ -0,0 +1,84 @@
+/* Copyright 2020-2021, Robotec.ai sp. z o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <AzCore/Casting/numeric_cast.h>
+#include <AzCore/std/containers/vector.h>
+#include <AzTest/AzTest.h>
+#include <Entity/EntityIdRegistry.h>
+
+namespace RGL
+{
+    TEST(EntityIdRegistryTest, IdsStartAfterTheInvalidId)
+    {
+        EntityIdRegistry registry;
+        EXPECT_EQ(registry.Acquire(AZ::EntityId{ 10U }), 1);
+        EXPECT_EQ(registry.Acquire(AZ::EntityId{ 20U }), 2);
+
+        EXPECT_EQ(registry.GetEntityId(1), AZ::EntityId{ 10U });
+        EXPECT_EQ(registry.GetEntityId(2), AZ::EntityId{ 20U });
+        EXPECT_FALSE(registry.GetEntityId(EntityIdRegistry::InvalidId).IsValid());
+        EXPECT_FALSE(registry.GetEntityId(3).IsValid());
+        EXPECT_FALSE(registry.GetEntityId(-1).IsValid());
+    }
+
+    TEST(EntityIdRegistryTest, ReleasedIdIsNotMapped)
+    {
+        EntityIdRegistry registry;
+        const int32_t rglEntityId = registry.Acquire(AZ::EntityId{ 10U });
+        registry.Release(rglEntityId);
+        registry.Release(EntityIdRegistry::InvalidId);
+
+        EXPECT_FALSE(registry.GetEntityId(rglEntityId).IsValid());
+    }
+
+    TEST(EntityIdRegistryTest, ReleasedIdsAreReusedAfterTheDelayInReleaseOrder)
+    {
+        EntityIdRegistry registry;
+        AZStd::vector<int32_t> rglEntityIds;
+        for (AZ::u64 entity = 1U; entity <= EntityIdRegistry::ReuseDelay + 2U; ++entity)
+        {
+            rglEntityIds.push_back(registry.Acquire(AZ::EntityId{ entity }));
+        }
+
+        // The first release is not reused immediately.
+        registry.Release(rglEntityIds[1]);
+        const int32_t newId = registry.Acquire(AZ::EntityId{ 1000000U });
+        EXPECT_EQ(newId, aznumeric_cast<int32_t>(EntityIdRegistry::ReuseDelay) + 3);
+
+        registry.Release(rglEntityIds[0]);
+        for (size_t index = 2U; index < rglEntityIds.size(); ++index)
+        {
+            registry.Release(rglEntityIds[index]);
+        }
+
+        // More than ReuseDelay ids are free now, so the oldest ones are reused first.
+        EXPECT_EQ(registry.Acquire(AZ::EntityId{ 2000000U }), rglEntityIds[1]);
+        EXPECT_EQ(registry.Acquire(AZ::EntityId{ 3000000U }), rglEntityIds[0]);
+        EXPECT_EQ(registry.GetEntityId(rglEntityIds[1]), AZ::EntityId{ 2000000U });
+        EXPECT_EQ(registry.GetEntityId(rglEntityIds[0]), AZ::EntityId{ 3000000U });
+        // The remaining ReuseDelay ids stay free, so a new id is assigned again.
+        EXPECT_EQ(registry.Acquire(AZ::EntityId{ 4000000U }), newId + 1);
+    }
+
+    TEST(EntityIdRegistryTest, ClearRestartsTheIds)
+    {
+        EntityIdRegistry registry;
+        const int32_t rglEntityId = registry.Acquire(AZ::EntityId{ 10U });
+        registry.Release(registry.Acquire(AZ::EntityId{ 20U }));
+        registry.Clear();
+
+        EXPECT_FALSE(registry.GetEntityId(rglEntityId).IsValid());
+        EXPECT_EQ(registry.Acquire(AZ::EntityId{ 30U }), 1);
+    }
+} // namespace RGL
@@ -0,0 +1,111 @@
+/* Copyright 2020-2021, Robotec.ai sp. z o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <AzCore/Casting/numeric_cast.h>
+#include <AzCore/std/containers/vector.h>
+#include <AzTest/AzTest.h>
+#include <Entity/EntityManagerPool.h>
+
+namespace RGL
+{
+    namespace
+    {
+        //! Manager counting the live instances.
+        struct TestManager
+        {
+            TestManager(int value, int& liveCount)
+                : m_value{ value }
+                , m_liveCount{ liveCount }
+            {
+                ++m_liveCount;
+            }
+
+            ~TestManager()
+            {
+                --m_liveCount;
+            }
+
+            int m_value;
+            int& m_liveCount;
+        };
+    } // namespace
+
+    TEST(EntityManagerPoolTest, ManagersKeepTheirAddresses)
+    {
+        int liveCount = 0;
+        EntityManagerPool<TestManager> pool;
+        AZStd::vector<TestManager*> managers;
+        const int managerCount = aznumeric_cast<int>(EntityManagerPool<TestManager>::ChunkSize) * 2 + 1;
+        for (int value = 0; value < managerCount; ++value)
+        {
+            managers.push_back(pool.Create(value, liveCount));
+        }
+
+        EXPECT_EQ(pool.GetSize(), aznumeric_cast<size_t>(managerCount));
+        EXPECT_EQ(liveCount, managerCount);
+        for (int value = 0; value < managerCount; ++value)
+        {
+            EXPECT_EQ(managers[value]->m_value, value);
+        }
+    }
+
+    TEST(EntityManagerPoolTest, DestroyedSlotsAreReused)
+    {
+        int liveCount = 0;
+        EntityManagerPool<TestManager> pool;
+        TestManager* first = pool.Create(1, liveCount);
+        pool.Create(2, liveCount);
+        pool.Destroy(first);
+        EXPECT_EQ(liveCount, 1);
+        EXPECT_EQ(pool.GetSize(), 1LU);
+
+        TestManager* reused = pool.Create(3, liveCount);
+        EXPECT_EQ(reused, first);
+        EXPECT_EQ(reused->m_value, 3);
+    }
+
+    TEST(EntityManagerPoolTest, ForEachVisitsTheManagersInStorageOrder)
+    {
+        int liveCount = 0;
+        EntityManagerPool<TestManager> pool;
+        for (int value = 0; value < 4; ++value)
+        {
+            pool.Create(value, liveCount);
+        }
+
+        AZStd::vector<int> values;
+        pool.ForEach(
+            [&values](TestManager& manager)
+            {
+                values.push_back(manager.m_value);
+            });
+        EXPECT_EQ(values, AZStd::vector<int>({ 0, 1, 2, 3 }));
+    }
+
+    TEST(EntityManagerPoolTest, ClearAndDestructionDestroyAllManagers)
+    {
+        int liveCount = 0;
+        {
+            EntityManagerPool<TestManager> pool;
+            pool.Create(1, liveCount);
+            pool.Create(2, liveCount);
+            pool.Clear();
+            EXPECT_EQ(liveCount, 0);
+            EXPECT_EQ(pool.GetSize(), 0LU);
+
+            pool.Create(3, liveCount);
+        }
+        EXPECT_EQ(liveCount, 0);
+    }
+} // namespace RGL
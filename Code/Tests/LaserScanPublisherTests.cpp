@@ -0,0 +1,100 @@
+/* Copyright 2020-2021, Robotec.ai sp. z o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <AzCore/Math/MathUtils.h>
+#include <AzTest/AzTest.h>
+#include <Lidar/LaserScanPublisher.h>
+#include <Utilities/RGLUtils.h>
+
+namespace RGL
+{
+    namespace
+    {
+        constexpr float AngleTolerance = 1e-5f;
+
+        //! Ray with the given azimuth and elevation. The rotation around the Y axis turns the Z axis of the ray towards the X axis.
+        rgl_mat3x4f MakeRay(float azimuth, float elevation = 0.0f)
+        {
+            return Utils::RglMat3x4FromAzMatrix3x4(
+                AZ::Matrix3x4::CreateRotationZ(azimuth) * AZ::Matrix3x4::CreateRotationY(AZ::Constants::HalfPi - elevation));
+        }
+
+        //! Uniformly spaced horizontal rays.
+        AZStd::vector<rgl_mat3x4f> MakeRays(float firstAzimuth, float azimuthStep, size_t rayCount)
+        {
+            AZStd::vector<rgl_mat3x4f> rays;
+            for (size_t rayIndex = 0U; rayIndex < rayCount; ++rayIndex)
+            {
+                rays.push_back(MakeRay(firstAzimuth + azimuthStep * static_cast<float>(rayIndex)));
+            }
+            return rays;
+        }
+    } // namespace
+
+    TEST(LaserScanPublisherTest, AnglesAreDerivedFromTheRays)
+    {
+        LaserScanPublisher::ScanAngles scanAngles;
+        ASSERT_EQ(
+            LaserScanPublisher::ComputeScanAngles(MakeRays(-1.0f, 0.25f, 9U), scanAngles), LaserScanPublisher::ScanAnglesResult::Planar);
+        EXPECT_NEAR(scanAngles.m_angleMin, -1.0f, AngleTolerance);
+        EXPECT_NEAR(scanAngles.m_angleMax, 1.0f, AngleTolerance);
+        EXPECT_NEAR(scanAngles.m_angleIncrement, 0.25f, AngleTolerance);
+    }
+
+    TEST(LaserScanPublisherTest, DescendingAnglesHaveNegativeIncrement)
+    {
+        LaserScanPublisher::ScanAngles scanAngles;
+        ASSERT_EQ(
+            LaserScanPublisher::ComputeScanAngles(MakeRays(0.5f, -0.25f, 5U), scanAngles), LaserScanPublisher::ScanAnglesResult::Planar);
+        EXPECT_NEAR(scanAngles.m_angleMin, 0.5f, AngleTolerance);
+        EXPECT_NEAR(scanAngles.m_angleMax, -0.5f, AngleTolerance);
+        EXPECT_NEAR(scanAngles.m_angleIncrement, -0.25f, AngleTolerance);
+    }
+
+    TEST(LaserScanPublisherTest, AnglesAreUnwrappedAcrossTheNegativeXAxis)
+    {
+        // The scan starts below pi and continues past it, where atan2 wraps around to -pi.
+        LaserScanPublisher::ScanAngles scanAngles;
+        ASSERT_EQ(
+            LaserScanPublisher::ComputeScanAngles(MakeRays(AZ::Constants::Pi - 0.5f, 0.25f, 5U), scanAngles),
+            LaserScanPublisher::ScanAnglesResult::Planar);
+        EXPECT_NEAR(scanAngles.m_angleMin, AZ::Constants::Pi - 0.5f, AngleTolerance);
+        EXPECT_NEAR(scanAngles.m_angleMax, AZ::Constants::Pi + 0.5f, AngleTolerance);
+        EXPECT_NEAR(scanAngles.m_angleIncrement, 0.25f, AngleTolerance);
+    }
+
+    TEST(LaserScanPublisherTest, SingleRayIsRejected)
+    {
+        LaserScanPublisher::ScanAngles scanAngles;
+        EXPECT_EQ(LaserScanPublisher::ComputeScanAngles({ MakeRay(0.0f) }, scanAngles), LaserScanPublisher::ScanAnglesResult::TooFewRays);
+    }
+
+    TEST(LaserScanPublisherTest, ElevatedRaysAreRejected)
+    {
+        AZStd::vector<rgl_mat3x4f> rays = MakeRays(-1.0f, 0.5f, 5U);
+        rays[2] = MakeRay(0.0f, 0.1f);
+
+        LaserScanPublisher::ScanAngles scanAngles;
+        EXPECT_EQ(LaserScanPublisher::ComputeScanAngles(rays, scanAngles), LaserScanPublisher::ScanAnglesResult::NotPlanar);
+    }
+
+    TEST(LaserScanPublisherTest, NonUniformRaysAreRejected)
+    {
+        AZStd::vector<rgl_mat3x4f> rays = MakeRays(-1.0f, 0.5f, 5U);
+        rays[1] = MakeRay(-0.4f);
+
+        LaserScanPublisher::ScanAngles scanAngles;
+        EXPECT_EQ(LaserScanPublisher::ComputeScanAngles(rays, scanAngles), LaserScanPublisher::ScanAnglesResult::NotUniform);
+    }
+} // namespace RGL
@@ -0,0 +1,208 @@
+/* Copyright 2020-2021, Robotec.ai sp. z o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <AzCore/Math/MathUtils.h>
+#include <AzCore/std/limits.h>
+#include <AzTest/AzTest.h>
+#include <Lidar/LidarCrop.h>
+#include <Lidar/LidarResultProcessor.h>
+#include <Utilities/RGLUtils.h>
+
+namespace RGL
+{
+    namespace
+    {
+        constexpr float MaxRange = 100.0f;
+
+        LidarCropVolume MakeBox(const AZ::Vector3& dimensions, bool isInclusive, CropVolumeFrame frame = CropVolumeFrame::Sensor)
+        {
+            LidarCropVolume volume;
+            volume.m_boxDimensions = dimensions;
+            volume.m_isInclusive = isInclusive;
+            volume.m_frame = frame;
+            return volume;
+        }
+
+        //! Ray cast from the lidar origin along the Z axis of the lidar frame.
+        rgl_mat3x4f MakeRayAlongZ()
+        {
+            return Utils::RglMat3x4FromAzMatrix3x4(AZ::Matrix3x4::CreateIdentity());
+        }
+
+        rgl_mat3x4f MakeRayAlongX()
+        {
+            // The rotation around the Y axis turns the Z axis of the ray into the X axis of the lidar.
+            return Utils::RglMat3x4FromAzMatrix3x4(AZ::Matrix3x4::CreateRotationY(AZ::Constants::HalfPi));
+        }
+    } // namespace
+
+    TEST(LidarCropTest, NoVolumesDisableTheCrop)
+    {
+        LidarCrop crop;
+        crop.Configure({});
+
+        EXPECT_FALSE(crop.IsEnabled());
+        EXPECT_FALSE(crop.HasRayRanges());
+        EXPECT_FALSE(crop.IsPointFilterEnabled());
+    }
+
+    TEST(LidarCropTest, ExclusiveSensorVolumeEnclosingTheLidarSetsTheRayRanges)
+    {
+        LidarCrop crop;
+        crop.Configure({ MakeBox(AZ::Vector3(2.0f, 2.0f, 4.0f), false) });
+
+        EXPECT_TRUE(crop.IsEnabled());
+        EXPECT_TRUE(crop.HasRayRanges());
+        EXPECT_FALSE(crop.IsPointFilterEnabled());
+
+        const AZStd::vector<rgl_vec2f>& rayRanges = crop.ComputeRayRanges({ MakeRayAlongZ(), MakeRayAlongX() }, MaxRange);
+        ASSERT_EQ(rayRanges.size(), 2U);
+        // Each ray starts where it exits the box.
+        EXPECT_NEAR(rayRanges[0].value[0], 2.0f, 1e-5f);
+        EXPECT_FLOAT_EQ(rayRanges[0].value[1], MaxRange);
+        EXPECT_NEAR(rayRanges[1].value[0], 1.0f, 1e-5f);
+        EXPECT_FLOAT_EQ(rayRanges[1].value[1], MaxRange);
+    }
+
+    TEST(LidarCropTest, RayNotLeavingTheVolumeWithinTheMaxRangeIsCropped)
+    {
+        LidarCrop crop;
+        crop.Configure({ MakeBox(AZ::Vector3(4.0f * MaxRange), false) });
+
+        const AZStd::vector<rgl_vec2f>& rayRanges = crop.ComputeRayRanges({ MakeRayAlongZ() }, MaxRange);
+        ASSERT_EQ(rayRanges.size(), 1U);
+        EXPECT_FLOAT_EQ(rayRanges[0].value[0], MaxRange);
+        EXPECT_FLOAT_EQ(rayRanges[0].value[1], MaxRange);
+    }
+
+    TEST(LidarCropTest, CylinderEnclosingTheLidarSetsTheRayRanges)
+    {
+        LidarCropVolume cylinder;
+        cylinder.m_shape = CropVolumeShape::Cylinder;
+        cylinder.m_cylinderRadius = 1.5f;
+        cylinder.m_cylinderHeight = 6.0f;
+
+        LidarCrop crop;
+        crop.Configure({ cylinder });
+        ASSERT_TRUE(crop.HasRayRanges());
+
+        const AZStd::vector<rgl_vec2f>& rayRanges = crop.ComputeRayRanges({ MakeRayAlongZ(), MakeRayAlongX() }, MaxRange);
+        ASSERT_EQ(rayRanges.size(), 2U);
+        EXPECT_NEAR(rayRanges[0].value[0], 3.0f, 1e-5f);
+        EXPECT_NEAR(rayRanges[1].value[0], 1.5f, 1e-5f);
+    }
+
+    TEST(LidarCropTest, ExclusiveVolumeAwayFromTheLidarCropsThePoints)
+    {
+        LidarCropVolume volume = MakeBox(AZ::Vector3(2.0f), false);
+        volume.m_transform = AZ::Transform::CreateTranslation(AZ::Vector3(5.0f, 0.0f, 0.0f));
+
+        LidarCrop crop;
+        crop.Configure({ volume });
+        EXPECT_FALSE(crop.HasRayRanges());
+        EXPECT_TRUE(crop.IsPointFilterEnabled());
+
+        const AZ::Matrix3x4 inverseLidarPose = AZ::Matrix3x4::CreateIdentity();
+        EXPECT_TRUE(crop.IsPointCropped(AZ::Vector3(5.5f, 0.5f, -0.5f), inverseLidarPose));
+        EXPECT_FALSE(crop.IsPointCropped(AZ::Vector3(2.0f, 0.0f, 0.0f), inverseLidarPose));
+    }
+
+    TEST(LidarCropTest, InclusiveVolumeCropsThePointsOutsideOfIt)
+    {
+        LidarCrop crop;
+        crop.Configure({ MakeBox(AZ::Vector3(10.0f), true) });
+        EXPECT_FALSE(crop.HasRayRanges());
+        EXPECT_TRUE(crop.IsPointFilterEnabled());
+
+        const AZ::Matrix3x4 inverseLidarPose = AZ::Matrix3x4::CreateIdentity();
+        EXPECT_FALSE(crop.IsPointCropped(AZ::Vector3(4.0f, -4.0f, 4.0f), inverseLidarPose));
+        EXPECT_TRUE(crop.IsPointCropped(AZ::Vector3(6.0f, 0.0f, 0.0f), inverseLidarPose));
+    }
+
+    TEST(LidarCropTest, InclusiveVolumesIntersect)
+    {
+        LidarCropVolume cylinder;
+        cylinder.m_shape = CropVolumeShape::Cylinder;
+        cylinder.m_isInclusive = true;
+        cylinder.m_cylinderRadius = 1.0f;
+        cylinder.m_cylinderHeight = 10.0f;
+
+        LidarCrop crop;
+        crop.Configure({ MakeBox(AZ::Vector3(4.0f), true), cylinder });
+
+        const AZ::Matrix3x4 inverseLidarPose = AZ::Matrix3x4::CreateIdentity();
+        EXPECT_FALSE(crop.IsPointCropped(AZ::Vector3(0.5f, 0.5f, 1.5f), inverseLidarPose));
+        // Within the box only.
+        EXPECT_TRUE(crop.IsPointCropped(AZ::Vector3(1.5f, 0.0f, 0.0f), inverseLidarPose));
+        // Within the cylinder only.
+        EXPECT_TRUE(crop.IsPointCropped(AZ::Vector3(0.0f, 0.0f, 4.0f), inverseLidarPose));
+    }
+
+    TEST(LidarCropTest, SensorVolumesFollowTheLidar)
+    {
+        LidarCrop crop;
+        crop.Configure({ MakeBox(AZ::Vector3(2.0f), true) });
+
+        const AZ::Matrix3x4 lidarPose = AZ::Matrix3x4::CreateTranslation(AZ::Vector3(10.0f, 0.0f, 0.0f));
+        const AZ::Matrix3x4 inverseLidarPose = lidarPose.GetInverseFull();
+        EXPECT_FALSE(crop.IsPointCropped(AZ::Vector3(10.5f, 0.0f, 0.0f), inverseLidarPose));
+        EXPECT_TRUE(crop.IsPointCropped(AZ::Vector3(0.5f, 0.0f, 0.0f), inverseLidarPose));
+    }
+
+    TEST(LidarCropTest, WorldVolumesIgnoreTheLidarPose)
+    {
+        LidarCrop crop;
+        crop.Configure({ MakeBox(AZ::Vector3(2.0f), false, CropVolumeFrame::World) });
+        // World volumes are never applied by the ray ranges, even when they enclose the lidar.
+        EXPECT_FALSE(crop.HasRayRanges());
+        EXPECT_TRUE(crop.IsPointFilterEnabled());
+
+        const AZ::Matrix3x4 lidarPose = AZ::Matrix3x4::CreateTranslation(AZ::Vector3(10.0f, 0.0f, 0.0f));
+        const AZ::Matrix3x4 inverseLidarPose = lidarPose.GetInverseFull();
+        EXPECT_TRUE(crop.IsPointCropped(AZ::Vector3(0.5f, 0.0f, 0.0f), inverseLidarPose));
+        EXPECT_FALSE(crop.IsPointCropped(AZ::Vector3(10.5f, 0.0f, 0.0f), inverseLidarPose));
+    }
+
+    TEST(LidarCropTest, CroppedRaysGetNoMaxRangePoints)
+    {
+        LidarResultProcessor processor;
+        processor.GetCrop().Configure({ MakeBox(AZ::Vector3(6.0f), true) });
+        LidarResultProcessor::Options options;
+        options.m_minRange = 0.0f;
+        options.m_maxRange = MaxRange;
+        options.m_isMaxRangeEnabled = true;
+        options.m_arePointsExpected = true;
+        options.m_areRangesExpected = true;
+        options.m_isCropEnabled = true;
+        options.m_areHostPointsRequired = true;
+
+        // The first ray hits a point within the box, the second one a point outside of it and the third one misses.
+        PipelineGraph::RaycastResults graphResults;
+        graphResults.m_isHit = { 1, 1, 0 };
+        graphResults.m_distance = { 2.0f, 5.0f, AZStd::numeric_limits<float>::max() };
+        graphResults.m_xyz = { { .value = { 0.0f, 0.0f, 2.0f } }, { .value = { 0.0f, 0.0f, 5.0f } }, { .value = { 0.0f, 0.0f, 0.0f } } };
+        ROS2::RaycastResult results;
+        const AZStd::vector<rgl_mat3x4f> rayPoses{ MakeRayAlongZ(), MakeRayAlongZ(), MakeRayAlongX() };
+        processor.Process(graphResults, rayPoses, AZ::Matrix3x4::CreateIdentity(), options, results);
+
+        // The cropped ray reports neither its hit nor a max range point in its place.
+        ASSERT_EQ(results.m_points.size(), 2U);
+        EXPECT_TRUE(results.m_points[0].IsClose(AZ::Vector3(0.0f, 0.0f, 2.0f)));
+        EXPECT_TRUE(results.m_points[1].IsClose(AZ::Vector3(MaxRange, 0.0f, 0.0f)));
+        ASSERT_EQ(results.m_ranges.size(), 3U);
+        EXPECT_FLOAT_EQ(results.m_ranges[0], 2.0f);
+        EXPECT_EQ(results.m_ranges[1], AZStd::numeric_limits<float>::infinity());
+        EXPECT_FLOAT_EQ(results.m_ranges[2], MaxRange);
+    }
+} // namespace RGL
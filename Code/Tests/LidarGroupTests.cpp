@@ -0,0 +1,75 @@
+/* Copyright 2020-2021, Robotec.ai sp. z o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <AzTest/AzTest.h>
+#include <Lidar/LidarGroup.h>
+#include <Utilities/RGLUtils.h>
+
+namespace RGL
+{
+    namespace
+    {
+        //! Member with the given number of rays along the Z axis of the lidar, with the ring ids repeated over the rays.
+        LidarGroup::MemberRays MakeMember(size_t rayCount, AZStd::vector<int32_t> ringIds, const AZ::Vector3& position, float maxRange)
+        {
+            auto rayPattern = AZStd::make_shared<RayPattern>();
+            rayPattern->m_rayPoses.assign(rayCount, Utils::IdentityTransform);
+            rayPattern->m_ringIds = AZStd::move(ringIds);
+            return { rayPattern, AZ::Matrix3x4::CreateTranslation(position), maxRange };
+        }
+    } // namespace
+
+    TEST(LidarGroupTest, RingIdsAreOffsetByThePreviousMembers)
+    {
+        const AZStd::vector<LidarGroup::MemberRays> memberRays{
+            MakeMember(4U, { 0, 1 }, AZ::Vector3::CreateZero(), 10.0f),
+            MakeMember(2U, {}, AZ::Vector3::CreateZero(), 10.0f),
+            MakeMember(2U, { 2, 0 }, AZ::Vector3::CreateZero(), 10.0f),
+        };
+
+        LidarGroup::RayBatch rayBatch;
+        LidarGroup::BuildRayBatch(memberRays, rayBatch);
+
+        // The first member has two rings, the second one a single ring and the third one three rings.
+        const AZStd::vector<int32_t> expectedRingIds{ 0, 1, 0, 1, 2, 2, 5, 3 };
+        EXPECT_EQ(rayBatch.m_ringIds, expectedRingIds);
+    }
+
+    TEST(LidarGroupTest, RaysArePlacedInTheGroupFrame)
+    {
+        const AZStd::vector<LidarGroup::MemberRays> memberRays{
+            MakeMember(1U, {}, AZ::Vector3(1.0f, 0.0f, 0.0f), 10.0f),
+            MakeMember(2U, {}, AZ::Vector3(0.0f, -2.0f, 0.5f), 20.0f),
+        };
+
+        LidarGroup::RayBatch rayBatch;
+        LidarGroup::BuildRayBatch(memberRays, rayBatch);
+
+        ASSERT_EQ(rayBatch.m_rayPoses.size(), 3U);
+        ASSERT_EQ(rayBatch.m_rayRanges.size(), 3U);
+        const AZStd::vector<AZ::Vector3> expectedPositions{
+            AZ::Vector3(1.0f, 0.0f, 0.0f),
+            AZ::Vector3(0.0f, -2.0f, 0.5f),
+            AZ::Vector3(0.0f, -2.0f, 0.5f),
+        };
+        const AZStd::vector<float> expectedMaxRanges{ 10.0f, 20.0f, 20.0f };
+        for (size_t rayIndex = 0U; rayIndex < rayBatch.m_rayPoses.size(); ++rayIndex)
+        {
+            const AZ::Matrix3x4 rayPose = Utils::AzMatrix3x4FromRglMat3x4(rayBatch.m_rayPoses[rayIndex]);
+            EXPECT_TRUE(rayPose.GetTranslation().IsClose(expectedPositions[rayIndex]));
+            EXPECT_FLOAT_EQ(rayBatch.m_rayRanges[rayIndex].value[0], 0.0f);
+            EXPECT_FLOAT_EQ(rayBatch.m_rayRanges[rayIndex].value[1], expectedMaxRanges[rayIndex]);
+        }
+    }
+} // namespace RGL
@@ -0,0 +1,192 @@
+/* Copyright 2020-2021, Robotec.ai sp. z o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <AzTest/AzTest.h>
+#include <Lidar/LidarMultiReturn.h>
+#include <Utilities/RGLUtils.h>
+
+namespace RGL
+{
+    namespace
+    {
+        constexpr float BeamDivergence = 0.01f;
+        constexpr int32_t Miss = 0;
+        constexpr int32_t Hit = 1;
+
+        //! Result of a single sub-ray.
+        struct SubRayResult
+        {
+            int32_t m_isHit;
+            float m_distance;
+        };
+
+        PipelineGraph::RaycastResults MakeResults(const AZStd::vector<SubRayResult>& subRayResults)
+        {
+            PipelineGraph::RaycastResults results;
+            for (const SubRayResult& subRayResult : subRayResults)
+            {
+                results.m_isHit.push_back(subRayResult.m_isHit);
+                results.m_distance.push_back(subRayResult.m_distance);
+                results.m_xyz.push_back({ .value = { 0.0f, 0.0f, subRayResult.m_distance } });
+            }
+            return results;
+        }
+
+        //! Sub-rays of a ray hitting an edge at 2 m and the background behind it at 5 m.
+        AZStd::vector<SubRayResult> MakeEdgeRay()
+        {
+            return { { Hit, 5.0f }, { Hit, 2.0f }, { Miss, 0.0f }, { Hit, 2.2f }, { Miss, 0.0f } };
+        }
+
+        //! Appends the sub-rays of a ray without any hit.
+        void AppendMissedRay(AZStd::vector<SubRayResult>& subRayResults)
+        {
+            subRayResults.insert(subRayResults.end(), LidarMultiReturn::SubRayCount, { Miss, 0.0f });
+        }
+    } // namespace
+
+    TEST(LidarMultiReturnTest, SingleReturnIsDisabled)
+    {
+        LidarMultiReturn multiReturn;
+        EXPECT_FALSE(multiReturn.IsEnabled());
+
+        multiReturn.Configure(LidarReturnMode::Single, BeamDivergence);
+        EXPECT_FALSE(multiReturn.IsEnabled());
+
+        multiReturn.Configure(LidarReturnMode::Dual, BeamDivergence);
+        EXPECT_TRUE(multiReturn.IsEnabled());
+        EXPECT_EQ(multiReturn.GetMode(), LidarReturnMode::Dual);
+    }
+
+    TEST(LidarMultiReturnTest, RaysAreExpandedToSubRays)
+    {
+        LidarMultiReturn multiReturn;
+        multiReturn.Configure(LidarReturnMode::First, BeamDivergence);
+
+        const AZ::Matrix3x4 rayPose = AZ::Matrix3x4::CreateTranslation(AZ::Vector3(1.0f, 2.0f, 3.0f));
+        const AZStd::vector<rgl_mat3x4f> rayPoses{ Utils::RglMat3x4FromAzMatrix3x4(AZ::Matrix3x4::CreateIdentity()),
+                                                   Utils::RglMat3x4FromAzMatrix3x4(rayPose) };
+        const AZStd::vector<rgl_mat3x4f>& subRayPoses = multiReturn.ExpandRayPoses(rayPoses);
+        ASSERT_EQ(subRayPoses.size(), rayPoses.size() * LidarMultiReturn::SubRayCount);
+
+        // The first sub-ray is the central one.
+        EXPECT_TRUE(Utils::AzMatrix3x4FromRglMat3x4(subRayPoses[LidarMultiReturn::SubRayCount]).IsClose(rayPose));
+        for (size_t subRay = 0U; subRay < LidarMultiReturn::SubRayCount; ++subRay)
+        {
+            const AZ::Matrix3x4 subRayPose = Utils::AzMatrix3x4FromRglMat3x4(subRayPoses[LidarMultiReturn::SubRayCount + subRay]);
+            // The sub-rays share the origin of their ray and diverge by half of the beam divergence at most.
+            EXPECT_TRUE(subRayPose.GetTranslation().IsClose(rayPose.GetTranslation()));
+            EXPECT_GE(subRayPose.GetBasisZ().Dot(AZ::Vector3::CreateAxisZ()), AZStd::cos(0.5f * BeamDivergence) - 1e-6f);
+        }
+
+        const AZStd::vector<int32_t> subRayRingIds = LidarMultiReturn::ExpandRayValues(AZStd::vector<int32_t>{ 3, 7 });
+        const AZStd::vector<int32_t> expectedRingIds{ 3, 3, 3, 3, 3, 7, 7, 7, 7, 7 };
+        EXPECT_EQ(subRayRingIds, expectedRingIds);
+    }
+
+    TEST(LidarMultiReturnTest, FirstReturnIsTheNearestHit)
+    {
+        LidarMultiReturn multiReturn;
+        multiReturn.Configure(LidarReturnMode::First, BeamDivergence);
+
+        AZStd::vector<SubRayResult> subRayResults = MakeEdgeRay();
+        AppendMissedRay(subRayResults);
+        PipelineGraph::RaycastResults results = MakeResults(subRayResults);
+        multiReturn.ReduceResults(results, AZ::Matrix3x4::CreateIdentity(), true);
+
+        ASSERT_EQ(results.m_isHit.size(), 2U);
+        ASSERT_EQ(results.m_distance.size(), 2U);
+        ASSERT_EQ(results.m_xyz.size(), 2U);
+        EXPECT_EQ(results.m_isHit[0], Hit);
+        EXPECT_FLOAT_EQ(results.m_distance[0], 2.0f);
+        EXPECT_FLOAT_EQ(results.m_xyz[0].value[2], 2.0f);
+        EXPECT_EQ(results.m_isHit[1], Miss);
+        EXPECT_FALSE(multiReturn.HasSecondaryReturn(0U));
+    }
+
+    TEST(LidarMultiReturnTest, LastReturnIsTheFarthestHit)
+    {
+        LidarMultiReturn multiReturn;
+        multiReturn.Configure(LidarReturnMode::Last, BeamDivergence);
+
+        PipelineGraph::RaycastResults results = MakeResults(MakeEdgeRay());
+        results.m_entityId = { 1, 2, 0, 3, 0 };
+        multiReturn.ReduceResults(results, AZ::Matrix3x4::CreateIdentity(), true);
+
+        ASSERT_EQ(results.m_distance.size(), 1U);
+        ASSERT_EQ(results.m_entityId.size(), 1U);
+        EXPECT_FLOAT_EQ(results.m_distance[0], 5.0f);
+        EXPECT_FLOAT_EQ(results.m_xyz[0].value[2], 5.0f);
+        EXPECT_EQ(results.m_entityId[0], 1);
+    }
+
+    TEST(LidarMultiReturnTest, DualReturnRequiresTheMinSeparation)
+    {
+        LidarMultiReturn multiReturn;
+        multiReturn.Configure(LidarReturnMode::Dual, BeamDivergence);
+
+        const float closeDistance = 2.0f + 0.5f * LidarMultiReturn::MinReturnSeparation;
+        AZStd::vector<SubRayResult> subRayResults = MakeEdgeRay();
+        subRayResults.insert(
+            subRayResults.end(), { { Hit, 2.0f }, { Hit, closeDistance }, { Miss, 0.0f }, { Miss, 0.0f }, { Miss, 0.0f } });
+        PipelineGraph::RaycastResults results = MakeResults(subRayResults);
+        multiReturn.ReduceResults(results, AZ::Matrix3x4::CreateIdentity(), true);
+
+        ASSERT_EQ(results.m_distance.size(), 2U);
+        EXPECT_FLOAT_EQ(results.m_distance[0], 2.0f);
+        ASSERT_TRUE(multiReturn.HasSecondaryReturn(0U));
+        EXPECT_FLOAT_EQ(multiReturn.GetSecondaryPoint(0U).value[2], 5.0f);
+        EXPECT_FLOAT_EQ(results.m_distance[1], 2.0f);
+        EXPECT_FALSE(multiReturn.HasSecondaryReturn(1U));
+
+        multiReturn.DiscardSecondaryReturn(0U);
+        EXPECT_FALSE(multiReturn.HasSecondaryReturn(0U));
+    }
+
+    TEST(LidarMultiReturnTest, MissingPointsAreComputedFromTheSubRays)
+    {
+        LidarMultiReturn multiReturn;
+        multiReturn.Configure(LidarReturnMode::Dual, BeamDivergence);
+        const AZStd::vector<rgl_mat3x4f> rayPoses(2U, Utils::RglMat3x4FromAzMatrix3x4(AZ::Matrix3x4::CreateIdentity()));
+        AZ_UNUSED(multiReturn.ExpandRayPoses(rayPoses));
+
+        AZStd::vector<SubRayResult> subRayResults{ { Hit, 3.0f }, { Miss, 0.0f }, { Miss, 0.0f }, { Miss, 0.0f }, { Miss, 0.0f } };
+        AppendMissedRay(subRayResults);
+        PipelineGraph::RaycastResults results = MakeResults(subRayResults);
+        results.m_xyz.clear();
+
+        const AZ::Vector3 lidarPosition(10.0f, 0.0f, 0.0f);
+        multiReturn.ReduceResults(results, AZ::Matrix3x4::CreateTranslation(lidarPosition), true);
+
+        // The points are expressed in the world frame, and the rays without any hit report a zero point.
+        ASSERT_EQ(results.m_xyz.size(), 2U);
+        EXPECT_TRUE(Utils::AzVector3FromRglVec3f(results.m_xyz[0]).IsClose(lidarPosition + AZ::Vector3(0.0f, 0.0f, 3.0f)));
+        EXPECT_TRUE(Utils::AzVector3FromRglVec3f(results.m_xyz[1]).IsClose(AZ::Vector3::CreateZero()));
+    }
+
+    TEST(LidarMultiReturnTest, PointsAreNotComputedUnlessRequired)
+    {
+        LidarMultiReturn multiReturn;
+        multiReturn.Configure(LidarReturnMode::First, BeamDivergence);
+        AZ_UNUSED(multiReturn.ExpandRayPoses({ Utils::RglMat3x4FromAzMatrix3x4(AZ::Matrix3x4::CreateIdentity()) }));
+
+        PipelineGraph::RaycastResults results = MakeResults(MakeEdgeRay());
+        results.m_xyz.clear();
+        multiReturn.ReduceResults(results, AZ::Matrix3x4::CreateIdentity(), false);
+
+        EXPECT_TRUE(results.m_xyz.empty());
+        ASSERT_EQ(results.m_distance.size(), 1U);
+        EXPECT_FLOAT_EQ(results.m_distance[0], 2.0f);
+    }
+} // namespace RGL
@@ -0,0 +1,60 @@
+/* Copyright 2020-2021, Robotec.ai sp. z o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <AzCore/Math/MathUtils.h>
+#include <AzTest/AzTest.h>
+#include <Lidar/LidarRaycaster.h>
+
+namespace RGL
+{
+    TEST(LidarRaycasterTest, TimeOffsetsAreScaledByTheScanDuration)
+    {
+        const AZStd::vector<float> timeOffsets = LidarRaycaster::ComputeRayTimeOffsets({ 0.0f, 0.25f, 0.5f, 1.0f }, 0.1f);
+
+        const AZStd::vector<float> expectedTimeOffsets{ 0.0f, 25.0f, 50.0f, 100.0f };
+        ASSERT_EQ(timeOffsets.size(), expectedTimeOffsets.size());
+        for (size_t rayIndex = 0U; rayIndex < timeOffsets.size(); ++rayIndex)
+        {
+            EXPECT_NEAR(timeOffsets[rayIndex], expectedTimeOffsets[rayIndex], 1e-4f);
+        }
+    }
+
+    TEST(LidarRaycasterTest, VelocityIsExpressedInTheLidarFrame)
+    {
+        // The lidar faces the Y axis of the world and moves along it by one meter.
+        const AZ::Matrix3x4 previousPose = AZ::Matrix3x4::CreateRotationZ(AZ::Constants::HalfPi);
+        const AZ::Matrix3x4 pose = AZ::Matrix3x4::CreateTranslation(AZ::Vector3(0.0f, 1.0f, 0.0f)) * previousPose;
+
+        AZ::Vector3 linearVelocity;
+        AZ::Vector3 angularVelocity;
+        LidarRaycaster::ComputeSensorVelocity(previousPose, pose, 0.1, linearVelocity, angularVelocity);
+
+        EXPECT_TRUE(linearVelocity.IsClose(AZ::Vector3(10.0f, 0.0f, 0.0f), 1e-4f));
+        EXPECT_TRUE(angularVelocity.IsClose(AZ::Vector3::CreateZero(), 1e-4f));
+    }
+
+    TEST(LidarRaycasterTest, AngularVelocityIsDividedByTheElapsedTime)
+    {
+        const AZ::Matrix3x4 previousPose = AZ::Matrix3x4::CreateTranslation(AZ::Vector3(1.0f, 2.0f, 0.0f));
+        const AZ::Matrix3x4 pose =
+            previousPose * AZ::Matrix3x4::CreateTranslation(AZ::Vector3(0.5f, 0.0f, 0.0f)) * AZ::Matrix3x4::CreateRotationZ(0.1f);
+
+        AZ::Vector3 linearVelocity;
+        AZ::Vector3 angularVelocity;
+        LidarRaycaster::ComputeSensorVelocity(previousPose, pose, 0.5, linearVelocity, angularVelocity);
+
+        EXPECT_TRUE(linearVelocity.IsClose(AZ::Vector3(1.0f, 0.0f, 0.0f), 1e-4f));
+        EXPECT_TRUE(angularVelocity.IsClose(AZ::Vector3(0.0f, 0.0f, 0.2f), 1e-4f));
+    }
+} // namespace RGL
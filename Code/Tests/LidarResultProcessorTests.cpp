@@ -0,0 +1,186 @@
+/* Copyright 2020-2021, Robotec.ai sp. z o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <AzCore/std/limits.h>
+#include <AzTest/AzTest.h>
+#include <Entity/EntityIdRegistry.h>
+#include <Lidar/LidarResultProcessor.h>
+#include <Utilities/RGLUtils.h>
+
+namespace RGL
+{
+    namespace
+    {
+        constexpr float MaxRange = 10.0f;
+
+        LidarResultProcessor::Options MakePointOptions()
+        {
+            LidarResultProcessor::Options options;
+            options.m_minRange = 1.0f;
+            options.m_maxRange = MaxRange;
+            options.m_arePointsExpected = true;
+            options.m_areHostPointsRequired = true;
+            return options;
+        }
+
+        //! Rays cast along the Z axis from the given origins in the lidar frame.
+        AZStd::vector<rgl_mat3x4f> MakeRayPoses(const AZStd::vector<AZ::Vector3>& origins)
+        {
+            AZStd::vector<rgl_mat3x4f> rayPoses;
+            for (const AZ::Vector3& origin : origins)
+            {
+                rayPoses.push_back(Utils::RglMat3x4FromAzMatrix3x4(AZ::Matrix3x4::CreateTranslation(origin)));
+            }
+            return rayPoses;
+        }
+
+        //! Rays cast along the Z axis from the lidar origin.
+        AZStd::vector<rgl_mat3x4f> MakeRayPoses(size_t rayCount)
+        {
+            return AZStd::vector<rgl_mat3x4f>(rayCount, Utils::RglMat3x4FromAzMatrix3x4(AZ::Matrix3x4::CreateIdentity()));
+        }
+
+        PipelineGraph::RaycastResults MakeResults(const AZStd::vector<int32_t>& isHit, const AZStd::vector<float>& distances)
+        {
+            PipelineGraph::RaycastResults results;
+            results.m_isHit = isHit;
+            results.m_distance = distances;
+            for (float distance : distances)
+            {
+                results.m_xyz.push_back({ .value = { 0.0f, 0.0f, distance } });
+            }
+            return results;
+        }
+    } // namespace
+
+    TEST(LidarResultProcessorTest, HitsAreReportedAsPoints)
+    {
+        LidarResultProcessor processor;
+        PipelineGraph::RaycastResults graphResults = MakeResults({ 1, 0, 1 }, { 2.0f, 0.0f, 3.0f });
+        ROS2::RaycastResult results;
+        processor.Process(graphResults, MakeRayPoses(3U), AZ::Matrix3x4::CreateIdentity(), MakePointOptions(), results);
+
+        ASSERT_EQ(results.m_points.size(), 2U);
+        EXPECT_TRUE(results.m_points[0].IsClose(AZ::Vector3(0.0f, 0.0f, 2.0f)));
+        EXPECT_TRUE(results.m_points[1].IsClose(AZ::Vector3(0.0f, 0.0f, 3.0f)));
+        EXPECT_TRUE(results.m_ranges.empty());
+    }
+
+    TEST(LidarResultProcessorTest, RaysWithoutHitsGetMaxRangePoints)
+    {
+        LidarResultProcessor::Options options = MakePointOptions();
+        options.m_isMaxRangeEnabled = true;
+        const AZ::Vector3 lidarPosition(0.0f, 5.0f, 0.0f);
+
+        LidarResultProcessor processor;
+        PipelineGraph::RaycastResults graphResults = MakeResults({ 0, 1 }, { 0.0f, 2.0f });
+        ROS2::RaycastResult results;
+        processor.Process(
+            graphResults,
+            MakeRayPoses({ AZ::Vector3(1.0f, 0.0f, 0.0f), AZ::Vector3::CreateZero() }),
+            AZ::Matrix3x4::CreateTranslation(lidarPosition),
+            options,
+            results);
+
+        ASSERT_EQ(results.m_points.size(), 2U);
+        EXPECT_TRUE(results.m_points[0].IsClose(lidarPosition + AZ::Vector3(1.0f, 0.0f, MaxRange)));
+        EXPECT_TRUE(results.m_points[1].IsClose(AZ::Vector3(0.0f, 0.0f, 2.0f)));
+    }
+
+    TEST(LidarResultProcessorTest, DistancesAreReportedAsRanges)
+    {
+        LidarResultProcessor::Options options = MakePointOptions();
+        options.m_arePointsExpected = false;
+        options.m_areRangesExpected = true;
+
+        LidarResultProcessor processor;
+        const float nonHitDistance = AZStd::numeric_limits<float>::max();
+        PipelineGraph::RaycastResults graphResults = MakeResults({ 1, 1, 0 }, { 0.5f, 5.0f, nonHitDistance });
+        ROS2::RaycastResult results;
+        processor.Process(graphResults, MakeRayPoses(3U), AZ::Matrix3x4::CreateIdentity(), options, results);
+
+        ASSERT_EQ(results.m_ranges.size(), 3U);
+        EXPECT_EQ(results.m_ranges[0], -AZStd::numeric_limits<float>::infinity());
+        EXPECT_FLOAT_EQ(results.m_ranges[1], 5.0f);
+        EXPECT_EQ(results.m_ranges[2], AZStd::numeric_limits<float>::infinity());
+        EXPECT_TRUE(results.m_points.empty());
+
+        options.m_isMaxRangeEnabled = true;
+        EXPECT_FLOAT_EQ(LidarResultProcessor::GetReportedRange(nonHitDistance, options), MaxRange);
+    }
+
+    TEST(LidarResultProcessorTest, LastReturnsFollowTheirFirstReturns)
+    {
+        LidarResultProcessor::Options options = MakePointOptions();
+        options.m_isMultiReturnEnabled = true;
+
+        LidarResultProcessor processor;
+        processor.GetMultiReturn().Configure(LidarReturnMode::Dual, 0.01f);
+        // The first ray hits an edge at 2 m and the background at 5 m, the second one hits a wall at 3 m.
+        PipelineGraph::RaycastResults graphResults =
+            MakeResults({ 1, 1, 0, 0, 0, 1, 0, 0, 0, 0 }, { 5.0f, 2.0f, 0.0f, 0.0f, 0.0f, 3.0f, 0.0f, 0.0f, 0.0f, 0.0f });
+        ROS2::RaycastResult results;
+        processor.Process(graphResults, MakeRayPoses(2U), AZ::Matrix3x4::CreateIdentity(), options, results);
+
+        ASSERT_EQ(results.m_points.size(), 3U);
+        EXPECT_FLOAT_EQ(results.m_points[0].GetZ(), 2.0f);
+        EXPECT_FLOAT_EQ(results.m_points[1].GetZ(), 5.0f);
+        EXPECT_FLOAT_EQ(results.m_points[2].GetZ(), 3.0f);
+        // The graph results match the rays afterwards.
+        EXPECT_EQ(graphResults.m_isHit.size(), 2U);
+    }
+
+    TEST(LidarResultProcessorTest, CroppedHitsAreReportedAsRaysWithoutHits)
+    {
+        LidarCropVolume volume;
+        volume.m_boxDimensions = AZ::Vector3(5.0f);
+        volume.m_isInclusive = true;
+        LidarResultProcessor::Options options = MakePointOptions();
+        options.m_isCropEnabled = true;
+
+        LidarResultProcessor processor;
+        processor.GetCrop().Configure({ volume });
+        PipelineGraph::RaycastResults graphResults = MakeResults({ 1, 1 }, { 2.0f, 4.0f });
+        graphResults.m_entityId = { 7, 8 };
+        ROS2::RaycastResult results;
+        processor.Process(graphResults, MakeRayPoses(2U), AZ::Matrix3x4::CreateIdentity(), options, results);
+
+        ASSERT_EQ(results.m_points.size(), 1U);
+        EXPECT_FLOAT_EQ(results.m_points[0].GetZ(), 2.0f);
+        EXPECT_EQ(graphResults.m_isHit[1], 0);
+        EXPECT_EQ(graphResults.m_entityId[1], EntityIdRegistry::InvalidId);
+    }
+
+    TEST(LidarResultProcessorTest, EncodedPointsAreDecodedAlongTheirRays)
+    {
+        LidarResultProcessor::Options options = MakePointOptions();
+        options.m_arePointsEncoded = true;
+        const AZ::Vector3 lidarPosition(0.0f, 0.0f, 1.0f);
+
+        LidarResultProcessor processor;
+        PipelineGraph::RaycastResults graphResults;
+        graphResults.m_rayIndex = { 1U };
+        graphResults.m_distance = { 4.0f };
+        ROS2::RaycastResult results;
+        processor.Process(
+            graphResults,
+            MakeRayPoses({ AZ::Vector3::CreateZero(), AZ::Vector3(2.0f, 0.0f, 0.0f) }),
+            AZ::Matrix3x4::CreateTranslation(lidarPosition),
+            options,
+            results);
+
+        ASSERT_EQ(results.m_points.size(), 1U);
+        EXPECT_TRUE(results.m_points[0].IsClose(lidarPosition + AZ::Vector3(2.0f, 0.0f, 4.0f)));
+    }
+} // namespace RGL
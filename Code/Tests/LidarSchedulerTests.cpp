@@ -0,0 +1,103 @@
+/* Copyright 2020-2021, Robotec.ai sp. z o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <AzTest/AzTest.h>
+#include <Lidar/LidarScheduler.h>
+
+namespace RGL
+{
+    namespace
+    {
+        constexpr float Budget = 0.008f;
+
+        //! Prepares the scans at their estimated costs and records their order.
+        LidarScheduler::PrepareScanFunction RecordPreparedScans(AZStd::vector<ROS2::LidarId>& preparedScans)
+        {
+            return [&preparedScans](const LidarScheduler::DueScan& dueScan)
+            {
+                preparedScans.push_back(dueScan.m_lidarId);
+                return dueScan.m_cost;
+            };
+        }
+    } // namespace
+
+    class LidarSchedulerTest : public ::testing::Test
+    {
+    protected:
+        //! Three scans exceeding the budget by 4 ms. The 4 ms scan cannot be prepared.
+        AZStd::vector<LidarScheduler::DueScan> MakeDueScans() const
+        {
+            return { { m_cheapLidar, 0.002f, true }, { m_expensiveLidar, 0.006f, true }, { m_unpreparedLidar, 0.004f, false } };
+        }
+
+        const ROS2::LidarId m_cheapLidar{ AZ::Uuid::CreateRandom() };
+        const ROS2::LidarId m_expensiveLidar{ AZ::Uuid::CreateRandom() };
+        const ROS2::LidarId m_unpreparedLidar{ AZ::Uuid::CreateRandom() };
+    };
+
+    TEST_F(LidarSchedulerTest, ScansWithinTheBudgetAreNotPrepared)
+    {
+        AZStd::vector<LidarScheduler::DueScan> dueScans{ { m_cheapLidar, 0.002f, true }, { m_expensiveLidar, 0.006f, true } };
+        AZStd::vector<ROS2::LidarId> preparedScans;
+        float spareBudget = Budget;
+
+        EXPECT_LE(LidarScheduler::PrepareScans(dueScans, Budget, spareBudget, RecordPreparedScans(preparedScans)), 0.0f);
+        EXPECT_TRUE(preparedScans.empty());
+        EXPECT_FLOAT_EQ(spareBudget, Budget);
+    }
+
+    TEST_F(LidarSchedulerTest, MostExpensiveScansArePreparedFirst)
+    {
+        AZStd::vector<LidarScheduler::DueScan> dueScans = MakeDueScans();
+        AZStd::vector<ROS2::LidarId> preparedScans;
+        float spareBudget = 0.01f;
+
+        // Preparing the most expensive scan is enough for the next frame to fit the budget.
+        EXPECT_LE(LidarScheduler::PrepareScans(dueScans, Budget, spareBudget, RecordPreparedScans(preparedScans)), 0.0f);
+        ASSERT_EQ(preparedScans.size(), 1U);
+        EXPECT_EQ(preparedScans[0], m_expensiveLidar);
+        EXPECT_FLOAT_EQ(spareBudget, 0.004f);
+    }
+
+    TEST_F(LidarSchedulerTest, PreparedScansFitTheSpareBudget)
+    {
+        AZStd::vector<LidarScheduler::DueScan> dueScans = MakeDueScans();
+        AZStd::vector<ROS2::LidarId> preparedScans;
+        float spareBudget = 0.005f;
+
+        // The expensive scan does not fit the current frame, so the next frame is still over budget.
+        const float excessCost = LidarScheduler::PrepareScans(dueScans, Budget, spareBudget, RecordPreparedScans(preparedScans));
+        ASSERT_EQ(preparedScans.size(), 1U);
+        EXPECT_EQ(preparedScans[0], m_cheapLidar);
+        EXPECT_FLOAT_EQ(spareBudget, 0.003f);
+        EXPECT_NEAR(excessCost, 0.002f, 1e-6f);
+    }
+
+    TEST_F(LidarSchedulerTest, PreparedScansExpireAfterTheNextUpdate)
+    {
+        EXPECT_FALSE(LidarScheduler::IsPreparedScanExpired(5U, 5U));
+        EXPECT_FALSE(LidarScheduler::IsPreparedScanExpired(5U, 6U));
+        EXPECT_TRUE(LidarScheduler::IsPreparedScanExpired(5U, 7U));
+    }
+
+    TEST_F(LidarSchedulerTest, CostsAreEstimatedFromTheRayTimings)
+    {
+        LidarScheduler scheduler;
+        scheduler.ReportRaycastCost(m_cheapLidar, 1000U, AZStd::chrono::milliseconds(1));
+
+        EXPECT_NEAR(scheduler.EstimateCost(m_cheapLidar, 2000U), 0.002f, 1e-6f);
+        // The lidars without any timings use the average cost of a ray.
+        EXPECT_NEAR(scheduler.EstimateCost(m_unpreparedLidar, 500U), 0.0005f, 1e-6f);
+    }
+} // namespace RGL
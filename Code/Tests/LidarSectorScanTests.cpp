@@ -0,0 +1,121 @@
+/* Copyright 2020-2021, Robotec.ai sp. z o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <AzCore/Math/MathUtils.h>
+#include <AzCore/std/limits.h>
+#include <AzTest/AzTest.h>
+#include <Lidar/LidarSectorScan.h>
+#include <Utilities/RGLUtils.h>
+
+namespace RGL
+{
+    namespace
+    {
+        //! Horizontal ray with the given azimuth. The rotation around the Y axis turns the Z axis of the ray into the X axis.
+        rgl_mat3x4f MakeRay(float azimuth)
+        {
+            return Utils::RglMat3x4FromAzMatrix3x4(
+                AZ::Matrix3x4::CreateRotationZ(azimuth) * AZ::Matrix3x4::CreateRotationY(AZ::Constants::HalfPi));
+        }
+
+        //! Four rays configured out of the azimuth order, with the ring ids matching their configured indices.
+        void ConfigureFourRays(LidarSectorScan& sectorScan)
+        {
+            sectorScan.Configure({ MakeRay(1.0f), MakeRay(-2.0f), MakeRay(2.0f), MakeRay(0.0f) }, { 0, 1, 2, 3 });
+        }
+
+        //! Traces the due rays, storing a point with its X coordinate equal to the configured index of the ray.
+        void TraceDueRays(LidarSectorScan& sectorScan)
+        {
+            for (size_t orderedIndex = sectorScan.GetTracedRayCount(); orderedIndex < sectorScan.GetDueRayCount(); ++orderedIndex)
+            {
+                const auto rayIndex = static_cast<float>(sectorScan.GetRayIndex(orderedIndex));
+                sectorScan.StoreRayResult(orderedIndex, true, AZ::Vector3(rayIndex, 0.0f, 0.0f), rayIndex);
+            }
+            sectorScan.SetTracedRayCount(sectorScan.GetDueRayCount());
+        }
+    } // namespace
+
+    TEST(LidarSectorScanTest, RaysAreOrderedByAzimuth)
+    {
+        LidarSectorScan sectorScan;
+        ConfigureFourRays(sectorScan);
+
+        ASSERT_EQ(sectorScan.GetRayCount(), 4U);
+        const AZStd::vector<size_t> expectedOrder{ 1U, 3U, 0U, 2U };
+        for (size_t orderedIndex = 0U; orderedIndex < expectedOrder.size(); ++orderedIndex)
+        {
+            EXPECT_EQ(sectorScan.GetRayIndex(orderedIndex), expectedOrder[orderedIndex]);
+            EXPECT_EQ(sectorScan.GetOrderedRingIds()[orderedIndex], static_cast<int32_t>(expectedOrder[orderedIndex]));
+        }
+        EXPECT_TRUE(Utils::AzMatrix3x4FromRglMat3x4(sectorScan.GetOrderedRayPoses()[0])
+                        .IsClose(Utils::AzMatrix3x4FromRglMat3x4(MakeRay(-2.0f))));
+    }
+
+    TEST(LidarSectorScanTest, DueRaysFollowTheScanProgress)
+    {
+        LidarSectorScan sectorScan;
+        ConfigureFourRays(sectorScan);
+
+        // The scan period is unknown until the first scan is completed, so no rays are due before it is requested.
+        sectorScan.Advance(0.5f);
+        EXPECT_EQ(sectorScan.GetDueRayCount(), 0U);
+        sectorScan.Advance(0.5f);
+        ROS2::RaycastResult results;
+        sectorScan.Complete(results, true, false);
+
+        sectorScan.Advance(0.25f);
+        EXPECT_EQ(sectorScan.GetDueRayCount(), 1U);
+        TraceDueRays(sectorScan);
+        sectorScan.Advance(0.3f);
+        EXPECT_EQ(sectorScan.GetDueRayCount(), 2U);
+        TraceDueRays(sectorScan);
+
+        // A late scan does not trace more than all the rays.
+        sectorScan.Advance(2.0f);
+        EXPECT_EQ(sectorScan.GetDueRayCount(), 4U);
+
+        // The due ray count never drops below the number of the traced rays.
+        sectorScan.SetTracedRayCount(3U);
+        sectorScan.Complete(results, true, false);
+        sectorScan.SetTracedRayCount(3U);
+        EXPECT_EQ(sectorScan.GetDueRayCount(), 3U);
+    }
+
+    TEST(LidarSectorScanTest, CompletedScanFollowsTheConfiguredOrder)
+    {
+        LidarSectorScan sectorScan;
+        ConfigureFourRays(sectorScan);
+        sectorScan.Advance(1.0f);
+        ROS2::RaycastResult results;
+        sectorScan.Complete(results, true, true);
+
+        sectorScan.Advance(1.0f);
+        TraceDueRays(sectorScan);
+        // The ray configured first produced no point, e.g. a ray without any hit.
+        sectorScan.StoreRayResult(2U, false, AZ::Vector3::CreateZero(), AZStd::numeric_limits<float>::infinity());
+        sectorScan.Complete(results, true, true);
+
+        ASSERT_EQ(results.m_points.size(), 3U);
+        EXPECT_FLOAT_EQ(results.m_points[0].GetX(), 1.0f);
+        EXPECT_FLOAT_EQ(results.m_points[1].GetX(), 2.0f);
+        EXPECT_FLOAT_EQ(results.m_points[2].GetX(), 3.0f);
+        ASSERT_EQ(results.m_ranges.size(), 4U);
+        EXPECT_EQ(results.m_ranges[0], AZStd::numeric_limits<float>::infinity());
+        EXPECT_FLOAT_EQ(results.m_ranges[1], 1.0f);
+        EXPECT_FLOAT_EQ(results.m_ranges[2], 2.0f);
+        EXPECT_FLOAT_EQ(results.m_ranges[3], 3.0f);
+        EXPECT_EQ(sectorScan.GetTracedRayCount(), 0U);
+    }
+} // namespace RGL
@@ -0,0 +1,75 @@
+/* Copyright 2020-2021, Robotec.ai sp. z o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <AzTest/AzTest.h>
+#include <Lidar/PipelineGraph.h>
+#include <Utilities/RGLUtils.h>
+
+namespace RGL
+{
+    class PipelineGraphTest : public ::testing::Test
+    {
+    protected:
+        void TearDown() override
+        {
+            RGL_CHECK(rgl_cleanup());
+        }
+    };
+
+    TEST_F(PipelineGraphTest, DownsampleRequiresCompaction)
+    {
+        PipelineGraph graph;
+        EXPECT_TRUE(graph.IsCompactEnabled());
+        EXPECT_FALSE(graph.IsDownsampleEnabled());
+
+        graph.SetIsDownsampleEnabled(true);
+        EXPECT_TRUE(graph.IsDownsampleEnabled());
+
+        // The downsampling node is connected after the compaction, so it is skipped along with it.
+        graph.SetIsCompactEnabled(false);
+        EXPECT_FALSE(graph.IsDownsampleEnabled());
+
+        graph.SetIsCompactEnabled(true);
+        EXPECT_TRUE(graph.IsDownsampleEnabled());
+    }
+
+    TEST_F(PipelineGraphTest, SnapshotRecordsTheActiveNodes)
+    {
+        using Snapshot::NodeType;
+        PipelineGraph graph;
+        Snapshot::LidarData lidar;
+        graph.AppendToSnapshot(lidar);
+        const std::vector<NodeType> defaultNodes{
+            NodeType::RayPoses,          NodeType::RayRingIds,    NodeType::RayRanges,         NodeType::LidarTransform, NodeType::RayTrace,
+            NodeType::IntermediateYield, NodeType::PointsCompact, NodeType::IntermediateYield, NodeType::ResultsYield
+        };
+        EXPECT_EQ(lidar.m_nodes, defaultNodes);
+
+        graph.SetIsNoiseEnabled(true);
+        graph.SetIsDownsampleEnabled(true);
+        graph.SetIsMotionDistortionEnabled(true);
+        graph.ConfigureAngularNoiseNode(0.01f);
+        graph.ConfigureDownsampleNode(AZ::Vector3(0.5f));
+        graph.AppendToSnapshot(lidar);
+        const std::vector<NodeType> configuredNodes{
+            NodeType::RayPoses,          NodeType::RayRingIds,    NodeType::RayTimeOffsets,   NodeType::RayRanges,
+            NodeType::LidarTransform,    NodeType::AngularNoise,  NodeType::DistortedRayTrace, NodeType::DistanceNoise,
+            NodeType::IntermediateYield, NodeType::PointsCompact, NodeType::PointsDownsample, NodeType::IntermediateYield,
+            NodeType::ResultsYield
+        };
+        EXPECT_EQ(lidar.m_nodes, configuredNodes);
+        EXPECT_FLOAT_EQ(lidar.m_angularNoiseStdDev, 0.01f);
+        EXPECT_FLOAT_EQ(lidar.m_downsampleLeafSize.value[1], 0.5f);
+    }
+} // namespace RGL
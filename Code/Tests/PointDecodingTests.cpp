@@ -0,0 +1,76 @@
+/* Copyright 2020-2021, Robotec.ai sp. z o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <AzTest/AzTest.h>
+#include <RGL/PointDecoding.h>
+#include <cstring>
+#include <vector>
+
+namespace RGL
+{
+    namespace
+    {
+        //! Ray pose with the identity rotation (cast along the Z axis) at the given origin.
+        void MakeRayPose(float (&rayPose)[3][4], float x, float y, float z)
+        {
+            const float pose[3][4] = { { 1.0f, 0.0f, 0.0f, x }, { 0.0f, 1.0f, 0.0f, y }, { 0.0f, 0.0f, 1.0f, z } };
+            std::memcpy(rayPose, pose, sizeof(pose));
+        }
+    } // namespace
+
+    TEST(PointDecodingTest, PointLiesAlongTheRay)
+    {
+        float rayPose[3][4];
+        MakeRayPose(rayPose, 1.0f, 2.0f, 3.0f);
+        float point[3];
+        PointDecoding::DecodePoint(rayPose, 2.0f, point);
+
+        EXPECT_FLOAT_EQ(point[0], 1.0f);
+        EXPECT_FLOAT_EQ(point[1], 2.0f);
+        EXPECT_FLOAT_EQ(point[2], 5.0f);
+    }
+
+    TEST(PointDecodingTest, PointFollowsTheRayDirection)
+    {
+        // The ray is cast along the X axis of the lidar.
+        const float rayPose[3][4] = { { 0.0f, 0.0f, 1.0f, 0.0f }, { 0.0f, 1.0f, 0.0f, 0.0f }, { -1.0f, 0.0f, 0.0f, 0.0f } };
+        float point[3];
+        PointDecoding::DecodePoint(rayPose, 4.0f, point);
+
+        EXPECT_FLOAT_EQ(point[0], 4.0f);
+        EXPECT_FLOAT_EQ(point[1], 0.0f);
+        EXPECT_FLOAT_EQ(point[2], 0.0f);
+    }
+
+    TEST(PointDecodingTest, UnalignedPointsAreDecodedAndInvalidRaysSkipped)
+    {
+        float rayPoses[2][3][4];
+        MakeRayPose(rayPoses[0], 0.0f, 0.0f, 0.0f);
+        MakeRayPose(rayPoses[1], 10.0f, 0.0f, 0.0f);
+
+        const PointDecoding::RayIndexDistancePoint encoded[] = { { 1U, 1.0f }, { 2U, 5.0f }, { 0U, 3.0f } };
+        // The data starts at an odd address, as the point cloud buffers are not guaranteed to be aligned.
+        std::vector<uint8_t> buffer(sizeof(encoded) + 1U);
+        std::memcpy(buffer.data() + 1, encoded, sizeof(encoded));
+
+        float points[3 * 3] = {};
+        const size_t decodedCount = PointDecoding::DecodePoints(buffer.data() + 1, 3, rayPoses, 2, points);
+
+        ASSERT_EQ(decodedCount, 2U);
+        EXPECT_FLOAT_EQ(points[0], 10.0f);
+        EXPECT_FLOAT_EQ(points[2], 1.0f);
+        EXPECT_FLOAT_EQ(points[3], 0.0f);
+        EXPECT_FLOAT_EQ(points[5], 3.0f);
+    }
+} // namespace RGL
@@ -0,0 +1,80 @@
+/* Copyright 2020-2021, Robotec.ai sp. z o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <AzCore/Math/MathUtils.h>
+#include <AzTest/AzTest.h>
+#include <Lidar/RangeImageLayout.h>
+#include <Utilities/RGLUtils.h>
+
+namespace RGL
+{
+    namespace
+    {
+        //! Horizontal ray cast from the lidar origin at the given azimuth (in radians, counterclockwise from the X axis).
+        rgl_mat3x4f MakeRay(float azimuth)
+        {
+            // Rays are cast along the Z axis of their poses.
+            const AZ::Matrix3x4 rayPose =
+                AZ::Matrix3x4::CreateRotationZ(azimuth) * AZ::Matrix3x4::CreateRotationY(AZ::Constants::HalfPi);
+            return Utils::RglMat3x4FromAzMatrix3x4(rayPose);
+        }
+    } // namespace
+
+    TEST(RangeImageLayoutTest, EmptyPatternHasNoCells)
+    {
+        const RangeImageLayout layout = RangeImageLayout::Create({}, {});
+
+        EXPECT_EQ(layout.m_rowCount, 0U);
+        EXPECT_EQ(layout.m_columnCount, 0U);
+        EXPECT_TRUE(layout.m_rayIndices.empty());
+    }
+
+    TEST(RangeImageLayoutTest, RingsAreRowsFromTheTop)
+    {
+        const AZStd::vector<rgl_mat3x4f> rayPoses{ MakeRay(0.0f), MakeRay(0.0f), MakeRay(0.0f) };
+        const AZStd::vector<int32_t> ringIds{ 0, 2, 1 };
+        const RangeImageLayout layout = RangeImageLayout::Create(rayPoses, ringIds);
+
+        EXPECT_EQ(layout.m_rowCount, 3U);
+        EXPECT_EQ(layout.m_columnCount, 1U);
+        const AZStd::vector<int32_t> expectedRayIndices{ 1, 2, 0 };
+        EXPECT_EQ(layout.m_rayIndices, expectedRayIndices);
+    }
+
+    TEST(RangeImageLayoutTest, ColumnsAreOrderedByAzimuth)
+    {
+        const AZStd::vector<rgl_mat3x4f> rayPoses{
+            MakeRay(0.5f), MakeRay(-1.0f), MakeRay(2.0f), MakeRay(1.0f), MakeRay(0.0f), MakeRay(-2.0f),
+        };
+        const AZStd::vector<int32_t> ringIds{ 0, 0, 0, 1, 1, 1 };
+        const RangeImageLayout layout = RangeImageLayout::Create(rayPoses, ringIds);
+
+        EXPECT_EQ(layout.m_rowCount, 2U);
+        EXPECT_EQ(layout.m_columnCount, 3U);
+        const AZStd::vector<int32_t> expectedRayIndices{ 5, 4, 3, 1, 0, 2 };
+        EXPECT_EQ(layout.m_rayIndices, expectedRayIndices);
+    }
+
+    TEST(RangeImageLayoutTest, ShorterRingsLeaveEmptyCells)
+    {
+        const AZStd::vector<rgl_mat3x4f> rayPoses{ MakeRay(0.0f), MakeRay(1.0f), MakeRay(0.5f) };
+        const AZStd::vector<int32_t> ringIds{ 1, 1, 0 };
+        const RangeImageLayout layout = RangeImageLayout::Create(rayPoses, ringIds);
+
+        EXPECT_EQ(layout.m_rowCount, 2U);
+        EXPECT_EQ(layout.m_columnCount, 2U);
+        const AZStd::vector<int32_t> expectedRayIndices{ 0, 1, 2, RangeImageLayout::EmptyCell };
+        EXPECT_EQ(layout.m_rayIndices, expectedRayIndices);
+    }
+} // namespace RGL
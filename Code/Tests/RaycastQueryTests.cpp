@@ -0,0 +1,87 @@
+/* Copyright 2020-2021, Robotec.ai sp. z o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <AzCore/std/limits.h>
+#include <AzTest/AzTest.h>
+#include <Scene/RaycastQuery.h>
+
+namespace RGL
+{
+    namespace
+    {
+        //! Results of three rays, of which only the first and the last one hit an Entity.
+        PipelineGraph::RaycastResults MakeGraphResults(int32_t firstEntityId, int32_t lastEntityId)
+        {
+            PipelineGraph::RaycastResults rglResults;
+            rglResults.m_isHit = { 1, 0, 1 };
+            rglResults.m_xyz = { { .value = { 1.0f, 0.0f, 0.0f } }, { .value = { 5.0f, 5.0f, 5.0f } }, { .value = { 0.0f, 0.0f, 3.0f } } };
+            rglResults.m_distance = { 1.0f, 8.0f, 3.0f };
+            rglResults.m_entityId = { firstEntityId, lastEntityId, lastEntityId };
+            return rglResults;
+        }
+    } // namespace
+
+    TEST(RaycastQueryTest, ResultsAreIndexedByTheRays)
+    {
+        EntityIdRegistry entityIdRegistry;
+        const int32_t firstEntityId = entityIdRegistry.Acquire(AZ::EntityId{ 10U });
+        const int32_t lastEntityId = entityIdRegistry.Acquire(AZ::EntityId{ 20U });
+
+        RaycastBatchResults results;
+        RaycastQuery::ConvertResults(MakeGraphResults(firstEntityId, lastEntityId), 3U, true, entityIdRegistry, results);
+
+        ASSERT_EQ(results.m_distances.size(), 3U);
+        ASSERT_EQ(results.m_points.size(), 3U);
+        ASSERT_EQ(results.m_entityIds.size(), 3U);
+
+        EXPECT_FLOAT_EQ(results.m_distances[0], 1.0f);
+        EXPECT_TRUE(results.m_points[0].IsClose(AZ::Vector3(1.0f, 0.0f, 0.0f)));
+        EXPECT_EQ(results.m_entityIds[0], AZ::EntityId{ 10U });
+
+        // The miss keeps its place between the hits, even though the graph reported a distance and a point for it.
+        EXPECT_EQ(results.m_distances[1], AZStd::numeric_limits<float>::infinity());
+        EXPECT_TRUE(results.m_points[1].IsZero());
+        EXPECT_FALSE(results.m_entityIds[1].IsValid());
+
+        EXPECT_FLOAT_EQ(results.m_distances[2], 3.0f);
+        EXPECT_TRUE(results.m_points[2].IsClose(AZ::Vector3(0.0f, 0.0f, 3.0f)));
+        EXPECT_EQ(results.m_entityIds[2], AZ::EntityId{ 20U });
+    }
+
+    TEST(RaycastQueryTest, EntityIdsAreOnlyReportedOnRequest)
+    {
+        EntityIdRegistry entityIdRegistry;
+        const int32_t entityId = entityIdRegistry.Acquire(AZ::EntityId{ 10U });
+
+        RaycastBatchResults results;
+        RaycastQuery::ConvertResults(MakeGraphResults(entityId, entityId), 3U, false, entityIdRegistry, results);
+
+        EXPECT_EQ(results.m_distances.size(), 3U);
+        EXPECT_EQ(results.m_points.size(), 3U);
+        EXPECT_TRUE(results.m_entityIds.empty());
+    }
+
+    TEST(RaycastQueryTest, UnassignedEntityIdsAreReportedAsInvalid)
+    {
+        // The hits on the RGL entities without an assigned id (e.g. the terrain) report the default id.
+        EntityIdRegistry entityIdRegistry;
+
+        RaycastBatchResults results;
+        RaycastQuery::ConvertResults(MakeGraphResults(EntityIdRegistry::InvalidId, 7), 3U, true, entityIdRegistry, results);
+
+        ASSERT_EQ(results.m_entityIds.size(), 3U);
+        EXPECT_FALSE(results.m_entityIds[0].IsValid());
+        EXPECT_FALSE(results.m_entityIds[2].IsValid());
+    }
+} // namespace RGL
@@ -0,0 +1,143 @@
+/* Copyright 2020-2021, Robotec.ai sp. z o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <AzTest/AzTest.h>
+#include <Scene/SceneChangeLog.h>
+#include <Utilities/RGLUtils.h>
+
+namespace RGL
+{
+    namespace
+    {
+        // The change log only uses the entity handles as keys, so they do not have to point to RGL entities.
+        rgl_entity_t MakeEntity(uintptr_t handle)
+        {
+            return reinterpret_cast<rgl_entity_t>(handle);
+        }
+
+        rgl_mat3x4f MakePose(const AZ::Vector3& translation, float scale = 1.0f)
+        {
+            return Utils::RglMat3x4FromAzMatrix3x4(
+                AZ::Matrix3x4::CreateTranslation(translation) * AZ::Matrix3x4::CreateScale(AZ::Vector3(scale)));
+        }
+    } // namespace
+
+    TEST(SceneChangeLogTest, CommitAdvancesVersionOnlyWithChanges)
+    {
+        SceneChangeLog changeLog;
+        changeLog.Commit();
+        EXPECT_EQ(changeLog.GetVersion(), 0LU);
+
+        changeLog.RecordGlobalChange();
+        changeLog.Commit();
+        EXPECT_EQ(changeLog.GetVersion(), 1LU);
+        EXPECT_TRUE(changeLog.HasChangedSince(0LU, AZ::Vector3::CreateZero(), 0.0f));
+        EXPECT_FALSE(changeLog.HasChangedSince(1LU, AZ::Vector3::CreateZero(), 0.0f));
+    }
+
+    TEST(SceneChangeLogTest, PoseChangeAffectsOnlyTheEntityBounds)
+    {
+        SceneChangeLog changeLog;
+        const rgl_entity_t entity = MakeEntity(1LU);
+        changeLog.SetEntityBoundingRadius(entity, 1.0f);
+        changeLog.RecordPoseChange(entity, MakePose(AZ::Vector3(10.0f, 0.0f, 0.0f)));
+        changeLog.Commit();
+
+        EXPECT_TRUE(changeLog.HasChangedSince(0LU, AZ::Vector3(10.0f, 0.0f, 0.0f), 0.0f));
+        EXPECT_TRUE(changeLog.HasChangedSince(0LU, AZ::Vector3(12.0f, 0.0f, 0.0f), 1.5f));
+        EXPECT_FALSE(changeLog.HasChangedSince(0LU, AZ::Vector3(-10.0f, 0.0f, 0.0f), 5.0f));
+    }
+
+    TEST(SceneChangeLogTest, MovedEntityChangesBothRegions)
+    {
+        SceneChangeLog changeLog;
+        const rgl_entity_t entity = MakeEntity(1LU);
+        changeLog.SetEntityBoundingRadius(entity, 1.0f);
+        changeLog.RecordPoseChange(entity, MakePose(AZ::Vector3(10.0f, 0.0f, 0.0f)));
+        changeLog.Commit();
+        const AZ::u64 version = changeLog.GetVersion();
+
+        changeLog.RecordPoseChange(entity, MakePose(AZ::Vector3(-10.0f, 0.0f, 0.0f)));
+        changeLog.Commit();
+
+        EXPECT_TRUE(changeLog.HasChangedSince(version, AZ::Vector3(10.0f, 0.0f, 0.0f), 0.0f));
+        EXPECT_TRUE(changeLog.HasChangedSince(version, AZ::Vector3(-10.0f, 0.0f, 0.0f), 0.0f));
+        EXPECT_FALSE(changeLog.HasChangedSince(version, AZ::Vector3(0.0f, 10.0f, 0.0f), 1.0f));
+    }
+
+    TEST(SceneChangeLogTest, BoundsAreScaledWithThePose)
+    {
+        SceneChangeLog changeLog;
+        const rgl_entity_t entity = MakeEntity(1LU);
+        changeLog.SetEntityBoundingRadius(entity, 1.0f);
+        changeLog.RecordPoseChange(entity, MakePose(AZ::Vector3::CreateZero(), 2.0f));
+        changeLog.Commit();
+
+        EXPECT_TRUE(changeLog.HasChangedSince(0LU, AZ::Vector3(1.5f, 0.0f, 0.0f), 0.0f));
+        EXPECT_FALSE(changeLog.HasChangedSince(0LU, AZ::Vector3(2.5f, 0.0f, 0.0f), 0.0f));
+    }
+
+    TEST(SceneChangeLogTest, EntitiesWithUnknownBoundsChangeTheWholeScene)
+    {
+        SceneChangeLog changeLog;
+        changeLog.RecordPoseChange(MakeEntity(1LU), MakePose(AZ::Vector3::CreateZero()));
+        changeLog.Commit();
+
+        EXPECT_TRUE(changeLog.HasChangedSince(0LU, AZ::Vector3(1000.0f, 0.0f, 0.0f), 0.0f));
+    }
+
+    TEST(SceneChangeLogTest, DestroyingAnUnknownEntityChangesTheWholeScene)
+    {
+        SceneChangeLog changeLog;
+        const rgl_entity_t entity = MakeEntity(1LU);
+        changeLog.SetEntityBoundingRadius(entity, 1.0f);
+        changeLog.RecordPoseChange(entity, MakePose(AZ::Vector3::CreateZero()));
+        changeLog.Commit();
+        const AZ::u64 version = changeLog.GetVersion();
+
+        changeLog.RecordEntityDestruction(entity);
+        changeLog.Commit();
+        EXPECT_TRUE(changeLog.HasChangedSince(version, AZ::Vector3::CreateZero(), 0.0f));
+        EXPECT_FALSE(changeLog.HasChangedSince(version, AZ::Vector3(10.0f, 0.0f, 0.0f), 1.0f));
+
+        changeLog.RecordEntityDestruction(MakeEntity(2LU));
+        changeLog.Commit();
+        EXPECT_TRUE(changeLog.HasChangedSince(version + 1LU, AZ::Vector3(10.0f, 0.0f, 0.0f), 1.0f));
+    }
+
+    TEST(SceneChangeLogTest, TruncatedLogReportsOlderVersionsAsChanged)
+    {
+        SceneChangeLog changeLog;
+        const rgl_entity_t entity = MakeEntity(1LU);
+        changeLog.SetEntityBoundingRadius(entity, 1.0f);
+        for (size_t changeIndex = 0LU; changeIndex <= SceneChangeLog::Capacity; ++changeIndex)
+        {
+            changeLog.RecordPoseChange(entity, MakePose(AZ::Vector3(10.0f, 0.0f, 0.0f)));
+            changeLog.Commit();
+        }
+
+        // The changes of the first versions were dropped, so any region may have changed.
+        EXPECT_TRUE(changeLog.HasChangedSince(0LU, AZ::Vector3(-10.0f, 0.0f, 0.0f), 0.0f));
+        EXPECT_FALSE(changeLog.HasChangedSince(changeLog.GetVersion() - 1LU, AZ::Vector3(-10.0f, 0.0f, 0.0f), 0.0f));
+    }
+
+    TEST(SceneChangeLogTest, ResetChangesTheWholeScene)
+    {
+        SceneChangeLog changeLog;
+        changeLog.Reset();
+
+        EXPECT_EQ(changeLog.GetVersion(), 1LU);
+        EXPECT_TRUE(changeLog.HasChangedSince(0LU, AZ::Vector3(1000.0f, 0.0f, 0.0f), 0.0f));
+    }
+} // namespace RGL
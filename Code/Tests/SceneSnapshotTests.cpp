@@ -0,0 +1,81 @@
+/* Copyright 2020-2021, Robotec.ai sp. z o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <AzTest/AzTest.h>
+#include <Snapshot/SceneSnapshot.h>
+#include <cstdio>
+
+namespace RGL
+{
+    TEST(SceneSnapshotTest, LidarGraphConfigurationIsSavedAndLoaded)
+    {
+        using Snapshot::NodeType;
+        const rgl_vec3f vertices[] = { { { 0.0f, 0.0f, 0.0f } }, { { 1.0f, 0.0f, 0.0f } }, { { 0.0f, 1.0f, 0.0f } } };
+        const rgl_vec3i indices[] = { { { 0, 1, 2 } } };
+        const rgl_mat3x4f identity{ { { 1.0f, 0.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 1.0f, 0.0f } } };
+
+        Snapshot::SceneSnapshot snapshot;
+        const auto mesh = reinterpret_cast<rgl_mesh_t>(1);
+        snapshot.AddMesh(mesh, vertices, 3U, indices, 1U);
+        EXPECT_TRUE(snapshot.AddEntity(mesh, identity, Snapshot::EntityKind::Dynamic));
+
+        Snapshot::LidarData lidar;
+        lidar.m_pose = identity;
+        lidar.m_maxRange = 50.0f;
+        lidar.m_nodes = { NodeType::RayPoses,          NodeType::RayRingIds,    NodeType::RayTimeOffsets,    NodeType::RayRanges,
+                          NodeType::LidarTransform,    NodeType::AngularNoise,  NodeType::DistortedRayTrace, NodeType::DistanceNoise,
+                          NodeType::IntermediateYield, NodeType::PointsCompact, NodeType::PointsDownsample,  NodeType::IntermediateYield,
+                          NodeType::ResultsYield };
+        lidar.m_rayPoses = { identity, identity };
+        lidar.m_ringIds = { 0, 1 };
+        lidar.m_timeOffsets = { 0.0f, 50.0f };
+        lidar.m_rayRanges = { { { 0.5f, 50.0f } }, { { 1.0f, 50.0f } } };
+        lidar.m_angularNoiseStdDev = 0.002f;
+        lidar.m_distanceNoiseStdDevBase = 0.02f;
+        lidar.m_distanceNoiseStdDevRisePerMeter = 0.001f;
+        lidar.m_downsampleLeafSize = { { 0.1f, 0.2f, 0.3f } };
+        lidar.m_linearVelocity = { { 1.0f, 0.0f, 0.0f } };
+        lidar.m_angularVelocity = { { 0.0f, 0.0f, 0.5f } };
+        lidar.m_intermediateFields = { RGL_FIELD_IS_HIT_I32, RGL_FIELD_XYZ_F32, RGL_FIELD_DISTANCE_F32 };
+        lidar.m_resultFields = { RGL_FIELD_XYZ_F32, RGL_FIELD_DISTANCE_F32 };
+        snapshot.AddLidar(lidar);
+
+        const std::string filePath = ::testing::TempDir() + "SceneSnapshotTest.rglsnap";
+        ASSERT_TRUE(snapshot.Save(filePath));
+        Snapshot::SceneSnapshot loadedSnapshot;
+        ASSERT_TRUE(loadedSnapshot.Load(filePath));
+        std::remove(filePath.c_str());
+
+        ASSERT_EQ(loadedSnapshot.GetMeshes().size(), 1U);
+        ASSERT_EQ(loadedSnapshot.GetEntities().size(), 1U);
+        EXPECT_EQ(loadedSnapshot.GetEntities()[0].m_kind, Snapshot::EntityKind::Dynamic);
+        ASSERT_EQ(loadedSnapshot.GetLidars().size(), 1U);
+        const Snapshot::LidarData& loadedLidar = loadedSnapshot.GetLidars()[0];
+        EXPECT_FLOAT_EQ(loadedLidar.m_maxRange, lidar.m_maxRange);
+        EXPECT_EQ(loadedLidar.m_nodes, lidar.m_nodes);
+        EXPECT_EQ(loadedLidar.m_rayPoses.size(), lidar.m_rayPoses.size());
+        EXPECT_EQ(loadedLidar.m_ringIds, lidar.m_ringIds);
+        EXPECT_EQ(loadedLidar.m_timeOffsets, lidar.m_timeOffsets);
+        ASSERT_EQ(loadedLidar.m_rayRanges.size(), 2U);
+        EXPECT_FLOAT_EQ(loadedLidar.m_rayRanges[1].value[0], 1.0f);
+        EXPECT_FLOAT_EQ(loadedLidar.m_angularNoiseStdDev, lidar.m_angularNoiseStdDev);
+        EXPECT_FLOAT_EQ(loadedLidar.m_distanceNoiseStdDevBase, lidar.m_distanceNoiseStdDevBase);
+        EXPECT_FLOAT_EQ(loadedLidar.m_distanceNoiseStdDevRisePerMeter, lidar.m_distanceNoiseStdDevRisePerMeter);
+        EXPECT_FLOAT_EQ(loadedLidar.m_downsampleLeafSize.value[2], 0.3f);
+        EXPECT_FLOAT_EQ(loadedLidar.m_linearVelocity.value[0], 1.0f);
+        EXPECT_FLOAT_EQ(loadedLidar.m_angularVelocity.value[2], 0.5f);
+        EXPECT_EQ(loadedLidar.m_intermediateFields, lidar.m_intermediateFields);
+        EXPECT_EQ(loadedLidar.m_resultFields, lidar.m_resultFields);
+    }
+} // namespace RGL
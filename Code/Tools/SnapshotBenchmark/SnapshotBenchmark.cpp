@@ -0,0 +1,416 @@
+/* Copyright 2020-2021, Robotec.ai sp. z o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Headless replay of an RGL scene snapshot (see RGLRequests::ExportSceneSnapshot).
+// The snapshot scene is recreated with the RGL API and N frames are replayed. Each frame consists of
+// the same phases as a game tick of the gem: entity pose updates, skinned mesh vertex updates,
+// lidar graph runs and result retrieval. Each phase is timed separately.
+// Note: rgl_graph_run may return before the raytracing is finished, in which case the synchronization cost is
+// accounted for in the result retrieval phase.
+
+#include <Snapshot/SceneSnapshot.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <rgl/api/extensions/pcl.h>
+#include <string>
+#include <vector>
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+#define CHECK(x) Check(x, #x)
+
+    void Check(rgl_status_t status, const char* call)
+    {
+        if (status == RGL_SUCCESS)
+        {
+            return;
+        }
+
+        const char* errorString = nullptr;
+        rgl_get_last_error_string(&errorString);
+        std::fprintf(stderr, "%s failed with status %d: %s\n", call, static_cast<int>(status), errorString ? errorString : "");
+        std::exit(EXIT_FAILURE);
+    }
+
+    struct Options
+    {
+        std::string m_snapshotPath;
+        std::string m_csvPath;
+        int m_frameCount{ 100 };
+        int m_warmupFrameCount{ 10 };
+    };
+
+    struct ReplayLidar
+    {
+        rgl_node_t m_rayPoses{ nullptr }; //!< First node of the graph.
+        rgl_node_t m_resultsYield{ nullptr }; //!< Last node of the graph.
+        const std::vector<rgl_field_t>* m_resultFields{ nullptr };
+    };
+
+    struct ReplayEntity
+    {
+        rgl_entity_t m_entity{ nullptr };
+        const RGL::Snapshot::EntityData* m_data{ nullptr };
+    };
+
+    struct Phase
+    {
+        const char* m_name;
+        std::vector<double> m_samples; //!< Duration of each frame in milliseconds.
+    };
+
+    void PrintUsage(const char* executable)
+    {
+        std::printf("Usage: %s <snapshot file> [--frames N] [--warmup N] [--csv <output file>]\n", executable);
+    }
+
+    bool ParseOptions(int argc, char** argv, Options& options)
+    {
+        for (int argIndex = 1; argIndex < argc; ++argIndex)
+        {
+            const std::string arg{ argv[argIndex] };
+            const bool hasValue = argIndex + 1 < argc;
+            if (arg == "--frames" && hasValue)
+            {
+                options.m_frameCount = std::atoi(argv[++argIndex]);
+            }
+            else if (arg == "--warmup" && hasValue)
+            {
+                options.m_warmupFrameCount = std::atoi(argv[++argIndex]);
+            }
+            else if (arg == "--csv" && hasValue)
+            {
+                options.m_csvPath = argv[++argIndex];
+            }
+            else if (options.m_snapshotPath.empty() && arg.rfind("--", 0) != 0)
+            {
+                options.m_snapshotPath = arg;
+            }
+            else
+            {
+                return false;
+            }
+        }
+
+        return !options.m_snapshotPath.empty() && options.m_frameCount > 0 && options.m_warmupFrameCount >= 0;
+    }
+
+    //! Creates a node of the recorded lidar graph with its recorded parameters.
+    rgl_node_t CreateNode(RGL::Snapshot::NodeType nodeType, const RGL::Snapshot::LidarData& lidarData)
+    {
+        using RGL::Snapshot::NodeType;
+        rgl_node_t node = nullptr;
+        switch (nodeType)
+        {
+        case NodeType::RayPoses:
+            CHECK(rgl_node_rays_from_mat3x4f(&node, lidarData.m_rayPoses.data(), static_cast<int32_t>(lidarData.m_rayPoses.size())));
+            break;
+        case NodeType::RayRingIds:
+            CHECK(rgl_node_rays_set_ring_ids(&node, lidarData.m_ringIds.data(), static_cast<int32_t>(lidarData.m_ringIds.size())));
+            break;
+        case NodeType::RayTimeOffsets:
+            CHECK(rgl_node_rays_set_time_offsets(
+                &node, lidarData.m_timeOffsets.data(), static_cast<int32_t>(lidarData.m_timeOffsets.size())));
+            break;
+        case NodeType::RayRanges:
+            CHECK(rgl_node_rays_set_range(&node, lidarData.m_rayRanges.data(), static_cast<int32_t>(lidarData.m_rayRanges.size())));
+            break;
+        case NodeType::LidarTransform:
+            CHECK(rgl_node_rays_transform(&node, &lidarData.m_pose));
+            break;
+        case NodeType::AngularNoise:
+            CHECK(rgl_node_gaussian_noise_angular_ray(&node, 0.0f, lidarData.m_angularNoiseStdDev, RGL_AXIS_Z));
+            break;
+        case NodeType::RayTrace:
+            CHECK(rgl_node_raytrace(&node, nullptr));
+            break;
+        case NodeType::DistortedRayTrace:
+            CHECK(rgl_node_raytrace_with_distortion(&node, nullptr, &lidarData.m_linearVelocity, &lidarData.m_angularVelocity));
+            break;
+        case NodeType::DistanceNoise:
+            CHECK(rgl_node_gaussian_noise_distance(
+                &node, 0.0f, lidarData.m_distanceNoiseStdDevBase, lidarData.m_distanceNoiseStdDevRisePerMeter));
+            break;
+        case NodeType::PointsCompact:
+            CHECK(rgl_node_points_compact(&node));
+            break;
+        case NodeType::PointsDownsample:
+        {
+            const rgl_vec3f& leafSize = lidarData.m_downsampleLeafSize;
+            CHECK(rgl_node_points_downsample(&node, leafSize.value[0], leafSize.value[1], leafSize.value[2]));
+            break;
+        }
+        case NodeType::IntermediateYield:
+            CHECK(rgl_node_points_yield(
+                &node, lidarData.m_intermediateFields.data(), static_cast<int32_t>(lidarData.m_intermediateFields.size())));
+            break;
+        case NodeType::ResultsYield:
+            CHECK(rgl_node_points_yield(&node, lidarData.m_resultFields.data(), static_cast<int32_t>(lidarData.m_resultFields.size())));
+            break;
+        default:
+            std::fprintf(stderr, "Unknown lidar graph node type %d.\n", static_cast<int>(nodeType));
+            std::exit(EXIT_FAILURE);
+        }
+
+        return node;
+    }
+
+    //! Chains the nodes recorded by the gem's PipelineGraph, so that the replayed graph matches the recorded one.
+    ReplayLidar CreateLidar(const RGL::Snapshot::LidarData& lidarData)
+    {
+        using RGL::Snapshot::NodeType;
+        if (lidarData.m_nodes.empty() || lidarData.m_nodes.front() != NodeType::RayPoses ||
+            lidarData.m_nodes.back() != NodeType::ResultsYield)
+        {
+            std::fprintf(stderr, "The lidar graph has to start with the ray poses and end with the results yield.\n");
+            std::exit(EXIT_FAILURE);
+        }
+
+        ReplayLidar lidar;
+        rgl_node_t parent = nullptr;
+        for (NodeType nodeType : lidarData.m_nodes)
+        {
+            rgl_node_t node = CreateNode(nodeType, lidarData);
+            if (parent)
+            {
+                CHECK(rgl_graph_node_add_child(parent, node));
+            }
+            else
+            {
+                lidar.m_rayPoses = node;
+            }
+            parent = node;
+        }
+
+        lidar.m_resultsYield = parent;
+        lidar.m_resultFields = &lidarData.m_resultFields;
+        return lidar;
+    }
+
+    //! Deterministic motion applied to dynamic entities, so that each frame invalidates the scene.
+    rgl_mat3x4f AnimatePose(const rgl_mat3x4f& pose, int frame, size_t entityIndex)
+    {
+        static constexpr float Amplitude = 0.05f;
+        const float phase = static_cast<float>(frame) * 0.1f + static_cast<float>(entityIndex);
+
+        rgl_mat3x4f animatedPose = pose;
+        animatedPose.value[0][3] += Amplitude * std::sin(phase);
+        animatedPose.value[1][3] += Amplitude * std::cos(phase);
+        return animatedPose;
+    }
+
+    double ToMilliseconds(Clock::duration duration)
+    {
+        return std::chrono::duration<double, std::milli>(duration).count();
+    }
+
+    double Percentile(std::vector<double> samples, double percentile)
+    {
+        std::sort(samples.begin(), samples.end());
+        const auto index = static_cast<size_t>(std::ceil(percentile * static_cast<double>(samples.size() - 1LU)));
+        return samples[index];
+    }
+
+    void PrintStatistics(const std::vector<Phase>& phases)
+    {
+        std::printf("%-20s %10s %10s %10s %10s %10s\n", "phase [ms]", "min", "mean", "median", "p95", "max");
+        for (const Phase& phase : phases)
+        {
+            double sum = 0.0;
+            for (double sample : phase.m_samples)
+            {
+                sum += sample;
+            }
+
+            std::printf(
+                "%-20s %10.3f %10.3f %10.3f %10.3f %10.3f\n",
+                phase.m_name,
+                *std::min_element(phase.m_samples.begin(), phase.m_samples.end()),
+                sum / static_cast<double>(phase.m_samples.size()),
+                Percentile(phase.m_samples, 0.5),
+                Percentile(phase.m_samples, 0.95),
+                *std::max_element(phase.m_samples.begin(), phase.m_samples.end()));
+        }
+    }
+
+    bool WriteCsv(const std::string& filePath, const std::vector<Phase>& phases)
+    {
+        std::ofstream stream(filePath, std::ios::trunc);
+        if (!stream.is_open())
+        {
+            return false;
+        }
+
+        stream << "frame";
+        for (const Phase& phase : phases)
+        {
+            stream << ',' << phase.m_name;
+        }
+        stream << '\n';
+
+        for (size_t frame = 0LU; frame < phases.front().m_samples.size(); ++frame)
+        {
+            stream << frame;
+            for (const Phase& phase : phases)
+            {
+                stream << ',' << phase.m_samples[frame];
+            }
+            stream << '\n';
+        }
+
+        return stream.good();
+    }
+} // namespace
+
+int main(int argc, char** argv)
+{
+    Options options;
+    if (!ParseOptions(argc, argv, options))
+    {
+        PrintUsage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    RGL::Snapshot::SceneSnapshot snapshot;
+    if (!snapshot.Load(options.m_snapshotPath))
+    {
+        std::fprintf(stderr, "Unable to load the snapshot file %s.\n", options.m_snapshotPath.c_str());
+        return EXIT_FAILURE;
+    }
+
+    CHECK(rgl_configure_logging(RGL_LOG_LEVEL_WARN, nullptr, true));
+
+    const auto setupStart = Clock::now();
+    std::vector<rgl_mesh_t> meshes;
+    meshes.reserve(snapshot.GetMeshes().size());
+    size_t triangleCount = 0LU;
+    for (const RGL::Snapshot::MeshData& meshData : snapshot.GetMeshes())
+    {
+        rgl_mesh_t mesh = nullptr;
+        CHECK(rgl_mesh_create(
+            &mesh,
+            meshData.m_vertices.data(),
+            static_cast<int32_t>(meshData.m_vertices.size()),
+            meshData.m_indices.data(),
+            static_cast<int32_t>(meshData.m_indices.size())));
+        meshes.push_back(mesh);
+        triangleCount += meshData.m_indices.size();
+    }
+
+    std::vector<ReplayEntity> dynamicEntities, skinnedEntities;
+    for (const RGL::Snapshot::EntityData& entityData : snapshot.GetEntities())
+    {
+        rgl_entity_t entity = nullptr;
+        CHECK(rgl_entity_create(&entity, nullptr, meshes[entityData.m_meshIndex]));
+        CHECK(rgl_entity_set_pose(entity, &entityData.m_pose));
+
+        if (entityData.m_kind == RGL::Snapshot::EntityKind::Dynamic)
+        {
+            dynamicEntities.push_back({ entity, &entityData });
+        }
+        else if (entityData.m_kind == RGL::Snapshot::EntityKind::Skinned)
+        {
+            skinnedEntities.push_back({ entity, &entityData });
+        }
+    }
+
+    std::vector<ReplayLidar> lidars;
+    size_t rayCount = 0LU;
+    for (const RGL::Snapshot::LidarData& lidarData : snapshot.GetLidars())
+    {
+        lidars.push_back(CreateLidar(lidarData));
+        rayCount += lidarData.m_rayPoses.size();
+    }
+
+    std::printf(
+        "Loaded %zu meshes (%zu triangles), %zu entities (%zu dynamic, %zu skinned) and %zu lidars (%zu rays) in %.3f ms.\n",
+        meshes.size(),
+        triangleCount,
+        snapshot.GetEntities().size(),
+        dynamicEntities.size(),
+        skinnedEntities.size(),
+        lidars.size(),
+        rayCount,
+        ToMilliseconds(Clock::now() - setupStart));
+
+    std::vector<Phase> phases{ { "entity poses", {} }, { "skinned vertices", {} }, { "graph run", {} }, { "results", {} }, { "frame", {} } };
+    std::vector<char> results;
+    for (int frame = -options.m_warmupFrameCount; frame < options.m_frameCount; ++frame)
+    {
+        const auto frameStart = Clock::now();
+        for (size_t entityIndex = 0LU; entityIndex < dynamicEntities.size(); ++entityIndex)
+        {
+            const rgl_mat3x4f pose = AnimatePose(dynamicEntities[entityIndex].m_data->m_pose, frame, entityIndex);
+            CHECK(rgl_entity_set_pose(dynamicEntities[entityIndex].m_entity, &pose));
+        }
+
+        const auto skinningStart = Clock::now();
+        for (const ReplayEntity& entity : skinnedEntities)
+        {
+            // The snapshot contains a single skinning state, so the same vertices are reuploaded to measure the transfer cost.
+            const RGL::Snapshot::MeshData& meshData = snapshot.GetMeshes()[entity.m_data->m_meshIndex];
+            CHECK(rgl_mesh_update_vertices(
+                meshes[entity.m_data->m_meshIndex], meshData.m_vertices.data(), static_cast<int32_t>(meshData.m_vertices.size())));
+        }
+
+        const auto runStart = Clock::now();
+        for (const ReplayLidar& lidar : lidars)
+        {
+            CHECK(rgl_graph_run(lidar.m_rayPoses));
+        }
+
+        const auto resultsStart = Clock::now();
+        for (const ReplayLidar& lidar : lidars)
+        {
+            for (rgl_field_t field : *lidar.m_resultFields)
+            {
+                int32_t resultCount = 0, resultSize = 0;
+                CHECK(rgl_graph_get_result_size(lidar.m_resultsYield, field, &resultCount, &resultSize));
+                results.resize(static_cast<size_t>(resultCount) * static_cast<size_t>(resultSize));
+                if (resultCount > 0)
+                {
+                    CHECK(rgl_graph_get_result_data(lidar.m_resultsYield, field, results.data()));
+                }
+            }
+        }
+        const auto frameEnd = Clock::now();
+
+        if (frame < 0)
+        {
+            continue;
+        }
+
+        phases[0].m_samples.push_back(ToMilliseconds(skinningStart - frameStart));
+        phases[1].m_samples.push_back(ToMilliseconds(runStart - skinningStart));
+        phases[2].m_samples.push_back(ToMilliseconds(resultsStart - runStart));
+        phases[3].m_samples.push_back(ToMilliseconds(frameEnd - resultsStart));
+        phases[4].m_samples.push_back(ToMilliseconds(frameEnd - frameStart));
+    }
+
+    PrintStatistics(phases);
+    if (!options.m_csvPath.empty() && !WriteCsv(options.m_csvPath, phases))
+    {
+        std::fprintf(stderr, "Unable to write the CSV file %s.\n", options.m_csvPath.c_str());
+    }
+
+    CHECK(rgl_cleanup());
+    return EXIT_SUCCESS;
+}
@@ -16,22 +16,77 @@ set(FILES
         Source/Entity/ActorEntityManager.h
         Source/Entity/MeshEntityManager.cpp
         Source/Entity/MeshEntityManager.h
+        Source/Entity/DynamicEntityList.cpp
+        Source/Entity/DynamicEntityList.h
+        Source/Entity/EntityIdRegistry.cpp
+        Source/Entity/EntityIdRegistry.h
         Source/Entity/EntityManager.cpp
         Source/Entity/EntityManager.h
+        Source/Entity/EntityManagerPool.h
+        Source/Entity/ReflectivityComponent.cpp
+        Source/Entity/ReflectivityComponent.h
+        Source/Entity/SemanticClassComponent.cpp
+        Source/Entity/SemanticClassComponent.h
         Source/Entity/TerrainEntityManagerSystemComponent.cpp
         Source/Entity/TerrainEntityManagerSystemComponent.h
+        Source/Lidar/LaserScanPublisher.cpp
+        Source/Lidar/LaserScanPublisher.h
+        Source/Lidar/LidarCrop.cpp
+        Source/Lidar/LidarCrop.h
+        Source/Lidar/LidarGroup.cpp
+        Source/Lidar/LidarGroup.h
+        Source/Lidar/LidarGroupBus.h
+        Source/Lidar/LidarGroupComponent.cpp
+        Source/Lidar/LidarGroupComponent.h
+        Source/Lidar/LidarMultiReturn.cpp
+        Source/Lidar/LidarMultiReturn.h
+        Source/Lidar/LidarRayPatternComponent.cpp
+        Source/Lidar/LidarRayPatternComponent.h
         Source/Lidar/LidarRaycaster.cpp
         Source/Lidar/LidarRaycaster.h
+        Source/Lidar/LidarResultProcessor.cpp
+        Source/Lidar/LidarResultProcessor.h
+        Source/Lidar/LidarScheduler.cpp
+        Source/Lidar/LidarScheduler.h
+        Source/Lidar/LidarSectorScan.cpp
+        Source/Lidar/LidarSectorScan.h
+        Source/Lidar/LidarSettingsComponent.cpp
+        Source/Lidar/LidarSettingsComponent.h
         Source/Lidar/LidarSystem.cpp
         Source/Lidar/LidarSystem.h
         Source/Lidar/PipelineGraph.cpp
         Source/Lidar/PipelineGraph.h
+        Source/Lidar/PipelineGraphPool.cpp
+        Source/Lidar/PipelineGraphPool.h
+        Source/Lidar/PointCloudFormat.cpp
+        Source/Lidar/PointCloudFormat.h
+        Source/Lidar/RangeImageLayout.cpp
+        Source/Lidar/RangeImageLayout.h
+        Source/Lidar/RayPatternCache.cpp
+        Source/Lidar/RayPatternCache.h
+        Source/Lidar/RayPatternLibrary.cpp
+        Source/Lidar/RayPatternLibrary.h
+        Source/Lidar/RayPatternPublisher.cpp
+        Source/Lidar/RayPatternPublisher.h
         Source/Mesh/MeshLibrary.cpp
         Source/Mesh/MeshLibrary.h
         Source/RGLSystemComponent.cpp
         Source/RGLSystemComponent.h
+        Source/Utilities/ApiTracer.cpp
+        Source/Utilities/ApiTracer.h
         Source/Utilities/RGLUtils.cpp
         Source/Utilities/RGLUtils.h
+        Source/Scene/RaycastQuery.cpp
+        Source/Scene/RaycastQuery.h
+        Source/Scene/SceneChangeLog.cpp
+        Source/Scene/SceneChangeLog.h
+        Source/Scene/SceneCommandBuffer.cpp
+        Source/Scene/SceneCommandBuffer.h
+        Source/Scene/SceneCommandBufferBus.h
+        Source/Scene/SceneVisibilityBus.h
         Source/SceneConfigurationComponent.cpp
         Source/SceneConfigurationComponent.h
+        Source/Snapshot/SceneSnapshot.cpp
+        Source/Snapshot/SceneSnapshot.h
+        Source/Snapshot/SceneSnapshotBus.h
 )
@@ -12,5 +12,9 @@
 # See the License for the specific language governing permissions and
 # limitations under the License.
 set(FILES
+        Include/RGL/LidarRangeImageBus.h
+        Include/RGL/PointDecoding.h
+        Include/RGL/ReflectivityBus.h
         Include/RGL/RGLBus.h
+        Include/RGL/SemanticClassBus.h
 )
@@ -0,0 +1,34 @@
+# Copyright 2020-2021, Robotec.ai sp. z o.o.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+set(FILES
+        Tests/ApiCallBudgetTests.cpp
+        Tests/DynamicEntityListTests.cpp
+        Tests/EntityIdRegistryTests.cpp
+        Tests/EntityManagerPoolTests.cpp
+        Tests/LaserScanPublisherTests.cpp
+        Tests/LidarCropTests.cpp
+        Tests/LidarGroupTests.cpp
+        Tests/LidarMultiReturnTests.cpp
+        Tests/LidarRaycasterTests.cpp
+        Tests/LidarResultProcessorTests.cpp
+        Tests/LidarSchedulerTests.cpp
+        Tests/LidarSectorScanTests.cpp
+        Tests/PipelineGraphTests.cpp
+        Tests/PointDecodingTests.cpp
+        Tests/RangeImageLayoutTests.cpp
+        Tests/RaycastQueryTests.cpp
+        Tests/RGLTest.cpp
+        Tests/SceneChangeLogTests.cpp
+        Tests/SceneSnapshotTests.cpp
+)